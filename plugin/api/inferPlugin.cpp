@@ -53,10 +53,15 @@
 #include "voxelGeneratorPlugin/voxelGenerator.h"
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <string_view>
+#include <type_traits>
 #include <unordered_set>
 using namespace nvinfer1;
 using namespace nvinfer1::plugin;
@@ -86,6 +91,18 @@ public:
 
     template <typename CreatorType>
     void addPluginCreator(void* logger, char const* libNamespace)
+    {
+        std::unique_ptr<CreatorType> pluginCreator{new CreatorType{}};
+        pluginCreator->setPluginNamespace(libNamespace);
+        char const* name = pluginCreator->getPluginName();
+        char const* version = pluginCreator->getPluginVersion();
+        addPluginCreator(std::move(pluginCreator), name, version, logger, libNamespace);
+    }
+
+    //! Register creator, whose getPluginName() and getPluginVersion() return name and version, unless a creator of
+    //! the same type was registered before.
+    void addPluginCreator(std::unique_ptr<IPluginCreatorInterface> pluginCreator, char const* name,
+        char const* version, void* logger, char const* libNamespace)
     {
         // Make accesses to the plugin creator registry thread safe
         std::lock_guard<std::mutex> lock(mRegistryLock);
@@ -93,13 +110,8 @@ public:
         std::string errorMsg;
         std::string verboseMsg;
 
-        std::unique_ptr<CreatorType> pluginCreator{new CreatorType{}};
-        pluginCreator->setPluginNamespace(libNamespace);
-
         nvinfer1::plugin::gLogger = static_cast<nvinfer1::ILogger*>(logger);
-        std::string pluginType = std::string{pluginCreator->getPluginNamespace()}
-            + "::" + std::string{pluginCreator->getPluginName()} + " version "
-            + std::string{pluginCreator->getPluginVersion()};
+        std::string pluginType = std::string{libNamespace} + "::" + name + " version " + version;
 
         if (mRegistryList.find(pluginType) == mRegistryList.end())
         {
@@ -163,6 +175,198 @@ void initializePlugin(void* logger, char const* libNamespace)
     PluginCreatorRegistry::getInstance().addPluginCreator<CreatorType>(logger, libNamespace);
 }
 
+//! Common part of the lazy creators: the name and version come from the creator table, and the creator itself is
+//! only constructed once the registry needs more than that, i.e. its fields or a plugin.
+template <typename CreatorType, typename InterfaceType>
+class LazyPluginCreatorBase : public InterfaceType
+{
+public:
+    LazyPluginCreatorBase(char const* name, char const* version, char const* libNamespace)
+        : mName(name)
+        , mVersion(version)
+        , mNamespace(libNamespace)
+    {
+    }
+
+    char const* getPluginName() const noexcept override
+    {
+        return mName;
+    }
+
+    char const* getPluginVersion() const noexcept override
+    {
+        return mVersion;
+    }
+
+    char const* getPluginNamespace() const noexcept override
+    {
+        return mNamespace.c_str();
+    }
+
+    PluginFieldCollection const* getFieldNames() noexcept override
+    {
+        CreatorType* creator = getCreator();
+        return creator == nullptr ? nullptr : creator->getFieldNames();
+    }
+
+protected:
+    //! The creator, constructed on first use. nullptr if it could not be constructed.
+    CreatorType* getCreator() noexcept
+    {
+        std::call_once(mCreated, [this]() {
+            try
+            {
+                mCreator.reset(new CreatorType{});
+                mCreator->setPluginNamespace(mNamespace.c_str());
+            }
+            catch (std::exception const& e)
+            {
+                mCreator.reset();
+                logMessage(ILogger::Severity::kERROR,
+                    std::string{"Could not create plugin creator - "} + mName + " version " + mVersion + ": "
+                        + e.what());
+                return;
+            }
+            // The registry has already been told the name and version from the table; they must not change.
+            if (std::strcmp(mCreator->getPluginName(), mName) != 0
+                || std::strcmp(mCreator->getPluginVersion(), mVersion) != 0)
+            {
+                logMessage(ILogger::Severity::kERROR,
+                    std::string{"Plugin creator table entry "} + mName + " version " + mVersion
+                        + " does not match its creator " + mCreator->getPluginName() + " version "
+                        + mCreator->getPluginVersion());
+            }
+            logMessage(ILogger::Severity::kVERBOSE,
+                std::string{"Instantiated plugin creator - "} + mNamespace + "::" + mName + " version " + mVersion);
+        });
+        return mCreator.get();
+    }
+
+    static void logMessage(ILogger::Severity severity, std::string const& message) noexcept
+    {
+        if (nvinfer1::plugin::gLogger != nullptr)
+        {
+            nvinfer1::plugin::gLogger->log(severity, message.c_str());
+        }
+    }
+
+    char const* mName;
+    char const* mVersion;
+    std::string mNamespace;
+    std::once_flag mCreated;
+    std::unique_ptr<CreatorType> mCreator;
+};
+
+template <typename CreatorType>
+class LazyPluginCreatorV2 final : public LazyPluginCreatorBase<CreatorType, IPluginCreator>
+{
+public:
+    using LazyPluginCreatorBase<CreatorType, IPluginCreator>::LazyPluginCreatorBase;
+
+    IPluginV2* createPlugin(char const* name, PluginFieldCollection const* fc) noexcept override
+    {
+        CreatorType* creator = this->getCreator();
+        return creator == nullptr ? nullptr : creator->createPlugin(name, fc);
+    }
+
+    IPluginV2* deserializePlugin(char const* name, void const* serialData, size_t serialLength) noexcept override
+    {
+        CreatorType* creator = this->getCreator();
+        return creator == nullptr ? nullptr : creator->deserializePlugin(name, serialData, serialLength);
+    }
+
+    void setPluginNamespace(char const* libNamespace) noexcept override
+    {
+        // Only called by the registry before the creator is used.
+        this->mNamespace = libNamespace;
+    }
+};
+
+template <typename CreatorType>
+class LazyPluginCreatorV3One final : public LazyPluginCreatorBase<CreatorType, IPluginCreatorV3One>
+{
+public:
+    using LazyPluginCreatorBase<CreatorType, IPluginCreatorV3One>::LazyPluginCreatorBase;
+
+    IPluginV3* createPlugin(char const* name, PluginFieldCollection const* fc, TensorRTPhase phase) noexcept override
+    {
+        CreatorType* creator = this->getCreator();
+        return creator == nullptr ? nullptr : creator->createPlugin(name, fc, phase);
+    }
+};
+
+template <typename CreatorType>
+void initializeLazyPlugin(void* logger, char const* libNamespace, char const* name, char const* version)
+{
+    using LazyCreatorType = std::conditional_t<std::is_base_of_v<IPluginCreatorV3One, CreatorType>,
+        LazyPluginCreatorV3One<CreatorType>, LazyPluginCreatorV2<CreatorType>>;
+    PluginCreatorRegistry::getInstance().addPluginCreator(
+        std::make_unique<LazyCreatorType>(name, version, libNamespace), name, version, logger, libNamespace);
+}
+
+//! Static description of a plugin creator of this library. The name and version are those the creator reports; they
+//! let the creator be registered without being constructed.
+struct PluginCreatorEntry
+{
+    char const* name;
+    char const* version;
+    void (*initialize)(void* logger, char const* libNamespace);
+    void (*initializeLazy)(void* logger, char const* libNamespace, char const* name, char const* version);
+};
+
+template <typename CreatorType>
+constexpr PluginCreatorEntry makePluginCreatorEntry(char const* name, char const* version)
+{
+    return PluginCreatorEntry{name, version, &initializePlugin<CreatorType>, &initializeLazyPlugin<CreatorType>};
+}
+
+// clang-format off
+constexpr PluginCreatorEntry kPLUGIN_CREATORS[] = {
+    makePluginCreatorEntry<nvinfer1::plugin::ROIAlignV3PluginCreator>("ROIAlign_TRT", "2"),
+    makePluginCreatorEntry<nvinfer1::plugin::CropAndResizeDynamicPluginCreator>("CropAndResizeDynamic", "2"),
+    makePluginCreatorEntry<nvinfer1::plugin::InstanceNormalizationV3PluginCreator>("InstanceNormalization_TRT", "3"),
+    makePluginCreatorEntry<nvinfer1::plugin::ScatterElementsPluginV3Creator>("ScatterElements", "2"),
+    makePluginCreatorEntry<nvinfer1::plugin::MultiscaleDeformableAttnPluginCreator>("MultiscaleDeformableAttnPlugin_TRT", "2"),
+    makePluginCreatorEntry<nvinfer1::plugin::ModulatedDeformableConvPluginDynamicCreator>("ModulatedDeformConv2d", "2"),
+    makePluginCreatorEntry<nvinfer1::plugin::DecodeBbox3DPluginCreator>("DecodeBbox3DPlugin", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::DetectionLayerPluginCreator>("DetectionLayer_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::EfficientNMSExplicitTFTRTPluginCreator>("EfficientNMS_Explicit_TF_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::EfficientNMSImplicitTFTRTPluginCreator>("EfficientNMS_Implicit_TF_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::EfficientNMSPluginCreator>("EfficientNMS_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::FlattenConcatPluginCreator>("FlattenConcat_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::GenerateDetectionPluginCreator>("GenerateDetection_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::GridAnchorPluginCreator>("GridAnchor_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::GridAnchorRectPluginCreator>("GridAnchorRect_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::InstanceNormalizationPluginCreator>("InstanceNormalization_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::InstanceNormalizationPluginCreatorV2>("InstanceNormalization_TRT", "2"),
+    makePluginCreatorEntry<nvinfer1::plugin::ModulatedDeformableConvPluginDynamicLegacyCreator>("ModulatedDeformConv2d", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::MultilevelCropAndResizePluginCreator>("MultilevelCropAndResize_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::MultilevelProposeROIPluginCreator>("MultilevelProposeROI_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::MultiscaleDeformableAttnPluginCreatorLegacy>("MultiscaleDeformableAttnPlugin_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::PillarScatterPluginCreator>("PillarScatterPlugin", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::PriorBoxPluginCreator>("PriorBox_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::ProposalLayerPluginCreator>("ProposalLayer_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::PyramidROIAlignPluginCreator>("PyramidROIAlign_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::RegionPluginCreator>("Region_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::ReorgDynamicPluginCreator>("Reorg_TRT", "2"),
+    makePluginCreatorEntry<nvinfer1::plugin::ReorgStaticPluginCreator>("Reorg_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::ResizeNearestPluginCreator>("ResizeNearest_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::ROIAlignPluginCreator>("ROIAlign_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::RPROIPluginCreator>("RPROI_TRT", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::ScatterElementsPluginV2Creator>("ScatterElements", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::ScatterNDPluginCreator>("ScatterND", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::TopkLastDimPluginCreator>("TopkLastDim", "1"),
+    makePluginCreatorEntry<nvinfer1::plugin::VoxelGeneratorPluginCreator>("VoxelGeneratorPlugin", "1"),
+};
+// clang-format on
+
+//! Lazy registration is selected by setting TRT_PLUGIN_LAZY_REGISTRATION to 1.
+bool useLazyRegistration()
+{
+    char const* value = std::getenv("TRT_PLUGIN_LAZY_REGISTRATION");
+    return value != nullptr && std::string_view{value} == "1";
+}
+
 } // namespace
 // New Plugin APIs
 
@@ -170,41 +374,26 @@ extern "C"
 {
     bool initLibNvInferPlugins(void* logger, char const* libNamespace)
     {
-        initializePlugin<nvinfer1::plugin::ROIAlignV3PluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::CropAndResizeDynamicPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::InstanceNormalizationV3PluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::ScatterElementsPluginV3Creator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::MultiscaleDeformableAttnPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::ModulatedDeformableConvPluginDynamicCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::DecodeBbox3DPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::DetectionLayerPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::EfficientNMSExplicitTFTRTPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::EfficientNMSImplicitTFTRTPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::EfficientNMSPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::FlattenConcatPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::GenerateDetectionPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::GridAnchorPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::GridAnchorRectPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::InstanceNormalizationPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::InstanceNormalizationPluginCreatorV2>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::ModulatedDeformableConvPluginDynamicLegacyCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::MultilevelCropAndResizePluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::MultilevelProposeROIPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::MultiscaleDeformableAttnPluginCreatorLegacy>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::PillarScatterPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::PriorBoxPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::ProposalLayerPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::PyramidROIAlignPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::RegionPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::ReorgDynamicPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::ReorgStaticPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::ResizeNearestPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::ROIAlignPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::RPROIPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::ScatterElementsPluginV2Creator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::ScatterNDPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::TopkLastDimPluginCreator>(logger, libNamespace);
-        initializePlugin<nvinfer1::plugin::VoxelGeneratorPluginCreator>(logger, libNamespace);
+        auto const start = std::chrono::steady_clock::now();
+        bool const lazy = useLazyRegistration();
+        for (auto const& entry : kPLUGIN_CREATORS)
+        {
+            if (lazy)
+            {
+                entry.initializeLazy(logger, libNamespace, entry.name, entry.version);
+            }
+            else
+            {
+                entry.initialize(logger, libNamespace);
+            }
+        }
+        if (logger)
+        {
+            std::chrono::duration<double, std::milli> const elapsed = std::chrono::steady_clock::now() - start;
+            std::string const msg = "Initialized " + std::to_string(std::size(kPLUGIN_CREATORS))
+                + (lazy ? " lazy" : "") + " plugin creators in " + std::to_string(elapsed.count()) + " ms";
+            static_cast<ILogger*>(logger)->log(ILogger::Severity::kVERBOSE, msg.c_str());
+        }
         return true;
     }
 } // extern "C"
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host versions of priorBoxKernel (priorBoxLayer.cu) and gridAnchorKernel (gridAnchorLayer.cu). Anchors only depend
+// on the plugin parameters and the feature map size, so the plugins generate them once on the host and copy them on
+// enqueue. Every expression below is evaluated with the same types and in the same order as in the kernels so that the
+// results are identical; fmin/fmax match the NaN handling of the CUDA min/max.
+
+#include "common/kernels/kernel.h"
+#include <cmath>
+
+namespace nvinfer1::plugin
+{
+namespace
+{
+void writeBox(float* output, float xMin, float yMin, float xMax, float yMax)
+{
+    output[0] = xMin;
+    output[1] = yMin;
+    output[2] = xMax;
+    output[3] = yMax;
+}
+
+void writeVariance(float* output, float const (&variance)[4], int32_t count)
+{
+    for (int32_t i = 0; i < count; ++i)
+    {
+        writeBox(output + i * 4, variance[0], variance[1], variance[2], variance[3]);
+    }
+}
+} // namespace
+
+void priorBoxHost(PriorBoxParameters const& param, int32_t H, int32_t W, int32_t numPriors, int32_t numAspectRatios,
+    float const* minSize, float const* maxSize, float const* aspectRatios, float* outputData)
+{
+    PLUGIN_ASSERT(param.numMaxSize >= 0);
+    int32_t const dim = H * W * numPriors;
+    bool const haveMaxSize = param.numMaxSize > 0;
+    int32_t const dimAR = (haveMaxSize ? 1 : 0) + numAspectRatios;
+    auto clip = [&param](float v) { return param.clip ? std::fmin(std::fmax(v, 0.0F), 1.0F) : v; };
+
+    for (int32_t i = 0; i < dim; ++i)
+    {
+        int32_t const w = (i / numPriors) % W;
+        int32_t const h = (i / numPriors) / W;
+        float const centerX = (w + param.offset) * param.stepW;
+        float const centerY = (h + param.offset) * param.stepH;
+        int32_t const minSizeId = (i / dimAR) % param.numMinSize;
+        int32_t const arId = i % dimAR;
+
+        float boxW;
+        float boxH;
+        if (arId == 0)
+        {
+            boxW = minSize[minSizeId];
+            boxH = boxW;
+        }
+        else if (haveMaxSize && arId == 1)
+        {
+            boxW = std::sqrt(minSize[minSizeId] * maxSize[minSizeId]);
+            boxH = boxW;
+        }
+        else
+        {
+            int32_t const arOffset = haveMaxSize ? arId - 1 : arId;
+            boxW = minSize[minSizeId] * std::sqrt(aspectRatios[arOffset]);
+            boxH = minSize[minSizeId] / std::sqrt(aspectRatios[arOffset]);
+        }
+        writeBox(outputData + i * 4, clip((centerX - boxW / 2.0F) / param.imgW),
+            clip((centerY - boxH / 2.0F) / param.imgH), clip((centerX + boxW / 2.0F) / param.imgW),
+            clip((centerY + boxH / 2.0F) / param.imgH));
+    }
+    writeVariance(outputData + dim * 4, param.variance, dim);
+}
+
+void anchorGridHost(GridAnchorParameters const& param, int32_t numAspectRatios, float const* widths,
+    float const* heights, float* outputData)
+{
+    int32_t const dim = param.H * param.W * numAspectRatios;
+    float const anchorStrideH = (1.0F / param.H);
+    float const anchorStrideW = (1.0F / param.W);
+    float const anchorOffsetH = 0.5F * anchorStrideH;
+    float const anchorOffsetW = 0.5F * anchorStrideW;
+
+    for (int32_t tid = 0; tid < dim; ++tid)
+    {
+        int32_t const arId = tid % numAspectRatios;
+        int32_t const currIndex = tid / numAspectRatios;
+        int32_t const w = currIndex % param.W;
+        int32_t const h = currIndex / param.W;
+
+        float const yC = std::fma(static_cast<float>(h), anchorStrideH, anchorOffsetH);
+        float const xC = std::fma(static_cast<float>(w), anchorStrideW, anchorOffsetW);
+
+        // The kernel computes the corners in double.
+        writeBox(outputData + tid * 4, static_cast<float>(xC - 0.5 * widths[arId]),
+            static_cast<float>(yC - 0.5 * heights[arId]), static_cast<float>(xC + 0.5 * widths[arId]),
+            static_cast<float>(yC + 0.5 * heights[arId]));
+    }
+    writeVariance(outputData + dim * 4, param.variance, dim);
+}
+
+} // namespace nvinfer1::plugin
@@ -0,0 +1,372 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/kernels/kernel.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <cuda_runtime_api.h>
+#include <functional>
+#include <vector>
+
+using namespace nvinfer1::plugin;
+
+namespace
+{
+// Boxes for the configurations below, as [xMin, yMin, xMax, yMax] per prior. They were computed with a float32 model of
+// priorBoxKernel and gridAnchorKernel (correctly rounded division and square root, fmaf for the grid centers), not on a
+// GPU; the MatchesKernel tests compare the host versions with the kernels themselves where a device is available.
+
+std::vector<float> const kSSD_MAX_SIZE{
+    0.2F, 0.2F, 0.3F, 0.3F,
+    0.17928933F, 0.17928933F, 0.3207107F, 0.3207107F,
+    0.17928933F, 0.21464467F, 0.3207107F, 0.28535533F,
+    0.21464467F, 0.17928933F, 0.28535533F, 0.3207107F,
+    0.7F, 0.2F, 0.8F, 0.3F,
+    0.67928934F, 0.17928933F, 0.82071066F, 0.3207107F,
+    0.67928934F, 0.21464467F, 0.82071066F, 0.28535533F,
+    0.7146447F, 0.17928933F, 0.7853553F, 0.3207107F,
+    0.2F, 0.7F, 0.3F, 0.8F,
+    0.17928933F, 0.67928934F, 0.3207107F, 0.82071066F,
+    0.17928933F, 0.7146447F, 0.3207107F, 0.7853553F,
+    0.21464467F, 0.67928934F, 0.28535533F, 0.82071066F,
+    0.7F, 0.7F, 0.8F, 0.8F,
+    0.67928934F, 0.67928934F, 0.82071066F, 0.82071066F,
+    0.67928934F, 0.7146447F, 0.82071066F, 0.7853553F,
+    0.7146447F, 0.67928934F, 0.7853553F, 0.82071066F
+};
+
+std::vector<float> const kSSD_CLIP_TWO_MIN_SIZES{
+    0.06666667F, 0.1F, 0.26666668F, 0.4F,
+    0.0F, 0.16339745F, 0.33987176F, 0.33660257F,
+    0.108931646F, 0.0F, 0.2244017F, 0.50980765F,
+    0.0F, 0.0F, 0.33333334F, 0.5F,
+    0.0F, 0.105662435F, 0.4553418F, 0.39433756F,
+    0.07044162F, 0.0F, 0.2628917F, 0.6830127F,
+    0.4F, 0.1F, 0.6F, 0.4F,
+    0.32679492F, 0.16339745F, 0.6732051F, 0.33660257F,
+    0.44226497F, 0.0F, 0.557735F, 0.50980765F,
+    0.33333334F, 0.0F, 0.6666667F, 0.5F,
+    0.21132487F, 0.105662435F, 0.7886751F, 0.39433756F,
+    0.40377495F, 0.0F, 0.596225F, 0.6830127F,
+    0.73333335F, 0.1F, 0.93333334F, 0.4F,
+    0.6601283F, 0.16339745F, 1.0F, 0.33660257F,
+    0.7755983F, 0.0F, 0.89106834F, 0.50980765F,
+    0.6666667F, 0.0F, 1.0F, 0.5F,
+    0.5446582F, 0.105662435F, 1.0F, 0.39433756F,
+    0.7371083F, 0.0F, 0.9295584F, 0.6830127F,
+    0.06666667F, 0.6F, 0.26666668F, 0.9F,
+    0.0F, 0.66339743F, 0.33987176F, 0.83660257F,
+    0.108931646F, 0.49019238F, 0.2244017F, 1.0F,
+    0.0F, 0.5F, 0.33333334F, 1.0F,
+    0.0F, 0.6056624F, 0.4553418F, 0.89433753F,
+    0.07044162F, 0.3169873F, 0.2628917F, 1.0F,
+    0.4F, 0.6F, 0.6F, 0.9F,
+    0.32679492F, 0.66339743F, 0.6732051F, 0.83660257F,
+    0.44226497F, 0.49019238F, 0.557735F, 1.0F,
+    0.33333334F, 0.5F, 0.6666667F, 1.0F,
+    0.21132487F, 0.6056624F, 0.7886751F, 0.89433753F,
+    0.40377495F, 0.3169873F, 0.596225F, 1.0F,
+    0.73333335F, 0.6F, 0.93333334F, 0.9F,
+    0.6601283F, 0.66339743F, 1.0F, 0.83660257F,
+    0.7755983F, 0.49019238F, 0.89106834F, 1.0F,
+    0.6666667F, 0.5F, 1.0F, 1.0F,
+    0.5446582F, 0.6056624F, 1.0F, 0.89433753F,
+    0.7371083F, 0.3169873F, 0.9295584F, 1.0F
+};
+
+std::vector<float> const kSSD_CLIP_MAX_SIZE{
+    0.125F, 0.125F, 0.375F, 0.375F,
+    0.07322331F, 0.07322331F, 0.4267767F, 0.4267767F,
+    0.07322331F, 0.16161165F, 0.4267767F, 0.33838835F,
+    0.0F, 0.0F, 0.55F, 0.55F,
+    0.0F, 0.0F, 0.6830127F, 0.6830127F,
+    0.0F, 0.037867967F, 0.6742641F, 0.46213204F,
+    0.625F, 0.125F, 0.875F, 0.375F,
+    0.5732233F, 0.07322331F, 0.9267767F, 0.4267767F,
+    0.5732233F, 0.16161165F, 0.9267767F, 0.33838835F,
+    0.45F, 0.0F, 1.0F, 0.55F,
+    0.3169873F, 0.0F, 1.0F, 0.6830127F,
+    0.32573593F, 0.037867967F, 1.0F, 0.46213204F
+};
+
+std::vector<float> const kGRID_SQUARE{
+    0.15F, 0.15F, 0.35F, 0.35F,
+    0.10857864F, 0.17928931F, 0.39142138F, 0.3207107F,
+    0.17928931F, 0.10857864F, 0.3207107F, 0.39142138F,
+    0.65F, 0.15F, 0.85F, 0.35F,
+    0.6085786F, 0.17928931F, 0.8914214F, 0.3207107F,
+    0.67928934F, 0.10857864F, 0.82071066F, 0.39142138F,
+    0.15F, 0.65F, 0.35F, 0.85F,
+    0.10857864F, 0.67928934F, 0.39142138F, 0.82071066F,
+    0.17928931F, 0.6085786F, 0.3207107F, 0.8914214F,
+    0.65F, 0.65F, 0.85F, 0.85F,
+    0.6085786F, 0.67928934F, 0.8914214F, 0.82071066F,
+    0.67928934F, 0.6085786F, 0.82071066F, 0.8914214F
+};
+
+std::vector<float> const kGRID_ODD{
+    -0.074999996F, -0.008333325F, 0.275F, 0.34166667F,
+    -0.25F, 0.07916667F, 0.45F, 0.25416666F,
+    0.12500001F, -0.008333325F, 0.47500002F, 0.34166667F,
+    -0.049999982F, 0.07916667F, 0.65F, 0.25416666F,
+    0.325F, -0.008333325F, 0.675F, 0.34166667F,
+    0.15F, 0.07916667F, 0.85F, 0.25416666F,
+    0.525F, -0.008333325F, 0.875F, 0.34166667F,
+    0.35F, 0.07916667F, 1.05F, 0.25416666F,
+    0.725F, -0.008333325F, 1.075F, 0.34166667F,
+    0.5500001F, 0.07916667F, 1.25F, 0.25416666F,
+    -0.074999996F, 0.325F, 0.275F, 0.675F,
+    -0.25F, 0.4125F, 0.45F, 0.5875F,
+    0.12500001F, 0.325F, 0.47500002F, 0.675F,
+    -0.049999982F, 0.4125F, 0.65F, 0.5875F,
+    0.325F, 0.325F, 0.675F, 0.675F,
+    0.15F, 0.4125F, 0.85F, 0.5875F,
+    0.525F, 0.325F, 0.875F, 0.675F,
+    0.35F, 0.4125F, 1.05F, 0.5875F,
+    0.725F, 0.325F, 1.075F, 0.675F,
+    0.5500001F, 0.4125F, 1.25F, 0.5875F,
+    -0.074999996F, 0.65833336F, 0.275F, 1.0083333F,
+    -0.25F, 0.7458334F, 0.45F, 0.92083335F,
+    0.12500001F, 0.65833336F, 0.47500002F, 1.0083333F,
+    -0.049999982F, 0.7458334F, 0.65F, 0.92083335F,
+    0.325F, 0.65833336F, 0.675F, 1.0083333F,
+    0.15F, 0.7458334F, 0.85F, 0.92083335F,
+    0.525F, 0.65833336F, 0.875F, 1.0083333F,
+    0.35F, 0.7458334F, 1.05F, 0.92083335F,
+    0.725F, 0.65833336F, 1.075F, 1.0083333F,
+    0.5500001F, 0.7458334F, 1.25F, 0.92083335F
+};
+struct PriorBoxConfig
+{
+    int32_t H;
+    int32_t W;
+    std::vector<float> minSize;
+    std::vector<float> maxSize;
+    //! Aspect ratios as the PriorBox plugin passes them: 1.0 first, then the others and their flips.
+    std::vector<float> aspectRatios;
+    bool clip;
+    int32_t imgH;
+    int32_t imgW;
+    float stepH;
+    float stepW;
+};
+
+float const kVARIANCE[4]{0.1F, 0.1F, 0.2F, 0.2F};
+
+//! Checks the boxes against the golden values and that the second half of the output repeats the variance.
+void expectAnchors(std::vector<float> const& output, std::vector<float> const& expectedBoxes)
+{
+    ASSERT_EQ(output.size(), expectedBoxes.size() * 2);
+    for (size_t i = 0; i < expectedBoxes.size(); ++i)
+    {
+        EXPECT_EQ(output[i], expectedBoxes[i]) << "box " << i / 4 << ", coordinate " << i % 4;
+    }
+    for (size_t i = expectedBoxes.size(); i < output.size(); ++i)
+    {
+        EXPECT_EQ(output[i], kVARIANCE[i % 4]) << "variance " << (i - expectedBoxes.size()) / 4;
+    }
+}
+
+PriorBoxParameters makePriorBoxParameters(PriorBoxConfig const& config)
+{
+    PriorBoxParameters param{};
+    // The parameters point at mutable arrays, but neither the host nor the device version writes through them.
+    param.minSize = const_cast<float*>(config.minSize.data());
+    param.maxSize = config.maxSize.empty() ? nullptr : const_cast<float*>(config.maxSize.data());
+    param.numMinSize = static_cast<int32_t>(config.minSize.size());
+    param.numMaxSize = static_cast<int32_t>(config.maxSize.size());
+    param.clip = config.clip;
+    std::copy(std::begin(kVARIANCE), std::end(kVARIANCE), param.variance);
+    param.imgH = config.imgH;
+    param.imgW = config.imgW;
+    param.stepH = config.stepH;
+    param.stepW = config.stepW;
+    param.offset = 0.5F;
+    return param;
+}
+
+int32_t getNumPriors(PriorBoxConfig const& config)
+{
+    return static_cast<int32_t>(config.minSize.size())
+        * (static_cast<int32_t>(config.aspectRatios.size()) + (config.maxSize.empty() ? 0 : 1));
+}
+
+std::vector<float> runPriorBoxHost(PriorBoxConfig const& config)
+{
+    PriorBoxParameters const param = makePriorBoxParameters(config);
+    int32_t const numPriors = getNumPriors(config);
+    std::vector<float> output(static_cast<size_t>(config.H) * config.W * numPriors * 4 * 2);
+    priorBoxHost(param, config.H, config.W, numPriors, static_cast<int32_t>(config.aspectRatios.size()),
+        param.minSize, param.maxSize, config.aspectRatios.data(), output.data());
+    return output;
+}
+
+GridAnchorParameters makeGridAnchorParameters(int32_t H, int32_t W)
+{
+    GridAnchorParameters param{};
+    param.H = H;
+    param.W = W;
+    std::copy(std::begin(kVARIANCE), std::end(kVARIANCE), param.variance);
+    return param;
+}
+
+std::vector<float> runAnchorGridHost(int32_t H, int32_t W, std::vector<float> const& widths,
+    std::vector<float> const& heights)
+{
+    auto const numAspectRatios = static_cast<int32_t>(widths.size());
+    std::vector<float> output(static_cast<size_t>(H) * W * numAspectRatios * 4 * 2);
+    anchorGridHost(
+        makeGridAnchorParameters(H, W), numAspectRatios, widths.data(), heights.data(), output.data());
+    return output;
+}
+
+bool hasCudaDevice()
+{
+    int32_t count{0};
+    bool const found = cudaGetDeviceCount(&count) == cudaSuccess && count > 0;
+    static_cast<void>(cudaGetLastError());
+    return found;
+}
+
+//! Copies the inputs to the device, runs launch with their device pointers and returns outputSize floats it wrote.
+std::vector<float> runOnDevice(std::vector<std::vector<float>> const& inputs, size_t outputSize,
+    std::function<pluginStatus_t(std::vector<void const*> const&, void*)> const& launch)
+{
+    std::vector<void*> buffers;
+    auto const deviceCopy = [&buffers](void const* src, size_t bytes) {
+        void* buffer{nullptr};
+        EXPECT_EQ(cudaMalloc(&buffer, std::max<size_t>(bytes, 1)), cudaSuccess);
+        if (bytes > 0)
+        {
+            EXPECT_EQ(cudaMemcpy(buffer, src, bytes, cudaMemcpyHostToDevice), cudaSuccess);
+        }
+        buffers.push_back(buffer);
+        return buffer;
+    };
+    std::vector<void const*> deviceInputs;
+    for (auto const& input : inputs)
+    {
+        deviceInputs.push_back(deviceCopy(input.data(), input.size() * sizeof(float)));
+    }
+    // Not zeroed, so that anything the kernel leaves out also shows up as a mismatch.
+    std::vector<float> output(outputSize, -1.F);
+    void* const deviceOutput = deviceCopy(output.data(), output.size() * sizeof(float));
+    EXPECT_EQ(launch(deviceInputs, deviceOutput), STATUS_SUCCESS);
+    EXPECT_EQ(cudaDeviceSynchronize(), cudaSuccess);
+    EXPECT_EQ(cudaMemcpy(output.data(), deviceOutput, output.size() * sizeof(float), cudaMemcpyDeviceToHost),
+        cudaSuccess);
+    for (void* buffer : buffers)
+    {
+        EXPECT_EQ(cudaFree(buffer), cudaSuccess);
+    }
+    return output;
+}
+
+void expectSameBits(std::vector<float> const& host, std::vector<float> const& device)
+{
+    ASSERT_EQ(host.size(), device.size());
+    for (size_t i = 0; i < host.size(); ++i)
+    {
+        EXPECT_EQ(std::memcmp(&host[i], &device[i], sizeof(float)), 0)
+            << "element " << i << ": host " << host[i] << ", kernel " << device[i];
+    }
+}
+
+std::vector<PriorBoxConfig> const kPRIOR_BOX_CONFIGS{
+    {2, 2, {30.F}, {60.F}, {1.F, 2.F, 0.5F}, false, 300, 300, 150.F, 150.F},
+    {2, 3, {60.F, 100.F}, {}, {1.F, 3.F, 1.F / 3.F}, true, 200, 300, 100.F, 100.F},
+    {1, 2, {50.F, 120.F}, {100.F, 250.F}, {1.F, 2.F}, true, 200, 200, 100.F, 100.F},
+    // Larger than the golden configurations: several thread blocks and SSD's 19x19 layer.
+    {19, 19, {60.F}, {111.F}, {1.F, 2.F, 0.5F, 3.F, 1.F / 3.F}, true, 300, 300, 16.F, 16.F},
+};
+} // namespace
+
+TEST(PriorBoxHost, MaxSize)
+{
+    expectAnchors(runPriorBoxHost(kPRIOR_BOX_CONFIGS[0]), kSSD_MAX_SIZE);
+}
+
+TEST(PriorBoxHost, ClipTwoMinSizesNonSquareImage)
+{
+    expectAnchors(runPriorBoxHost(kPRIOR_BOX_CONFIGS[1]), kSSD_CLIP_TWO_MIN_SIZES);
+}
+
+TEST(PriorBoxHost, ClipMaxSizePerMinSize)
+{
+    expectAnchors(runPriorBoxHost(kPRIOR_BOX_CONFIGS[2]), kSSD_CLIP_MAX_SIZE);
+}
+
+TEST(PriorBoxHost, MatchesKernel)
+{
+    if (!hasCudaDevice())
+    {
+        GTEST_SKIP() << "No CUDA device";
+    }
+    for (auto const& config : kPRIOR_BOX_CONFIGS)
+    {
+        auto const host = runPriorBoxHost(config);
+        auto const device = runOnDevice({config.minSize, config.maxSize, config.aspectRatios}, host.size(),
+            [&config](std::vector<void const*> const& in, void* out) {
+                return priorBoxInference(nullptr, makePriorBoxParameters(config), config.H, config.W,
+                    getNumPriors(config), static_cast<int32_t>(config.aspectRatios.size()), in[0],
+                    config.maxSize.empty() ? nullptr : in[1], in[2], out);
+            });
+        expectSameBits(host, device);
+    }
+}
+
+TEST(AnchorGridHost, Square)
+{
+    expectAnchors(runAnchorGridHost(2, 2, {0.2F, 0.28284273F, 0.14142136F}, {0.2F, 0.14142136F, 0.28284273F}),
+        kGRID_SQUARE);
+}
+
+TEST(AnchorGridHost, NonSquareStridesNotRepresentable)
+{
+    expectAnchors(runAnchorGridHost(3, 5, {0.35F, 0.7F}, {0.35F, 0.175F}), kGRID_ODD);
+}
+
+TEST(AnchorGridHost, MatchesKernel)
+{
+    if (!hasCudaDevice())
+    {
+        GTEST_SKIP() << "No CUDA device";
+    }
+    struct GridConfig
+    {
+        int32_t H;
+        int32_t W;
+        std::vector<float> widths;
+        std::vector<float> heights;
+    };
+    // The last one has more than 5120 priors, which the kernel launches with larger blocks.
+    std::vector<GridConfig> const configs{{2, 2, {0.2F, 0.28284273F, 0.14142136F}, {0.2F, 0.14142136F, 0.28284273F}},
+        {3, 5, {0.35F, 0.7F}, {0.35F, 0.175F}},
+        {38, 38, {0.1F, 0.14142136F, 0.07071068F, 0.17320508F}, {0.1F, 0.07071068F, 0.14142136F, 0.057735026F}}};
+    for (auto const& config : configs)
+    {
+        auto const host = runAnchorGridHost(config.H, config.W, config.widths, config.heights);
+        auto const device = runOnDevice({config.widths, config.heights}, host.size(),
+            [&config](std::vector<void const*> const& in, void* out) {
+                return anchorGridInference(nullptr, makeGridAnchorParameters(config.H, config.W),
+                    static_cast<int32_t>(config.widths.size()), in[0], in[1], out);
+            });
+        expectSameBits(host, device);
+    }
+}
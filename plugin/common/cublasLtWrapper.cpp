@@ -54,6 +54,7 @@ CublasLtWrapper::CublasLtWrapper(bool initHandle)
     };
     *(void**) (&_cublasLtCreate) = load_sym(mLibrary, "cublasLtCreate");
     *(void**) (&_cublasLtDestroy) = load_sym(mLibrary, "cublasLtDestroy");
+    *(void**) (&_cublasLtGetVersion) = load_sym(mLibrary, "cublasLtGetVersion");
     *(void**) (&_cublasLtMatmul) = load_sym(mLibrary, "cublasLtMatmul");
     *(void**) (&_cublasLtMatmulDescCreate) = load_sym(mLibrary, "cublasLtMatmulDescCreate");
     *(void**) (&_cublasLtMatmulDescDestroy) = load_sym(mLibrary, "cublasLtMatmulDescDestroy");
@@ -120,6 +121,11 @@ cublasStatus_t CublasLtWrapper::cublasLtDestroy(cublasLtHandle_t handle)
     return (*_cublasLtDestroy)(handle);
 }
 
+size_t CublasLtWrapper::cublasLtGetVersion()
+{
+    return (*_cublasLtGetVersion)();
+}
+
 cublasStatus_t CublasLtWrapper::cublasLtMatmul(cublasLtHandle_t lightHandle, cublasLtMatmulDesc_t computeDesc,
     void const* alpha, void const* A, cublasLtMatrixLayout_t Adesc, void const* B, cublasLtMatrixLayout_t Bdesc,
     void const* beta, void const* C, cublasLtMatrixLayout_t Cdesc, void* D, cublasLtMatrixLayout_t Ddesc,
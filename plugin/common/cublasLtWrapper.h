@@ -243,6 +243,7 @@ public:
 
     cublasStatus_t cublasLtCreate(cublasLtHandle_t* handle);
     cublasStatus_t cublasLtDestroy(cublasLtHandle_t handle);
+    size_t cublasLtGetVersion();
     cublasStatus_t cublasLtMatmul(cublasLtHandle_t lightHandle, cublasLtMatmulDesc_t computeDesc, void const* alpha,
         void const* A, cublasLtMatrixLayout_t Adesc, void const* B, cublasLtMatrixLayout_t Bdesc, void const* beta,
         void const* C, cublasLtMatrixLayout_t Cdesc, void* D, cublasLtMatrixLayout_t Ddesc,
@@ -284,6 +285,7 @@ private:
 
     cublasStatus_t (*_cublasLtCreate)(cublasLtHandle_t*);
     cublasStatus_t (*_cublasLtDestroy)(cublasLtHandle_t);
+    size_t (*_cublasLtGetVersion)();
     cublasStatus_t (*_cublasLtMatmul)(cublasLtHandle_t lightHandle, cublasLtMatmulDesc_t computeDesc, void const* alpha,
         void const* A, cublasLtMatrixLayout_t Adesc, void const* B, cublasLtMatrixLayout_t Bdesc, void const* beta,
         void const* C, cublasLtMatrixLayout_t Cdesc, void* D, cublasLtMatrixLayout_t Ddesc,
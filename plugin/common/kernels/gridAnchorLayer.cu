@@ -51,9 +51,9 @@ __launch_bounds__(nthdsPerCTA) __global__ void gridAnchorKernel(const GridAnchor
     const int w = currIndex % param.W;
     const int h = currIndex / param.W;
 
-    // Center coordinates
-    float yC = h * anchorStrideH + anchorOffsetH;
-    float xC = w * anchorStrideW + anchorOffsetW;
+    // Center coordinates. The fused multiply-add is spelled out so that anchorGridHost can reproduce it exactly.
+    float yC = fmaf(h, anchorStrideH, anchorOffsetH);
+    float xC = fmaf(w, anchorStrideW, anchorOffsetW);
 
     // x_min, y_min
     float xMin = xC - 0.5 * widths[arId];
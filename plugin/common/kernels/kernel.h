@@ -92,18 +92,30 @@ pluginStatus_t scatterNDInference(cudaStream_t stream, int32_t* outputDims, int3
     int32_t nRows, int32_t rowSize, int32_t CopySize, int32_t sizeOfElementInBytes, void const* index,
     void const* updates, void const* data, void* output, void* workspace);
 
+//! The PriorBox plugin generates its output with priorBoxHost. The kernel is kept as the reference that
+//! anchorHelper.test.cpp checks priorBoxHost against.
 pluginStatus_t priorBoxInference(cudaStream_t stream, nvinfer1::plugin::PriorBoxParameters param, int32_t H, int32_t W,
     int32_t numPriors, int32_t numAspectRatios, void const* minSize, void const* maxSize, void const* aspectRatios,
     void* outputData);
 
+//! Host version of priorBoxInference, producing the same bits. minSize, maxSize and aspectRatios are host arrays.
+void priorBoxHost(nvinfer1::plugin::PriorBoxParameters const& param, int32_t H, int32_t W, int32_t numPriors,
+    int32_t numAspectRatios, float const* minSize, float const* maxSize, float const* aspectRatios, float* outputData);
+
 pluginStatus_t lReLUInference(cudaStream_t stream, int32_t n, float negativeSlope, void const* input, void* output);
 
 pluginStatus_t reorgInference(cudaStream_t stream, int32_t batch, int32_t C, int32_t H, int32_t W, int32_t stride,
     void const* input, void* output);
 
+//! The GridAnchor plugins generate their output with anchorGridHost. The kernel is kept as the reference that
+//! anchorHelper.test.cpp checks anchorGridHost against.
 pluginStatus_t anchorGridInference(cudaStream_t stream, nvinfer1::plugin::GridAnchorParameters param,
     int32_t numAspectRatios, void const* aspectRatios, void const* scales, void* outputData);
 
+//! Host version of anchorGridInference, producing the same bits. widths and heights are host arrays.
+void anchorGridHost(nvinfer1::plugin::GridAnchorParameters const& param, int32_t numAspectRatios, float const* widths,
+    float const* heights, float* outputData);
+
 pluginStatus_t regionInference(cudaStream_t stream, int32_t batch, int32_t C, int32_t H, int32_t W, int32_t num,
     int32_t coords, int32_t classes, bool hasSoftmaxTree, nvinfer1::plugin::softmaxTree const* smTree,
     void const* input, void* output);
@@ -24,6 +24,7 @@
 #include "NvInfer.h"
 #include "common/serialize.hpp"
 #include "fcPlugin.h"
+#include "gemmAlgoCache.h"
 
 #include <algorithm>
 #include <cstdio>
@@ -45,6 +46,25 @@ using namespace std::string_view_literals;
 char const* const kFC_VERSION{"1"};
 char const* const kFC_NAME{"CustomFCPluginDynamic"};
 constexpr size_t kMAX_WORKSPACE_BYTES = 4 * 1024 * 1024; // 4MiB
+
+GemmAlgoKey makeGemmAlgoKey(int32_t m, int32_t n, int32_t k, DataType type)
+{
+    int32_t device{-1};
+    PLUGIN_CUASSERT(cudaGetDevice(&device));
+    cudaDeviceProp props{};
+    PLUGIN_CUASSERT(cudaGetDeviceProperties(&props, device));
+
+    GemmAlgoKey key;
+    key.m = m;
+    key.n = n;
+    key.k = k;
+    key.dataType = static_cast<int32_t>(type);
+    key.smVersion = props.major * 10 + props.minor;
+    key.deviceName = props.name;
+    key.cublasLtVersion = getCublasLtWrapper().cublasLtGetVersion();
+    key.workspaceLimit = kMAX_WORKSPACE_BYTES;
+    return key;
+}
 } // namespace
 
 REGISTER_TENSORRT_PLUGIN(FCPluginDynamicCreator);
@@ -500,22 +520,33 @@ void FCPluginDynamic::configurePlugin(DynamicPluginTensorDesc const* inputs, int
         size_t actualWorkspace = 0;
         if (std::all_of(std::begin(mAlgo.data), std::end(mAlgo.data), [](auto v) { return v == 0; }))
         {
-            gLogVerbose << "FCPluginDynamic gemmSearch\n";
-            if (mSharedStream == nullptr)
-            {
-                SharedStream ss{};
-                mSharedStream = static_cast<SharedStream*>(
-                    getPluginRegistry()->acquirePluginResource(kFCPLUGIN_SHARED_STREAM_KEY, &ss))
-                                    ->mStream;
-            }
-            if (mType == DataType::kFLOAT)
-            {
-                mAlgo = gemmSearch<float>(mOutDim, mNmax, mK, kMAX_WORKSPACE_BYTES, actualWorkspace, mSharedStream);
-            }
-            else if (mType == DataType::kHALF)
-            {
-                mAlgo = gemmSearch<half>(mOutDim, mNmax, mK, kMAX_WORKSPACE_BYTES, actualWorkspace, mSharedStream);
-            }
+            GemmAlgoResult const found = GemmAlgoCache::getInstance().getOrSearch(
+                makeGemmAlgoKey(mOutDim, mNmax, mK, mType), [this](GemmAlgoKey const&) {
+                    gLogVerbose << "FCPluginDynamic gemmSearch\n";
+                    if (mSharedStream == nullptr)
+                    {
+                        SharedStream ss{};
+                        mSharedStream = static_cast<SharedStream*>(
+                            getPluginRegistry()->acquirePluginResource(kFCPLUGIN_SHARED_STREAM_KEY, &ss))
+                                            ->mStream;
+                    }
+                    GemmAlgoResult result;
+                    size_t workspace = 0;
+                    if (mType == DataType::kFLOAT)
+                    {
+                        result.algo = gemmSearch<float>(
+                            mOutDim, mNmax, mK, kMAX_WORKSPACE_BYTES, workspace, mSharedStream);
+                    }
+                    else if (mType == DataType::kHALF)
+                    {
+                        result.algo
+                            = gemmSearch<half>(mOutDim, mNmax, mK, kMAX_WORKSPACE_BYTES, workspace, mSharedStream);
+                    }
+                    result.workspaceSize = workspace;
+                    return result;
+                });
+            mAlgo = found.algo;
+            actualWorkspace = found.workspaceSize;
         }
 
         AlgoProps p;
@@ -0,0 +1,288 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gemmAlgoCache.h"
+#include "common/checkMacrosPlugin.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif // defined(WIN32_LEAN_AND_MEAN)
+#include <windows.h>
+#else // defined(_WIN32)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif // defined(_WIN32)
+
+namespace nvinfer1::plugin::bert
+{
+namespace
+{
+constexpr char const* kCACHE_FILE_HEADER{"# fcPlugin GEMM algorithm cache v1"};
+
+//! Device names contain spaces, which separate the key fields.
+std::string sanitizeDeviceName(std::string name)
+{
+    std::replace_if(name.begin(), name.end(), [](unsigned char c) { return std::isspace(c) != 0; }, '_');
+    return name.empty() ? std::string{"unknown"} : name;
+}
+
+//! An all-zero algorithm is what a failed search leaves behind, and what FCPluginDynamic takes for "not searched yet".
+//! It is never cached, so that the next configuration searches again.
+bool isSearchedAlgo(GemmAlgoResult const& result)
+{
+    return std::any_of(std::begin(result.algo.data), std::end(result.algo.data), [](auto v) { return v != 0; });
+}
+
+//! Exclusive advisory lock on a file, held for the lifetime of the object. Serializes the read-merge-write of the
+//! cache file across processes so that no process drops the entries another one has just added. If the lock cannot
+//! be taken, writers still never corrupt the file, they may only lose entries.
+class ScopedFileLock
+{
+public:
+    explicit ScopedFileLock(std::string const& path)
+    {
+#if defined(_WIN32)
+        mHandle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        OVERLAPPED overlapped{};
+        if (mHandle != INVALID_HANDLE_VALUE && !LockFileEx(mHandle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped))
+        {
+            CloseHandle(mHandle);
+            mHandle = INVALID_HANDLE_VALUE;
+        }
+#else  // defined(_WIN32)
+        mFd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (mFd >= 0 && flock(mFd, LOCK_EX) != 0)
+        {
+            close(mFd);
+            mFd = -1;
+        }
+#endif // defined(_WIN32)
+    }
+
+    ~ScopedFileLock()
+    {
+#if defined(_WIN32)
+        if (mHandle != INVALID_HANDLE_VALUE)
+        {
+            OVERLAPPED overlapped{};
+            UnlockFileEx(mHandle, 0, 1, 0, &overlapped);
+            CloseHandle(mHandle);
+        }
+#else  // defined(_WIN32)
+        if (mFd >= 0)
+        {
+            flock(mFd, LOCK_UN);
+            close(mFd);
+        }
+#endif // defined(_WIN32)
+    }
+
+    ScopedFileLock(ScopedFileLock const&) = delete;
+    ScopedFileLock& operator=(ScopedFileLock const&) = delete;
+
+private:
+#if defined(_WIN32)
+    HANDLE mHandle{INVALID_HANDLE_VALUE};
+#else  // defined(_WIN32)
+    int32_t mFd{-1};
+#endif // defined(_WIN32)
+};
+} // namespace
+
+std::string serializeGemmAlgoKey(GemmAlgoKey const& key)
+{
+    std::ostringstream os;
+    os << key.m << ' ' << key.n << ' ' << key.k << ' ' << key.dataType << ' ' << key.smVersion << ' '
+       << sanitizeDeviceName(key.deviceName) << ' ' << key.cublasLtVersion << ' ' << key.workspaceLimit;
+    return os.str();
+}
+
+std::string serializeGemmAlgoResult(GemmAlgoResult const& result)
+{
+    std::ostringstream os;
+    os << std::hex << result.workspaceSize;
+    for (auto const word : result.algo.data)
+    {
+        os << ' ' << word;
+    }
+    return os.str();
+}
+
+std::optional<GemmAlgoResult> deserializeGemmAlgoResult(std::string const& text)
+{
+    std::istringstream is(text);
+    GemmAlgoResult result;
+    is >> std::hex >> result.workspaceSize;
+    for (auto& word : result.algo.data)
+    {
+        is >> word;
+    }
+    if (is.fail() || !(is >> std::ws).eof())
+    {
+        return std::nullopt;
+    }
+    return result;
+}
+
+GemmAlgoCache::GemmAlgoCache(std::string path)
+    : mPath(std::move(path))
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    loadLocked();
+}
+
+GemmAlgoResult GemmAlgoCache::getOrSearch(GemmAlgoKey const& key, SearchFunction const& search)
+{
+    std::string const text = serializeGemmAlgoKey(key);
+    // Holding the lock during the search keeps threads configuring the same problem from searching twice.
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (auto const cached = findLocked(text))
+    {
+        return *cached;
+    }
+    // Another process may have searched for this problem since the file was read.
+    loadLocked();
+    if (auto const cached = findLocked(text))
+    {
+        return *cached;
+    }
+
+    GemmAlgoResult const result = search(key);
+    if (isSearchedAlgo(result))
+    {
+        mEntries[text] = result;
+        saveLocked();
+    }
+    return result;
+}
+
+std::optional<GemmAlgoResult> GemmAlgoCache::find(GemmAlgoKey const& key)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return findLocked(serializeGemmAlgoKey(key));
+}
+
+void GemmAlgoCache::insert(GemmAlgoKey const& key, GemmAlgoResult const& result)
+{
+    if (!isSearchedAlgo(result))
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries[serializeGemmAlgoKey(key)] = result;
+    saveLocked();
+}
+
+size_t GemmAlgoCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mEntries.size();
+}
+
+GemmAlgoCache& GemmAlgoCache::getInstance()
+{
+    static GemmAlgoCache instance([] {
+        char const* path = std::getenv("TRT_FC_PLUGIN_ALGO_CACHE");
+        return path != nullptr ? std::string{path} : std::string{};
+    }());
+    return instance;
+}
+
+std::optional<GemmAlgoResult> GemmAlgoCache::findLocked(std::string const& key) const
+{
+    auto const it = mEntries.find(key);
+    if (it == mEntries.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void GemmAlgoCache::loadLocked()
+{
+    if (mPath.empty())
+    {
+        return;
+    }
+    std::ifstream file(mPath);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        auto const tab = line.find('\t');
+        if (line.empty() || line[0] == '#' || tab == std::string::npos)
+        {
+            continue;
+        }
+        auto const result = deserializeGemmAlgoResult(line.substr(tab + 1));
+        if (result && isSearchedAlgo(*result))
+        {
+            mEntries.emplace(line.substr(0, tab), *result);
+        }
+    }
+}
+
+void GemmAlgoCache::saveLocked()
+{
+    if (mPath.empty())
+    {
+        return;
+    }
+    ScopedFileLock const fileLock(mPath + ".lock");
+    // Pick up what other processes wrote since we last read the file.
+    loadLocked();
+
+    // A name no other writer uses, so that the rename below is the only step that touches the shared file.
+    std::filesystem::path const tmpPath = mPath + ".tmp" + std::to_string(std::random_device{}());
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        file << kCACHE_FILE_HEADER << '\n';
+        // Sorted so that the file does not depend on hashing order.
+        for (auto const& [key, result] : std::map<std::string, GemmAlgoResult>(mEntries.begin(), mEntries.end()))
+        {
+            file << key << '\t' << serializeGemmAlgoResult(result) << '\n';
+        }
+        file.close();
+        if (!file)
+        {
+            gLogWarning << "Could not write the fcPlugin algorithm cache " << tmpPath.string() << std::endl;
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, mPath, ec);
+    if (ec)
+    {
+        gLogWarning << "Could not update the fcPlugin algorithm cache " << mPath << ": " << ec.message() << std::endl;
+        std::filesystem::remove(tmpPath, ec);
+    }
+}
+
+} // namespace nvinfer1::plugin::bert
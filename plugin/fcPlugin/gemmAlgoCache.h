@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_FC_PLUGIN_GEMM_ALGO_CACHE_H
+#define TRT_FC_PLUGIN_GEMM_ALGO_CACHE_H
+
+#include "common/cublasLtWrapper.h"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace nvinfer1
+{
+namespace plugin
+{
+namespace bert
+{
+
+//! Everything the outcome of LtGemmSearch depends on.
+struct GemmAlgoKey
+{
+    int32_t m{0};
+    int32_t n{0};
+    int32_t k{0};
+    int32_t dataType{0};
+    int32_t smVersion{0};
+    std::string deviceName;
+    uint64_t cublasLtVersion{0};
+    uint64_t workspaceLimit{0};
+};
+
+struct GemmAlgoResult
+{
+    nvinfer1::pluginInternal::cublasLtMatmulAlgo_t algo{};
+    uint64_t workspaceSize{0};
+};
+
+//! Remembers the fastest algorithm found for each GEMM problem so that LtGemmSearch runs once per problem.
+//!
+//! When constructed with a file path, entries are also read from and written to that file so that they survive the
+//! process. The file is only ever replaced by renaming a completely written temporary file over it, so concurrent
+//! processes always read a whole file, and writers merge the current file under a lock on "<path>.lock" so that they
+//! keep each other's entries. Unreadable lines and I/O errors are ignored: the cache can make a search unnecessary but
+//! never makes configuration fail.
+//!
+//! The search itself is passed in by the caller, so the cache can be exercised without a GPU.
+class GemmAlgoCache
+{
+public:
+    using SearchFunction = std::function<GemmAlgoResult(GemmAlgoKey const&)>;
+
+    //! An empty path keeps the cache in memory.
+    explicit GemmAlgoCache(std::string path = {});
+
+    //! Returns the cached result for the key, or runs search and records its result. Results whose algorithm is all
+    //! zeros, i.e. failed searches, are returned but not recorded.
+    GemmAlgoResult getOrSearch(GemmAlgoKey const& key, SearchFunction const& search);
+
+    std::optional<GemmAlgoResult> find(GemmAlgoKey const& key);
+
+    //! Ignores results whose algorithm is all zeros.
+    void insert(GemmAlgoKey const& key, GemmAlgoResult const& result);
+
+    size_t size() const;
+
+    //! The process-wide cache used by FCPluginDynamic, persisted to the file named by TRT_FC_PLUGIN_ALGO_CACHE.
+    static GemmAlgoCache& getInstance();
+
+private:
+    std::optional<GemmAlgoResult> findLocked(std::string const& key) const;
+    void loadLocked();
+    void saveLocked();
+
+    std::string mPath;
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, GemmAlgoResult> mEntries;
+};
+
+//! Serialized forms used in the cache file, one entry per line as "<key>\t<result>". Exposed for testing.
+std::string serializeGemmAlgoKey(GemmAlgoKey const& key);
+std::string serializeGemmAlgoResult(GemmAlgoResult const& result);
+std::optional<GemmAlgoResult> deserializeGemmAlgoResult(std::string const& text);
+
+} // namespace bert
+} // namespace plugin
+} // namespace nvinfer1
+
+#endif // TRT_FC_PLUGIN_GEMM_ALGO_CACHE_H
@@ -0,0 +1,260 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fcPlugin/gemmAlgoCache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace nvinfer1::plugin::bert;
+
+namespace
+{
+//! Stands in for LtGemmSearch: returns a result derived from the key and counts how often it is called.
+class CountingSearch
+{
+public:
+    GemmAlgoResult operator()(GemmAlgoKey const& key)
+    {
+        ++mCalls;
+        return makeResult(key);
+    }
+
+    static GemmAlgoResult makeResult(GemmAlgoKey const& key)
+    {
+        GemmAlgoResult result;
+        for (size_t i = 0; i < std::size(result.algo.data); ++i)
+        {
+            result.algo.data[i] = (static_cast<uint64_t>(key.m) << 40) ^ (static_cast<uint64_t>(key.n) << 20)
+                ^ static_cast<uint64_t>(key.k) ^ (i * 0x9E3779B97F4A7C15ULL);
+        }
+        result.workspaceSize = static_cast<uint64_t>(key.m) * key.n;
+        return result;
+    }
+
+    int32_t calls() const
+    {
+        return mCalls;
+    }
+
+private:
+    int32_t mCalls{0};
+};
+
+GemmAlgoKey makeKey(int32_t m = 1024, int32_t n = 384, int32_t k = 768)
+{
+    return GemmAlgoKey{m, n, k, 1, 86, "NVIDIA A10", 120800, 1ULL << 25};
+}
+
+bool sameResult(GemmAlgoResult const& a, GemmAlgoResult const& b)
+{
+    return a.workspaceSize == b.workspaceSize && std::memcmp(a.algo.data, b.algo.data, sizeof(a.algo.data)) == 0;
+}
+
+//! A cache file path that does not exist yet, removed with its lock file at the end of the test.
+class TempCachePath
+{
+public:
+    explicit TempCachePath(char const* name)
+        : mPath((std::filesystem::temp_directory_path() / name).string())
+    {
+        remove();
+    }
+
+    ~TempCachePath()
+    {
+        remove();
+    }
+
+    std::string const& str() const
+    {
+        return mPath;
+    }
+
+private:
+    void remove() const
+    {
+        std::error_code ec;
+        std::filesystem::remove(mPath, ec);
+        std::filesystem::remove(mPath + ".lock", ec);
+    }
+
+    std::string mPath;
+};
+} // namespace
+
+TEST(GemmAlgoCache, SearchesOnMissOnly)
+{
+    GemmAlgoCache cache;
+    CountingSearch search;
+    auto const key = makeKey();
+    auto const searchRef = [&search](GemmAlgoKey const& k) { return search(k); };
+
+    EXPECT_FALSE(cache.find(key).has_value());
+    auto const first = cache.getOrSearch(key, searchRef);
+    EXPECT_EQ(search.calls(), 1);
+    EXPECT_TRUE(sameResult(first, CountingSearch::makeResult(key)));
+
+    auto const second = cache.getOrSearch(key, searchRef);
+    EXPECT_EQ(search.calls(), 1);
+    EXPECT_TRUE(sameResult(second, first));
+    ASSERT_TRUE(cache.find(key).has_value());
+    EXPECT_TRUE(sameResult(*cache.find(key), first));
+    EXPECT_EQ(cache.size(), 1U);
+}
+
+TEST(GemmAlgoCache, EveryKeyFieldMatters)
+{
+    GemmAlgoCache cache;
+    CountingSearch search;
+    auto const searchRef = [&search](GemmAlgoKey const& k) { return search(k); };
+    cache.getOrSearch(makeKey(), searchRef);
+
+    std::vector<GemmAlgoKey> variants(8, makeKey());
+    variants[0].m += 1;
+    variants[1].n += 1;
+    variants[2].k += 1;
+    variants[3].dataType = 0;
+    variants[4].smVersion = 89;
+    variants[5].deviceName = "NVIDIA L4";
+    variants[6].cublasLtVersion += 1;
+    variants[7].workspaceLimit /= 2;
+    for (size_t i = 0; i < variants.size(); ++i)
+    {
+        EXPECT_FALSE(cache.find(variants[i]).has_value()) << "key field " << i;
+        cache.getOrSearch(variants[i], searchRef);
+        EXPECT_EQ(search.calls(), static_cast<int32_t>(i) + 2) << "key field " << i;
+    }
+    EXPECT_EQ(cache.size(), variants.size() + 1);
+}
+
+TEST(GemmAlgoCache, FailedSearchIsNotCached)
+{
+    TempCachePath const path("trt_gemm_algo_cache_failed.txt");
+    GemmAlgoCache cache(path.str());
+    int32_t calls = 0;
+    auto const failingSearch = [&calls](GemmAlgoKey const&) {
+        ++calls;
+        return GemmAlgoResult{};
+    };
+
+    cache.getOrSearch(makeKey(), failingSearch);
+    cache.getOrSearch(makeKey(), failingSearch);
+    EXPECT_EQ(calls, 2);
+    cache.insert(makeKey(), GemmAlgoResult{});
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_EQ(GemmAlgoCache(path.str()).size(), 0U);
+}
+
+TEST(GemmAlgoCache, ResultSerializationRoundTrip)
+{
+    auto const result = CountingSearch::makeResult(makeKey());
+    auto const parsed = deserializeGemmAlgoResult(serializeGemmAlgoResult(result));
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_TRUE(sameResult(*parsed, result));
+}
+
+TEST(GemmAlgoCache, FileRoundTrip)
+{
+    TempCachePath const path("trt_gemm_algo_cache_roundtrip.txt");
+    std::vector<GemmAlgoKey> const keys{makeKey(), makeKey(4096, 128, 1024), makeKey(768, 512, 3072)};
+    {
+        GemmAlgoCache cache(path.str());
+        CountingSearch search;
+        for (auto const& key : keys)
+        {
+            cache.getOrSearch(key, [&search](GemmAlgoKey const& k) { return search(k); });
+        }
+        EXPECT_EQ(search.calls(), 3);
+    }
+
+    GemmAlgoCache reloaded(path.str());
+    EXPECT_EQ(reloaded.size(), keys.size());
+    CountingSearch search;
+    for (auto const& key : keys)
+    {
+        auto const result = reloaded.getOrSearch(key, [&search](GemmAlgoKey const& k) { return search(k); });
+        EXPECT_TRUE(sameResult(result, CountingSearch::makeResult(key)));
+    }
+    EXPECT_EQ(search.calls(), 0);
+}
+
+TEST(GemmAlgoCache, CorruptLinesAreSkipped)
+{
+    TempCachePath const path("trt_gemm_algo_cache_corrupt.txt");
+    auto const good = makeKey();
+    auto const result = CountingSearch::makeResult(good);
+    {
+        std::ofstream file(path.str());
+        file << "# fcPlugin GEMM algorithm cache v1\n"
+             << "\n"
+             << "not a cache line\n"
+             << serializeGemmAlgoKey(makeKey(1, 2, 3)) << "\tzz 1 2\n"
+             << serializeGemmAlgoKey(makeKey(4, 5, 6)) << "\t100 1 2 3\n"
+             << serializeGemmAlgoKey(makeKey(7, 8, 9)) << '\t' << serializeGemmAlgoResult(result) << " 5\n"
+             << serializeGemmAlgoKey(good) << '\t' << serializeGemmAlgoResult(result) << '\n'
+             << serializeGemmAlgoKey(makeKey(2, 2, 2)) << '\t' << serializeGemmAlgoResult(result).substr(0, 20);
+    }
+
+    GemmAlgoCache cache(path.str());
+    EXPECT_EQ(cache.size(), 1U);
+    ASSERT_TRUE(cache.find(good).has_value());
+    EXPECT_TRUE(sameResult(*cache.find(good), result));
+
+    // The cache keeps working with the file: a new entry is written and both are read back.
+    CountingSearch search;
+    cache.getOrSearch(makeKey(1, 2, 3), [&search](GemmAlgoKey const& k) { return search(k); });
+    EXPECT_EQ(search.calls(), 1);
+    EXPECT_EQ(GemmAlgoCache(path.str()).size(), 2U);
+}
+
+TEST(GemmAlgoCache, InstancesSharingAFileKeepEachOthersEntries)
+{
+    TempCachePath const path("trt_gemm_algo_cache_shared.txt");
+    // Both read the (missing) file before either writes, like two processes started together.
+    GemmAlgoCache first(path.str());
+    GemmAlgoCache second(path.str());
+    CountingSearch firstSearch;
+    CountingSearch secondSearch;
+    auto const firstRef = [&firstSearch](GemmAlgoKey const& k) { return firstSearch(k); };
+    auto const secondRef = [&secondSearch](GemmAlgoKey const& k) { return secondSearch(k); };
+
+    auto const keyA = makeKey(128, 128, 128);
+    auto const keyB = makeKey(256, 256, 256);
+    auto const keyC = makeKey(512, 512, 512);
+    first.getOrSearch(keyA, firstRef);
+    second.getOrSearch(keyB, secondRef);
+    first.getOrSearch(keyC, firstRef);
+
+    // Each instance picks up what the other wrote instead of searching again.
+    second.getOrSearch(keyA, secondRef);
+    first.getOrSearch(keyB, firstRef);
+    EXPECT_EQ(firstSearch.calls(), 2);
+    EXPECT_EQ(secondSearch.calls(), 1);
+
+    GemmAlgoCache reloaded(path.str());
+    EXPECT_EQ(reloaded.size(), 3U);
+    for (auto const& key : {keyA, keyB, keyC})
+    {
+        ASSERT_TRUE(reloaded.find(key).has_value());
+        EXPECT_TRUE(sameResult(*reloaded.find(key), CountingSearch::makeResult(key)));
+    }
+}
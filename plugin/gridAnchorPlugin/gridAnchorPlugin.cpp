@@ -38,10 +38,9 @@ GridAnchorGenerator::GridAnchorGenerator(GridAnchorParameters const* paramIn, in
     : mPluginName(name)
     , mNumLayers(numLayers)
 {
-    PLUGIN_CUASSERT(cudaMallocHost((void**) &mNumPriors, mNumLayers * sizeof(int32_t)));
-    PLUGIN_CUASSERT(cudaMallocHost((void**) &mDeviceWidths, mNumLayers * sizeof(Weights)));
-    PLUGIN_CUASSERT(cudaMallocHost((void**) &mDeviceHeights, mNumLayers * sizeof(Weights)));
-
+    mNumPriors.resize(mNumLayers);
+    mWidths.resize(mNumLayers);
+    mHeights.resize(mNumLayers);
     mParam.resize(mNumLayers);
     for (int32_t id = 0; id < mNumLayers; id++)
     {
@@ -108,18 +107,13 @@ GridAnchorGenerator::GridAnchorGenerator(GridAnchorParameters const* paramIn, in
             mNumPriors[id] = mParam[id].numAspectRatios + 1;
         }
 
-        std::vector<float> tmpWidths;
-        std::vector<float> tmpHeights;
         // Calculate the width and height of the prior boxes
         for (int32_t i = 0; i < mNumPriors[id]; i++)
         {
             float sqrt_AR = std::sqrt(aspect_ratios[i]);
-            tmpWidths.push_back(scales[i] * sqrt_AR);
-            tmpHeights.push_back(scales[i] / sqrt_AR);
+            mWidths[id].push_back(scales[i] * sqrt_AR);
+            mHeights[id].push_back(scales[i] / sqrt_AR);
         }
-
-        mDeviceWidths[id] = copyToDevice(tmpWidths.data(), tmpWidths.size());
-        mDeviceHeights[id] = copyToDevice(tmpHeights.data(), tmpHeights.size());
     }
 }
 
@@ -128,9 +122,9 @@ GridAnchorGenerator::GridAnchorGenerator(void const* data, size_t length, char c
 {
     char const *d = reinterpret_cast<char const*>(data), *a = d;
     mNumLayers = read<int32_t>(d);
-    PLUGIN_CUASSERT(cudaMallocHost((void**) &mNumPriors, mNumLayers * sizeof(int32_t)));
-    PLUGIN_CUASSERT(cudaMallocHost((void**) &mDeviceWidths, mNumLayers * sizeof(Weights)));
-    PLUGIN_CUASSERT(cudaMallocHost((void**) &mDeviceHeights, mNumLayers * sizeof(Weights)));
+    mNumPriors.resize(mNumLayers);
+    mWidths.resize(mNumLayers);
+    mHeights.resize(mNumLayers);
     mParam.resize(mNumLayers);
     for (int32_t id = 0; id < mNumLayers; id++)
     {
@@ -151,8 +145,14 @@ GridAnchorGenerator::GridAnchorGenerator(void const* data, size_t length, char c
         }
 
         mNumPriors[id] = read<int32_t>(d);
-        mDeviceWidths[id] = deserializeToDevice(d, mNumPriors[id]);
-        mDeviceHeights[id] = deserializeToDevice(d, mNumPriors[id]);
+        for (auto* sizes : {&mWidths[id], &mHeights[id]})
+        {
+            sizes->resize(mNumPriors[id]);
+            for (auto& size : *sizes)
+            {
+                size = read<float>(d);
+            }
+        }
     }
 
     PLUGIN_VALIDATE(d == a + length);
@@ -160,15 +160,11 @@ GridAnchorGenerator::GridAnchorGenerator(void const* data, size_t length, char c
 
 GridAnchorGenerator::~GridAnchorGenerator()
 {
+    freeAnchors();
     for (int32_t id = 0; id < mNumLayers; id++)
     {
-        PLUGIN_CUERROR(cudaFree(const_cast<void*>(mDeviceWidths[id].values)));
-        PLUGIN_CUERROR(cudaFree(const_cast<void*>(mDeviceHeights[id].values)));
         free(mParam[id].aspectRatios);
     }
-    PLUGIN_CUERROR(cudaFreeHost(mNumPriors));
-    PLUGIN_CUERROR(cudaFreeHost(mDeviceWidths));
-    PLUGIN_CUERROR(cudaFreeHost(mDeviceHeights));
 }
 
 int32_t GridAnchorGenerator::getNbOutputs() const noexcept
@@ -186,10 +182,52 @@ Dims GridAnchorGenerator::getOutputDimensions(int32_t index, Dims const* inputs,
 
 int32_t GridAnchorGenerator::initialize() noexcept
 {
+    try
+    {
+        generateAnchors();
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+        return STATUS_FAILURE;
+    }
     return STATUS_SUCCESS;
 }
 
-void GridAnchorGenerator::terminate() noexcept {}
+void GridAnchorGenerator::terminate() noexcept
+{
+    freeAnchors();
+}
+
+void GridAnchorGenerator::generateAnchors()
+{
+    freeAnchors();
+    // Per layer, the boxes and then the variance of each box.
+    mAnchorOffsets.assign(1, 0);
+    for (int32_t id = 0; id < mNumLayers; id++)
+    {
+        mAnchorOffsets.push_back(
+            mAnchorOffsets.back() + static_cast<size_t>(mParam[id].H) * mParam[id].W * mNumPriors[id] * 4 * 2);
+    }
+    std::vector<float> anchors(mAnchorOffsets.back());
+    for (int32_t id = 0; id < mNumLayers; id++)
+    {
+        anchorGridHost(mParam[id], mNumPriors[id], mWidths[id].data(), mHeights[id].data(),
+            anchors.data() + mAnchorOffsets[id]);
+    }
+    PLUGIN_CUASSERT(cudaMalloc(reinterpret_cast<void**>(&mAnchorsGPU), anchors.size() * sizeof(float)));
+    PLUGIN_CUASSERT(
+        cudaMemcpy(mAnchorsGPU, anchors.data(), anchors.size() * sizeof(float), cudaMemcpyHostToDevice));
+}
+
+void GridAnchorGenerator::freeAnchors() noexcept
+{
+    if (mAnchorsGPU != nullptr)
+    {
+        PLUGIN_CUERROR(cudaFree(mAnchorsGPU));
+        mAnchorsGPU = nullptr;
+    }
+}
 
 size_t GridAnchorGenerator::getWorkspaceSize(int32_t maxBatchSize) const noexcept
 {
@@ -199,17 +237,24 @@ size_t GridAnchorGenerator::getWorkspaceSize(int32_t maxBatchSize) const noexcep
 int32_t GridAnchorGenerator::enqueue(
     int32_t batchSize, void const* const* inputs, void* const* outputs, void* workspace, cudaStream_t stream) noexcept
 {
-    // Generate prior boxes for each layer
-    for (int32_t id = 0; id < mNumLayers; id++)
+    try
     {
-        void* outputData = outputs[id];
-        pluginStatus_t status = anchorGridInference(
-            stream, mParam[id], mNumPriors[id], mDeviceWidths[id].values, mDeviceHeights[id].values, outputData);
-        if (status != STATUS_SUCCESS)
+        // Generating the anchors allocates and copies synchronously, which must not happen here: it would break
+        // stream capture. They are generated by initialize().
+        PLUGIN_VALIDATE(mAnchorsGPU != nullptr, "GridAnchor anchors were not generated: initialize() was not called");
+        // Copy the prior boxes of each layer
+        for (int32_t id = 0; id < mNumLayers; id++)
         {
-            return status;
+            size_t const bytes = (mAnchorOffsets[id + 1] - mAnchorOffsets[id]) * sizeof(float);
+            PLUGIN_CUASSERT(cudaMemcpyAsync(
+                outputs[id], mAnchorsGPU + mAnchorOffsets[id], bytes, cudaMemcpyDeviceToDevice, stream));
         }
     }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+        return STATUS_FAILURE;
+    }
     return STATUS_SUCCESS;
 }
 
@@ -221,8 +266,8 @@ size_t GridAnchorGenerator::getSerializationSize() const noexcept
         sum += 4 * sizeof(int32_t); // mNumPriors, mParam[i].{numAspectRatios, H, W}
         sum += (6 + mParam[i].numAspectRatios)
             * sizeof(float); // mParam[i].{minSize, maxSize, aspectRatios, variance[4]}
-        sum += mDeviceWidths[i].count * sizeof(float);
-        sum += mDeviceHeights[i].count * sizeof(float);
+        sum += mWidths[i].size() * sizeof(float);
+        sum += mHeights[i].size() * sizeof(float);
     }
     return sum;
 }
@@ -249,33 +294,18 @@ void GridAnchorGenerator::serialize(void* buffer) const noexcept
         }
 
         write(d, mNumPriors[id]);
-        serializeFromDevice(d, mDeviceWidths[id]);
-        serializeFromDevice(d, mDeviceHeights[id]);
+        for (float const width : mWidths[id])
+        {
+            write(d, width);
+        }
+        for (float const height : mHeights[id])
+        {
+            write(d, height);
+        }
     }
     PLUGIN_ASSERT(d == a + getSerializationSize());
 }
 
-Weights GridAnchorGenerator::copyToDevice(void const* hostData, size_t count) noexcept
-{
-    void* deviceData;
-    PLUGIN_CUASSERT(cudaMalloc(&deviceData, count * sizeof(float)));
-    PLUGIN_CUASSERT(cudaMemcpy(deviceData, hostData, count * sizeof(float), cudaMemcpyHostToDevice));
-    return Weights{DataType::kFLOAT, deviceData, int64_t(count)};
-}
-
-void GridAnchorGenerator::serializeFromDevice(char*& hostBuffer, Weights deviceWeights) const noexcept
-{
-    PLUGIN_CUASSERT(
-        cudaMemcpy(hostBuffer, deviceWeights.values, deviceWeights.count * sizeof(float), cudaMemcpyDeviceToHost));
-    hostBuffer += deviceWeights.count * sizeof(float);
-}
-
-Weights GridAnchorGenerator::deserializeToDevice(char const*& hostBuffer, size_t count) noexcept
-{
-    Weights w = copyToDevice(hostBuffer, count);
-    hostBuffer += count * sizeof(float);
-    return w;
-}
 bool GridAnchorGenerator::supportsFormat(DataType type, PluginFormat format) const noexcept
 {
     return (type == DataType::kFLOAT && format == PluginFormat::kLINEAR);
@@ -82,16 +82,20 @@ protected:
     std::string mPluginName;
 
 private:
-    Weights copyToDevice(void const* hostData, size_t count) noexcept;
+    void generateAnchors();
 
-    void serializeFromDevice(char*& hostBuffer, Weights deviceWeights) const noexcept;
-
-    Weights deserializeToDevice(char const*& hostBuffer, size_t count) noexcept;
+    void freeAnchors() noexcept;
 
     int32_t mNumLayers;
     std::vector<GridAnchorParameters> mParam;
-    int32_t* mNumPriors;
-    Weights *mDeviceWidths, *mDeviceHeights;
+    std::vector<int32_t> mNumPriors;
+    // Per layer, the width and height of each prior.
+    std::vector<std::vector<float>> mWidths;
+    std::vector<std::vector<float>> mHeights;
+    // The outputs of all layers, generated on the host once; enqueue copies them. Layer id starts at
+    // mAnchorOffsets[id] floats.
+    float* mAnchorsGPU{nullptr};
+    std::vector<size_t> mAnchorOffsets;
     std::string mPluginNamespace;
 };
 
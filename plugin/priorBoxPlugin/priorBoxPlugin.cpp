@@ -51,19 +51,11 @@ PriorBox::PriorBox(PriorBoxParameters param, int32_t H, int32_t W)
     copyParamData(mParam.maxSize, mMaxSizeCPU, param.maxSize, param.numMaxSize);
     copyParamData(mParam.aspectRatios, mAspectRatiosCPU, param.aspectRatios, param.numAspectRatios);
 
-    setupDeviceMemory();
+    setupPriors();
 }
 
-void PriorBox::setupDeviceMemory() noexcept
+void PriorBox::setupPriors()
 {
-    auto copyToDevice = [](void const* hostData, int32_t count) -> Weights {
-        PLUGIN_VALIDATE(count >= 0);
-        void* deviceData = nullptr;
-        PLUGIN_CUASSERT(cudaMalloc(&deviceData, count * sizeof(float)));
-        PLUGIN_CUASSERT(cudaMemcpy(deviceData, hostData, count * sizeof(float), cudaMemcpyHostToDevice));
-        return Weights{DataType::kFLOAT, deviceData, static_cast<int64_t>(count)};
-    };
-
     // minSize is required and needs to be positive.
     PLUGIN_VALIDATE(mParam.numMinSize > 0);
     PLUGIN_VALIDATE(mParam.minSize != nullptr);
@@ -71,7 +63,6 @@ void PriorBox::setupDeviceMemory() noexcept
     {
         PLUGIN_VALIDATE(mParam.minSize[i] > 0.F, "minSize must be positive");
     }
-    mMinSizeGPU = copyToDevice(mParam.minSize, mParam.numMinSize);
 
     PLUGIN_VALIDATE(mParam.numAspectRatios >= 0);
     PLUGIN_VALIDATE(mParam.aspectRatios != nullptr);
@@ -100,12 +91,8 @@ void PriorBox::setupDeviceMemory() noexcept
             }
         }
     }
-    //
-    // mAspectRatiosGPU is of type nvinfer1::Weights.
-    // https://docs.nvidia.com/deeplearning/sdk/tensorrt-api/c_api/classnvinfer1_1_1_weights.html
-    // mAspectRatiosGPU.count is different to mParam.numAspectRatios.
-    //
-    mAspectRatiosGPU = copyToDevice(tmpAR.data(), tmpAR.size());
+    // mPriorAspectRatios.size() is different to mParam.numAspectRatios.
+    mPriorAspectRatios = tmpAR;
 
     // Number of prior boxes per grid cell on the feature map
     // tmpAR already included an aspect ratio of 1.0
@@ -130,7 +117,29 @@ void PriorBox::setupDeviceMemory() noexcept
             PLUGIN_VALIDATE(mParam.maxSize[i] > mParam.minSize[i], "maxSize must be greater than minSize");
             mNumPriors++;
         }
-        mMaxSizeGPU = copyToDevice(mParam.maxSize, mParam.numMaxSize);
+    }
+}
+
+void PriorBox::generateAnchors()
+{
+    freeAnchors();
+    // Boxes, then the variance of each box.
+    std::vector<float> anchors(static_cast<size_t>(mH) * mW * mNumPriors * 4 * 2);
+    priorBoxHost(mParam, mH, mW, mNumPriors, static_cast<int32_t>(mPriorAspectRatios.size()), mParam.minSize,
+        mParam.maxSize, mPriorAspectRatios.data(), anchors.data());
+    size_t const bytes = anchors.size() * sizeof(float);
+    PLUGIN_CUASSERT(cudaMalloc(&mAnchorsGPU, bytes));
+    PLUGIN_CUASSERT(cudaMemcpy(mAnchorsGPU, anchors.data(), bytes, cudaMemcpyHostToDevice));
+    mAnchorsH = mH;
+    mAnchorsW = mW;
+}
+
+void PriorBox::freeAnchors() noexcept
+{
+    if (mAnchorsGPU != nullptr)
+    {
+        PLUGIN_CUERROR(cudaFree(mAnchorsGPU));
+        mAnchorsGPU = nullptr;
     }
 }
 
@@ -162,7 +171,7 @@ void PriorBox::deserialize(uint8_t const* data, size_t length)
 
     PLUGIN_VALIDATE(d == data + length);
 
-    setupDeviceMemory();
+    setupPriors();
 }
 
 // Returns the number of output from the plugin layer
@@ -189,9 +198,23 @@ Dims PriorBox::getOutputDimensions(int32_t index, Dims const* inputs, int32_t nb
 
 int32_t PriorBox::initialize() noexcept
 {
+    try
+    {
+        generateAnchors();
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+        return STATUS_FAILURE;
+    }
     return STATUS_SUCCESS;
 }
 
+void PriorBox::terminate() noexcept
+{
+    freeAnchors();
+}
+
 size_t PriorBox::getWorkspaceSize(int32_t /*maxBatchSize*/) const noexcept
 {
     return 0;
@@ -200,11 +223,21 @@ size_t PriorBox::getWorkspaceSize(int32_t /*maxBatchSize*/) const noexcept
 int32_t PriorBox::enqueue(int32_t /*batchSize*/, void const* const* /*inputs*/, void* const* outputs,
     void* /*workspace*/, cudaStream_t stream) noexcept
 {
-    void* outputData = outputs[0];
-    pluginStatus_t status = priorBoxInference(stream, mParam, mH, mW, mNumPriors, mAspectRatiosGPU.count,
-        mMinSizeGPU.values, mMaxSizeGPU.values, mAspectRatiosGPU.values, outputData);
-
-    return status;
+    try
+    {
+        // Generating the anchors allocates and copies synchronously, which must not happen here: it would break
+        // stream capture. They are generated by initialize() and configurePlugin().
+        PLUGIN_VALIDATE(mAnchorsGPU != nullptr && mAnchorsH == mH && mAnchorsW == mW,
+            "PriorBox anchors were not generated for the configured shape before enqueue");
+        size_t const bytes = static_cast<size_t>(mH) * mW * mNumPriors * 4 * 2 * sizeof(float);
+        PLUGIN_CUASSERT(cudaMemcpyAsync(outputs[0], mAnchorsGPU, bytes, cudaMemcpyDeviceToDevice, stream));
+    }
+    catch (std::exception const& e)
+    {
+        caughtError(e);
+        return STATUS_FAILURE;
+    }
+    return STATUS_SUCCESS;
 }
 
 // Returns the size of serialized parameters
@@ -257,16 +290,7 @@ char const* PriorBox::getPluginVersion() const noexcept
 
 void PriorBox::destroy() noexcept
 {
-    PLUGIN_CUASSERT(cudaFree(const_cast<void*>(mMinSizeGPU.values)));
-    if (mParam.numMaxSize > 0)
-    {
-        PLUGIN_CUASSERT(cudaFree(const_cast<void*>(mMaxSizeGPU.values)));
-    }
-    if (mParam.numAspectRatios > 0)
-    {
-        PLUGIN_CUASSERT(cudaFree(const_cast<void*>(mAspectRatiosGPU.values)));
-    }
-
+    freeAnchors();
     delete this;
 }
 
@@ -331,6 +355,20 @@ void PriorBox::configurePlugin(Dims const* inputDims, int32_t nbInputs, Dims con
         mParam.stepH = static_cast<float>(mParam.imgH) / mH;
         mParam.stepW = static_cast<float>(mParam.imgW) / mW;
     }
+    // Anchors generated before were for the previous configuration.
+    if (mAnchorsGPU != nullptr)
+    {
+        try
+        {
+            generateAnchors();
+        }
+        catch (std::exception const& e)
+        {
+            // enqueue reports the missing anchors.
+            freeAnchors();
+            caughtError(e);
+        }
+    }
 }
 
 // Attach the plugin object to an execution context and grant the plugin the access to some context resource.
@@ -42,7 +42,7 @@ public:
 
     int32_t initialize() noexcept override;
 
-    void terminate() noexcept override {}
+    void terminate() noexcept override;
 
     size_t getWorkspaceSize(int32_t maxBatchSize) const noexcept override;
 
@@ -81,17 +81,23 @@ public:
 
 private:
     void deserialize(uint8_t const* buffer, size_t length);
-    void setupDeviceMemory() noexcept;
+    void setupPriors();
+    void generateAnchors();
+    void freeAnchors() noexcept;
 
     PriorBoxParameters mParam{};
     int32_t mNumPriors{};
     int32_t mH{};
     int32_t mW{};
 
-    // Arrays stored on the GPU.
-    Weights mMinSizeGPU{};      // not learnable weights
-    Weights mMaxSizeGPU{};      // not learnable weights
-    Weights mAspectRatiosGPU{}; // not learnable weights
+    // Aspect ratios of the priors in each cell: 1.0 first, then the requested ones without duplicates (and flipped).
+    std::vector<float> mPriorAspectRatios;
+
+    // The output only depends on the parameters and on mH, mW. It is generated on the host for the shape it was
+    // generated for (mAnchorsH, mAnchorsW) and enqueue copies it.
+    void* mAnchorsGPU{nullptr};
+    int32_t mAnchorsH{};
+    int32_t mAnchorsW{};
 
     // Arrays stored on the CPU.
     // Data pointers in mParams point to these vectors.
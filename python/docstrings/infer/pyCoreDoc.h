@@ -1059,6 +1059,28 @@ constexpr char const* seek = R"trtdoc(
 )trtdoc";
 } // namespace StreamReaderV2Doc
 
+namespace FileStreamReaderV2Doc
+{
+constexpr char const* descr = R"trtdoc(
+    An :class:`IStreamReaderV2` that reads from a file. It is implemented natively, so TensorRT reads from it without
+    calling back into Python and with the GIL released. Device memory is filled from the file chunk by chunk, without
+    staging the whole engine in host memory.
+
+    Reads into device memory are asynchronous on the stream passed to :func:`read`: the copies are complete once that
+    stream is synchronized. Each chunk is read into a pinned host buffer and copied from there while the next chunk is
+    read. Reads into host memory complete before :func:`read` returns.
+    ::
+        reader = trt.FileStreamReaderV2("model.engine")
+        engine = runtime.deserialize_cuda_engine(reader)
+
+    :arg path: The file to read.
+)trtdoc";
+
+constexpr char const* close = R"trtdoc(
+    Close the file. Called automatically when the reader is destroyed.
+)trtdoc";
+} // namespace FileStreamReaderV2Doc
+
 namespace StreamWriterDoc
 {
 constexpr char const* descr = R"trtdoc(
@@ -1076,15 +1098,41 @@ To implement a custom stream writer, ensure that you explicitly instantiate the
 
 )trtdoc";
 
+constexpr char const* init = R"trtdoc(
+    :arg use_memoryview: Pass :func:`write` a read-only ``memoryview`` of the data instead of a ``bytes`` copy of it.
+        The view is only valid during the call: consume the data, e.g. write it to a file, or copy it before returning.
+)trtdoc";
+
 constexpr char const* write = R"trtdoc(
     A callback implemented by the application to write a particular chunk of memory.
 
-    :arg data: The data to be written out in bytes.
+    :arg data: The data to be written out in bytes, or a ``memoryview`` of it if the writer was created with
+        ``use_memoryview=True``.
 
     :returns: The total bytes actually be written.
 )trtdoc";
 } // namespace StreamWriterDoc
 
+namespace FileStreamWriterDoc
+{
+constexpr char const* descr = R"trtdoc(
+    An :class:`IStreamWriter` that writes to a file. It is implemented natively, so TensorRT writes to it without
+    copying the data into Python objects and with the GIL released.
+    ::
+        writer = trt.FileStreamWriter("model.engine")
+        builder.build_serialized_network_to_stream(network, config, writer)
+        writer.close()
+
+    :arg path: The file to write. It is created, or truncated if it exists.
+)trtdoc";
+
+constexpr char const* close = R"trtdoc(
+    Flush and close the file. Called automatically when the writer is destroyed.
+
+    :returns: False if the data could not be written completely.
+)trtdoc";
+} // namespace FileStreamWriterDoc
+
 namespace SeekPositionDoc
 {
 constexpr char const* descr
@@ -19,8 +19,11 @@
 #include "ForwardDeclarations.h"
 #include "utils.h"
 #include <chrono>
+#include <cstdio>
 #include <iomanip>
+#include <mutex>
 #include <pybind11/stl.h>
+#include <type_traits>
 
 #include "infer/pyCoreDoc.h"
 #include <cuda.h>
@@ -830,6 +833,12 @@ private:
 class PyStreamWriter : public IStreamWriter
 {
 public:
+    //! With useMemoryview, write() is passed a read-only memoryview of the data instead of a bytes copy.
+    explicit PyStreamWriter(bool useMemoryview = false)
+        : mUseMemoryview(useMemoryview)
+    {
+    }
+
     int64_t write(void const* data, int64_t size) noexcept override
     {
         try
@@ -842,8 +851,28 @@ public:
                 return 0;
             }
 
-            auto const pyBytes = py::bytes(static_cast<char const*>(data), size);
-            py::object bytesWritten = pyFunc(pyBytes);
+            py::object bytesWritten;
+            if (mUseMemoryview)
+            {
+                // A view of const memory is read-only.
+                auto view = py::memoryview::from_memory(data, static_cast<py::ssize_t>(size));
+                bytesWritten = pyFunc(view);
+                // The data is only valid during the call; make a view kept by the application fail rather than
+                // read freed memory later. Releasing fails if the application still holds a buffer exported from it.
+                if (PyObject* released = PyObject_CallMethod(view.ptr(), "release", nullptr))
+                {
+                    Py_DECREF(released);
+                }
+                else
+                {
+                    PyErr_Clear();
+                }
+            }
+            else
+            {
+                auto const pyBytes = py::bytes(static_cast<char const*>(data), size);
+                bytesWritten = pyFunc(pyBytes);
+            }
 
             if (!py::isinstance<py::int_>(bytesWritten))
             {
@@ -864,6 +893,327 @@ public:
 
         return 0;
     }
+
+private:
+    bool mUseMemoryview{false};
+};
+
+//! Seek within file to the 64-bit offset, relative to origin (SEEK_SET, SEEK_CUR or SEEK_END).
+bool seekFile(std::FILE* file, int64_t offset, int32_t origin)
+{
+#if defined(_WIN32)
+    return _fseeki64(file, offset, origin) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+}
+
+//! IStreamWriter that writes to a file natively. It never calls into Python, so TensorRT writes to it without the GIL.
+class FileStreamWriter : public IStreamWriter
+{
+public:
+    explicit FileStreamWriter(std::string const& path)
+        : mFile(std::fopen(path.c_str(), "wb"))
+    {
+        if (mFile == nullptr)
+        {
+            utils::throwPyError(PyExc_OSError, "Cannot open file " + path + " for writing.");
+        }
+    }
+
+    ~FileStreamWriter() override
+    {
+        close();
+    }
+
+    int64_t write(void const* data, int64_t size) noexcept override
+    {
+        if (mFile == nullptr || data == nullptr || size < 0)
+        {
+            return 0;
+        }
+        return static_cast<int64_t>(std::fwrite(data, 1, static_cast<size_t>(size), mFile));
+    }
+
+    //! Flush and close the file. Returns false if the data could not be written completely.
+    bool close() noexcept
+    {
+        if (mFile == nullptr)
+        {
+            return true;
+        }
+        bool const ok = std::fclose(mFile) == 0;
+        mFile = nullptr;
+        return ok;
+    }
+
+private:
+    std::FILE* mFile{nullptr};
+};
+
+//! IStreamReaderV2 that reads from a file natively. It never calls into Python, so TensorRT reads from it without the
+//! GIL. Reads into device memory are asynchronous on the given stream: each chunk is read into one of two pinned
+//! staging buffers and copied from there while the next chunk is read into the other one.
+class FileStreamReaderV2 : public IStreamReaderV2
+{
+    using TFnPointerGetAttribute = CUresult (*)(void*, CUpointer_attribute, CUdeviceptr);
+    using TFnMemcpyHtoDAsync = CUresult (*)(CUdeviceptr, void const*, size_t, CUstream);
+    using TFnMemHostAlloc = CUresult (*)(void**, size_t, unsigned int);
+    using TFnMemFreeHost = CUresult (*)(void*);
+    using TFnEventCreate = CUresult (*)(CUevent*, unsigned int);
+    using TFnEventRecord = CUresult (*)(CUevent, CUstream);
+    using TFnEventSynchronize = CUresult (*)(CUevent);
+    using TFnEventDestroy = CUresult (*)(CUevent);
+    using TFnCtxGetCurrent = CUresult (*)(CUcontext*);
+    using TFnCtxPushCurrent = CUresult (*)(CUcontext);
+    using TFnCtxPopCurrent = CUresult (*)(CUcontext*);
+
+public:
+    static constexpr int64_t kSTAGING_SIZE{int64_t{8} << 20};
+    static constexpr int32_t kNB_STAGING_BUFFERS{2};
+
+    explicit FileStreamReaderV2(std::string const& path)
+        : mFile(std::fopen(path.c_str(), "rb"))
+    {
+        if (mFile == nullptr)
+        {
+            utils::throwPyError(PyExc_OSError, "Cannot open file " + path + " for reading.");
+        }
+    }
+
+    ~FileStreamReaderV2() override
+    {
+        close();
+        releaseStaging();
+        if (mCudaHandle != nullptr)
+        {
+            utils::dllClose(mCudaHandle);
+        }
+    }
+
+    int64_t read(void* destination, int64_t nbBytes, cudaStream_t stream) noexcept override
+    {
+        if (mFile == nullptr || destination == nullptr || nbBytes < 0)
+        {
+            return 0;
+        }
+        auto* const out = static_cast<std::byte*>(destination);
+        if (!isDeviceMemory(destination))
+        {
+            return static_cast<int64_t>(std::fread(out, 1, static_cast<size_t>(nbBytes), mFile));
+        }
+        if (!allocateStaging())
+        {
+            return readPageable(out, nbBytes, stream);
+        }
+
+        auto const cuStream = reinterpret_cast<CUstream>(stream);
+        int64_t totalBytesRead{0};
+        while (totalBytesRead < nbBytes)
+        {
+            auto& staging = mStaging[mNextStaging];
+            // The copy issued from this buffer two chunks ago must be done before the buffer is refilled.
+            CUDA_CALL_WITH_RET(mFnEventSynchronize(staging.copied), totalBytesRead);
+            size_t const request = static_cast<size_t>(std::min(nbBytes - totalBytesRead, kSTAGING_SIZE));
+            size_t const bytesRead = std::fread(staging.host, 1, request, mFile);
+            if (bytesRead == 0)
+            {
+                break;
+            }
+            CUDA_CALL_WITH_RET(mFnMemcpyHtoDAsync(reinterpret_cast<CUdeviceptr>(out + totalBytesRead), staging.host,
+                                   bytesRead, cuStream),
+                totalBytesRead);
+            CUDA_CALL_WITH_RET(mFnEventRecord(staging.copied, cuStream), totalBytesRead);
+            mNextStaging = (mNextStaging + 1) % kNB_STAGING_BUFFERS;
+            totalBytesRead += static_cast<int64_t>(bytesRead);
+            if (bytesRead < request)
+            {
+                break; // End of the file.
+            }
+        }
+        return totalBytesRead;
+    }
+
+    bool seek(int64_t offset, SeekPosition where) noexcept override
+    {
+        if (mFile == nullptr)
+        {
+            return false;
+        }
+        int32_t origin{SEEK_SET};
+        switch (where)
+        {
+        case SeekPosition::kSET: origin = SEEK_SET; break;
+        case SeekPosition::kCUR: origin = SEEK_CUR; break;
+        case SeekPosition::kEND: origin = SEEK_END; break;
+        }
+        return seekFile(mFile, offset, origin);
+    }
+
+    void close() noexcept
+    {
+        if (mFile != nullptr)
+        {
+            std::fclose(mFile);
+            mFile = nullptr;
+        }
+    }
+
+private:
+    //! A pinned host buffer and the event recorded after the last copy out of it.
+    struct Staging
+    {
+        void* host{};
+        CUevent copied{};
+    };
+
+    //! Whether destination is device memory. The CUDA driver is only loaded once the first read needs to know.
+    bool isDeviceMemory(void* destination) noexcept
+    {
+        std::call_once(mCudaLoaded, [this]() {
+            mCudaHandle = utils::nvdllOpen(CUDA_LIB_NAME);
+            if (mCudaHandle != nullptr)
+            {
+                auto const getSym = [this](auto& fn, char const* name) {
+                    fn = reinterpret_cast<std::remove_reference_t<decltype(fn)>>(utils::dllGetSym(mCudaHandle, name));
+                };
+                getSym(mFnPointerGetAttribute, "cuPointerGetAttribute");
+                getSym(mFnMemcpyHtoDAsync, "cuMemcpyHtoDAsync_v2");
+                getSym(mFnMemHostAlloc, "cuMemHostAlloc");
+                getSym(mFnMemFreeHost, "cuMemFreeHost");
+                getSym(mFnEventCreate, "cuEventCreate");
+                getSym(mFnEventRecord, "cuEventRecord");
+                getSym(mFnEventSynchronize, "cuEventSynchronize");
+                getSym(mFnEventDestroy, "cuEventDestroy_v2");
+                getSym(mFnCtxGetCurrent, "cuCtxGetCurrent");
+                getSym(mFnCtxPushCurrent, "cuCtxPushCurrent_v2");
+                getSym(mFnCtxPopCurrent, "cuCtxPopCurrent_v2");
+            }
+        });
+        if (mFnPointerGetAttribute == nullptr || mFnMemcpyHtoDAsync == nullptr)
+        {
+            return false;
+        }
+        uint32_t memoryType{};
+        CUresult const ret = mFnPointerGetAttribute(
+            &memoryType, CU_POINTER_ATTRIBUTE_MEMORY_TYPE, reinterpret_cast<CUdeviceptr>(destination));
+        return ret == CUDA_SUCCESS && memoryType == CU_MEMORYTYPE_DEVICE;
+    }
+
+    //! Allocate the pinned staging buffers on first use, in the context current for the read. Returns false if they
+    //! are unavailable, in which case reads fall back to pageable staging.
+    bool allocateStaging() noexcept
+    {
+        if (mStaging[0].host != nullptr)
+        {
+            return true;
+        }
+        if (mPinnedUnavailable || mFnMemHostAlloc == nullptr || mFnMemFreeHost == nullptr
+            || mFnEventCreate == nullptr || mFnEventRecord == nullptr || mFnEventSynchronize == nullptr
+            || mFnEventDestroy == nullptr || mFnCtxGetCurrent == nullptr || mFnCtxPushCurrent == nullptr
+            || mFnCtxPopCurrent == nullptr || mFnCtxGetCurrent(&mContext) != CUDA_SUCCESS || mContext == nullptr)
+        {
+            mPinnedUnavailable = true;
+            return false;
+        }
+        for (auto& staging : mStaging)
+        {
+            if (mFnMemHostAlloc(&staging.host, static_cast<size_t>(kSTAGING_SIZE), CU_MEMHOSTALLOC_PORTABLE)
+                    != CUDA_SUCCESS
+                || mFnEventCreate(&staging.copied, CU_EVENT_DISABLE_TIMING) != CUDA_SUCCESS)
+            {
+                // Do not retry on every read: pinned memory is scarce and failing allocations are slow.
+                releaseStaging();
+                mPinnedUnavailable = true;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Wait for the outstanding copies and free the staging buffers.
+    void releaseStaging() noexcept
+    {
+        if (mContext == nullptr)
+        {
+            return;
+        }
+        // The reader may be destroyed on a thread without the context current.
+        bool const pushed = mFnCtxPushCurrent(mContext) == CUDA_SUCCESS;
+        for (auto& staging : mStaging)
+        {
+            if (staging.copied != nullptr)
+            {
+                mFnEventSynchronize(staging.copied);
+                mFnEventDestroy(staging.copied);
+            }
+            if (staging.host != nullptr)
+            {
+                mFnMemFreeHost(staging.host);
+            }
+            staging = Staging{};
+        }
+        if (pushed)
+        {
+            CUcontext popped{};
+            mFnCtxPopCurrent(&popped);
+        }
+        mContext = nullptr;
+    }
+
+    //! Fallback when pinned memory is unavailable. The copies are still issued on the stream, but the driver stages
+    //! pageable memory before each copy returns, so they do not overlap with reading the file.
+    int64_t readPageable(std::byte* out, int64_t nbBytes, cudaStream_t stream) noexcept
+    {
+        try
+        {
+            mPageable.resize(static_cast<size_t>(std::min(nbBytes, kSTAGING_SIZE)));
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "[ERROR] Exception caught in read(): " << e.what() << std::endl;
+            return 0;
+        }
+        int64_t totalBytesRead{0};
+        while (totalBytesRead < nbBytes)
+        {
+            size_t const request = static_cast<size_t>(std::min(nbBytes - totalBytesRead, kSTAGING_SIZE));
+            size_t const bytesRead = std::fread(mPageable.data(), 1, request, mFile);
+            if (bytesRead == 0)
+            {
+                break;
+            }
+            CUDA_CALL_WITH_RET(mFnMemcpyHtoDAsync(reinterpret_cast<CUdeviceptr>(out + totalBytesRead),
+                                   mPageable.data(), bytesRead, reinterpret_cast<CUstream>(stream)),
+                totalBytesRead);
+            totalBytesRead += static_cast<int64_t>(bytesRead);
+            if (bytesRead < request)
+            {
+                break; // End of the file.
+            }
+        }
+        return totalBytesRead;
+    }
+
+    std::FILE* mFile{nullptr};
+    Staging mStaging[kNB_STAGING_BUFFERS]{};
+    int32_t mNextStaging{0};
+    CUcontext mContext{};
+    bool mPinnedUnavailable{false};
+    std::vector<std::byte> mPageable;
+    std::once_flag mCudaLoaded;
+    void* mCudaHandle{};
+    TFnPointerGetAttribute mFnPointerGetAttribute{};
+    TFnMemcpyHtoDAsync mFnMemcpyHtoDAsync{};
+    TFnMemHostAlloc mFnMemHostAlloc{};
+    TFnMemFreeHost mFnMemFreeHost{};
+    TFnEventCreate mFnEventCreate{};
+    TFnEventRecord mFnEventRecord{};
+    TFnEventSynchronize mFnEventSynchronize{};
+    TFnEventDestroy mFnEventDestroy{};
+    TFnCtxGetCurrent mFnCtxGetCurrent{};
+    TFnCtxPushCurrent mFnCtxPushCurrent{};
+    TFnCtxPopCurrent mFnCtxPopCurrent{};
 };
 
 class PyDebugListener : public IDebugListener
@@ -1589,12 +1939,25 @@ void bindCore(py::module& m)
 
     py::class_<IStreamReaderV2, PyStreamReaderV2>(m, "IStreamReaderV2", StreamReaderV2Doc::descr, py::module_local())
         .def(py::init<>())
-        .def("read", lambdas::reader_v2_read, "destination"_a, "num_bytes"_a, "stream"_a, StreamReaderV2Doc::seek)
-        .def("seek", &IStreamReaderV2::seek, "offset"_a, "where"_a, StreamReaderV2Doc::read);
+        .def("read", lambdas::reader_v2_read, "destination"_a, "num_bytes"_a, "stream"_a, StreamReaderV2Doc::seek,
+            py::call_guard<py::gil_scoped_release>{})
+        .def("seek", &IStreamReaderV2::seek, "offset"_a, "where"_a, StreamReaderV2Doc::read,
+            py::call_guard<py::gil_scoped_release>{});
+
+    py::class_<FileStreamReaderV2, IStreamReaderV2>(
+        m, "FileStreamReaderV2", FileStreamReaderV2Doc::descr, py::module_local())
+        .def(py::init<std::string const&>(), "path"_a)
+        .def("close", &FileStreamReaderV2::close, FileStreamReaderV2Doc::close);
 
     py::class_<IStreamWriter, PyStreamWriter>(m, "IStreamWriter", StreamWriterDoc::descr, py::module_local())
         .def(py::init<>())
-        .def("write", &IStreamWriter::write, "data"_a, "size"_a, StreamWriterDoc::write);
+        .def(py::init<bool>(), "use_memoryview"_a, StreamWriterDoc::init)
+        .def("write", &IStreamWriter::write, "data"_a, "size"_a, StreamWriterDoc::write,
+            py::call_guard<py::gil_scoped_release>{});
+
+    py::class_<FileStreamWriter, IStreamWriter>(m, "FileStreamWriter", FileStreamWriterDoc::descr, py::module_local())
+        .def(py::init<std::string const&>(), "path"_a)
+        .def("close", &FileStreamWriter::close, FileStreamWriterDoc::close, py::call_guard<py::gil_scoped_release>{});
 
     py::enum_<BuilderFlag>(m, "BuilderFlag", py::arithmetic{}, BuilderFlagDoc::descr, py::module_local())
         .value("DEBUG", BuilderFlag::kDEBUG, BuilderFlagDoc::DEBUG)
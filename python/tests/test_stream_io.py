@@ -0,0 +1,254 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""
+Tests of the stream reader and writer bindings: FileStreamWriter, FileStreamReaderV2 and the Python trampolines of
+IStreamWriter and IStreamReaderV2, including use_memoryview.
+
+The bindings release the GIL, so calling the base class methods from Python goes through the C++ trampoline, which has
+to reacquire the GIL before it calls back into Python. Run with ``python3 -m pytest python/tests``.
+"""
+
+import ctypes
+import ctypes.util
+import threading
+
+import pytest
+
+trt = pytest.importorskip("tensorrt")
+
+
+def as_pointer(buffer):
+    """Wrap the address of a ctypes buffer in a capsule, which the bindings accept for ``void*`` arguments."""
+    new_capsule = ctypes.pythonapi.PyCapsule_New
+    new_capsule.restype = ctypes.py_object
+    new_capsule.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_void_p]
+    return new_capsule(ctypes.addressof(buffer), None, None)
+
+
+def make_data(size):
+    return bytes((i * 131 + 7) & 0xFF for i in range(size))
+
+
+def has_cuda_driver():
+    return ctypes.util.find_library("cuda") is not None
+
+
+class CollectingWriter(trt.IStreamWriter):
+    """Records what the trampoline passes to write()."""
+
+    def __init__(self, use_memoryview=False):
+        trt.IStreamWriter.__init__(self, use_memoryview=use_memoryview)
+        self.chunks = []
+        self.types = []
+        self.views = []
+
+    def write(self, data):
+        self.types.append(type(data))
+        self.chunks.append(bytes(data))
+        if isinstance(data, memoryview):
+            self.views.append(data)
+        return len(data)
+
+
+class BytesReader(trt.IStreamReaderV2):
+    """Serves a bytes object, at most max_chunk bytes per call."""
+
+    def __init__(self, data, max_chunk):
+        trt.IStreamReaderV2.__init__(self)
+        self.data = data
+        self.max_chunk = max_chunk
+        self.position = 0
+
+    def read(self, num_bytes, stream):
+        size = min(num_bytes, self.max_chunk, len(self.data) - self.position)
+        chunk = self.data[self.position : self.position + size]
+        self.position += size
+        return chunk
+
+    def seek(self, offset, where):
+        assert where == trt.SeekPosition.SET
+        self.position = offset
+        return True
+
+
+def test_file_stream_writer_writes_every_chunk(tmp_path):
+    path = tmp_path / "model.engine"
+    data = make_data(10000)
+    writer = trt.FileStreamWriter(str(path))
+    for begin, end in ((0, 4000), (4000, 10000)):
+        chunk = ctypes.create_string_buffer(data[begin:end], end - begin)
+        assert writer.write(as_pointer(chunk), end - begin) == end - begin
+    assert writer.close()
+    assert path.read_bytes() == data
+
+    # Writes after close are refused; closing again is harmless.
+    chunk = ctypes.create_string_buffer(data, len(data))
+    assert writer.write(as_pointer(chunk), len(data)) == 0
+    assert writer.close()
+
+
+def test_file_stream_writer_reports_open_failure(tmp_path):
+    with pytest.raises(OSError):
+        trt.FileStreamWriter(str(tmp_path / "missing" / "model.engine"))
+
+
+def test_file_stream_reader_reads_and_seeks_host_memory(tmp_path):
+    path = tmp_path / "model.engine"
+    data = make_data(10000)
+    path.write_bytes(data)
+    reader = trt.FileStreamReaderV2(str(path))
+
+    buffer = ctypes.create_string_buffer(len(data))
+    assert reader.read(as_pointer(buffer), 4000, 0) == 4000
+    assert buffer.raw[:4000] == data[:4000]
+    # A read past the end returns what is left, then nothing.
+    assert reader.read(as_pointer(buffer), len(data), 0) == len(data) - 4000
+    assert buffer.raw[: len(data) - 4000] == data[4000:]
+    assert reader.read(as_pointer(buffer), 1, 0) == 0
+
+    assert reader.seek(123, trt.SeekPosition.SET)
+    assert reader.read(as_pointer(buffer), 10, 0) == 10
+    assert buffer.raw[:10] == data[123:133]
+    assert reader.seek(-10, trt.SeekPosition.END)
+    assert reader.read(as_pointer(buffer), 100, 0) == 10
+    assert buffer.raw[:10] == data[-10:]
+
+    reader.close()
+    assert reader.read(as_pointer(buffer), 10, 0) == 0
+    assert not reader.seek(0, trt.SeekPosition.SET)
+
+
+def test_file_stream_reader_reports_open_failure(tmp_path):
+    with pytest.raises(OSError):
+        trt.FileStreamReaderV2(str(tmp_path / "missing.engine"))
+
+
+@pytest.mark.parametrize("use_memoryview", [False, True])
+def test_python_writer_trampoline(use_memoryview):
+    data = make_data(5000)
+    writer = CollectingWriter(use_memoryview=use_memoryview)
+    chunk = ctypes.create_string_buffer(data, len(data))
+    # Calls the base binding, which releases the GIL and dispatches to the trampoline.
+    assert trt.IStreamWriter.write(writer, as_pointer(chunk), len(data)) == len(data)
+    assert writer.chunks == [data]
+    assert writer.types == [memoryview if use_memoryview else bytes]
+
+
+def test_python_writer_memoryview_is_read_only_and_released():
+    class CheckingWriter(CollectingWriter):
+        def write(self, data):
+            assert data.readonly
+            with pytest.raises(TypeError):
+                data[0] = 0
+            return super().write(data)
+
+    writer = CheckingWriter(use_memoryview=True)
+    chunk = ctypes.create_string_buffer(b"abc", 3)
+    assert trt.IStreamWriter.write(writer, as_pointer(chunk), 3) == 3
+    assert writer.chunks == [b"abc"]
+    # The view is released once the call returns, so a kept view fails instead of reading freed memory.
+    with pytest.raises(ValueError):
+        bytes(writer.views[0])
+
+
+def test_default_writer_constructor_passes_bytes():
+    class Writer(trt.IStreamWriter):
+        def __init__(self):
+            trt.IStreamWriter.__init__(self)
+            self.received = None
+
+        def write(self, data):
+            self.received = data
+            return len(data)
+
+    writer = Writer()
+    chunk = ctypes.create_string_buffer(b"xyz", 3)
+    assert trt.IStreamWriter.write(writer, as_pointer(chunk), 3) == 3
+    assert writer.received == b"xyz"
+
+
+def test_writer_trampoline_reacquires_gil_across_threads():
+    # Each thread releases the GIL in the binding and reacquires it in the trampoline. A trampoline that did not
+    # reacquire it would crash in the callback; one that deadlocked would leave the threads running.
+    writers = [CollectingWriter(use_memoryview=index % 2 == 1) for index in range(4)]
+    data = make_data(1000)
+    errors = []
+
+    def run(writer):
+        try:
+            for _ in range(50):
+                chunk = ctypes.create_string_buffer(data, len(data))
+                assert trt.IStreamWriter.write(writer, as_pointer(chunk), len(data)) == len(data)
+        except Exception as e:  # Reported from the main thread below.
+            errors.append(e)
+
+    threads = [threading.Thread(target=run, args=(writer,)) for writer in writers]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join(timeout=60)
+        assert not thread.is_alive()
+    assert not errors
+    for writer in writers:
+        assert writer.chunks == [data] * 50
+
+
+@pytest.mark.skipif(not has_cuda_driver(), reason="The IStreamReaderV2 trampoline needs the CUDA driver.")
+def test_python_reader_trampoline_reads_host_memory():
+    data = make_data(10000)
+    reader = BytesReader(data, max_chunk=3000)
+    buffer = ctypes.create_string_buffer(len(data))
+    # The trampoline keeps calling read() until the request is filled.
+    assert trt.IStreamReaderV2.read(reader, as_pointer(buffer), len(data), 0) == len(data)
+    assert buffer.raw == data
+    assert trt.IStreamReaderV2.seek(reader, 5, trt.SeekPosition.SET)
+    assert reader.position == 5
+
+
+@pytest.fixture(scope="module")
+def identity_network():
+    logger = trt.Logger(trt.Logger.ERROR)
+    try:
+        builder = trt.Builder(logger)
+    except Exception:
+        builder = None
+    if builder is None:
+        pytest.skip("Building engines needs a GPU.")
+    network = builder.create_network(0)
+    inp = network.add_input("input", trt.float32, (1, 3, 8, 8))
+    network.mark_output(network.add_identity(inp).get_output(0))
+    config = builder.create_builder_config()
+    return logger, builder, network, config
+
+
+@pytest.mark.parametrize("use_memoryview", [False, True])
+def test_engine_round_trip_through_files(tmp_path, identity_network, use_memoryview):
+    logger, builder, network, config = identity_network
+    native_path = tmp_path / "native.engine"
+    writer = trt.FileStreamWriter(str(native_path))
+    assert builder.build_serialized_network_to_stream(network, config, writer)
+    assert writer.close()
+
+    python_writer = CollectingWriter(use_memoryview=use_memoryview)
+    assert builder.build_serialized_network_to_stream(network, config, python_writer)
+    assert len(b"".join(python_writer.chunks)) > 0
+
+    runtime = trt.Runtime(logger)
+    engine = runtime.deserialize_cuda_engine(trt.FileStreamReaderV2(str(native_path)))
+    assert engine is not None
+    assert engine.num_io_tensors == 2
@@ -20,7 +20,13 @@
 #include "NvInfer.h"
 #include "common.h"
 #include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
 #include <stdio.h>
+#include <string>
+#include <thread>
 #include <vector>
 
 class IBatchStream
@@ -150,6 +156,212 @@ private:
     std::vector<float> mLabels{};
 };
 
+//!
+//! \class ImageBatchPrefetcher
+//!
+//! \brief Decodes the PPM images of a calibration list into a ring of batches on worker threads.
+//!
+//! Image i always lands at position i % batchSize of batch i / batchSize, so batches come out in list order however
+//! the decoding is scheduled. A batch handed out by acquire() stays valid until the next call to acquire() or start();
+//! meanwhile the workers fill the other slots of the ring with the batches that follow it.
+//!
+class ImageBatchPrefetcher
+{
+public:
+    ImageBatchPrefetcher(std::vector<std::string> imageNames, std::vector<std::string> directories,
+        nvinfer1::Dims const& dims, int64_t batchSize, int64_t nbBatches, int32_t nbSlots = 4)
+        : mImageNames(std::move(imageNames))
+        , mDirectories(std::move(directories))
+        , mDims(dims)
+        , mBatchSize(batchSize)
+        , mImageSize(static_cast<int64_t>(dims.d[1]) * dims.d[2] * dims.d[3])
+        , mNbBatches(nbBatches)
+        , mSlots(nbSlots)
+    {
+        ASSERT(mDims.d[1] == 3 && "PPM images have 3 channels");
+        ASSERT(mNbBatches * mBatchSize <= static_cast<int64_t>(mImageNames.size()));
+        for (auto& slot : mSlots)
+        {
+            slot.data.resize(mBatchSize * mImageSize);
+        }
+    }
+
+    ~ImageBatchPrefetcher()
+    {
+        stop();
+    }
+
+    ImageBatchPrefetcher(ImageBatchPrefetcher const&) = delete;
+    ImageBatchPrefetcher& operator=(ImageBatchPrefetcher const&) = delete;
+
+    //! Discards the batches decoded so far and starts decoding from firstBatch.
+    void start(int64_t firstBatch)
+    {
+        stop();
+        for (auto& slot : mSlots)
+        {
+            slot.batch = -1;
+        }
+        mNextImage = std::min(firstBatch, mNbBatches) * mBatchSize;
+        mNextBatch = firstBatch;
+        mStopping = false;
+        // Workers beyond one per image of the ring would only wait for a slot to be released.
+        int64_t const nbWorkers = std::clamp<int64_t>(
+            std::thread::hardware_concurrency(), 1, static_cast<int64_t>(mSlots.size()) * mBatchSize);
+        for (int64_t i = 0; i < nbWorkers; ++i)
+        {
+            mWorkers.emplace_back([this] { work(); });
+        }
+    }
+
+    //! Waits for the next batch and returns it, or nullptr past the last batch or if one of its images could not be
+    //! read. Releases the batch returned before.
+    float* acquire()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        int64_t const batch = mNextBatch++;
+        // The workers may now reuse the slot of the previous batch.
+        mSlotReleased.notify_all();
+        if (batch >= mNbBatches)
+        {
+            return nullptr;
+        }
+        Slot& slot = mSlots[batch % mSlots.size()];
+        mBatchDecoded.wait(lock, [&] { return slot.batch == batch && slot.nbDecoded == mBatchSize; });
+        if (!slot.error.empty())
+        {
+            sample::gLogError << slot.error << std::endl;
+            return nullptr;
+        }
+        return slot.data.data();
+    }
+
+private:
+    struct Slot
+    {
+        std::vector<float> data;
+        int64_t batch{-1};     //!< The batch being decoded into, or held in, the slot.
+        int64_t nbDecoded{0};  //!< Images of the batch finished, successfully or not.
+        std::string error;     //!< Why an image of the batch could not be read.
+    };
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mSlotReleased.notify_all();
+        for (auto& worker : mWorkers)
+        {
+            worker.join();
+        }
+        mWorkers.clear();
+    }
+
+    void work()
+    {
+        std::vector<uint8_t> pixels;
+        int64_t const endImage = mNbBatches * mBatchSize;
+        while (true)
+        {
+            int64_t image{0};
+            Slot* slot{nullptr};
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                // The batch acquired last is mNextBatch - 1; its slot is the only one that must not be overwritten.
+                mSlotReleased.wait(lock, [&] {
+                    return mStopping || mNextImage >= endImage
+                        || mNextImage / mBatchSize < mNextBatch - 1 + static_cast<int64_t>(mSlots.size());
+                });
+                if (mStopping || mNextImage >= endImage)
+                {
+                    return;
+                }
+                image = mNextImage++;
+                int64_t const batch = image / mBatchSize;
+                slot = &mSlots[batch % mSlots.size()];
+                if (slot->batch != batch)
+                {
+                    // First image of the batch: images are claimed in order.
+                    slot->batch = batch;
+                    slot->nbDecoded = 0;
+                    slot->error.clear();
+                }
+            }
+
+            float* output = slot->data.data() + (image % mBatchSize) * mImageSize;
+            std::string error = decode(mImageNames[image], output, pixels);
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (!error.empty() && slot->error.empty())
+                {
+                    slot->error = std::move(error);
+                }
+                if (++slot->nbDecoded == mBatchSize)
+                {
+                    mBatchDecoded.notify_all();
+                }
+            }
+        }
+    }
+
+    //! Reads a PPM image and writes it normalized to [-1, 1] in CHW order. Returns an error message on failure.
+    std::string decode(std::string const& name, float* output, std::vector<uint8_t>& pixels) const
+    {
+        std::string const path = samplesCommon::locateFile(name, mDirectories, false);
+        std::ifstream infile(path, std::ifstream::binary);
+        if (path.empty() || !infile)
+        {
+            return "Could not open calibration image " + name;
+        }
+        std::string magic;
+        int32_t w{0};
+        int32_t h{0};
+        int32_t max{0};
+        infile >> magic >> w >> h >> max;
+        infile.seekg(1, infile.cur);
+        if (magic != "P6" || h != mDims.d[2] || w != mDims.d[3] || max > 255)
+        {
+            return "Calibration image " + name + " is not a " + std::to_string(mDims.d[3]) + "x"
+                + std::to_string(mDims.d[2]) + " 8-bit PPM image";
+        }
+        int64_t const volChl = static_cast<int64_t>(h) * w;
+        pixels.resize(volChl * 3);
+        if (!infile.read(reinterpret_cast<char*>(pixels.data()), pixels.size()))
+        {
+            return "Calibration image " + name + " is truncated";
+        }
+
+        float const scale = 2.0 / 255.0;
+        float const bias = 1.0;
+        for (int64_t c = 0; c < 3; ++c)
+        {
+            for (int64_t j = 0; j < volChl; ++j)
+            {
+                output[c * volChl + j] = scale * float(pixels[j * 3 + c]) - bias;
+            }
+        }
+        return {};
+    }
+
+    std::vector<std::string> const mImageNames;
+    std::vector<std::string> const mDirectories;
+    nvinfer1::Dims const mDims;
+    int64_t const mBatchSize;
+    int64_t const mImageSize;
+    int64_t const mNbBatches;
+
+    std::mutex mMutex;
+    std::condition_variable mSlotReleased; //!< acquire() moved on, or the workers are stopping.
+    std::condition_variable mBatchDecoded; //!< All the images of a batch are done.
+    std::vector<Slot> mSlots;
+    int64_t mNextImage{0}; //!< The next image a worker picks up.
+    int64_t mNextBatch{0}; //!< The batch acquire() returns next.
+    bool mStopping{false};
+    std::vector<std::thread> mWorkers;
+};
+
 class BatchStream : public IBatchStream
 {
 public:
@@ -194,16 +406,40 @@ public:
         , mDataDir(directories)
     {
         mImageSize = mDims.d[1] * mDims.d[2] * mDims.d[3];
-        mBatch.resize(mBatchSize * mImageSize, 0);
         mLabels.resize(mBatchSize, 0);
-        mFileBatch.resize(mDims.d[0] * mImageSize, 0);
-        mFileLabels.resize(mDims.d[0], 0);
+
+        // Each line of the list file names an image, without the .ppm extension.
+        std::ifstream file(samplesCommon::locateFile(mListFile, mDataDir), std::ios::binary);
+        ASSERT(file.good());
+        std::vector<std::string> imageNames;
+        for (std::string name; std::getline(file, name);)
+        {
+            if (!name.empty() && name.back() == '\r')
+            {
+                name.pop_back();
+            }
+            if (!name.empty())
+            {
+                imageNames.emplace_back(name + ".ppm");
+            }
+        }
+        int64_t const nbBatches = std::min<int64_t>(mMaxBatches, imageNames.size() / mBatchSize);
+        mPrefetcher = std::make_unique<ImageBatchPrefetcher>(
+            std::move(imageNames), mDataDir, mDims, mBatchSize, nbBatches);
+        mPrefetcher->start(0);
     }
 
     // Resets data members
     void reset(int firstBatch) override
     {
         mBatchCount = 0;
+        if (mPrefetcher)
+        {
+            mListBatch = nullptr;
+            mListBatchPos = firstBatch;
+            mPrefetcher->start(mListBatchPos);
+            return;
+        }
         mFileCount = 0;
         mFileBatchPos = mDims.d[0];
         skip(firstBatch);
@@ -217,6 +453,18 @@ public:
             return false;
         }
 
+        if (mPrefetcher)
+        {
+            mListBatch = mPrefetcher->acquire();
+            if (mListBatch == nullptr)
+            {
+                return false;
+            }
+            sample::gLogInfo << "Batch #" << mListBatchPos++ << std::endl;
+            mBatchCount++;
+            return true;
+        }
+
         for (int64_t csize = 1, batchPos = 0; batchPos < mBatchSize; batchPos += csize, mFileBatchPos += csize)
         {
             ASSERT(mFileBatchPos > 0 && mFileBatchPos <= mDims.d[0]);
@@ -238,6 +486,13 @@ public:
     // Skips the batches
     void skip(int skipCount) override
     {
+        if (mPrefetcher)
+        {
+            mListBatchPos += skipCount;
+            mPrefetcher->start(mListBatchPos);
+            return;
+        }
+
         if (mBatchSize >= mDims.d[0] && mBatchSize % mDims.d[0] == 0 && mFileBatchPos == mDims.d[0])
         {
             mFileCount += skipCount * mBatchSize / mDims.d[0];
@@ -254,7 +509,8 @@ public:
 
     float* getBatch() override
     {
-        return mBatch.data();
+        // Batches read from a list file are handed out where they were decoded.
+        return mPrefetcher ? mListBatch : mBatch.data();
     }
 
     float* getLabels() override
@@ -290,72 +546,18 @@ private:
 
     bool update()
     {
-        if (mListFile.empty())
+        std::string inputFileName
+            = samplesCommon::locateFile(mPrefix + std::to_string(mFileCount++) + mSuffix, mDataDir);
+        std::ifstream file(inputFileName.c_str(), std::ios::binary);
+        if (!file)
         {
-            std::string inputFileName
-                = samplesCommon::locateFile(mPrefix + std::to_string(mFileCount++) + mSuffix, mDataDir);
-            std::ifstream file(inputFileName.c_str(), std::ios::binary);
-            if (!file)
-            {
-                return false;
-            }
-            int d[4];
-            file.read(reinterpret_cast<char*>(d), 4 * sizeof(int32_t));
-            ASSERT(mDims.d[0] == d[0] && mDims.d[1] == d[1] && mDims.d[2] == d[2] && mDims.d[3] == d[3]);
-            file.read(reinterpret_cast<char*>(getFileBatch()), sizeof(float) * mDims.d[0] * mImageSize);
-            file.read(reinterpret_cast<char*>(getFileLabels()), sizeof(float) * mDims.d[0]);
-        }
-        else
-        {
-            std::vector<std::string> fNames;
-            std::ifstream file(samplesCommon::locateFile(mListFile, mDataDir), std::ios::binary);
-            if (!file)
-            {
-                return false;
-            }
-
-            sample::gLogInfo << "Batch #" << mFileCount << std::endl;
-            file.seekg(((mBatchCount * mBatchSize)) * 7);
-
-            for (int i = 1; i <= mBatchSize; i++)
-            {
-                std::string sName;
-                std::getline(file, sName);
-                sName = sName + ".ppm";
-                sample::gLogInfo << "Calibrating with file " << sName << std::endl;
-                fNames.emplace_back(sName);
-            }
-
-            mFileCount++;
-
-            const int imageC = 3;
-            const int imageH = 300;
-            const int imageW = 300;
-            std::vector<samplesCommon::PPM<imageC, imageH, imageW>> ppms(fNames.size());
-            for (uint32_t i = 0; i < fNames.size(); ++i)
-            {
-                readPPMFile(samplesCommon::locateFile(fNames[i], mDataDir), ppms[i]);
-            }
-
-            std::vector<float> data(samplesCommon::volume(mDims));
-            const float scale = 2.0 / 255.0;
-            const float bias = 1.0;
-            long int volChl = mDims.d[2] * mDims.d[3];
-
-            // Normalize input data
-            for (int i = 0, volImg = mDims.d[1] * mDims.d[2] * mDims.d[3]; i < mBatchSize; ++i)
-            {
-                for (int c = 0; c < mDims.d[1]; ++c)
-                {
-                    for (int j = 0; j < volChl; ++j)
-                    {
-                        data[i * volImg + c * volChl + j] = scale * float(ppms[i].buffer[j * mDims.d[1] + c]) - bias;
-                    }
-                }
-            }
-
-            std::copy_n(data.data(), mDims.d[0] * mImageSize, getFileBatch());
+            return false;
         }
+        int d[4];
+        file.read(reinterpret_cast<char*>(d), 4 * sizeof(int32_t));
+        ASSERT(mDims.d[0] == d[0] && mDims.d[1] == d[1] && mDims.d[2] == d[2] && mDims.d[3] == d[3]);
+        file.read(reinterpret_cast<char*>(getFileBatch()), sizeof(float) * mDims.d[0] * mImageSize);
+        file.read(reinterpret_cast<char*>(getFileLabels()), sizeof(float) * mDims.d[0]);
 
         mFileBatchPos = 0;
         return true;
@@ -376,6 +578,9 @@ private:
     nvinfer1::Dims mDims;              //!< Input dimensions
     std::string mListFile;             //!< File name of the list of image names
     std::vector<std::string> mDataDir; //!< Directories where the files can be found
+    std::unique_ptr<ImageBatchPrefetcher> mPrefetcher; //!< Decodes the images of the list file
+    float* mListBatch{nullptr};                        //!< The batch last returned by mPrefetcher
+    int64_t mListBatchPos{0};                          //!< Index in the list of the next batch
 };
 
 #endif
@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BatchStream.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+namespace
+{
+constexpr int32_t kHEIGHT{4};
+constexpr int32_t kWIDTH{5};
+constexpr int32_t kNB_IMAGES{11};
+constexpr int32_t kBATCH_SIZE{3};
+constexpr int32_t kNB_BATCHES{3};
+constexpr int64_t kIMAGE_SIZE{3 * kHEIGHT * kWIDTH};
+
+//! Writes kNB_IMAGES random PPM images and a list file naming them, and the same images already normalized as
+//! one-image .batch files. BatchStream reads the .batch files on the calling thread, which makes it the reference
+//! for the batches decoded by ImageBatchPrefetcher.
+class BatchStreamFiles : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        mDirectory = (std::filesystem::path(::testing::TempDir()) / "trt_batch_stream_test").string();
+        std::filesystem::remove_all(mDirectory);
+        std::filesystem::create_directories(mDirectory);
+
+        std::mt19937 rng(7);
+        std::ofstream list(mDirectory + "/list.txt");
+        for (int32_t i = 0; i < kNB_IMAGES; ++i)
+        {
+            std::string const name = "image" + std::to_string(i);
+            list << name << "\n";
+            mImageNames.push_back(name + ".ppm");
+
+            std::vector<uint8_t> pixels(kIMAGE_SIZE);
+            for (auto& p : pixels)
+            {
+                p = static_cast<uint8_t>(rng() % 256);
+            }
+            std::ofstream ppm(mDirectory + "/" + name + ".ppm", std::ios::binary);
+            ppm << "P6\n" << kWIDTH << " " << kHEIGHT << "\n255\n";
+            ppm.write(reinterpret_cast<char const*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+
+            // Normalized to [-1, 1] in CHW order, as the calibrators expect.
+            std::vector<float> chw(kIMAGE_SIZE);
+            for (int64_t c = 0; c < 3; ++c)
+            {
+                for (int64_t j = 0; j < kHEIGHT * kWIDTH; ++j)
+                {
+                    chw[c * kHEIGHT * kWIDTH + j] = static_cast<float>(2.0 / 255.0) * float(pixels[j * 3 + c]) - 1.F;
+                }
+            }
+            int32_t const dims[4]{1, 3, kHEIGHT, kWIDTH};
+            float const label{0.F};
+            std::ofstream batch(mDirectory + "/ref" + std::to_string(i) + ".batch", std::ios::binary);
+            batch.write(reinterpret_cast<char const*>(dims), sizeof(dims));
+            batch.write(
+                reinterpret_cast<char const*>(chw.data()), static_cast<std::streamsize>(sizeof(float) * chw.size()));
+            batch.write(reinterpret_cast<char const*>(&label), sizeof(label));
+        }
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(mDirectory);
+    }
+
+    //! The batches from firstBatch on, read by BatchStream from the .batch files.
+    std::vector<std::vector<float>> referenceBatches(int32_t firstBatch) const
+    {
+        BatchStream stream(kBATCH_SIZE, kNB_BATCHES, "ref", {mDirectory});
+        stream.reset(firstBatch);
+        std::vector<std::vector<float>> batches;
+        while (stream.next())
+        {
+            batches.emplace_back(stream.getBatch(), stream.getBatch() + kBATCH_SIZE * kIMAGE_SIZE);
+        }
+        return batches;
+    }
+
+    static nvinfer1::Dims getDims()
+    {
+        return nvinfer1::Dims{4, {kBATCH_SIZE, 3, kHEIGHT, kWIDTH}};
+    }
+
+    static void expectBatch(float const* batch, std::vector<float> const& expected)
+    {
+        ASSERT_NE(batch, nullptr);
+        EXPECT_EQ(std::memcmp(batch, expected.data(), expected.size() * sizeof(float)), 0);
+    }
+
+    std::string mDirectory;
+    std::vector<std::string> mImageNames;
+};
+} // namespace
+
+TEST_F(BatchStreamFiles, PrefetcherMatchesSequentialReadsForEveryRingDepth)
+{
+    auto const expected = referenceBatches(0);
+    ASSERT_EQ(expected.size(), static_cast<size_t>(kNB_BATCHES));
+    for (int32_t nbSlots : {1, 2, 3, 8})
+    {
+        ImageBatchPrefetcher prefetcher(mImageNames, {mDirectory}, getDims(), kBATCH_SIZE, kNB_BATCHES, nbSlots);
+        for (int32_t firstBatch : {0, 1, 0})
+        {
+            prefetcher.start(firstBatch);
+            for (int32_t b = firstBatch; b < kNB_BATCHES; ++b)
+            {
+                SCOPED_TRACE("slots " + std::to_string(nbSlots) + ", batch " + std::to_string(b));
+                expectBatch(prefetcher.acquire(), expected[b]);
+            }
+            EXPECT_EQ(prefetcher.acquire(), nullptr);
+        }
+    }
+}
+
+TEST_F(BatchStreamFiles, ListFileStreamMatchesAfterResetAndSkip)
+{
+    auto const expected = referenceBatches(0);
+    BatchStream stream(kBATCH_SIZE, kNB_BATCHES, getDims(), "list.txt", {mDirectory});
+    ASSERT_TRUE(stream.next());
+    expectBatch(stream.getBatch(), expected[0]);
+    ASSERT_TRUE(stream.next());
+    expectBatch(stream.getBatch(), expected[1]);
+
+    stream.reset(1);
+    ASSERT_TRUE(stream.next());
+    expectBatch(stream.getBatch(), expected[1]);
+
+    stream.reset(0);
+    stream.skip(2);
+    ASSERT_TRUE(stream.next());
+    expectBatch(stream.getBatch(), expected[2]);
+    EXPECT_FALSE(stream.next());
+}
+
+TEST_F(BatchStreamFiles, EarlyDestructionDoesNotHang)
+{
+    for (int32_t nbSlots : {1, 2, 4})
+    {
+        // Destroyed before, during and after the workers fill the ring.
+        {
+            ImageBatchPrefetcher prefetcher(mImageNames, {mDirectory}, getDims(), kBATCH_SIZE, kNB_BATCHES, nbSlots);
+            prefetcher.start(0);
+        }
+        {
+            ImageBatchPrefetcher prefetcher(mImageNames, {mDirectory}, getDims(), kBATCH_SIZE, kNB_BATCHES, nbSlots);
+            prefetcher.start(0);
+            EXPECT_NE(prefetcher.acquire(), nullptr);
+        }
+        {
+            ImageBatchPrefetcher prefetcher(mImageNames, {mDirectory}, getDims(), kBATCH_SIZE, kNB_BATCHES, nbSlots);
+            prefetcher.start(0);
+            prefetcher.start(2);
+            prefetcher.start(1);
+            EXPECT_NE(prefetcher.acquire(), nullptr);
+        }
+    }
+}
+
+TEST_F(BatchStreamFiles, MissingImageFailsItsBatchOnly)
+{
+    auto const expected = referenceBatches(0);
+    std::filesystem::remove(mDirectory + "/image4.ppm");
+    ImageBatchPrefetcher prefetcher(mImageNames, {mDirectory}, getDims(), kBATCH_SIZE, kNB_BATCHES, 2);
+    prefetcher.start(0);
+    expectBatch(prefetcher.acquire(), expected[0]);
+    EXPECT_EQ(prefetcher.acquire(), nullptr);
+    expectBatch(prefetcher.acquire(), expected[2]);
+}
@@ -54,10 +54,10 @@ BigInt::BigInt(std::string const& str)
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
 std::pair<BigInt, bool> BigInt::multiplyWithOverflow(BigInt const& a, BigInt const& b) noexcept
 {
-    // Full multiplication into 2*kWordCount words
+    // Full multiplication into 2*kWordCount words. Only the used words of the operands contribute.
     std::array<WordType, kWordCount * 2> result{};
 
-    for (uint64_t i = 0; i < kWordCount; ++i)
+    for (uint64_t i = 0; i < a.mUsedWords; ++i)
     {
         if (a.mWords[i] == 0)
         {
@@ -65,13 +65,9 @@ std::pair<BigInt, bool> BigInt::multiplyWithOverflow(BigInt const& a, BigInt con
         }
 
         WordType carry = 0;
-        for (uint64_t j = 0; j < kWordCount; ++j)
+        for (uint64_t j = 0; j < b.mUsedWords; ++j)
         {
             uint64_t const k = i + j;
-            if (k >= kWordCount * 2)
-            {
-                break;
-            }
 
             // 64x64 → 128-bit multiply using four 32-bit half-words.
             // Split: a = aHi*2^32 + aLo, b = bHi*2^32 + bLo
@@ -109,15 +105,13 @@ std::pair<BigInt, bool> BigInt::multiplyWithOverflow(BigInt const& a, BigInt con
             result[k] = prodLo;
             carry = prodHi;
         }
-        if (i + kWordCount < kWordCount * 2)
-        {
-            result[i + kWordCount] += carry;
-        }
+        result[i + b.mUsedWords] += carry;
     }
 
     // Check for overflow (any non-zero word in upper half)
+    uint64_t const usedWords = a.mUsedWords + b.mUsedWords;
     bool overflow = false;
-    for (uint64_t i = kWordCount; i < kWordCount * 2; ++i)
+    for (uint64_t i = kWordCount; i < usedWords; ++i)
     {
         if (result[i] != 0)
         {
@@ -128,10 +122,12 @@ std::pair<BigInt, bool> BigInt::multiplyWithOverflow(BigInt const& a, BigInt con
 
     // Copy lower half to result
     BigInt low;
-    for (uint64_t i = 0; i < kWordCount; ++i)
+    low.mUsedWords = std::min(usedWords, kWordCount);
+    for (uint64_t i = 0; i < low.mUsedWords; ++i)
     {
         low.mWords[i] = result[i];
     }
+    low.trimUsedWords();
 
     return {low, overflow};
 }
@@ -153,6 +149,12 @@ std::pair<BigInt, BigInt> BigInt::divideWithRemainder(BigInt const& dividend, Bi
         return {BigInt(1), BigInt()};
     }
 
+    // Both operands fit in a word (the divisor is not larger than the dividend here).
+    if (dividend.mUsedWords == 1)
+    {
+        return {BigInt(dividend.mWords[0] / divisor.mWords[0]), BigInt(dividend.mWords[0] % divisor.mWords[0])};
+    }
+
     // Binary long division algorithm
     BigInt quotient;
     BigInt remainder;
@@ -44,6 +44,9 @@ namespace sample
 //! - Division/modulo for mixed-radix index decomposition
 //! - String conversion for display
 //!
+//! The number of words in use is tracked alongside the value, so counting, comparison and arithmetic only touch
+//! the words that hold the value instead of all 128 of them; small values cost about as much as a uint64_t.
+//!
 class BigInt
 {
 public:
@@ -59,6 +62,7 @@ public:
     //! \brief Construct from a 64-bit unsigned integer.
     //! \param[in] value The initial value.
     constexpr BigInt(uint64_t value) noexcept
+        : mUsedWords(value != 0 ? 1 : 0)
     {
         mWords[0] = value;
     }
@@ -79,14 +83,7 @@ public:
     //! \return True if zero.
     constexpr bool isZero() const noexcept
     {
-        for (uint64_t i = 0; i < kWordCount; ++i)
-        {
-            if (mWords[i] != 0)
-            {
-                return false;
-            }
-        }
-        return true;
+        return mUsedWords == 0;
     }
 
     //! \brief Get the bit value at a specific position.
@@ -117,10 +114,12 @@ public:
         if (value)
         {
             mWords[wordIdx] |= (WordType{1} << bitIdx);
+            mUsedWords = std::max(mUsedWords, wordIdx + 1);
         }
         else
         {
             mWords[wordIdx] &= ~(WordType{1} << bitIdx);
+            trimUsedWords();
         }
     }
 
@@ -128,21 +127,19 @@ public:
     //! \return The position (0-indexed), or -1 if zero.
     constexpr int32_t getHighestSetBit() const noexcept
     {
-        for (int32_t i = kWordCount - 1; i >= 0; --i)
+        if (mUsedWords == 0)
         {
-            if (mWords[i] != 0)
-            {
-                // Count leading zeros portably (no compiler intrinsics).
-                uint64_t w = mWords[i];
-                int32_t bit = 63;
-                while (bit > 0 && (w & (uint64_t{1} << bit)) == 0)
-                {
-                    --bit;
-                }
-                return i * 64 + bit;
-            }
+            return -1;
+        }
+        // The highest used word is nonzero. Count leading zeros portably (no compiler intrinsics).
+        int32_t const i = static_cast<int32_t>(mUsedWords) - 1;
+        uint64_t const w = mWords[i];
+        int32_t bit = 63;
+        while (bit > 0 && (w & (uint64_t{1} << bit)) == 0)
+        {
+            --bit;
         }
-        return -1;
+        return i * 64 + bit;
     }
 
     // ========================================================================
@@ -152,7 +149,11 @@ public:
     constexpr bool operator==(BigInt const& other) const noexcept
     {
         // Manual element-by-element comparison (std::array::operator== is not constexpr in C++17)
-        for (uint64_t i = 0; i < kWordCount; ++i)
+        if (mUsedWords != other.mUsedWords)
+        {
+            return false;
+        }
+        for (uint64_t i = 0; i < mUsedWords; ++i)
         {
             if (mWords[i] != other.mWords[i])
             {
@@ -168,10 +169,14 @@ public:
     }
 
     //! \brief Less-than comparison.
-    //! Compares from most significant word down.
+    //! Compares the number of used words, then from most significant word down.
     constexpr bool operator<(BigInt const& other) const noexcept
     {
-        for (int32_t i = kWordCount - 1; i >= 0; --i)
+        if (mUsedWords != other.mUsedWords)
+        {
+            return mUsedWords < other.mUsedWords;
+        }
+        for (int32_t i = static_cast<int32_t>(mUsedWords) - 1; i >= 0; --i)
         {
             if (mWords[i] < other.mWords[i])
             {
@@ -210,7 +215,8 @@ public:
     {
         BigInt result;
         uint64_t carry = 0;
-        for (uint64_t i = 0; i < kWordCount; ++i)
+        uint64_t const usedWords = std::max(a.mUsedWords, b.mUsedWords);
+        for (uint64_t i = 0; i < usedWords; ++i)
         {
             // Add with carry using plain uint64_t. Overflow is detected by comparing
             // the result against the operand: if sum < a then overflow occurred.
@@ -221,6 +227,14 @@ public:
             result.mWords[i] = sum2;
             carry = c1 + c2;
         }
+        result.mUsedWords = usedWords;
+        if (carry != 0 && usedWords < kWordCount)
+        {
+            result.mWords[usedWords] = carry;
+            result.mUsedWords = usedWords + 1;
+            carry = 0;
+        }
+        result.trimUsedWords();
         return {result, carry != 0};
     }
 
@@ -230,7 +244,8 @@ public:
     {
         BigInt result;
         uint64_t borrow = 0;
-        for (uint64_t i = 0; i < kWordCount; ++i)
+        uint64_t const usedWords = std::max(a.mUsedWords, b.mUsedWords);
+        for (uint64_t i = 0; i < usedWords; ++i)
         {
             // Subtract with borrow using plain uint64_t.
             // Borrow is detected by: if a < b+borrow, then we borrowed from the next word.
@@ -241,6 +256,17 @@ public:
             result.mWords[i] = sub2;
             borrow = b1 + b2;
         }
+        result.mUsedWords = usedWords;
+        if (borrow != 0 && usedWords < kWordCount)
+        {
+            // The borrow runs through the remaining all-zero words, wrapping them to all ones.
+            for (uint64_t i = usedWords; i < kWordCount; ++i)
+            {
+                result.mWords[i] = ~WordType{0};
+            }
+            result.mUsedWords = kWordCount;
+        }
+        result.trimUsedWords();
         return {result, borrow != 0};
     }
 
@@ -310,17 +336,19 @@ public:
         BigInt result;
         uint64_t const wordShift = shift / 64;
         uint64_t const bitShift = shift % 64;
+        // Words above this bound only receive zeros.
+        uint64_t const usedWords = std::min(kWordCount, mUsedWords + wordShift + 1);
 
         if (bitShift == 0)
         {
-            for (uint64_t i = wordShift; i < kWordCount; ++i)
+            for (uint64_t i = wordShift; i < usedWords; ++i)
             {
                 result.mWords[i] = mWords[i - wordShift];
             }
         }
         else
         {
-            for (uint64_t i = wordShift; i < kWordCount; ++i)
+            for (uint64_t i = wordShift; i < usedWords; ++i)
             {
                 result.mWords[i] = mWords[i - wordShift] << bitShift;
                 if (i > wordShift)
@@ -329,6 +357,8 @@ public:
                 }
             }
         }
+        result.mUsedWords = usedWords;
+        result.trimUsedWords();
         return result;
     }
 
@@ -350,10 +380,12 @@ public:
         {
             if (++mWords[i] != 0)
             {
-                break; // No carry, done
+                mUsedWords = std::max(mUsedWords, i + 1);
+                return *this; // No carry, done
             }
             // Carry propagates to next word
         }
+        mUsedWords = 0; // Wrapped around to zero
         return *this;
     }
 
@@ -368,6 +400,7 @@ public:
     //! Handles borrow propagation across words.
     constexpr BigInt& operator--() noexcept
     {
+        bool const wasZero = isZero();
         for (uint64_t i = 0; i < kWordCount; ++i)
         {
             if (mWords[i]-- != 0)
@@ -376,6 +409,11 @@ public:
             }
             // Borrow propagates to next word
         }
+        if (wasZero)
+        {
+            mUsedWords = kWordCount; // Wrapped around to all ones
+        }
+        trimUsedWords();
         return *this;
     }
 
@@ -402,7 +440,18 @@ public:
     }
 
 private:
+    //! \brief Drop the zero words at the top so that mUsedWords is again the index of the highest nonzero word + 1.
+    constexpr void trimUsedWords() noexcept
+    {
+        while (mUsedWords > 0 && mWords[mUsedWords - 1] == 0)
+        {
+            --mUsedWords;
+        }
+    }
+
     std::array<WordType, kWordCount> mWords{};
+    //! Number of words in use: every word at or above this index is zero, and the word below it is not.
+    uint64_t mUsedWords{0};
 };
 
 } // namespace sample
@@ -0,0 +1,273 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bigInt.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace sample;
+
+// Differential tests against unsigned __int128: operands are drawn so that the exact result fits in 128 bits, and
+// include the values that make carries and borrows run across word boundaries.
+
+namespace
+{
+using Uint128 = unsigned __int128;
+
+constexpr int32_t kITERATIONS{20000};
+
+//! Built bit by bit so that the conversion does not depend on the arithmetic under test.
+BigInt toBigInt(Uint128 value)
+{
+    BigInt result;
+    for (uint64_t bit = 0; bit < 128; ++bit)
+    {
+        if (((value >> bit) & 1) != 0)
+        {
+            result.setBit(bit);
+        }
+    }
+    return result;
+}
+
+//! The low 128 bits of the value.
+Uint128 toUint128(BigInt const& value)
+{
+    Uint128 result = 0;
+    for (uint64_t bit = 0; bit < 128; ++bit)
+    {
+        if (value.getBit(bit))
+        {
+            result |= Uint128{1} << bit;
+        }
+    }
+    return result;
+}
+
+std::string toString(Uint128 value)
+{
+    if (value == 0)
+    {
+        return "0";
+    }
+    std::string result;
+    for (; value != 0; value /= 10)
+    {
+        result.insert(result.begin(), static_cast<char>('0' + static_cast<int32_t>(value % 10)));
+    }
+    return result;
+}
+
+//! Checks both the value and that nothing is set above bit 127, which also covers a stale used-word count.
+void expectEqual(BigInt const& actual, Uint128 expected)
+{
+    EXPECT_EQ(toUint128(actual), expected) << toString(expected);
+    EXPECT_LT(actual.getHighestSetBit(), 128);
+    EXPECT_TRUE(actual == toBigInt(expected));
+    EXPECT_EQ(actual.isZero(), expected == 0);
+}
+
+class ValueGenerator
+{
+public:
+    //! A value of at most maxBits bits. Besides uniform values, it returns runs of ones, single bits and values next to
+    //! a word boundary, which make carries and borrows propagate.
+    Uint128 operator()(int32_t maxBits)
+    {
+        if (maxBits == 0)
+        {
+            return 0;
+        }
+        int32_t const bits = std::uniform_int_distribution<int32_t>(1, maxBits)(mRng);
+        Uint128 const mask = bits == 128 ? ~Uint128{0} : (Uint128{1} << bits) - 1;
+        switch (std::uniform_int_distribution<int32_t>(0, 4)(mRng))
+        {
+        case 0: return mask;
+        case 1: return Uint128{1} << (bits - 1);
+        case 2: return ((Uint128{1} << 64) + static_cast<int32_t>(mRng() % 3) - 1) & mask;
+        default: return ((static_cast<Uint128>(mRng()) << 64) | mRng()) & mask;
+        }
+    }
+
+    int32_t bits(int32_t lo, int32_t hi)
+    {
+        return std::uniform_int_distribution<int32_t>(lo, hi)(mRng);
+    }
+
+private:
+    std::mt19937_64 mRng{20260718};
+};
+} // namespace
+
+TEST(BigInt, AddMatchesUint128)
+{
+    ValueGenerator gen;
+    for (int32_t i = 0; i < kITERATIONS; ++i)
+    {
+        Uint128 const a = gen(127);
+        Uint128 const b = gen(127);
+        auto const [sum, overflow] = BigInt::addWithOverflow(toBigInt(a), toBigInt(b));
+        EXPECT_FALSE(overflow);
+        expectEqual(sum, a + b);
+    }
+}
+
+TEST(BigInt, SubMatchesUint128)
+{
+    ValueGenerator gen;
+    for (int32_t i = 0; i < kITERATIONS; ++i)
+    {
+        Uint128 const a = gen(128);
+        Uint128 const b = gen(128);
+        auto const [difference, underflow] = BigInt::subWithUnderflow(toBigInt(a), toBigInt(b));
+        EXPECT_EQ(underflow, a < b);
+        if (a >= b)
+        {
+            expectEqual(difference, a - b);
+        }
+        else
+        {
+            // Wraps modulo 2^8192: the low bits match the wrapped uint128 and every bit above is set.
+            EXPECT_EQ(toUint128(difference), a - b);
+            EXPECT_EQ(difference.getHighestSetBit(), static_cast<int32_t>(BigInt::kBitCount) - 1);
+            auto const [zero, carry] = BigInt::addWithOverflow(difference, toBigInt(b - a));
+            EXPECT_TRUE(carry);
+            EXPECT_TRUE(zero.isZero());
+        }
+    }
+}
+
+TEST(BigInt, MultiplyMatchesUint128)
+{
+    ValueGenerator gen;
+    for (int32_t i = 0; i < kITERATIONS; ++i)
+    {
+        // Any split of the 128 bits, so that either operand may span one or two words and the carry out of each
+        // row lands in the word above the other operand.
+        int32_t const bitsA = gen.bits(0, 128);
+        Uint128 const a = gen(bitsA);
+        Uint128 const b = gen(128 - bitsA);
+        auto const [product, overflow] = BigInt::multiplyWithOverflow(toBigInt(a), toBigInt(b));
+        EXPECT_FALSE(overflow);
+        expectEqual(product, a * b);
+        expectEqual(toBigInt(b) * toBigInt(a), a * b);
+    }
+}
+
+TEST(BigInt, MultiplyOverflow)
+{
+    BigInt const half = BigInt(1) << (BigInt::kBitCount / 2);
+    EXPECT_TRUE(BigInt::multiplyWithOverflow(half, half).second);
+    EXPECT_FALSE(BigInt::multiplyWithOverflow(half, BigInt(1) << (BigInt::kBitCount / 2 - 1)).second);
+}
+
+TEST(BigInt, DivideMatchesUint128)
+{
+    ValueGenerator gen;
+    for (int32_t i = 0; i < kITERATIONS; ++i)
+    {
+        // Single-word dividends take the shortcut; the others go through long division.
+        Uint128 const a = gen(i % 2 == 0 ? 64 : 128);
+        Uint128 b = gen(gen.bits(1, 128));
+        b = b == 0 ? 1 : b;
+        auto const [quotient, remainder] = BigInt::divideWithRemainder(toBigInt(a), toBigInt(b));
+        expectEqual(quotient, a / b);
+        expectEqual(remainder, a % b);
+    }
+    EXPECT_THROW(BigInt::divideWithRemainder(BigInt(1), BigInt()), std::domain_error);
+}
+
+TEST(BigInt, ShiftMatchesUint128)
+{
+    ValueGenerator gen;
+    for (int32_t i = 0; i < kITERATIONS; ++i)
+    {
+        int32_t const shift = gen.bits(0, 127);
+        Uint128 const a = gen(128 - shift);
+        expectEqual(toBigInt(a) << shift, a << shift);
+    }
+
+    // Bits shifted past the top are dropped.
+    BigInt const top = BigInt(3) << (BigInt::kBitCount - 2);
+    EXPECT_EQ(top.getHighestSetBit(), static_cast<int32_t>(BigInt::kBitCount) - 1);
+    EXPECT_EQ((top << 1).getHighestSetBit(), static_cast<int32_t>(BigInt::kBitCount) - 1);
+    EXPECT_TRUE((top << 2).isZero());
+    EXPECT_TRUE((BigInt(1) << BigInt::kBitCount).isZero());
+}
+
+TEST(BigInt, IncrementDecrementMatchUint128)
+{
+    ValueGenerator gen;
+    for (int32_t i = 0; i < kITERATIONS; ++i)
+    {
+        Uint128 const a = gen(127);
+        BigInt value = toBigInt(a);
+        ++value;
+        expectEqual(value, a + 1);
+        --value;
+        expectEqual(value, a);
+        if (a != 0)
+        {
+            --value;
+            expectEqual(value, a - 1);
+        }
+    }
+}
+
+TEST(BigInt, DecrementWrapsAroundZero)
+{
+    BigInt value;
+    --value;
+    EXPECT_EQ(value.getHighestSetBit(), static_cast<int32_t>(BigInt::kBitCount) - 1);
+    EXPECT_EQ(toUint128(value), ~Uint128{0});
+    EXPECT_EQ(value + BigInt(1), BigInt());
+    ++value;
+    EXPECT_TRUE(value.isZero());
+    EXPECT_EQ(value, BigInt());
+}
+
+TEST(BigInt, ComparisonsMatchUint128)
+{
+    ValueGenerator gen;
+    for (int32_t i = 0; i < kITERATIONS; ++i)
+    {
+        Uint128 const a = gen(128);
+        // Often equal, or equal in all but the lowest word.
+        Uint128 const b = i % 4 == 0 ? a : i % 4 == 1 ? (a & ~Uint128{0xFFFFFFFFFFFFFFFFULL}) | gen(64) : gen(128);
+        BigInt const x = toBigInt(a);
+        BigInt const y = toBigInt(b);
+        EXPECT_EQ(x == y, a == b);
+        EXPECT_EQ(x != y, a != b);
+        EXPECT_EQ(x < y, a < b);
+        EXPECT_EQ(x <= y, a <= b);
+        EXPECT_EQ(x > y, a > b);
+        EXPECT_EQ(x >= y, a >= b);
+    }
+}
+
+TEST(BigInt, StringRoundTripMatchesUint128)
+{
+    ValueGenerator gen;
+    for (int32_t i = 0; i < kITERATIONS / 10; ++i)
+    {
+        Uint128 const a = gen(128);
+        EXPECT_EQ(toBigInt(a).toString(), toString(a));
+        expectEqual(BigInt(toString(a)), a);
+    }
+}
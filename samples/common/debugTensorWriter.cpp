@@ -27,6 +27,8 @@
 #include <cuda_fp4.h>
 #endif
 #include <cuda_runtime_api.h>
+#include <cstdlib>
+#include <cstring>
 #include <numeric>
 namespace sample
 {
@@ -241,7 +243,7 @@ std::string_view getDataTypeString(nvinfer1::DataType type)
 }
 
 template <typename T>
-void printTensorElements(T const* data, int64_t volume, std::ofstream& f)
+void printTensorElements(T const* data, int64_t volume, std::ostream& f)
 {
     f << "        \"elements\": \"";
     constexpr int32_t kPRINT_ELEMENTS_COUNT = 10;
@@ -288,7 +290,7 @@ void printTensorElements(T const* data, int64_t volume, std::ofstream& f)
 }
 
 template <typename T>
-void processTensorSummary(void const* addr_host, int64_t volume, std::ofstream& f)
+void processTensorSummary(void const* addr_host, int64_t volume, std::ostream& f)
 {
     DataRange<T> range(addr_host, volume);
 
@@ -567,14 +569,16 @@ std::vector<U> convertBufferTo(T const* data, int64_t volume)
 } // namespace
 
 DebugTensorWriter::DebugTensorWriter(std::unordered_map<std::string, std::string> const& debugTensorFileNames,
-    std::vector<std::string> const& debugTensorFormats, std::string const& engineName, std::string const& cmdline)
+    std::vector<std::string> const& debugTensorFormats, std::string const& engineName, std::string const& cmdline,
+    size_t memoryLimit)
     : mDebugTensorFileNames(debugTensorFileNames)
     , mDebugTensorFormats(debugTensorFormats)
     , mEngineName(engineName)
     , mCmdline(cmdline)
+    , mMemoryLimit(memoryLimit)
 {
     // Create a summary file if "summary" format is requested
-    if (std::find(mDebugTensorFormats.begin(), mDebugTensorFormats.end(), "summary") != mDebugTensorFormats.end())
+    if (hasFormat("summary"))
     {
         mSummaryFileName = "tensor_summary.json";
         mSummaryFile.open(mSummaryFileName, std::ios::out);
@@ -588,10 +592,39 @@ DebugTensorWriter::DebugTensorWriter(std::unordered_map<std::string, std::string
             sample::gLogError << "Failed to open tensor summary file: " << mSummaryFileName << std::endl;
         }
     }
+
+    // The workers wait for the copies of the tensors, which must happen on the device they were produced on.
+    CHECK(cudaGetDevice(&mDevice));
+    // Writing is mostly I/O bound: a few threads are enough to keep up with the files and the statistics.
+    constexpr uint32_t kMAX_WORKERS{4};
+    uint32_t const nbWorkers = std::clamp(std::thread::hardware_concurrency(), 1U, kMAX_WORKERS);
+    for (uint32_t i = 0; i < nbWorkers; ++i)
+    {
+        mWorkers.emplace_back(&DebugTensorWriter::workerLoop, this);
+    }
 }
 
 DebugTensorWriter::~DebugTensorWriter()
 {
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mQueueChanged.notify_all();
+    for (auto& worker : mWorkers)
+    {
+        worker.join();
+    }
+    for (auto const& buffer : mFreeBuffers)
+    {
+        freeBuffer(buffer);
+    }
+    for (auto event : mFreeEvents)
+    {
+        cudaEventDestroy(event);
+    }
+
     // Close the summary file
     if (mSummaryFile.is_open())
     {
@@ -600,6 +633,145 @@ DebugTensorWriter::~DebugTensorWriter()
     }
 }
 
+bool DebugTensorWriter::hasFormat(std::string_view format) const
+{
+    return std::find(mDebugTensorFormats.begin(), mDebugTensorFormats.end(), format) != mDebugTensorFormats.end();
+}
+
+DebugTensorWriter::HostBuffer DebugTensorWriter::acquireBuffer(size_t size)
+{
+    size = std::max<size_t>(size, 1);
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        // Smallest pooled buffer that fits, so that large buffers stay available for large tensors.
+        auto best = mFreeBuffers.end();
+        for (auto it = mFreeBuffers.begin(); it != mFreeBuffers.end(); ++it)
+        {
+            if (it->capacity >= size && (best == mFreeBuffers.end() || it->capacity < best->capacity))
+            {
+                best = it;
+            }
+        }
+        if (best != mFreeBuffers.end())
+        {
+            HostBuffer buffer = *best;
+            mFreeBuffers.erase(best);
+            ++mBuffersInUse;
+            return buffer;
+        }
+        // Make room by releasing the pooled buffers that are too small.
+        while (mMemoryUsed + size > mMemoryLimit && !mFreeBuffers.empty())
+        {
+            mMemoryUsed -= mFreeBuffers.back().capacity;
+            freeBuffer(mFreeBuffers.back());
+            mFreeBuffers.pop_back();
+        }
+        // Backpressure: wait for the workers to return buffers, unless none is in use and the tensor is simply
+        // larger than the limit.
+        if (mMemoryUsed + size <= mMemoryLimit || mBuffersInUse == 0)
+        {
+            break;
+        }
+        mBufferFreed.wait(lock);
+    }
+    mMemoryUsed += size;
+    ++mBuffersInUse;
+    lock.unlock();
+
+    // Pinned memory makes the copy from the device asynchronous.
+    HostBuffer buffer{nullptr, size, true};
+    if (cudaMallocHost(&buffer.data, size) != cudaSuccess)
+    {
+        static_cast<void>(cudaGetLastError());
+        buffer.data = std::malloc(size);
+        buffer.pinned = false;
+        ASSERT(buffer.data != nullptr && "Cannot allocate a host buffer for a debug tensor");
+    }
+    return buffer;
+}
+
+void DebugTensorWriter::freeBuffer(HostBuffer const& buffer)
+{
+    if (buffer.pinned)
+    {
+        cudaFreeHost(buffer.data);
+    }
+    else
+    {
+        std::free(buffer.data);
+    }
+}
+
+void DebugTensorWriter::releaseBuffer(HostBuffer buffer)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFreeBuffers.push_back(buffer);
+        --mBuffersInUse;
+    }
+    mBufferFreed.notify_all();
+}
+
+cudaEvent_t DebugTensorWriter::acquireEvent()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mFreeEvents.empty())
+        {
+            cudaEvent_t event = mFreeEvents.back();
+            mFreeEvents.pop_back();
+            return event;
+        }
+    }
+    cudaEvent_t event{nullptr};
+    CHECK(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    return event;
+}
+
+void DebugTensorWriter::releaseEvent(cudaEvent_t event)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mFreeEvents.push_back(event);
+}
+
+void DebugTensorWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mJobsFinished.wait(lock, [this] { return mJobsPending == 0; });
+}
+
+void DebugTensorWriter::workerLoop()
+{
+    CHECK(cudaSetDevice(mDevice));
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mQueueChanged.wait(lock, [this] { return mStop || !mQueue.empty(); });
+            if (mQueue.empty())
+            {
+                return;
+            }
+            job = std::move(mQueue.front());
+            mQueue.pop_front();
+        }
+        if (job.ready != nullptr)
+        {
+            CHECK(cudaEventSynchronize(job.ready));
+            releaseEvent(job.ready);
+        }
+        writeTensor(job);
+        releaseBuffer(job.buffer);
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mJobsPending;
+        }
+        mJobsFinished.notify_all();
+    }
+}
+
 void DebugTensorWriter::writeSummaryHeader()
 {
     mSummaryFile << "{" << std::endl;
@@ -618,19 +790,12 @@ void DebugTensorWriter::writeSummaryFooter()
     mSummaryFile << "}" << std::endl;
 }
 
-void DebugTensorWriter::writeSummary(std::string_view name, nvinfer1::Dims const& shape, nvinfer1::DataType type,
-    int64_t volume, void const* addr_host, std::string_view assignedFileName, std::string_view numpyFileName,
-    std::string_view stringFileName, std::string_view rawFileName)
+void DebugTensorWriter::writeSummary(std::ostream& os, std::string_view name, nvinfer1::Dims const& shape,
+    nvinfer1::DataType type, int64_t volume, void const* addr_host, std::string_view assignedFileName,
+    std::string_view numpyFileName, std::string_view stringFileName, std::string_view rawFileName) const
 {
-    // Add comma separator if not the first tensor
-    if (!mFirstTensor)
-    {
-        mSummaryFile << "," << std::endl;
-    }
-    mFirstTensor = false;
-
     // Write tensor information
-    mSummaryFile << "  {\n"
+    os << "  {\n"
                  << "    \"name\": \"" << name << "\",\n"
                  << "    \"shape\": [";
 
@@ -638,28 +803,28 @@ void DebugTensorWriter::writeSummary(std::string_view name, nvinfer1::Dims const
     {
         if (i > 0)
         {
-            mSummaryFile << ", ";
+            os << ", ";
         }
-        mSummaryFile << shape.d[i];
+        os << shape.d[i];
     }
 
-    mSummaryFile << "],\n"
+    os << "],\n"
                  << "    \"type\": \"" << getDataTypeString(type) << "\",\n";
 
     // Write statistics
-    mSummaryFile << "    \"statistics\": {\n";
+    os << "    \"statistics\": {\n";
 
     switch (type)
     {
-    case nvinfer1::DataType::kBOOL: processTensorSummary<bool>(addr_host, volume, mSummaryFile); break;
-    case nvinfer1::DataType::kINT4: processTensorSummary<Int4x2>(addr_host, volume, mSummaryFile); break;
-    case nvinfer1::DataType::kINT8: processTensorSummary<int8_t>(addr_host, volume, mSummaryFile); break;
-    case nvinfer1::DataType::kINT32: processTensorSummary<int32_t>(addr_host, volume, mSummaryFile); break;
-    case nvinfer1::DataType::kINT64: processTensorSummary<int64_t>(addr_host, volume, mSummaryFile); break;
-    case nvinfer1::DataType::kUINT8: processTensorSummary<uint8_t>(addr_host, volume, mSummaryFile); break;
+    case nvinfer1::DataType::kBOOL: processTensorSummary<bool>(addr_host, volume, os); break;
+    case nvinfer1::DataType::kINT4: processTensorSummary<Int4x2>(addr_host, volume, os); break;
+    case nvinfer1::DataType::kINT8: processTensorSummary<int8_t>(addr_host, volume, os); break;
+    case nvinfer1::DataType::kINT32: processTensorSummary<int32_t>(addr_host, volume, os); break;
+    case nvinfer1::DataType::kINT64: processTensorSummary<int64_t>(addr_host, volume, os); break;
+    case nvinfer1::DataType::kUINT8: processTensorSummary<uint8_t>(addr_host, volume, os); break;
     case nvinfer1::DataType::kFP4:
 #if CUDA_VERSION >= 12070
-        processTensorSummary<Fp4x2>(addr_host, volume, mSummaryFile);
+        processTensorSummary<Fp4x2>(addr_host, volume, os);
 #else
         sample::gLogWarning << "Unsupported data type kFP4 for tensor '" << name
                             << "' summary dump in this CUDA version." << std::endl;
@@ -667,7 +832,7 @@ void DebugTensorWriter::writeSummary(std::string_view name, nvinfer1::Dims const
         break;
     case nvinfer1::DataType::kFP8:
 #if CUDA_VERSION >= 11060
-        processTensorSummary<__nv_fp8_e4m3>(addr_host, volume, mSummaryFile);
+        processTensorSummary<__nv_fp8_e4m3>(addr_host, volume, os);
         break;
 #else
         sample::gLogWarning << "Unsupported data type kFP8 for tensor '" << name
@@ -677,46 +842,68 @@ void DebugTensorWriter::writeSummary(std::string_view name, nvinfer1::Dims const
     case nvinfer1::DataType::kE8M0:
         sample::gLogWarning << "Unsupported data type kE8M0 for tensor '" << name << "' summary dump." << std::endl;
         break;
-    case nvinfer1::DataType::kHALF: processTensorSummary<half>(addr_host, volume, mSummaryFile); break;
-    case nvinfer1::DataType::kBF16: processTensorSummary<nv_bfloat16>(addr_host, volume, mSummaryFile); break;
-    case nvinfer1::DataType::kFLOAT: processTensorSummary<float>(addr_host, volume, mSummaryFile); break;
+    case nvinfer1::DataType::kHALF: processTensorSummary<half>(addr_host, volume, os); break;
+    case nvinfer1::DataType::kBF16: processTensorSummary<nv_bfloat16>(addr_host, volume, os); break;
+    case nvinfer1::DataType::kFLOAT: processTensorSummary<float>(addr_host, volume, os); break;
     }
 
-    mSummaryFile << "    }";
+    os << "    }";
 
     // Write file information only if at least one file exists
     if (!assignedFileName.empty() || !numpyFileName.empty() || !stringFileName.empty() || !rawFileName.empty())
     {
-        mSummaryFile << ",\n    \"files\": {\n";
+        os << ",\n    \"files\": {\n";
         std::string delimiter = "";
 
         if (!assignedFileName.empty())
         {
-            mSummaryFile << delimiter << "      \"assigned\": \"" << escapeJsonString(assignedFileName) << "\"";
+            os << delimiter << "      \"assigned\": \"" << escapeJsonString(assignedFileName) << "\"";
             delimiter = ",\n";
         }
 
         if (!numpyFileName.empty())
         {
-            mSummaryFile << delimiter << "      \"numpy\": \"" << escapeJsonString(numpyFileName) << "\"";
+            os << delimiter << "      \"numpy\": \"" << escapeJsonString(numpyFileName) << "\"";
             delimiter = ",\n";
         }
 
         if (!stringFileName.empty())
         {
-            mSummaryFile << delimiter << "      \"string\": \"" << escapeJsonString(stringFileName) << "\"";
+            os << delimiter << "      \"string\": \"" << escapeJsonString(stringFileName) << "\"";
             delimiter = ",\n";
         }
 
         if (!rawFileName.empty())
         {
-            mSummaryFile << delimiter << "      \"raw\": \"" << escapeJsonString(rawFileName) << "\"";
+            os << delimiter << "      \"raw\": \"" << escapeJsonString(rawFileName) << "\"";
         }
 
-        mSummaryFile << "\n    }";
+        os << "\n    }";
     }
 
-    mSummaryFile << "\n  }";
+    os << "\n  }";
+}
+
+void DebugTensorWriter::appendSummary(int32_t index, std::string entry)
+{
+    std::lock_guard<std::mutex> lock(mSummaryMutex);
+    mPendingSummaries.emplace(index, std::move(entry));
+    for (auto it = mPendingSummaries.begin(); it != mPendingSummaries.end() && it->first == mNextSummary;
+         it = mPendingSummaries.erase(it), ++mNextSummary)
+    {
+        if (it->second.empty())
+        {
+            continue;
+        }
+        // Add comma separator if not the first tensor
+        if (!mFirstTensor)
+        {
+            mSummaryFile << "," << std::endl;
+        }
+        mFirstTensor = false;
+        mSummaryFile << it->second;
+        mSummaryFile.flush();
+    }
 }
 
 bool writeNumpyFile(void const* addr_host, std::string_view dtype, nvinfer1::Dims const& shape, int64_t size,
@@ -852,22 +1039,48 @@ std::string writeNumpy(nvinfer1::DataType type, void const* addr_host, int64_t v
 bool DebugTensorWriter::processDebugTensor(void const* addr, nvinfer1::TensorLocation location, nvinfer1::DataType type,
     nvinfer1::Dims const& shape, char const* name, cudaStream_t stream)
 {
-    CHECK(cudaStreamSynchronize(stream));
     // Store data from callback.
     auto volume = std::accumulate(shape.d, shape.d + shape.nbDims, 1LL, std::multiplies<int64_t>{});
     int64_t size = samplesCommon::getNbBytes(type, volume);
-    std::vector<char> hostDataOut;
-    void const* addrHost = nullptr;
+
+    Job job;
+    job.index = mTensorIndex++;
+    job.name = name;
+    job.shape = shape;
+    job.type = type;
+    job.volume = volume;
+    job.buffer = acquireBuffer(static_cast<size_t>(size));
     if (location == nvinfer1::TensorLocation::kDEVICE)
     {
-        hostDataOut.resize(size);
-        CHECK(cudaMemcpy(hostDataOut.data(), addr, size, cudaMemcpyDeviceToHost));
-        addrHost = hostDataOut.data();
+        // The copy is ordered before the work that reuses the memory of the tensor on the stream; the worker waits
+        // for it, so the callback does not.
+        job.ready = acquireEvent();
+        CHECK(cudaMemcpyAsync(job.buffer.data, addr, size, cudaMemcpyDeviceToHost, stream));
+        CHECK(cudaEventRecord(job.ready, stream));
     }
     else
     {
-        addrHost = addr;
+        CHECK(cudaStreamSynchronize(stream));
+        std::memcpy(job.buffer.data, addr, size);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQueue.push_back(std::move(job));
+        ++mJobsPending;
     }
+    mQueueChanged.notify_one();
+    return true;
+}
+
+void DebugTensorWriter::writeTensor(Job const& job)
+{
+    std::string const& name = job.name;
+    nvinfer1::Dims const& shape = job.shape;
+    nvinfer1::DataType const type = job.type;
+    int64_t const volume = job.volume;
+    int64_t const size = samplesCommon::getNbBytes(type, volume);
+    void const* addrHost = job.buffer.data;
 
     std::string assignedFileName;
     std::string numpyFileName;
@@ -886,10 +1099,10 @@ bool DebugTensorWriter::processDebugTensor(void const* addr, nvinfer1::TensorLoc
     }
 
     std::stringstream ss;
-    ss << std::setw(4) << std::setfill('0') << mTensorIndex << "_";
+    ss << std::setw(4) << std::setfill('0') << job.index << "_";
     std::string prefix = ss.str();
 
-    if (std::find(mDebugTensorFormats.begin(), mDebugTensorFormats.end(), "raw") != mDebugTensorFormats.end())
+    if (hasFormat("raw"))
     {
         rawFileName = genFilenameSafeString(prefix + name + ".raw");
         sample::gLogVerbose << "Writing debug tensor '" << name << "' to raw file '" << rawFileName << "'" << std::endl;
@@ -899,25 +1112,24 @@ bool DebugTensorWriter::processDebugTensor(void const* addr, nvinfer1::TensorLoc
         f.close();
     }
 
-    if (std::find(mDebugTensorFormats.begin(), mDebugTensorFormats.end(), "numpy") != mDebugTensorFormats.end())
+    if (hasFormat("numpy"))
     {
         numpyFileName = writeNumpy(type, addrHost, volume, shape, name, prefix);
     }
 
-    if (std::find(mDebugTensorFormats.begin(), mDebugTensorFormats.end(), "string") != mDebugTensorFormats.end())
+    if (hasFormat("string"))
     {
         stringFileName = writeStringFile(addrHost, type, shape, name, prefix);
     }
 
-    if (std::find(mDebugTensorFormats.begin(), mDebugTensorFormats.end(), "summary") != mDebugTensorFormats.end()
-        && mSummaryFile.is_open())
+    // Every tensor takes its turn in the summary, even without an entry, so that the entries keep their order.
+    std::ostringstream entry;
+    if (hasFormat("summary") && mSummaryFile.is_open())
     {
-        writeSummary(name, shape, type, volume, addrHost, assignedFileName, numpyFileName, stringFileName, rawFileName);
-        mSummaryFile.flush();
+        writeSummary(
+            entry, name, shape, type, volume, addrHost, assignedFileName, numpyFileName, stringFileName, rawFileName);
     }
-
-    mTensorIndex++;
-    return true;
+    appendSummary(job.index, entry.str());
 }
 
 } // namespace sample
@@ -19,30 +19,88 @@
 #define TENSORRT_DEBUG_TENSOR_WRITER_H
 
 #include "NvInferRuntime.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 namespace sample
 {
 
+//!
+//! \class DebugTensorWriter
+//! \brief Debug listener that saves the debug tensors to files
+//!
+//! The callback only snapshots the tensor: a device tensor is copied asynchronously, on the stream that produces it,
+//! to a host buffer recycled from a pool, and the files and summary statistics are written by background threads.
+//! The host memory of the snapshots is capped: the callback blocks until enough earlier tensors are written to make
+//! room (a tensor larger than the cap is still saved, alone). Summary entries keep the order of the callbacks.
+//! Everything received is written by flush() and at destruction.
+//!
 class DebugTensorWriter : public nvinfer1::IDebugListener
 {
 public:
+    //! Default cap on the host memory holding tensors waiting to be written.
+    static constexpr size_t kDEFAULT_MEMORY_LIMIT{size_t{1} << 30};
+
     DebugTensorWriter(std::unordered_map<std::string, std::string> const& debugTensorFileNames,
         std::vector<std::string> const& debugTensorFormats, std::string const& engineName = "",
-        std::string const& cmdline = "");
+        std::string const& cmdline = "", size_t memoryLimit = kDEFAULT_MEMORY_LIMIT);
     ~DebugTensorWriter() override;
 
+    DebugTensorWriter(DebugTensorWriter const&) = delete;
+    DebugTensorWriter& operator=(DebugTensorWriter const&) = delete;
+
     bool processDebugTensor(void const* addr, nvinfer1::TensorLocation location, nvinfer1::DataType type,
         nvinfer1::Dims const& shape, char const* name, cudaStream_t stream) override;
 
+    //! Wait until every tensor received so far has been written.
+    void flush();
+
 private:
+    struct HostBuffer
+    {
+        void* data{nullptr};
+        size_t capacity{0};
+        bool pinned{false};
+    };
+
+    struct Job
+    {
+        int32_t index{0};
+        std::string name;
+        nvinfer1::Dims shape{};
+        nvinfer1::DataType type{};
+        int64_t volume{0};
+        HostBuffer buffer;
+        cudaEvent_t ready{nullptr}; //!< Recorded after the copy of a device tensor; nullptr for host tensors.
+    };
+
+    //! Take a buffer of at least size bytes from the pool, waiting while the memory limit would be exceeded.
+    HostBuffer acquireBuffer(size_t size);
+    void releaseBuffer(HostBuffer buffer);
+    static void freeBuffer(HostBuffer const& buffer);
+    cudaEvent_t acquireEvent();
+    void releaseEvent(cudaEvent_t event);
+
+    void workerLoop();
+    void writeTensor(Job const& job);
+
     void writeSummaryHeader();
     void writeSummaryFooter();
-    void writeSummary(std::string_view name, nvinfer1::Dims const& shape, nvinfer1::DataType type, int64_t volume,
-        void const* addr_host, std::string_view assignedFileName, std::string_view numpyFileName,
-        std::string_view stringFileName, std::string_view rawFileName);
+    void writeSummary(std::ostream& os, std::string_view name, nvinfer1::Dims const& shape, nvinfer1::DataType type,
+        int64_t volume, void const* addr_host, std::string_view assignedFileName, std::string_view numpyFileName,
+        std::string_view stringFileName, std::string_view rawFileName) const;
+    //! Append the summary entry of tensor index, or nothing if entry is empty, once those before it are appended.
+    void appendSummary(int32_t index, std::string entry);
+
+    bool hasFormat(std::string_view format) const;
 
     std::unordered_map<std::string, std::string> mDebugTensorFileNames;
     std::vector<std::string> mDebugTensorFormats;
@@ -52,6 +110,28 @@ private:
     std::string mEngineName;
     std::string mCmdline;
     int32_t mTensorIndex{0};
+    int32_t mDevice{0};
+
+    //! Guards the pools, the queue and the counters below.
+    std::mutex mMutex;
+    std::condition_variable mQueueChanged; //!< A job was queued, or the writer is stopping.
+    std::condition_variable mBufferFreed;  //!< A buffer went back to the pool.
+    std::condition_variable mJobsFinished; //!< A job was written.
+    size_t const mMemoryLimit;
+    size_t mMemoryUsed{0}; //!< Capacity of every buffer allocated, in use or pooled.
+    size_t mBuffersInUse{0};
+    std::vector<HostBuffer> mFreeBuffers;
+    std::vector<cudaEvent_t> mFreeEvents;
+    std::deque<Job> mQueue;
+    size_t mJobsPending{0}; //!< Queued or being written.
+    bool mStop{false};
+
+    //! Guards the summary file and the entries that arrived before those preceding them.
+    std::mutex mSummaryMutex;
+    int32_t mNextSummary{0};
+    std::map<int32_t, std::string> mPendingSummaries;
+
+    std::vector<std::thread> mWorkers;
 };
 
 } // namespace sample
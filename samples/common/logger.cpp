@@ -18,6 +18,10 @@
 #include "logger.h"
 #include "ErrorRecorder.h"
 #include "logging.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <thread>
 using namespace nvinfer1;
 SampleErrorRecorder gRecorder;
 namespace sample
@@ -29,6 +33,283 @@ LogStreamConsumer gLogWarning{LOG_WARN(gLogger)};
 LogStreamConsumer gLogError{LOG_ERROR(gLogger)};
 LogStreamConsumer gLogFatal{LOG_FATAL(gLogger)};
 
+namespace
+{
+//! A queued line. The queue always holds one node whose line has already been taken, the stub, at its tail.
+struct LogNode
+{
+    std::atomic<LogNode*> next{nullptr};
+    Severity severity{Severity::kINFO};
+    std::time_t time{};
+    std::string text;
+    bool stop{false}; //!< Pushed last by AsyncLogWriter::stop() to end the writer thread.
+};
+
+//! Format a line the way LogStreamConsumerBuffer does. The timestamp is only formatted again when it changes.
+struct LineFormatter
+{
+    void append(std::string& out, Severity severity, std::time_t time, std::string const& text)
+    {
+        if (time != stampTime || stamp.empty())
+        {
+            std::ostringstream os;
+            os << std::put_time(std::localtime(&time), "[%m/%d/%Y-%H:%M:%S] ");
+            stamp = os.str();
+            stampTime = time;
+        }
+        out.append(stamp).append(LogStreamConsumer::severityPrefix(severity)).append(text);
+    }
+
+    std::string stamp;
+    std::time_t stampTime{};
+};
+
+class AsyncLogState
+{
+public:
+    //! Wait-free for producers: one exchange to claim the head, one store to link the previous node.
+    void enqueue(LogNode* node)
+    {
+        LogNode* const previous = mHead.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+        mPushed.fetch_add(1, std::memory_order_release);
+        mPushed.notify_one();
+    }
+
+    //! Writer side only. The returned node becomes the new stub, so its line must be consumed before the next call.
+    LogNode* dequeue()
+    {
+        LogNode* const next = mTail->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return nullptr;
+        }
+        delete mTail;
+        mTail = next;
+        return next;
+    }
+
+    void writerLoop()
+    {
+        LineFormatter formatter;
+        std::string batch;
+        std::ostream* out{nullptr};
+        auto const writeBatch = [&]() {
+            if (out != nullptr && !batch.empty())
+            {
+                out->write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                out->flush();
+            }
+            batch.clear();
+        };
+
+        bool stopped{false};
+        while (!stopped)
+        {
+            uint64_t const pushed = mPushed.load(std::memory_order_acquire);
+            uint64_t nbWritten{0};
+            while (LogNode* node = dequeue())
+            {
+                ++nbWritten;
+                if (node->stop)
+                {
+                    stopped = true;
+                    break;
+                }
+                // Lines are kept in order across streams: the batch is written out when the stream changes.
+                std::ostream* const nodeOut = &LogStreamConsumer::severityOstream(node->severity);
+                if (nodeOut != out || batch.size() >= kMAX_BATCH_SIZE)
+                {
+                    writeBatch();
+                    out = nodeOut;
+                }
+                formatter.append(batch, node->severity, node->time, node->text);
+                node->text = std::string{};
+            }
+            writeBatch();
+            if (nbWritten > 0)
+            {
+                mWritten.fetch_add(nbWritten, std::memory_order_release);
+                mWritten.notify_all();
+            }
+            else
+            {
+                mPushed.wait(pushed, std::memory_order_acquire);
+            }
+        }
+    }
+
+    static constexpr size_t kMAX_BATCH_SIZE{1 << 16};
+
+    std::mutex mControlMutex;      //!< Serializes start() and stop().
+    std::mutex mSyncMutex;         //!< Serializes lines written synchronously while the writer is not running.
+    std::atomic<bool> mRunning{false};
+    std::atomic<int32_t> mProducers{0}; //!< Threads between checking mRunning and enqueueing a line.
+    std::atomic<uint64_t> mPushed{0};
+    std::atomic<uint64_t> mWritten{0};
+    std::atomic<LogNode*> mHead{nullptr};
+    LogNode* mTail{nullptr};
+    std::thread mWriter;
+};
+
+AsyncLogState& asyncLogState()
+{
+    static AsyncLogState state;
+    return state;
+}
+
+//! std::ostream over a line buffer of the calling thread that queues every line it is flushed with.
+class ThreadLogStream
+{
+public:
+    ThreadLogStream(Severity severity)
+        : mBuffer(severity)
+    {
+    }
+
+    std::ostream& stream()
+    {
+        return mStream;
+    }
+
+private:
+    class LineBuffer : public std::stringbuf
+    {
+    public:
+        explicit LineBuffer(Severity severity)
+            : mSeverity(severity)
+        {
+        }
+
+        ~LineBuffer() override
+        {
+            // A line the thread did not end before exiting.
+            if (pbase() != pptr())
+            {
+                sync();
+            }
+        }
+
+        int32_t sync() override
+        {
+            AsyncLogWriter::push(mSeverity, str());
+            str("");
+            return 0;
+        }
+
+    private:
+        Severity mSeverity;
+    };
+
+    LineBuffer mBuffer;
+    std::ostream mStream{&mBuffer};
+};
+} // namespace
+
+void AsyncLogWriter::start()
+{
+    auto& state = asyncLogState();
+    std::lock_guard<std::mutex> guard(state.mControlMutex);
+    if (state.mRunning.load())
+    {
+        return;
+    }
+    auto* const stub = new LogNode;
+    state.mHead.store(stub);
+    state.mTail = stub;
+    state.mWriter = std::thread([&state]() { state.writerLoop(); });
+    state.mRunning.store(true);
+
+    // The state was constructed before the handler is registered, so it outlives the handler.
+    static bool const registered = std::atexit([]() { AsyncLogWriter::stop(); }) == 0;
+    static_cast<void>(registered);
+}
+
+void AsyncLogWriter::stop()
+{
+    auto& state = asyncLogState();
+    std::lock_guard<std::mutex> guard(state.mControlMutex);
+    if (!state.mRunning.load())
+    {
+        return;
+    }
+    // New lines are written synchronously from now on; wait for the lines that were being queued meanwhile.
+    state.mRunning.store(false);
+    while (state.mProducers.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+    auto* const last = new LogNode;
+    last->stop = true;
+    state.enqueue(last);
+    state.mWriter.join();
+    delete state.mTail;
+    state.mTail = nullptr;
+    state.mHead.store(nullptr);
+}
+
+void AsyncLogWriter::flush()
+{
+    auto& state = asyncLogState();
+    if (state.mRunning.load())
+    {
+        uint64_t const pushed = state.mPushed.load(std::memory_order_acquire);
+        uint64_t written = state.mWritten.load(std::memory_order_acquire);
+        while (written < pushed)
+        {
+            state.mWritten.wait(written, std::memory_order_acquire);
+            written = state.mWritten.load(std::memory_order_acquire);
+        }
+    }
+    std::cout.flush();
+    std::cerr.flush();
+}
+
+bool AsyncLogWriter::isRunning() noexcept
+{
+    return asyncLogState().mRunning.load(std::memory_order_acquire);
+}
+
+std::ostream* AsyncLogWriter::threadStream(Severity severity)
+{
+    if (!isRunning())
+    {
+        return nullptr;
+    }
+    thread_local ThreadLogStream streams[]{Severity::kINTERNAL_ERROR, Severity::kERROR, Severity::kWARNING,
+        Severity::kINFO, Severity::kVERBOSE};
+    return &streams[static_cast<int32_t>(severity)].stream();
+}
+
+void AsyncLogWriter::push(Severity severity, std::string&& text)
+{
+    auto& state = asyncLogState();
+    state.mProducers.fetch_add(1);
+    if (!state.mRunning.load())
+    {
+        state.mProducers.fetch_sub(1);
+        std::lock_guard<std::mutex> guard(state.mSyncMutex);
+        std::string line;
+        LineFormatter{}.append(line, severity, std::time(nullptr), text);
+        auto& out = LogStreamConsumer::severityOstream(severity);
+        out << line;
+        out.flush();
+        return;
+    }
+    auto* const node = new LogNode;
+    node->severity = severity;
+    node->time = std::time(nullptr);
+    node->text = std::move(text);
+    state.enqueue(node);
+    state.mProducers.fetch_sub(1);
+
+    // Errors may be followed by the process going down; make sure they are out before returning.
+    if (severity <= Severity::kERROR)
+    {
+        flush();
+    }
+}
+
 void setReportableSeverity(Logger::Severity severity)
 {
     gLogger.setReportableSeverity(severity);
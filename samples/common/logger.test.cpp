@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "logger.h"
+#include "logging.h"
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sample;
+
+namespace
+{
+//! Runs the asynchronous writer with std::cout redirected to a string for the lifetime of the object.
+class CapturedAsyncLog
+{
+public:
+    CapturedAsyncLog()
+        : mPrevious(std::cout.rdbuf(mCaptured.rdbuf()))
+    {
+        AsyncLogWriter::start();
+    }
+
+    ~CapturedAsyncLog()
+    {
+        AsyncLogWriter::stop();
+        std::cout.rdbuf(mPrevious);
+    }
+
+    //! Stop the writer and return the text of every info line, without timestamp and severity prefix.
+    std::vector<std::string> stopAndGetLines()
+    {
+        AsyncLogWriter::stop();
+        std::vector<std::string> lines;
+        std::istringstream is(mCaptured.str());
+        for (std::string line; std::getline(is, line);)
+        {
+            auto const prefix = line.find("[I] ");
+            lines.push_back(prefix == std::string::npos ? line : line.substr(prefix + 4));
+        }
+        return lines;
+    }
+
+private:
+    std::ostringstream mCaptured;
+    std::streambuf* mPrevious;
+};
+} // namespace
+
+TEST(AsyncLogWriter, KeepsLinesOfEachThreadInOrder)
+{
+    int32_t constexpr kTHREADS{4};
+    int32_t constexpr kLINES{500};
+    CapturedAsyncLog capture;
+    std::vector<std::thread> producers;
+    for (int32_t t = 0; t < kTHREADS; ++t)
+    {
+        producers.emplace_back([t] {
+            for (int32_t i = 0; i < kLINES; ++i)
+            {
+                // Producer 0 also writes through std::ostream&, like code that takes the logger as a plain stream.
+                if (t == 0 && i % 2 == 1)
+                {
+                    std::ostream& os = gLogInfo;
+                    os << t << " " << i << std::endl;
+                }
+                else
+                {
+                    gLogInfo << t << " " << i << std::endl;
+                }
+            }
+        });
+    }
+    for (auto& p : producers)
+    {
+        p.join();
+    }
+
+    std::vector<int32_t> next(kTHREADS, 0);
+    for (auto const& line : capture.stopAndGetLines())
+    {
+        std::istringstream is(line);
+        int32_t t{-1};
+        int32_t i{-1};
+        is >> t >> i;
+        ASSERT_TRUE(t >= 0 && t < kTHREADS) << line;
+        EXPECT_EQ(i, next[t]) << line;
+        next[t] = i + 1;
+    }
+    EXPECT_EQ(next, std::vector<int32_t>(kTHREADS, kLINES));
+}
+
+TEST(AsyncLogWriter, DrainsQueueOnStop)
+{
+    int32_t constexpr kLINES{20000};
+    CapturedAsyncLog capture;
+    for (int32_t i = 0; i < kLINES; ++i)
+    {
+        gLogInfo << "line " << i << std::endl;
+    }
+    auto const lines = capture.stopAndGetLines();
+    ASSERT_EQ(lines.size(), static_cast<size_t>(kLINES));
+    for (int32_t i = 0; i < kLINES; ++i)
+    {
+        EXPECT_EQ(lines[i], "line " + std::to_string(i));
+    }
+    EXPECT_FALSE(AsyncLogWriter::isRunning());
+}
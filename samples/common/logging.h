@@ -35,13 +35,47 @@ namespace sample
 
 using Severity = nvinfer1::ILogger::Severity;
 
+//!
+//! \class AsyncLogWriter
+//! \brief Optional background writer for the messages of LogStreamConsumer and Logger::log.
+//!
+//! While it runs, every thread formats its messages into a line buffer of its own, without taking a lock, and hands
+//! complete lines to a single writer thread through a lock-free multi-producer queue. The writer timestamps the lines
+//! and writes them in batches, flushing each output stream once per batch instead of once per line.
+//!
+//! Errors are written before the logging call returns, and the lines still queued are written when the writer is
+//! stopped, which also happens at exit.
+//!
+class AsyncLogWriter
+{
+public:
+    //! Start the writer thread. Does nothing if it is already running.
+    static void start();
+
+    //! Write the queued lines and stop the writer thread. Later messages are written synchronously again.
+    static void stop();
+
+    //! Wait until every line queued so far has been written and flushed.
+    static void flush();
+
+    static bool isRunning() noexcept;
+
+    //! The line buffer of the calling thread for messages of the given severity, or nullptr if the writer is not
+    //! running. Every line is queued when the stream is flushed, e.g. by std::endl.
+    static std::ostream* threadStream(Severity severity);
+
+    //! Queue one line, including its trailing newline. It is written synchronously if the writer is not running.
+    static void push(Severity severity, std::string&& text);
+};
+
 class LogStreamConsumerBuffer : public std::stringbuf
 {
 public:
-    LogStreamConsumerBuffer(std::ostream& stream, const std::string& prefix, bool shouldLog)
+    LogStreamConsumerBuffer(std::ostream& stream, const std::string& prefix, bool shouldLog, Severity severity)
         : mOutput(stream)
         , mPrefix(prefix)
         , mShouldLog(shouldLog)
+        , mSeverity(severity)
     {
     }
 
@@ -49,6 +83,7 @@ public:
         : mOutput(other.mOutput)
         , mPrefix(other.mPrefix)
         , mShouldLog(other.mShouldLog)
+        , mSeverity(other.mSeverity)
     {
     }
     LogStreamConsumerBuffer(const LogStreamConsumerBuffer& other) = delete;
@@ -81,6 +116,17 @@ public:
 
     void putOutput()
     {
+        // Code that writes to the consumer as a std::ostream& ends up here rather than in LogStreamConsumer::write().
+        // Queue its lines too while the asynchronous writer runs, so that they stay in order with the queued ones.
+        if (mShouldLog && AsyncLogWriter::isRunning())
+        {
+            if (pbase() != pptr())
+            {
+                AsyncLogWriter::push(mSeverity, str());
+                str("");
+            }
+            return;
+        }
         if (mShouldLog)
         {
             // prepend timestamp
@@ -112,6 +158,7 @@ private:
     std::ostream& mOutput;
     std::string mPrefix;
     bool mShouldLog{};
+    Severity mSeverity;
 }; // class LogStreamConsumerBuffer
 
 //!
@@ -121,8 +168,8 @@ private:
 class LogStreamConsumerBase
 {
 public:
-    LogStreamConsumerBase(std::ostream& stream, const std::string& prefix, bool shouldLog)
-        : mBuffer(stream, prefix, shouldLog)
+    LogStreamConsumerBase(std::ostream& stream, const std::string& prefix, bool shouldLog, Severity severity)
+        : mBuffer(stream, prefix, shouldLog, severity)
     {
     }
 
@@ -148,7 +195,8 @@ public:
     //!  Reportable severity determines if the messages are severe enough to be logged.
     //!
     LogStreamConsumer(nvinfer1::ILogger::Severity reportableSeverity, nvinfer1::ILogger::Severity severity)
-        : LogStreamConsumerBase(severityOstream(severity), severityPrefix(severity), severity <= reportableSeverity)
+        : LogStreamConsumerBase(
+            severityOstream(severity), severityPrefix(severity), severity <= reportableSeverity, severity)
         , std::ostream(&mBuffer) // links the stream buffer with the stream
         , mShouldLog(severity <= reportableSeverity)
         , mSeverity(severity)
@@ -156,7 +204,8 @@ public:
     }
 
     LogStreamConsumer(LogStreamConsumer&& other) noexcept
-        : LogStreamConsumerBase(severityOstream(other.mSeverity), severityPrefix(other.mSeverity), other.mShouldLog)
+        : LogStreamConsumerBase(
+            severityOstream(other.mSeverity), severityPrefix(other.mSeverity), other.mShouldLog, other.mSeverity)
         , std::ostream(&mBuffer) // links the stream buffer with the stream
         , mShouldLog(other.mShouldLog)
         , mSeverity(other.mSeverity)
@@ -184,7 +233,31 @@ public:
         return mShouldLog;
     }
 
-private:
+    Severity getSeverity() const
+    {
+        return mSeverity;
+    }
+
+    //!
+    //! \brief Run fn on the stream a message should be formatted into, if it should be logged: the line buffer of the
+    //!  calling thread when the asynchronous writer is running, otherwise the buffer of this consumer, under its mutex.
+    //!
+    template <typename Fn>
+    void write(Fn&& fn)
+    {
+        if (!mShouldLog)
+        {
+            return;
+        }
+        if (std::ostream* os = AsyncLogWriter::threadStream(mSeverity))
+        {
+            fn(*os);
+            return;
+        }
+        std::lock_guard<std::mutex> guard(mLogMutex);
+        fn(static_cast<std::ostream&>(*this));
+    }
+
     static std::ostream& severityOstream(Severity severity)
     {
         return severity >= Severity::kINFO ? std::cout : std::cerr;
@@ -203,6 +276,7 @@ private:
         }
     }
 
+private:
     bool mShouldLog;
     Severity mSeverity;
 }; // class LogStreamConsumer
@@ -210,12 +284,7 @@ private:
 template <typename T>
 LogStreamConsumer& operator<<(LogStreamConsumer& logger, const T& obj)
 {
-    if (logger.getShouldLog())
-    {
-        std::lock_guard<std::mutex> guard(logger.getMutex());
-        auto& os = static_cast<std::ostream&>(logger);
-        os << obj;
-    }
+    logger.write([&obj](std::ostream& os) { os << obj; });
     return logger;
 }
 
@@ -224,38 +293,25 @@ LogStreamConsumer& operator<<(LogStreamConsumer& logger, const T& obj)
 //!
 inline LogStreamConsumer& operator<<(LogStreamConsumer& logger, std::ostream& (*f)(std::ostream&) )
 {
-    if (logger.getShouldLog())
-    {
-        std::lock_guard<std::mutex> guard(logger.getMutex());
-        auto& os = static_cast<std::ostream&>(logger);
-        os << f;
-    }
+    logger.write([f](std::ostream& os) { os << f; });
     return logger;
 }
 
 inline LogStreamConsumer& operator<<(LogStreamConsumer& logger, const nvinfer1::Dims& dims)
 {
-    if (logger.getShouldLog())
-    {
-        std::lock_guard<std::mutex> guard(logger.getMutex());
-        auto& os = static_cast<std::ostream&>(logger);
+    logger.write([&dims](std::ostream& os) {
         for (int32_t i = 0; i < dims.nbDims; ++i)
         {
             os << (i ? "x" : "") << dims.d[i];
         }
-    }
+    });
     return logger;
 }
 
 template <typename First, typename Second>
 inline LogStreamConsumer& operator<<(LogStreamConsumer& logger, const std::pair<First, Second>& value)
 {
-    if (logger.getShouldLog())
-    {
-        std::lock_guard<std::mutex> guard(logger.getMutex());
-        auto& os = static_cast<std::ostream&>(logger);
-        os << "(" << value.first << ", " << value.second << ")";
-    }
+    logger.write([&value](std::ostream& os) { os << "(" << value.first << ", " << value.second << ")"; });
     return logger;
 }
 
@@ -327,7 +383,16 @@ public:
     //!
     void log(Severity severity, const char* msg) noexcept override
     {
-        LogStreamConsumer(mReportableSeverity, severity) << "[TRT] " << std::string(msg) << std::endl;
+        if (severity > mReportableSeverity)
+        {
+            return;
+        }
+        if (AsyncLogWriter::isRunning())
+        {
+            AsyncLogWriter::push(severity, std::string("[TRT] ") + msg + '\n');
+            return;
+        }
+        LogStreamConsumer(mReportableSeverity, severity) << "[TRT] " << msg << std::endl;
     }
 
     //!
@@ -568,6 +633,7 @@ private:
     static void reportTaskWithBuildRoute(
         TestResult result, std::string const& index, std::string const& buildRoute, bool blankBefore, bool blankAfter)
     {
+        AsyncLogWriter::flush();
         auto& os = severityOstream(Severity::kINFO);
         if (blankBefore)
         {
@@ -594,6 +660,7 @@ private:
     //!
     static void reportTestResult(TestAtom const& testAtom, TestResult result)
     {
+        AsyncLogWriter::flush();
         severityOstream(Severity::kINFO) << "&&&& " << testResultString(result) << " " << testAtom.mName << " # "
                                          << testAtom.mCmdline << std::endl;
     }
@@ -20,6 +20,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <cuda.h>
 #include <cuda_runtime.h>
 #include <iostream>
@@ -518,6 +519,88 @@ private:
     TrtDeviceBuffer mDeviceBuffer;
 }; // class DiscreteMirroredBuffer
 
+//!
+//! Class to mirror the content of an input file on the device. The host side is the read-only FileContent shared by
+//! every buffer loaded from the same file, so that host memory does not grow with the number of streams; only the
+//! device buffer is allocated per buffer. The content should be pinned for the copies to the device to be
+//! asynchronous.
+//!
+//! The host buffer is only writable once it has been made private: getHostBuffer() and deviceToHost() copy the
+//! content to a buffer owned by this object first, after which it behaves like a DiscreteMirroredBuffer until the
+//! next setContent().
+//!
+class FileMirroredBuffer : public IMirroredBuffer
+{
+public:
+    void allocate(size_t size) override
+    {
+        mSize = size;
+        mDeviceBuffer.allocate(size);
+        if (mHostBuffer.get() != nullptr)
+        {
+            mHostBuffer.allocate(size);
+        }
+    }
+
+    //! Use content as the host side. content must hold at least getSize() bytes.
+    void setContent(std::shared_ptr<FileContent const> content)
+    {
+        ASSERT(content && content->size() >= mSize);
+        // A copy from the current content may still be in flight; it is released on the next call.
+        mPreviousContent = std::move(mContent);
+        mContent = std::move(content);
+    }
+
+    void* getDeviceBuffer() const override
+    {
+        return mDeviceBuffer.get();
+    }
+
+    void* getHostBuffer() const override
+    {
+        makePrivate();
+        return mHostBuffer.get();
+    }
+
+    void hostToDevice(TrtCudaStream& stream) override
+    {
+        void const* src = mContent ? mContent->data() : mHostBuffer.get();
+        CHECK(cudaMemcpyAsync(mDeviceBuffer.get(), src, mSize, cudaMemcpyHostToDevice, stream.get()));
+    }
+
+    void deviceToHost(TrtCudaStream& stream) override
+    {
+        makePrivate();
+        CHECK(cudaMemcpyAsync(mHostBuffer.get(), mDeviceBuffer.get(), mSize, cudaMemcpyDeviceToHost, stream.get()));
+    }
+
+    size_t getSize() const override
+    {
+        return mSize;
+    }
+
+private:
+    void makePrivate() const
+    {
+        if (mHostBuffer.get() == nullptr)
+        {
+            mHostBuffer.allocate(mSize);
+        }
+        if (mContent)
+        {
+            std::memcpy(mHostBuffer.get(), mContent->data(), mSize);
+            mPreviousContent = std::move(mContent);
+            mContent.reset();
+        }
+    }
+
+    size_t mSize{0};
+    mutable std::shared_ptr<FileContent const> mContent;
+    mutable std::shared_ptr<FileContent const> mPreviousContent;
+    mutable TrtHostBuffer mHostBuffer;
+    TrtDeviceBuffer mDeviceBuffer;
+}; // class FileMirroredBuffer
+
 //!
 //! Class to have a unified memory buffer for embedded devices.
 //!
@@ -1003,10 +1003,12 @@ bool loadStreamingEngineToBuildEnv(std::string const& filepath, BuildEnvironment
     return true;
 }
 
-bool loadAsyncStreamingEngineToBuildEnv(std::string const& filepath, BuildEnvironment& env, std::ostream& err)
+bool loadAsyncStreamingEngineToBuildEnv(
+    std::string const& filepath, BuildEnvironment& env, std::ostream& err, bool directIO)
 {
     auto& asyncReader = env.engine.getAsyncFileReader();
-    SMP_RETVAL_IF_FALSE(asyncReader.open(filepath), "", false, err << "Error opening engine file: " << filepath);
+    SMP_RETVAL_IF_FALSE(
+        asyncReader.open(filepath, directIO), "", false, err << "Error opening engine file: " << filepath);
     return true;
 }
 
@@ -1157,7 +1159,8 @@ bool getEngineBuildEnv(
         {
             if (build.asyncFileReader)
             {
-                createEngineSuccess = loadAsyncStreamingEngineToBuildEnv(build.engine, env, err);
+                createEngineSuccess
+                    = loadAsyncStreamingEngineToBuildEnv(build.engine, env, err, build.asyncFileReaderDirectIO);
             }
             else
             {
@@ -1191,7 +1194,8 @@ bool getEngineBuildEnv(
             env.engine.releaseBlob();
             if (build.asyncFileReader)
             {
-                SMP_RETVAL_IF_FALSE(loadAsyncStreamingEngineToBuildEnv(build.engine, env, err),
+                SMP_RETVAL_IF_FALSE(
+                    loadAsyncStreamingEngineToBuildEnv(build.engine, env, err, build.asyncFileReaderDirectIO),
                     "Reading engine file via async stream reader failed.", false, err);
             }
             else
@@ -23,6 +23,7 @@
 #include <optional>
 #include <cuda_profiler_api.h>
 #include <functional>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <memory>
@@ -534,7 +535,7 @@ bool setUpSafeInference(InferenceEnvironmentSafe& iEnv, InferenceOptions const&
 
         safeGraph->clone(clonedGraph, *gSafeRecorder); // return errorcode
         iEnv.mClonedGraphs.emplace_back(clonedGraph);
-        iEnv.bindings.emplace_back(std::make_unique<BindingsSafe>(useManagedMemory));
+        iEnv.bindings.emplace_back(std::make_unique<BindingsSafe>(useManagedMemory, inference.inputSeed));
         iEnv.mAuxStreamsDeleters.push_back(samplesSafeCommon::setUpAuxStreamsOn(*clonedGraph, *gSafeRecorder));
     }
 
@@ -724,7 +725,7 @@ bool setUpStdInference(InferenceEnvironmentStd& iEnv, InferenceOptions const& in
             return false;
         }
         iEnv.contexts.emplace_back(ec);
-        iEnv.bindings.emplace_back(std::make_unique<BindingsStd>(useManagedMemory));
+        iEnv.bindings.emplace_back(std::make_unique<BindingsStd>(useManagedMemory, inference.inputSeed));
     }
 
     if (iEnv.profiler)
@@ -853,8 +854,8 @@ bool setUpStdInference(InferenceEnvironmentStd& iEnv, InferenceOptions const& in
     // Create Debug Listener and turn on debug states if client requested dumping debug tensors.
     if (!inference.debugTensorFileNames.empty() || !inference.dumpAlldebugTensorFormats.empty())
     {
-        iEnv.listener = std::make_unique<DebugTensorWriter>(
-            inference.debugTensorFileNames, inference.dumpAlldebugTensorFormats, engine->getName(), iEnv.cmdline);
+        iEnv.listener = std::make_unique<DebugTensorWriter>(inference.debugTensorFileNames,
+            inference.dumpAlldebugTensorFormats, engine->getName(), iEnv.cmdline, inference.debugTensorMemoryLimit);
         iEnv.contexts.front()->setDebugListener(iEnv.listener.get());
         for (auto const& s : inference.debugTensorFileNames)
         {
@@ -1438,18 +1439,36 @@ private:
 };
 #endif
 
-// Helper template function to validate accuracy - abstracts tensor info retrieval
-// Note: This function is placed here (before inferenceLoop) because inferenceLoop is a template
-// that calls validateAccuracy, and templates require definitions to be visible at instantiation.
-template <typename TensorInfoGetter>
-std::unordered_map<std::string, double> validateAccuracy(InferenceEnvironmentBase& iEnv, BindingsBase const& bindings,
-    int64_t pairIndex, TensorInfoGetter getTensorInfo, InferenceOptions const& inference)
+//!
+//! \brief Compare an output buffer with its reference in place using the selected accuracy algorithm.
+//!
+template <typename T>
+double computeAccuracy(void const* actual, void const* reference, int64_t volume, InferenceOptions const& inference)
+{
+    auto validator = createAccuracyValidator<T>(inference.accuracyValidationAlgorithm, inference.atol, inference.rtol);
+    return validator->calculateAccuracy(StridedView<T>(static_cast<T const*>(actual), volume),
+        StridedView<T>(static_cast<T const*>(reference), volume));
+}
+
+//!
+//! \brief Host copy of the outputs of one reference pair, so that they can be validated while the next pair runs.
+//!
+struct OutputSnapshot
+{
+    struct Tensor
+    {
+        std::vector<char> data;
+        nvinfer1::Dims dims{};
+        nvinfer1::DataType dataType{};
+    };
+    std::unordered_map<std::string, Tensor> tensors;
+};
+
+//! Whether reference outputs were loaded for pairIndex.
+bool hasRefOutputs(InferenceEnvironmentBase const& iEnv, int64_t pairIndex)
 {
-    std::unordered_map<std::string, double> accuracyResults;
-    // Accuracy validation with reference outputs is not supported on Windows or RTX (tuner is Linux enterprise-only).
 #if defined(_WIN32)
-    // Early return if no reference outputs are available for validation.
-    return accuracyResults;
+    return false;
 #else
     // The checks are ordered to ensure safe array access:
     // 1. First check if refOutputsAll vector is empty
@@ -1472,7 +1491,24 @@ std::unordered_map<std::string, double> validateAccuracy(InferenceEnvironmentBas
         {
             sample::gLogVerbose << "iEnv.refOutputsAll[pairIndex].empty():" << isPairEmpty << std::endl;
         }
-        return accuracyResults;
+        return false;
+    }
+    return true;
+#endif // defined(_WIN32)
+}
+
+// Helper template function to copy the outputs to validate - abstracts tensor info retrieval
+// Note: This function is placed here (before inferenceLoop) because inferenceLoop is a template
+// that calls takeOutputSnapshot, and templates require definitions to be visible at instantiation.
+template <typename TensorInfoGetter>
+OutputSnapshot takeOutputSnapshot(
+    InferenceEnvironmentBase const& iEnv, BindingsBase const& bindings, int64_t pairIndex, TensorInfoGetter getTensorInfo)
+{
+    OutputSnapshot snapshot;
+#if !defined(_WIN32)
+    if (!hasRefOutputs(iEnv, pairIndex))
+    {
+        return snapshot;
     }
 
     auto const outputBindings = bindings.getOutputBindings();
@@ -1480,7 +1516,6 @@ std::unordered_map<std::string, double> validateAccuracy(InferenceEnvironmentBas
     for (auto const& refOutput : iEnv.refOutputsAll[pairIndex])
     {
         std::string const& tensorName = refOutput.first;
-        auto const* refBuffer = refOutput.second.get();
 
         // Find the binding for this tensor
         auto it = outputBindings.find(tensorName);
@@ -1506,9 +1541,52 @@ std::unordered_map<std::string, double> validateAccuracy(InferenceEnvironmentBas
         }
 
         // Get tensor info using the provided getter
-        nvinfer1::Dims dims;
-        nvinfer1::DataType dataType;
-        getTensorInfo(tensorName.c_str(), dims, dataType);
+        auto& tensor = snapshot.tensors[tensorName];
+        getTensorInfo(tensorName.c_str(), tensor.dims, tensor.dataType);
+
+        int64_t const volume
+            = std::accumulate(tensor.dims.d, tensor.dims.d + tensor.dims.nbDims, 1LL, std::multiplies<int64_t>{});
+        auto const* begin = static_cast<char const*>(actualBuffer);
+        tensor.data.assign(begin, begin + samplesCommon::getNbBytes(tensor.dataType, volume));
+    }
+#endif // !defined(_WIN32)
+    return snapshot;
+}
+
+//!
+//! \brief Validate the outputs of a reference pair against its reference outputs.
+//!
+//! Only reads the snapshot and the reference outputs, so it can run on another thread than the inference loop.
+//! Updates iEnv.accuracyFailed.
+//!
+std::unordered_map<std::string, double> validateAccuracy(InferenceEnvironmentBase& iEnv,
+    OutputSnapshot const& snapshot, int64_t pairIndex, InferenceOptions const& inference)
+{
+    std::unordered_map<std::string, double> accuracyResults;
+    // Accuracy validation with reference outputs is not supported on Windows or RTX (tuner is Linux enterprise-only).
+#if defined(_WIN32)
+    // Early return if no reference outputs are available for validation.
+    return accuracyResults;
+#else
+    // An empty snapshot means there is nothing to validate; takeOutputSnapshot() has logged why.
+    if (snapshot.tensors.empty())
+    {
+        return accuracyResults;
+    }
+
+    for (auto const& refOutput : iEnv.refOutputsAll[pairIndex])
+    {
+        std::string const& tensorName = refOutput.first;
+        auto const* refBuffer = refOutput.second.get();
+
+        auto const it = snapshot.tensors.find(tensorName);
+        if (it == snapshot.tensors.end())
+        {
+            continue; // Not an output binding, see takeOutputSnapshot().
+        }
+        void const* actualBuffer = it->second.data.data();
+        nvinfer1::Dims const& dims = it->second.dims;
+        nvinfer1::DataType const dataType = it->second.dataType;
 
         int64_t const volume = std::accumulate(dims.d, dims.d + dims.nbDims, 1LL, std::multiplies<int64_t>{});
 
@@ -1518,53 +1596,25 @@ std::unordered_map<std::string, double> validateAccuracy(InferenceEnvironmentBas
         switch (dataType)
         {
         case nvinfer1::DataType::kFLOAT:
-        {
-            std::vector<float> actual(static_cast<float*>(actualBuffer), static_cast<float*>(actualBuffer) + volume);
-            std::vector<float> reference(
-                static_cast<float const*>(refBuffer->get()), static_cast<float const*>(refBuffer->get()) + volume);
-            auto validator
-                = createAccuracyValidator<float>(inference.accuracyValidationAlgorithm, inference.atol, inference.rtol);
-            accuracy = validator->calculateAccuracy(actual, reference);
+            accuracy = computeAccuracy<float>(actualBuffer, refBuffer->data(), volume, inference);
             break;
-        }
         case nvinfer1::DataType::kHALF:
-        {
-            // Convert half to float for comparison
-            auto const* actualHalf = static_cast<half_float::half const*>(actualBuffer);
-            auto const* refHalf = static_cast<half_float::half const*>(refBuffer->get());
-            std::vector<float> actual(volume);
-            std::vector<float> reference(volume);
-            for (int64_t i = 0; i < volume; ++i)
-            {
-                actual[i] = static_cast<float>(actualHalf[i]);
-                reference[i] = static_cast<float>(refHalf[i]);
-            }
-            auto validator
-                = createAccuracyValidator<float>(inference.accuracyValidationAlgorithm, inference.atol, inference.rtol);
-            accuracy = validator->calculateAccuracy(actual, reference);
+            accuracy = computeAccuracy<half_float::half>(actualBuffer, refBuffer->data(), volume, inference);
             break;
-        }
+        case nvinfer1::DataType::kBF16:
+            accuracy = computeAccuracy<BFloat16>(actualBuffer, refBuffer->data(), volume, inference);
+            break;
+#if CUDA_VERSION >= 11060
+        case nvinfer1::DataType::kFP8:
+            accuracy = computeAccuracy<__nv_fp8_e4m3>(actualBuffer, refBuffer->data(), volume, inference);
+            break;
+#endif
         case nvinfer1::DataType::kINT32:
-        {
-            std::vector<int32_t> actual(
-                static_cast<int32_t*>(actualBuffer), static_cast<int32_t*>(actualBuffer) + volume);
-            std::vector<int32_t> reference(
-                static_cast<int32_t const*>(refBuffer->get()), static_cast<int32_t const*>(refBuffer->get()) + volume);
-            auto validator = createAccuracyValidator<int32_t>(
-                inference.accuracyValidationAlgorithm, inference.atol, inference.rtol);
-            accuracy = validator->calculateAccuracy(actual, reference);
+            accuracy = computeAccuracy<int32_t>(actualBuffer, refBuffer->data(), volume, inference);
             break;
-        }
         case nvinfer1::DataType::kINT8:
-        {
-            std::vector<int8_t> actual(static_cast<int8_t*>(actualBuffer), static_cast<int8_t*>(actualBuffer) + volume);
-            std::vector<int8_t> reference(
-                static_cast<int8_t const*>(refBuffer->get()), static_cast<int8_t const*>(refBuffer->get()) + volume);
-            auto validator = createAccuracyValidator<int8_t>(
-                inference.accuracyValidationAlgorithm, inference.atol, inference.rtol);
-            accuracy = validator->calculateAccuracy(actual, reference);
+            accuracy = computeAccuracy<int8_t>(actualBuffer, refBuffer->data(), volume, inference);
             break;
-        }
         default:
             sample::gLogWarning << "Unsupported data type for accuracy validation: " << static_cast<int>(dataType)
                                 << std::endl;
@@ -1589,6 +1639,9 @@ std::unordered_map<std::string, double> validateAccuracy(InferenceEnvironmentBas
 #endif // !(defined(_WIN32) || TRT_WINML)
 }
 
+//! Number of reference pairs whose inputs are loaded ahead of the one being run.
+constexpr int32_t kREF_PAIR_PREFETCH_DEPTH{4};
+
 //!
 //! \brief Run the inference loop with optional accuracy validation.
 //! \tparam TensorInfoGetter Callable type for retrieving tensor info (dims, dataType) by name.
@@ -1624,6 +1677,58 @@ bool inferenceLoop(std::vector<std::unique_ptr<IterationBase>>& iStreams, TimePo
     float durationMs = 0;
     int32_t skip = 0;
 
+    // Hand completed traces to the streaming recorder, dropping them afterwards unless the full trace is wanted.
+    InferenceTimeRecorder* const recorder = iEnv.timeRecorder.get();
+    size_t recorded = 0;
+    // --tuningPruneAboveMs: test the compute times after warmup before the recorder may drop them.
+    TimingPruner pruner(inference.pruneAboveMs);
+    size_t pruneChecked = 0;
+    auto const checkPrune = [&]() {
+        for (; pruneChecked < trace.size(); ++pruneChecked)
+        {
+            auto const& t = trace[pruneChecked];
+            if (t.computeStart >= warmupMs && pruner.add(t.computeEnd - t.computeStart))
+            {
+                iEnv.pruned = true;
+            }
+        }
+        return iEnv.pruned.load();
+    };
+    auto const flushTrace = [&]() {
+        if (recorder == nullptr)
+        {
+            return;
+        }
+        for (; recorded < trace.size(); ++recorded)
+        {
+            recorder->record(trace[recorded]);
+        }
+        if (!recorder->keepTraces())
+        {
+            trace.clear();
+            recorded = 0;
+            pruneChecked = 0;
+        }
+    };
+
+    // Load the inputs of the next reference pairs while the current one runs; those of pair 0 are already loaded.
+    std::optional<RefPairPrefetcher> prefetcher;
+    if (numRefPairs > 1)
+    {
+        prefetcher.emplace(inference.refPairs, kREF_PAIR_PREFETCH_DEPTH);
+    }
+    // The outputs of a pair are validated on a copy while the next pair runs; results are merged in pair order.
+    std::future<std::unordered_map<std::string, double>> validation;
+    auto const finishValidation = [&]() {
+        if (validation.valid())
+        {
+            for (auto const& [name, value] : validation.get())
+            {
+                iEnv.accuracyLossValues[name] = value;
+            }
+        }
+    };
+
     if (maxDurationMs == -1.F)
     {
         sample::gLogWarning << "--duration=-1 is specified, inference will run in an endless loop until"
@@ -1638,6 +1743,7 @@ bool inferenceLoop(std::vector<std::unique_ptr<IterationBase>>& iStreams, TimePo
             {
                 s->sync(cpuStart, gpuStart, trace, includeTransfers);
             }
+            flushTrace();
         }
     }
 
@@ -1650,6 +1756,10 @@ bool inferenceLoop(std::vector<std::unique_ptr<IterationBase>>& iStreams, TimePo
         // Before each refPair iteration, load input data (including i=0 for consistency)
         if (i < numRefPairs)
         {
+            if (prefetcher)
+            {
+                prefetcher->acquire(i);
+            }
             bindings.fillInputsFromMap(inference.refPairs[i].first);
         }
 
@@ -1664,6 +1774,13 @@ bool inferenceLoop(std::vector<std::unique_ptr<IterationBase>>& iStreams, TimePo
         {
             durationMs = std::max(durationMs, s->sync(cpuStart, gpuStart, trace, currentIncludeTransfers));
         }
+        // Never stop before the accuracy of every reference pair has been validated.
+        bool const prune = pruner.isEnabled() && i >= numRefPairs && checkPrune();
+        flushTrace();
+        if (prune)
+        {
+            break;
+        }
 
         // Validate accuracy for refPair iterations (runs for first numRefPairs iterations)
         // This must happen BEFORE the warmup check to ensure validation is not skipped
@@ -1674,11 +1791,15 @@ bool inferenceLoop(std::vector<std::unique_ptr<IterationBase>>& iStreams, TimePo
             {
                 s->fetchOutputData(true);
             }
-            auto results = validateAccuracy(iEnv, bindings, i, getTensorInfo, inference);
+            // Copy the outputs before the next pair overwrites them, then validate them in the background.
+            auto snapshot = takeOutputSnapshot(iEnv, bindings, i, getTensorInfo);
             // Merge per-tensor accuracy values into iEnv for the tuning cache
-            for (auto const& [name, value] : results)
+            finishValidation();
+            if (!snapshot.tensors.empty())
             {
-                iEnv.accuracyLossValues[name] = value;
+                validation = std::async(std::launch::async, [&iEnv, &inference, i, snapshot = std::move(snapshot)]() {
+                    return validateAccuracy(iEnv, snapshot, i, inference);
+                });
             }
         }
 
@@ -1697,10 +1818,12 @@ bool inferenceLoop(std::vector<std::unique_ptr<IterationBase>>& iStreams, TimePo
         }
     }
 
+    finishValidation();
     for (auto& s : iStreams)
     {
         s->syncAll(cpuStart, gpuStart, trace, includeTransfers);
     }
+    flushTrace();
     return true;
 }
 
@@ -1858,6 +1981,16 @@ bool runInference(InferenceOptions const& inference, InferenceEnvironmentBase& i
     CHECK(cudaProfilerStart());
 
     trace.resize(0);
+    iEnv.timeRecorder.reset();
+    iEnv.pruned = false;
+    // The profiling run that follows the timed run is not exported, as with the JSON trace.
+    bool const exportBinaryTrace = !reporting.exportTimes.empty()
+        && reporting.exportTimesFormat == TraceExportFormat::kBINARY && iEnv.profiler == nullptr;
+    if (reporting.streamingStats || reporting.reportInterval > 0.F || exportBinaryTrace)
+    {
+        iEnv.timeRecorder = std::make_unique<InferenceTimeRecorder>(
+            reporting, inference, sample::gLogInfo, exportBinaryTrace ? reporting.exportTimes : std::string{});
+    }
 
     SyncStruct sync;
     sync.sleep = inference.sleep;
@@ -1882,6 +2015,11 @@ bool runInference(InferenceOptions const& inference, InferenceEnvironmentBase& i
     }
     CHECK(cudaProfilerStop());
 
+    if (iEnv.timeRecorder)
+    {
+        iEnv.timeRecorder->finish();
+    }
+
     auto cmpTrace = [](InferenceTrace const& a, InferenceTrace const& b) { return a.h2dStart < b.h2dStart; };
     std::sort(trace.begin(), trace.end(), cmpTrace);
 
@@ -2045,51 +2183,60 @@ std::string getLayerInformation(
 
 void Binding::fill(std::string const& fileName)
 {
-    loadFromFile(fileName, static_cast<char*>(buffer->getHostBuffer()), buffer->getSize());
+    auto content = loadFileContent(fileName, buffer->getSize());
+    auto* fileBuffer = dynamic_cast<FileMirroredBuffer*>(buffer.get());
+    if (fileBuffer != nullptr && content->pin())
+    {
+        fileBuffer->setContent(std::move(content));
+    }
+    else
+    {
+        std::memcpy(buffer->getHostBuffer(), content->data(), buffer->getSize());
+    }
 }
 
-void Binding::fill()
+void Binding::fill(uint64_t seed)
 {
     switch (dataType)
     {
     case nvinfer1::DataType::kBOOL:
     {
-        fillBuffer<bool>(buffer->getHostBuffer(), volume, 0, 1);
+        fillBuffer<bool>(buffer->getHostBuffer(), volume, 0, 1, seed);
         break;
     }
     case nvinfer1::DataType::kINT32:
     {
-        fillBuffer<int32_t>(buffer->getHostBuffer(), volume, -128, 127);
+        fillBuffer<int32_t>(buffer->getHostBuffer(), volume, -128, 127, seed);
         break;
     }
     case nvinfer1::DataType::kINT64:
     {
-        fillBuffer<int64_t>(buffer->getHostBuffer(), volume, -128, 127);
+        fillBuffer<int64_t>(buffer->getHostBuffer(), volume, -128, 127, seed);
         break;
     }
     case nvinfer1::DataType::kINT8:
     {
-        fillBuffer<int8_t>(buffer->getHostBuffer(), volume, -128, 127);
+        fillBuffer<int8_t>(buffer->getHostBuffer(), volume, -128, 127, seed);
         break;
     }
     case nvinfer1::DataType::kFLOAT:
     {
-        fillBuffer<float>(buffer->getHostBuffer(), volume, -1.0F, 1.0F);
+        fillBuffer<float>(buffer->getHostBuffer(), volume, -1.0F, 1.0F, seed);
         break;
     }
     case nvinfer1::DataType::kHALF:
     {
-        fillBuffer<__half>(buffer->getHostBuffer(), volume, -1.0F, 1.0F);
+        fillBuffer<__half>(buffer->getHostBuffer(), volume, -1.0F, 1.0F, seed);
         break;
     }
     case nvinfer1::DataType::kBF16:
     {
-        fillBuffer<BFloat16>(buffer->getHostBuffer(), volume, -1.0F, 1.0F);
+        fillBuffer<BFloat16>(buffer->getHostBuffer(), volume, -1.0F, 1.0F, seed);
         break;
     }
     case nvinfer1::DataType::kUINT8:
     {
-        fillBuffer<uint8_t>(buffer->getHostBuffer(), volume, 0, 255);
+        fillBuffer<uint8_t>(buffer->getHostBuffer(), volume, 0, 255, seed);
         break;
     }
     case nvinfer1::DataType::kFP8:
@@ -2097,7 +2244,7 @@ void Binding::fill()
         ASSERT(false && "FP8 is not supported");
 #else
     {
-        fillBuffer<__nv_fp8_e4m3>(buffer->getHostBuffer(), volume, -1.0F, 1.0F);
+        fillBuffer<__nv_fp8_e4m3>(buffer->getHostBuffer(), volume, -1.0F, 1.0F, seed);
         break;
     }
 #endif
@@ -2106,7 +2253,7 @@ void Binding::fill()
         // int4 is implemented as packing two elements into a single byte,
         // so all possible bit patterns of the two int4 elements coincides with all possible bit patterns of
         // an uint8.
-        fillBuffer<uint8_t>(buffer->getHostBuffer(), volume, 0, 255);
+        fillBuffer<uint8_t>(buffer->getHostBuffer(), volume, 0, 255, seed);
         break;
     }
     case DataType::kFP4: ASSERT(false && "FP4 is not supported");
@@ -2225,6 +2372,21 @@ void BindingsBase::addBinding(
             return std::make_shared<DiscreteMirroredBuffer>();
         }
     };
+    //! Inputs loaded from files share the pages of the file across streams when they can be pinned, so that the copy
+    //! to the device stays asynchronous. The buffer holds the content, so fill() below finds it in the cache.
+    auto makeInputBuffer = [&]() -> std::shared_ptr<IMirroredBuffer> {
+        if (!mUseManaged && !fileName.empty() && tensorInfo.vol > 0)
+        {
+            auto content = loadFileContent(fileName, samplesCommon::getNbBytes(tensorInfo.dataType, tensorInfo.vol));
+            if (content->pin())
+            {
+                auto buffer = std::make_shared<FileMirroredBuffer>();
+                buffer->setContent(std::move(content));
+                return buffer;
+            }
+        }
+        return makeBuffer(mUseManaged);
+    };
     if (tensorInfo.isDynamic)
     {
         ASSERT(!tensorInfo.isInput); // Only output shape can be possibly unknown because of DDS.
@@ -2237,7 +2399,7 @@ void BindingsBase::addBinding(
     {
         if (mBindings[b].buffer == nullptr)
         {
-            mBindings[b].buffer = makeBuffer(mUseManaged);
+            mBindings[b].buffer = tensorInfo.isInput ? makeInputBuffer() : makeBuffer(mUseManaged);
         }
         // Some memory allocators return nullptr when allocating zero bytes, but TensorRT requires a non-null ptr
         // even for empty tensors, so allocate a dummy byte.
@@ -2567,14 +2729,12 @@ void loadRefOutputsImpl(InferenceEnvironmentBase& iEnv, InferenceOptions const&
         int64_t const volume = std::accumulate(dims.d, dims.d + dims.nbDims, 1LL, std::multiplies<int64_t>{});
         size_t const nbBytes = samplesCommon::getNbBytes(dataType, volume);
 
-        // Allocate host buffer and load data
-        auto hostBuffer = std::make_unique<TrtHostBuffer>(nbBytes);
-        loadFromFile(fileName, static_cast<char*>(hostBuffer->get()), nbBytes);
+        auto content = loadFileContent(fileName, nbBytes);
 
         sample::gLogInfo << "Loaded reference output for tensor " << tensorName << " from " << fileName
                          << " (volume=" << volume << ", bytes=" << nbBytes << ")" << std::endl;
 
-        iEnv.refOutputsAll[pairIndex].insert_or_assign(tensorName, std::move(hostBuffer));
+        iEnv.refOutputsAll[pairIndex].insert_or_assign(tensorName, std::move(content));
     }
 }
 } // namespace
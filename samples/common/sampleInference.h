@@ -24,6 +24,7 @@
 #include "sampleReporting.h"
 #include "sampleUtils.h"
 
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <list>
@@ -174,19 +175,22 @@ struct InferenceEnvironmentBase
     std::vector<TrtDeviceBuffer>
         deviceMemory; //< Device memory used for inference when the allocation strategy is not static.
     std::unique_ptr<DebugTensorWriter> listener;
+    //! Streaming timing statistics, set by runInference() when --streamingStats or --reportInterval is used.
+    std::unique_ptr<InferenceTimeRecorder> timeRecorder;
     bool error{false};
     bool accuracyFailed{false};                                 //< Set to true if any tensor accuracy exceeds threshold
     std::unordered_map<std::string, double> accuracyLossValues; //< Per-tensor accuracy values from the last validation
+    std::atomic<bool> pruned{false}; //< Set when --tuningPruneAboveMs stopped the timing run early
 
     bool safe{false};
     std::string cmdline;
 
 #if !defined(_WIN32)
     //! Reference outputs for accuracy validation (tuner feature, Linux enterprise/auto-only).
-    //! Map from tensor name to host buffer containing reference data.
+    //! Map from tensor name to the content of the reference file, shared with every other user of the file.
     //! Guarded because MSVC cannot instantiate vector<unordered_map<string, unique_ptr<T>>>,
     //! and the tuner does not run on Windows or RTX/winjit.
-    using RefOutputMap = std::unordered_map<std::string, std::unique_ptr<TrtHostBuffer>>;
+    using RefOutputMap = std::unordered_map<std::string, std::shared_ptr<FileContent const>>;
     //! Vector of reference output maps, one for each refPair.
     std::vector<RefOutputMap> refOutputsAll;
 #endif // !defined(_WIN32) && !TRT_WINML
@@ -306,7 +310,8 @@ struct Binding
 
     void fill(std::string const& fileName);
 
-    void fill();
+    //! Fill with random values generated from seed.
+    void fill(uint64_t seed);
 
     void dump(std::ostream& os, nvinfer1::Dims dims, nvinfer1::Dims strides, int32_t vectorDim, int32_t spv,
         std::string const separator = " ") const;
@@ -335,8 +340,9 @@ class BindingsBase
 {
 public:
     BindingsBase() = delete;
-    explicit BindingsBase(bool useManaged)
+    explicit BindingsBase(bool useManaged, uint64_t inputSeed = 0)
         : mUseManaged(useManaged)
+        , mInputSeed(inputSeed)
     {
     }
 
@@ -356,7 +362,7 @@ public:
 
     void fill(int binding)
     {
-        mBindings[binding].fill();
+        mBindings[binding].fill(mInputSeed);
     }
 
     std::unordered_map<std::string, int> getInputBindings() const
@@ -411,14 +417,15 @@ protected:
     std::vector<Binding> mBindings;
     std::vector<void*> mDevicePointers;
     bool mUseManaged{false};
+    uint64_t mInputSeed{0};
 };
 
 class BindingsStd : public BindingsBase
 {
 public:
     BindingsStd() = delete;
-    explicit BindingsStd(bool useManaged)
-        : BindingsBase(useManaged)
+    explicit BindingsStd(bool useManaged, uint64_t inputSeed = 0)
+        : BindingsBase(useManaged, inputSeed)
     {
     }
 
@@ -474,8 +481,8 @@ class BindingsSafe : public BindingsBase
 {
 public:
     BindingsSafe() = delete;
-    explicit BindingsSafe(bool useManaged)
-        : BindingsBase(useManaged)
+    explicit BindingsSafe(bool useManaged, uint64_t inputSeed = 0)
+        : BindingsBase(useManaged, inputSeed)
     {
     }
 
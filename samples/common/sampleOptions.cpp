@@ -1274,6 +1274,11 @@ void BuildOptions::parse(Arguments& arguments)
         load = true;
     }
     getAndDelOption(arguments, "--asyncFileReader", asyncFileReader);
+    getAndDelOption(arguments, "--asyncFileReaderDirectIO", asyncFileReaderDirectIO);
+    if (asyncFileReaderDirectIO && !asyncFileReader)
+    {
+        throw std::invalid_argument("--asyncFileReaderDirectIO requires --asyncFileReader.");
+    }
     getAndDelOption(arguments, "--getPlanVersionOnly", getPlanVersionOnly);
 
     if (getAndDelOption(arguments, "--saveEngine", engine))
@@ -1565,6 +1570,10 @@ TuningSearchAlgorithm parseTuningSearchAlgorithm(std::string const& spec, Tuning
     {
         return TuningSearchAlgorithm::kMIXED;
     }
+    if (spec == "adaptive")
+    {
+        return TuningSearchAlgorithm::kADAPTIVE;
+    }
     throw std::invalid_argument(std::string("Unknown tuning search algorithm: ") + spec);
 }
 
@@ -1632,9 +1641,20 @@ void TuningOptions::parse(Arguments& arguments)
     tuningSearchAlgorithm = parseTuningSearchAlgorithm(searchAlgorithmString, tuningSearchAlgorithm);
 
     getAndDelOption(arguments, "--tuningTimeOut", timeout);
+    getAndDelOption(arguments, "--tuningBudget", budget);
     getAndDelOption(arguments, "--tuningCacheFile", tuningCacheFile);
     getAndDelOption(arguments, "--continue", continueFromCache);
     getAndDelOption(arguments, "--dryRun", dryRun);
+    getAndDelOption(arguments, "--tuningJobs", jobs);
+    getAndDelOption(arguments, "--tuningPrune", prune);
+    std::string devicesString;
+    if (getAndDelOption(arguments, "--tuningDevices", devicesString))
+    {
+        for (auto const& d : splitToStringVec(devicesString, ','))
+        {
+            devices.emplace_back(stringToValue<int32_t>(d));
+        }
+    }
     // Hidden parent->child IPC flag (not in TuningOptions::help()).
     getAndDelOption(arguments, "--tuningResultFile", tuningResultFile);
 
@@ -1651,6 +1671,26 @@ void TuningOptions::parse(Arguments& arguments)
     {
         throw std::invalid_argument("--dryRun is incompatible with --tuningSearch=mixed.");
     }
+    if (tuningSearchAlgorithm == TuningSearchAlgorithm::kADAPTIVE && dryRun)
+    {
+        throw std::invalid_argument("--dryRun is incompatible with --tuningSearch=adaptive.");
+    }
+    if (budget == 0 || budget < -1)
+    {
+        throw std::invalid_argument("--tuningBudget must be a positive number of iterations.");
+    }
+    if (budget != -1 && tuningSearchAlgorithm != TuningSearchAlgorithm::kADAPTIVE)
+    {
+        throw std::invalid_argument("--tuningBudget requires --tuningSearch=adaptive.");
+    }
+    if (jobs < 1)
+    {
+        throw std::invalid_argument("--tuningJobs must be at least 1.");
+    }
+    if (std::any_of(devices.begin(), devices.end(), [](int32_t d) { return d < 0; }))
+    {
+        throw std::invalid_argument("--tuningDevices entries must be non-negative device ordinals.");
+    }
 
     if (!tuningExprFile.empty())
     {
@@ -1728,6 +1768,12 @@ void InferenceOptions::parse(Arguments& arguments)
     getAndDelOption(arguments, "--timeDeserialize", timeDeserialize);
     getAndDelOption(arguments, "--timeRefit", timeRefit);
     getAndDelOption(arguments, "--persistentCacheRatio", persistentCacheRatio);
+    if (getAndDelOption(arguments, "--inputSeed", inputSeed) && inputSeed < 0)
+    {
+        throw std::invalid_argument("--inputSeed must be a non-negative integer.");
+    }
+    // Hidden tuning parent->child flag (not in InferenceOptions::help()), injected with the best GPU time so far.
+    getAndDelOption(arguments, "--tuningPruneAboveMs", pruneAboveMs);
 
     // Parse reference pairs: either single pair (--loadInputs/--loadRefOutputs) or multiple pairs (--refPair)
     // This is similar to how --profile works with --minShapes/--optShapes/--maxShapes
@@ -1851,6 +1897,7 @@ void InferenceOptions::parse(Arguments& arguments)
     std::string debugFormats;
     getAndDelOption(arguments, "--saveAllDebugTensors", debugFormats);
     dumpAlldebugTensorFormats = splitToStringVec(debugFormats, ',');
+    getAndDelOption(arguments, "--debugTensorMemoryLimit", debugTensorMemoryLimit);
     getAndDelOption(arguments, "--refitFromOnnx", refitOnnxModel);
 }
 
@@ -1858,6 +1905,7 @@ void ReportingOptions::parse(Arguments& arguments)
 {
     getAndDelOption(arguments, "--avgRuns", avgs);
     getAndDelOption(arguments, "--verbose", verbose);
+    getAndDelOption(arguments, "--asyncLogging", asyncLogging);
     getAndDelOption(arguments, "--dumpRefit", refit);
     getAndDelOption(arguments, "--dumpOutput", output);
     getAndDelOption(arguments, "--dumpRawBindingsToFile", dumpRawBindings);
@@ -1868,6 +1916,40 @@ void ReportingOptions::parse(Arguments& arguments)
     getAndDelOption(arguments, "--exportOutput", exportOutput);
     getAndDelOption(arguments, "--exportProfile", exportProfile);
     getAndDelOption(arguments, "--exportLayerInfo", exportLayerInfo);
+    getAndDelOption(arguments, "--compareProfile", compareProfile);
+    getAndDelOption(arguments, "--compareProfileThreshold", compareProfileThreshold);
+    getAndDelOption(arguments, "--streamingStats", streamingStats);
+    getAndDelOption(arguments, "--reportInterval", reportInterval);
+
+    std::string exportTimesFormatString;
+    getAndDelOption(arguments, "--exportTimesFormat", exportTimesFormatString);
+    if (exportTimesFormatString == "json")
+    {
+        exportTimesFormat = TraceExportFormat::kJSON;
+    }
+    else if (exportTimesFormatString == "binary")
+    {
+        exportTimesFormat = TraceExportFormat::kBINARY;
+    }
+    else if (!exportTimesFormatString.empty())
+    {
+        throw std::invalid_argument(std::string("Unknown exportTimesFormat: ") + exportTimesFormatString);
+    }
+
+    if (reportInterval < 0.F)
+    {
+        throw std::invalid_argument("--reportInterval must be non-negative.");
+    }
+    if (compareProfileThreshold < 0.F)
+    {
+        throw std::invalid_argument("--compareProfileThreshold must be non-negative.");
+    }
+    if (streamingStats && !exportTimes.empty() && exportTimesFormat == TraceExportFormat::kJSON)
+    {
+        throw std::invalid_argument(
+            "--exportTimes with the json format needs the full timing trace and cannot be used with --streamingStats. "
+            "Use --exportTimesFormat=binary instead.");
+    }
 
     std::string percentileString;
     getAndDelOption(arguments, "--percentile", percentileString);
@@ -2528,6 +2610,7 @@ std::ostream& operator<<(std::ostream& os, InferenceOptions const& options)
           "Time Refit: "                << boolToEnabled(options.timeRefit)                     << std::endl <<
           "NVTX verbosity: "            << static_cast<int32_t>(options.nvtxVerbosity)          << std::endl <<
           "Persistent Cache Ratio: "    << static_cast<float>(options.persistentCacheRatio)     << std::endl <<
+          "Input Seed: "                << options.inputSeed                                    << std::endl <<
           "Optimization Profile Index: "<< options.optProfileIndex                              << std::endl <<
           "Weight Streaming Budget: "   << wsBudget                                             << std::endl;
     // clang-format on
@@ -2590,14 +2673,21 @@ std::ostream& operator<<(std::ostream& os, ReportingOptions const& options)
     // clang-format off
     os << "=== Reporting Options ==="                                                     << std::endl <<
           "Verbose: "                     << boolToEnabled(options.verbose)               << std::endl <<
+          "Asynchronous logging: "        << boolToEnabled(options.asyncLogging)          << std::endl <<
           "Averages: "                    << options.avgs << " inferences"                << std::endl <<
           "Percentiles: "                 << joinValuesToString(options.percentiles, ",") << std::endl <<
           "Dump refittable layers:"       << boolToEnabled(options.refit)                 << std::endl <<
           "Dump output: "                 << boolToEnabled(options.output)                << std::endl <<
           "Profile: "                     << boolToEnabled(options.profile)               << std::endl <<
-          "Export timing to JSON file: "  << options.exportTimes                          << std::endl <<
+          "Export timing to file: "       << options.exportTimes                          << std::endl <<
+          "Export timing format: "        << (options.exportTimesFormat == TraceExportFormat::kBINARY
+                                              ? "binary" : "json")                        << std::endl <<
           "Export output to JSON file: "  << options.exportOutput                         << std::endl <<
-          "Export profile to JSON file: " << options.exportProfile                        << std::endl;
+          "Export profile to JSON file: " << options.exportProfile                        << std::endl <<
+          "Compare profile with: "        << options.compareProfile                       << std::endl <<
+          "Regression threshold: "        << options.compareProfileThreshold << "%"       << std::endl <<
+          "Streaming statistics: "        << boolToEnabled(options.streamingStats)        << std::endl <<
+          "Report interval: "             << options.reportInterval << " s"               << std::endl;
     // clang-format on
 
     return os;
@@ -2772,6 +2862,8 @@ void BuildOptions::help(std::ostream& os)
           "  --saveEngine=<file>                Save the serialized engine"                                                                         "\n"
           "  --loadEngine=<file>                Load a serialized engine"                                                                           "\n"
           "  --asyncFileReader                  Load a serialized engine using async stream reader. Should be combined with --loadEngine."          "\n"
+          "  --asyncFileReaderDirectIO          Read the engine file with direct I/O (O_DIRECT, Linux only), bypassing the page cache. Useful for" "\n"
+          "                                     plans larger than the free host memory. Requires --asyncFileReader."                                "\n"
           "  --getPlanVersionOnly               Print TensorRT version when loaded plan was created. Works without deserialization of the plan."    "\n"
           "                                     Use together with --loadEngine. Supported only for engines created with 8.6 and forward."           "\n"
           "  --tacticSources=tactics            Specify the tactics to be used by adding (+) or removing (-) tactics from the default "             "\n"
@@ -2886,6 +2978,8 @@ void InferenceOptions::help(std::ostream& os)
         R"(                              Input values spec ::= Ival[","spec])"                                                       << std::endl <<
         R"(                                           Ival ::= name":"file)"                                                         << std::endl <<
           "                              Consult the README for more information on generating files for custom inputs."             << std::endl <<
+          "  --inputSeed=N               Non-negative seed of the random values of inputs that are not loaded from files. The same " << std::endl <<
+          "                              seed always generates the same values (default = " << defaultInputSeed << ")"               << std::endl <<
           "  --loadRefOutputs=spec       Load reference output values from files for accuracy validation. Output names can be "      << std::endl <<
           "                              wrapped with single quotes (ex: 'Output:0')."                                               << std::endl <<
         R"(                              Output values spec ::= Oval[","spec])"                                                      << std::endl <<
@@ -2968,6 +3062,9 @@ void InferenceOptions::help(std::ostream& os)
           "                              Multiple file formats can be saved simultaneously."                                         << std::endl <<
         R"(                              Input values spec   ::= format[","format])"                                                 << std::endl <<
         R"(                                           format ::= "summary"|"numpy"|"string"|"raw")"                                  << std::endl <<
+          "  --debugTensorMemoryLimit=N  Maximum host memory holding debug tensors waiting to be written (default = 1G)."            << std::endl <<
+          "                              Inference waits for earlier tensors to be written when the limit is reached."               << std::endl <<
+          "                              Supports the following base-2 suffixes: " << getAvailableUnitSuffixes() << "."              << std::endl <<
           "  --weightStreamingBudget     Set the maximum amount of GPU memory TensorRT is allowed to use for weights."               << std::endl <<
           "                              It can take on the following values:"                                                       << std::endl <<
           "                                  -2: (default) Disable weight streaming at runtime."                                     << std::endl <<
@@ -2994,8 +3091,17 @@ void TuningOptions::help(std::ostream& os)
           "                                  fast  = baseline + one-off variations per knob (default)"                  << std::endl <<
           "                                  full  = enumerate every combination (Cartesian product)"                   << std::endl <<
           "                                  mixed = phase 1 fast scan, then exhaustive over positive knobs"            << std::endl <<
+          "                                  adaptive = baseline, then each route of the full space is chosen from the" << std::endl <<
+          "                                             results so far (surrogate model + local search)"                << std::endl <<
+          "  --tuningBudget=N            Maximum number of routes tried by --tuningSearch=adaptive"                      << std::endl <<
+          "                              (default = twice the number of fast-search iterations)."                       << std::endl <<
           "  --tuningCacheFile=<f>       JSON file to which per-iteration results are appended (best-config cache)."     << std::endl <<
           "  --tuningTimeOut=<seconds>   Stop the loop after N elapsed seconds. -1 = no timeout (default)."              << std::endl <<
+          "  --tuningJobs=N              Keep up to N child builds in flight at once (default = 1). Each worker gets"   << std::endl <<
+          "                              a disjoint share of the CPUs; results are recorded in iteration order."         << std::endl <<
+          "  --tuningDevices=<d0,d1,..>  Pin worker k to CUDA device d[k % count] (injected as --device=<d>)."           << std::endl <<
+          "  --tuningPrune               Stop timing a child as soon as its median GPU time cannot beat the best"      << std::endl <<
+          "                              route so far; such iterations are recorded as pruned (default = false)."       << std::endl <<
           "  --saveAllEngines            Save the engine of every iteration as <engine>.iter<N>. Requires --saveEngine." << std::endl <<
           "  --dryRun                    Enumerate the route list and exit without building any engine."                 << std::endl <<
           "  --continue                  Resume an interrupted tuning loop from --tuningCacheFile."                      << std::endl <<
@@ -3010,6 +3116,8 @@ void ReportingOptions::help(std::ostream& os)
     // clang-format off
     os << "=== Reporting Options ==="                                                                    << std::endl <<
           "  --verbose                   Use verbose logging (default = false)"                          << std::endl <<
+          "  --asyncLogging              Format log messages on the logging threads and write them from a background thread "
+                                        "in batches (default = disabled)"                                << std::endl <<
           "  --avgRuns=N                 Report performance measurements averaged over N consecutive "
                                                        "iterations (default = " << defaultAvgRuns << ")" << std::endl <<
           "  --percentile=P1,P2,P3,...   Report performance for the P1,P2,P3,... percentages (0<=P_i<=100, 0 "
@@ -3027,11 +3135,25 @@ void ReportingOptions::help(std::ostream& os)
           "  --dumpOptimizationProfile   Print the optimization profile(s) information "
                                                                                 "(default = disabled)"   << std::endl <<
           "  --exportTimes=<file>        Write the timing results in a json file (default = disabled)"   << std::endl <<
+          "  --exportTimesFormat=<fmt>   Format of the --exportTimes file: json or binary. The binary format is a compact "
+                                        "columnar file written while inference is running; use tracer.py to convert "
+                                        "it to CSV or JSON (default = json)"                             << std::endl <<
           "  --exportOutput=<file>       Write the output tensors to a json file (default = disabled)"   << std::endl <<
           "  --exportProfile=<file>      Write the profile information per layer in a json file "
                                                                               "(default = disabled)"     << std::endl <<
           "  --exportLayerInfo=<file>    Write the layer information of the engine in a json file "
-                                                                              "(default = disabled)"     << std::endl;
+                                                                              "(default = disabled)"     << std::endl <<
+          "  --compareProfile=<file>     Profile the layers and compare their median times with a profile written by "
+                                        "--exportProfile. Only statistically significant changes are reported "
+                                        "(default = disabled)"                                           << std::endl <<
+          "  --compareProfileThreshold=P Fail with --compareProfile when a layer regressed significantly by more than "
+                                        "P% (default = " << defaultCompareProfileThreshold << ")"        << std::endl <<
+          "  --streamingStats            Summarize timings in fixed-size histograms instead of keeping every trace in "
+                                        "memory; percentiles are accurate to within 0.4% and trace details are not "
+                                        "printed. Requires --exportTimesFormat=binary with --exportTimes "
+                                        "(default = disabled)"                                           << std::endl <<
+          "  --reportInterval=N          Print a latency and throughput summary every N seconds while inference is "
+                                        "running (default = 0, disabled)"                                << std::endl;
     // clang-format on
 }
 
@@ -57,10 +57,12 @@ constexpr float defaultDuration{3.F};
 constexpr float defaultSleep{};
 constexpr float defaultIdle{};
 constexpr float defaultPersistentCacheRatio{0};
+constexpr int64_t defaultInputSeed{0};
 
 // Reporting default params
 constexpr int32_t defaultAvgRuns{10};
 constexpr std::array<float, 3> defaultPercentiles{90, 95, 99};
+constexpr float defaultCompareProfileThreshold{5.F};
 
 
 enum class ModelFormat
@@ -83,6 +85,12 @@ enum class TimingCacheMode
     kGLOBAL
 };
 
+enum class TraceExportFormat
+{
+    kJSON,   //< One JSON object per query, written once inference has finished.
+    kBINARY, //< Versioned columnar binary file, appended to while inference is running.
+};
+
 enum class MemoryAllocationStrategy
 {
     kSTATIC,  //< Allocate device memory based on max size across all profiles.
@@ -104,12 +112,14 @@ enum class TuningSearchAlgorithm
     kFAST,       //< Fast searching algorithm: baseline + one-off variations (linear in #knobs)
     kEXHAUSTIVE, //< Exhaustive: all combinations enumerated (product of knob value-counts)
     kMIXED,      //< Two-phase: fast scan, then exhaustive over knobs that improved performance
+    kADAPTIVE,   //< Surrogate-guided: picks each next route of the full space from the results so far
 };
 
 //! \brief Convert a TuningSearchAlgorithm enum to its CLI / cache-file string.
 //!   kFAST       -> "fast"
 //!   kEXHAUSTIVE -> "full"
 //!   kMIXED      -> "mixed"
+//!   kADAPTIVE   -> "adaptive"
 inline std::string toString(TuningSearchAlgorithm algo)
 {
     switch (algo)
@@ -117,6 +127,7 @@ inline std::string toString(TuningSearchAlgorithm algo)
     case TuningSearchAlgorithm::kFAST: return "fast";
     case TuningSearchAlgorithm::kEXHAUSTIVE: return "full";
     case TuningSearchAlgorithm::kMIXED: return "mixed";
+    case TuningSearchAlgorithm::kADAPTIVE: return "adaptive";
     }
     return "unknown";
 }
@@ -268,6 +279,7 @@ public:
     bool saveAllEngines{false}; //!< Save per-iteration engines as <engine>.iter<N> during tuning
     bool load{false};
     bool asyncFileReader{false};
+    bool asyncFileReaderDirectIO{false}; //!< Read the engine file with O_DIRECT, bypassing the page cache
     bool refittable{false};
     bool stripWeights{false};
     bool versionCompatible{false};
@@ -350,6 +362,8 @@ public:
     float sleep{defaultSleep};
     float idle{defaultIdle};
     float persistentCacheRatio{defaultPersistentCacheRatio};
+    int64_t inputSeed{defaultInputSeed}; // Seed of the random values of inputs that are not loaded from files
+    double pruneAboveMs{-1.0}; // Hidden --tuningPruneAboveMs: stop timing once the median compute time is above it
     float atol{1e-5};                  // Element-wise accuracy threshold absolute tolerance
     float rtol{1e-5};                  // Element-wise accuracy threshold relative tolerance
     float accuracyThresholdEndToEnd{}; // End-to-end accuracy threshold should not have default value
@@ -376,6 +390,7 @@ public:
     MemoryAllocationStrategy memoryAllocationStrategy{MemoryAllocationStrategy::kSTATIC};
     std::unordered_map<std::string, std::string> debugTensorFileNames;
     std::vector<std::string> dumpAlldebugTensorFormats;
+    size_t debugTensorMemoryLimit{size_t{1} << 30};
     WeightStreamingBudget weightStreamingBudget;
     std::string refitOnnxModel;
 
@@ -397,9 +412,15 @@ public:
     bool layerInfo{false};
     bool optProfileInfo{false};
     std::string exportTimes;
+    TraceExportFormat exportTimesFormat{TraceExportFormat::kJSON};
     std::string exportOutput;
     std::string exportProfile;
     std::string exportLayerInfo;
+    std::string compareProfile;
+    float compareProfileThreshold{defaultCompareProfileThreshold};
+    bool streamingStats{false};
+    float reportInterval{0.F};
+    bool asyncLogging{false};
 
     void parse(Arguments& arguments) override;
 
@@ -444,10 +465,14 @@ public:
     std::string tuningExprFile{};                                      //!< --tuneBuildRouteFile
     TuningSearchAlgorithm tuningSearchAlgorithm{TuningSearchAlgorithm::kFAST};
     int64_t timeout{-1};                                               //!< --tuningTimeOut (s); -1 = no timeout
+    int64_t budget{-1};                                                //!< --tuningBudget; -1 = adaptive default
     bool helpBuildRoute{false};                                        //!< --helpBuildRoute (short-circuit)
     std::string helpBuildRouteKnob{};                                  //!< --helpBuildRoute=<knob> filter
     bool continueFromCache{false};                                     //!< --continue
     bool dryRun{false};                                                //!< --dryRun (enumerate, don't build)
+    int32_t jobs{1};                                                   //!< --tuningJobs; children kept in flight
+    std::vector<int32_t> devices{};                                    //!< --tuningDevices; per-worker CUDA devices
+    bool prune{false};                                                 //!< --tuningPrune; stop hopeless children early
     //! \brief Hidden parent->child IPC channel.
     //!
     //! When set, runOnceBuildAndInfer writes a small JSON to this path containing
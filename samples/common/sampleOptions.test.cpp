@@ -79,3 +79,21 @@ TEST(ArgsToArgumentsMap, ArgPositionRecorded)
     EXPECT_EQ(args.find("--onnx")->second.second, 1);
     EXPECT_EQ(args.find("--fp16")->second.second, 2);
 }
+
+TEST(InferenceOptions, InputSeed)
+{
+    TestArgVec av{"--inputSeed=42"};
+    auto args = argsToArgumentsMap(av.argc(), av.argv());
+    InferenceOptions options;
+    options.parse(args);
+    EXPECT_EQ(options.inputSeed, 42);
+}
+
+TEST(InferenceOptions, NegativeInputSeedIsRejected)
+{
+    // The seed is used as an unsigned value; a negative one would silently wrap around.
+    TestArgVec av{"--inputSeed=-1"};
+    auto args = argsToArgumentsMap(av.argc(), av.argv());
+    InferenceOptions options;
+    EXPECT_THROW(options.parse(args), std::invalid_argument);
+}
@@ -16,16 +16,23 @@
  */
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <numeric>
+#include <unordered_map>
 #include <utility>
 
+#include <nlohmann/json.hpp>
+
 #include "sampleInference.h"
 #include "sampleOptions.h"
 #include "sampleReporting.h"
+#include "sampleTraceFile.h"
 
 #if ENABLE_UNIFIED_BUILDER
 #include "NvInferSafeRuntime.h"
@@ -114,6 +121,130 @@ inline InferenceTime traceToTiming(const InferenceTrace& a)
         (a.enqEnd - a.enqStart), (a.h2dEnd - a.h2dStart), (a.computeEnd - a.computeStart), (a.d2hEnd - a.d2hStart));
 }
 
+//!
+//! \brief Format min/max/mean/median/percentiles of a performance result on one line
+//!
+std::string toPerfString(PerformanceResult const& r, std::vector<float> const& percentiles)
+{
+    std::stringstream s;
+    s << "min = " << r.min << " ms, max = " << r.max << " ms, mean = " << r.mean << " ms, "
+      << "median = " << r.median << " ms";
+    for (int32_t i = 0, n = percentiles.size(); i < n; ++i)
+    {
+        s << ", percentile(" << percentiles[i] << "%) = " << r.percentiles[i] << " ms";
+    }
+    return s.str();
+}
+
+//!
+//! \brief Print the performance summary and the related warnings given the per-metric results
+//!
+void printSummary(PerformanceResult const& latencyResult, PerformanceResult const& enqueueResult,
+    PerformanceResult const& h2dResult, PerformanceResult const& gpuComputeResult, PerformanceResult const& d2hResult,
+    int64_t nbTimings, float walltimeMs, std::vector<float> const& percentiles, int32_t batchSize, int32_t infStreams,
+    std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose)
+{
+    float const throughput = batchSize * nbTimings / walltimeMs * 1000;
+
+    osInfo << std::endl;
+    osInfo << "=== Performance summary ===" << std::endl;
+    osInfo << "Throughput: " << throughput << " qps" << std::endl;
+    osInfo << "Latency: " << toPerfString(latencyResult, percentiles) << std::endl;
+    osInfo << "Enqueue Time: " << toPerfString(enqueueResult, percentiles) << std::endl;
+    osInfo << "H2D Latency: " << toPerfString(h2dResult, percentiles) << std::endl;
+    osInfo << "GPU Compute Time: " << toPerfString(gpuComputeResult, percentiles) << std::endl;
+    osInfo << "D2H Latency: " << toPerfString(d2hResult, percentiles) << std::endl;
+    osInfo << "Total Host Walltime: " << walltimeMs / 1000 << " s" << std::endl;
+    osInfo << "Total GPU Compute Time: " << gpuComputeResult.mean * nbTimings / 1000 << " s" << std::endl;
+
+    // Report warnings if the throughput is bound by other factors than GPU Compute Time.
+    constexpr float kENQUEUE_BOUND_REPORTING_THRESHOLD{0.8F};
+    if (enqueueResult.median > kENQUEUE_BOUND_REPORTING_THRESHOLD * gpuComputeResult.median)
+    {
+        osWarning
+            << "* Throughput may be bound by Enqueue Time rather than GPU Compute and the GPU may be under-utilized."
+            << std::endl;
+        osWarning << "  If you are using --noCudaGraph, removing it may increase throughput." << std::endl;
+    }
+    if (h2dResult.median >= gpuComputeResult.median)
+    {
+        osWarning << "* Throughput may be bound by host-to-device transfers for the inputs rather than GPU Compute and "
+                     "the GPU may be under-utilized."
+                  << std::endl;
+        osWarning << "  Consider removing --includeDataTransfers to disable data transfers and potentially increase "
+                     "throughput."
+                  << std::endl;
+    }
+    if (d2hResult.median >= gpuComputeResult.median)
+    {
+        osWarning << "* Throughput may be bound by device-to-host transfers for the outputs rather than GPU Compute "
+                     "and the GPU may be under-utilized."
+                  << std::endl;
+        osWarning << "  Consider removing --includeDataTransfers to disable data transfers and potentially increase "
+                     "throughput."
+                  << std::endl;
+    }
+
+    // Report warnings if the GPU Compute Time is unstable.
+    constexpr float kUNSTABLE_PERF_REPORTING_THRESHOLD{2.5F};
+    if (gpuComputeResult.coeffVar > kUNSTABLE_PERF_REPORTING_THRESHOLD)
+    {
+        osWarning << "* GPU compute time is unstable, with coefficient of variance = " << gpuComputeResult.coeffVar
+                  << "%." << std::endl;
+        osWarning << "  If not already in use, locking GPU clock frequency may improve the stability." << std::endl;
+    }
+
+    // Report warnings if multiple inference streams are used.
+    if (infStreams > 1)
+    {
+        osWarning << "* Multiple inference streams are used. Latencies may not be accurate since inferences may run in "
+                  << "  parallel. Please use \"Throughput\" as the performance metric instead." << std::endl;
+    }
+
+    // Explain what the metrics mean.
+    osInfo << "Explanations of the performance metrics are printed in the verbose logs." << std::endl;
+    printMetricExplanations(osVerbose);
+
+    osInfo << std::endl;
+}
+
+constexpr int32_t kSUB_BUCKETS{1 << LatencyHistogram::kSUB_BUCKET_BITS};
+constexpr int32_t kNB_OCTAVES{LatencyHistogram::kMAX_EXPONENT - LatencyHistogram::kMIN_EXPONENT};
+//! Bucket 0 holds values below 2^kMIN_EXPONENT (including zero), the last one values at or above 2^kMAX_EXPONENT.
+constexpr int32_t kNB_BUCKETS{kNB_OCTAVES * kSUB_BUCKETS + 2};
+
+//!
+//! \brief Map a time to its histogram bucket using the exponent and top mantissa bits of the float
+//!
+int32_t histogramBucket(float ms) noexcept
+{
+    static float const kLOWEST = std::ldexp(1.F, LatencyHistogram::kMIN_EXPONENT);
+    static float const kHIGHEST = std::ldexp(1.F, LatencyHistogram::kMAX_EXPONENT);
+    if (!(ms >= kLOWEST)) // Also catches NaN.
+    {
+        return 0;
+    }
+    if (ms >= kHIGHEST)
+    {
+        return kNB_BUCKETS - 1;
+    }
+    uint32_t bits{0};
+    std::memcpy(&bits, &ms, sizeof(bits));
+    int32_t const exponent = static_cast<int32_t>((bits >> 23) & 0xFFU) - 127;
+    int32_t const sub = static_cast<int32_t>((bits >> (23 - LatencyHistogram::kSUB_BUCKET_BITS)) & (kSUB_BUCKETS - 1));
+    return 1 + (exponent - LatencyHistogram::kMIN_EXPONENT) * kSUB_BUCKETS + sub;
+}
+
+//!
+//! \brief Midpoint of a regular histogram bucket
+//!
+float histogramBucketMidpoint(int32_t bucket) noexcept
+{
+    int32_t const exponent = (bucket - 1) / kSUB_BUCKETS + LatencyHistogram::kMIN_EXPONENT;
+    int32_t const sub = (bucket - 1) % kSUB_BUCKETS;
+    return static_cast<float>(std::ldexp(1.0 + (sub + 0.5) / kSUB_BUCKETS, exponent));
+}
+
 inline std::string dimsToString(Dims const& shape)
 {
     std::stringstream ss;
@@ -232,8 +363,6 @@ PerformanceResult getPerformanceResult(std::vector<InferenceTime> const& timings
 void printEpilog(std::vector<InferenceTime> const& timings, float walltimeMs, std::vector<float> const& percentiles,
     int32_t batchSize, int32_t infStreams, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose)
 {
-    float const throughput = batchSize * timings.size() / walltimeMs * 1000;
-
     auto const getLatency = [](InferenceTime const& t) { return t.latency(); };
     auto const latencyResult = getPerformanceResult(timings, getLatency, percentiles);
 
@@ -249,77 +378,18 @@ void printEpilog(std::vector<InferenceTime> const& timings, float walltimeMs, st
     auto const getD2h = [](InferenceTime const& t) { return t.d2h; };
     auto const d2hResult = getPerformanceResult(timings, getD2h, percentiles);
 
-    auto const toPerfString = [&](const PerformanceResult& r) {
-        std::stringstream s;
-        s << "min = " << r.min << " ms, max = " << r.max << " ms, mean = " << r.mean << " ms, "
-          << "median = " << r.median << " ms";
-        for (int32_t i = 0, n = percentiles.size(); i < n; ++i)
-        {
-            s << ", percentile(" << percentiles[i] << "%) = " << r.percentiles[i] << " ms";
-        }
-        return s.str();
-    };
-
-    osInfo << std::endl;
-    osInfo << "=== Performance summary ===" << std::endl;
-    osInfo << "Throughput: " << throughput << " qps" << std::endl;
-    osInfo << "Latency: " << toPerfString(latencyResult) << std::endl;
-    osInfo << "Enqueue Time: " << toPerfString(enqueueResult) << std::endl;
-    osInfo << "H2D Latency: " << toPerfString(h2dResult) << std::endl;
-    osInfo << "GPU Compute Time: " << toPerfString(gpuComputeResult) << std::endl;
-    osInfo << "D2H Latency: " << toPerfString(d2hResult) << std::endl;
-    osInfo << "Total Host Walltime: " << walltimeMs / 1000 << " s" << std::endl;
-    osInfo << "Total GPU Compute Time: " << gpuComputeResult.mean * timings.size() / 1000 << " s" << std::endl;
-
-    // Report warnings if the throughput is bound by other factors than GPU Compute Time.
-    constexpr float kENQUEUE_BOUND_REPORTING_THRESHOLD{0.8F};
-    if (enqueueResult.median > kENQUEUE_BOUND_REPORTING_THRESHOLD * gpuComputeResult.median)
-    {
-        osWarning
-            << "* Throughput may be bound by Enqueue Time rather than GPU Compute and the GPU may be under-utilized."
-            << std::endl;
-        osWarning << "  If you are using --noCudaGraph, removing it may increase throughput." << std::endl;
-    }
-    if (h2dResult.median >= gpuComputeResult.median)
-    {
-        osWarning << "* Throughput may be bound by host-to-device transfers for the inputs rather than GPU Compute and "
-                     "the GPU may be under-utilized."
-                  << std::endl;
-        osWarning << "  Consider removing --includeDataTransfers to disable data transfers and potentially increase "
-                     "throughput."
-                  << std::endl;
-    }
-    if (d2hResult.median >= gpuComputeResult.median)
-    {
-        osWarning << "* Throughput may be bound by device-to-host transfers for the outputs rather than GPU Compute "
-                     "and the GPU may be under-utilized."
-                  << std::endl;
-        osWarning << "  Consider removing --includeDataTransfers to disable data transfers and potentially increase "
-                     "throughput."
-                  << std::endl;
-    }
-
-    // Report warnings if the GPU Compute Time is unstable.
-    constexpr float kUNSTABLE_PERF_REPORTING_THRESHOLD{2.5F};
-    if (gpuComputeResult.coeffVar > kUNSTABLE_PERF_REPORTING_THRESHOLD)
-    {
-        osWarning << "* GPU compute time is unstable, with coefficient of variance = " << gpuComputeResult.coeffVar
-                  << "%." << std::endl;
-        osWarning << "  If not already in use, locking GPU clock frequency may improve the stability." << std::endl;
-    }
-
-    // Report warnings if multiple inference streams are used.
-    if (infStreams > 1)
-    {
-        osWarning << "* Multiple inference streams are used. Latencies may not be accurate since inferences may run in "
-                  << "  parallel. Please use \"Throughput\" as the performance metric instead." << std::endl;
-    }
-
-    // Explain what the metrics mean.
-    osInfo << "Explanations of the performance metrics are printed in the verbose logs." << std::endl;
-    printMetricExplanations(osVerbose);
+    printSummary(latencyResult, enqueueResult, h2dResult, gpuComputeResult, d2hResult, timings.size(), walltimeMs,
+        percentiles, batchSize, infStreams, osInfo, osWarning, osVerbose);
+}
 
-    osInfo << std::endl;
+void printEpilog(InferenceTimeRecorder const& recorder, float walltimeMs, std::vector<float> const& percentiles,
+    int32_t batchSize, int32_t infStreams, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose)
+{
+    using Metric = InferenceTimeRecorder::Metric;
+    printSummary(recorder.getResult(Metric::kLATENCY, percentiles), recorder.getResult(Metric::kENQUEUE, percentiles),
+        recorder.getResult(Metric::kH2D, percentiles), recorder.getResult(Metric::kCOMPUTE, percentiles),
+        recorder.getResult(Metric::kD2H, percentiles), recorder.getTimings(), walltimeMs, percentiles, batchSize,
+        infStreams, osInfo, osWarning, osVerbose);
 }
 
 void printPerformanceReport(std::vector<InferenceTrace> const& trace, ReportingOptions const& reportingOpts,
@@ -341,12 +411,270 @@ void printPerformanceReport(std::vector<InferenceTrace> const& trace, ReportingO
     printEpilog(
         timings, benchTime, reportingOpts.percentiles, batchSize, infOpts.infStreams, osInfo, osWarning, osVerbose);
 
-    if (!reportingOpts.exportTimes.empty())
+    // The binary trace has already been appended to while inference was running.
+    if (!reportingOpts.exportTimes.empty() && reportingOpts.exportTimesFormat == TraceExportFormat::kJSON)
     {
         exportJSONTrace(trace, reportingOpts.exportTimes, warmups);
     }
 }
 
+void printPerformanceReport(InferenceTimeRecorder const& recorder, ReportingOptions const& reportingOpts,
+    InferenceOptions const& infOpts, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose)
+{
+    // treat inference with explicit batch as a single query and report the throughput
+    int32_t const batchSize = infOpts.batch ? infOpts.batch : 1;
+    float const benchTime = recorder.getBenchTimeMs();
+    printProlog(recorder.getWarmups() * batchSize, static_cast<int32_t>(recorder.getTimings()) * batchSize,
+        infOpts.warmup, benchTime, osInfo);
+    osInfo << "Statistics were collected with --streamingStats: trace details are not kept and percentiles are "
+              "accurate to within 0.4%."
+           << std::endl;
+    printEpilog(
+        recorder, benchTime, reportingOpts.percentiles, batchSize, infOpts.infStreams, osInfo, osWarning, osVerbose);
+}
+
+void LatencyHistogram::add(float ms)
+{
+    int32_t const bucket = histogramBucket(ms);
+    if (bucket == 0)
+    {
+        ++mUnderflow;
+    }
+    else if (bucket == kNB_BUCKETS - 1)
+    {
+        ++mOverflow;
+    }
+    else
+    {
+        int32_t const octave = (bucket - 1) / kSUB_BUCKETS;
+        int32_t const nbOctaves = static_cast<int32_t>(mBuckets.size()) / kSUB_BUCKETS;
+        if (nbOctaves == 0)
+        {
+            mBuckets.resize(kSUB_BUCKETS, 0);
+            mFirstOctave = octave;
+        }
+        else if (octave < mFirstOctave || octave >= mFirstOctave + nbOctaves)
+        {
+            // Grow the range to cover the new power of two. Times rarely span more than a few of them.
+            int32_t const first = std::min(octave, mFirstOctave);
+            int32_t const last = std::max(octave, mFirstOctave + nbOctaves - 1);
+            std::vector<int64_t> buckets(static_cast<size_t>(last - first + 1) * kSUB_BUCKETS, 0);
+            std::copy(mBuckets.begin(), mBuckets.end(), buckets.begin() + (mFirstOctave - first) * kSUB_BUCKETS);
+            mBuckets = std::move(buckets);
+            mFirstOctave = first;
+        }
+        ++mBuckets[bucket - 1 - mFirstOctave * kSUB_BUCKETS];
+    }
+
+    if (mCount == 0)
+    {
+        mMin = ms;
+        mMax = ms;
+    }
+    else
+    {
+        mMin = std::min(mMin, ms);
+        mMax = std::max(mMax, ms);
+    }
+    ++mCount;
+    double const delta = ms - mMean;
+    mMean += delta / static_cast<double>(mCount);
+    mM2 += delta * (ms - mMean);
+}
+
+void LatencyHistogram::reset() noexcept
+{
+    std::fill(mBuckets.begin(), mBuckets.end(), 0);
+    mUnderflow = 0;
+    mOverflow = 0;
+    mCount = 0;
+    mMean = 0.0;
+    mM2 = 0.0;
+    mMin = 0.F;
+    mMax = 0.F;
+}
+
+float LatencyHistogram::valueAtRank(int64_t rank) const noexcept
+{
+    if (rank <= 0)
+    {
+        return mMin;
+    }
+    if (rank >= mCount - 1)
+    {
+        return mMax;
+    }
+    // The under- and overflow buckets have no meaningful midpoint.
+    int64_t seen{mUnderflow};
+    if (seen > rank)
+    {
+        return mMin;
+    }
+    for (size_t b = 0; b < mBuckets.size(); ++b)
+    {
+        seen += mBuckets[b];
+        if (seen > rank)
+        {
+            auto const bucket = static_cast<int32_t>(1 + mFirstOctave * kSUB_BUCKETS + b);
+            return std::clamp(histogramBucketMidpoint(bucket), mMin, mMax);
+        }
+    }
+    return mMax;
+}
+
+PerformanceResult LatencyHistogram::getResult(std::vector<float> const& percentiles) const
+{
+    PerformanceResult result;
+    if (mCount == 0)
+    {
+        result.median = std::numeric_limits<float>::infinity();
+        result.percentiles.assign(percentiles.size(), std::numeric_limits<float>::infinity());
+        return result;
+    }
+
+    result.min = mMin;
+    result.max = mMax;
+    result.mean = static_cast<float>(mMean);
+
+    int64_t const m = mCount / 2;
+    result.median = (mCount % 2) ? valueAtRank(m) : (valueAtRank(m - 1) + valueAtRank(m)) / 2;
+
+    for (auto percentile : percentiles)
+    {
+        if (percentile < 0.F || percentile > 100.F)
+        {
+            throw std::runtime_error("percentile is not in [0, 100]!");
+        }
+        // Same rank as findPercentile() so that both report paths agree up to bucket resolution.
+        int64_t const exclude = static_cast<int64_t>((1 - percentile / 100) * mCount);
+        result.percentiles.emplace_back(valueAtRank(std::max<int64_t>(mCount - 1 - exclude, 0)));
+    }
+
+    if (mMean == 0.0)
+    {
+        result.coeffVar = std::numeric_limits<float>::infinity();
+    }
+    else
+    {
+        result.coeffVar = static_cast<float>(std::sqrt(mM2 / static_cast<double>(mCount)) / mMean * 100.0);
+    }
+    return result;
+}
+
+bool TimingPruner::add(float computeMs) noexcept
+{
+    if (mPruned || !isEnabled())
+    {
+        return mPruned;
+    }
+    ++mCount;
+    if (computeMs <= mTargetMs)
+    {
+        ++mAtOrBelow;
+    }
+    // Under the null hypothesis (median <= target), mAtOrBelow is at least Binomial(n, 1/2): mean n/2, stddev sqrt(n)/2.
+    auto const n = static_cast<double>(mCount);
+    mPruned = mCount >= kMIN_SAMPLES && static_cast<double>(mAtOrBelow) < 0.5 * n - kZ * 0.5 * std::sqrt(n);
+    return mPruned;
+}
+
+InferenceTimeRecorder::InferenceTimeRecorder(ReportingOptions const& reporting, InferenceOptions const& inference,
+    std::ostream& os, std::string const& traceFileName)
+    : mOs(os)
+    , mPercentiles(reporting.percentiles)
+    , mWarmupMs(inference.warmup)
+    , mIntervalMs(reporting.reportInterval * 1000.F)
+    , mBatchSize(inference.batch ? inference.batch : 1)
+    , mKeepTraces(!reporting.streamingStats)
+{
+    if (!traceFileName.empty())
+    {
+        mTraceWriter = std::make_unique<TraceFileWriter>(traceFileName, mWarmupMs);
+        if (!mTraceWriter->isOpen())
+        {
+            sample::gLogError << "Cannot open " << traceFileName << " to export the timing trace." << std::endl;
+            mTraceWriter.reset();
+        }
+    }
+}
+
+InferenceTimeRecorder::~InferenceTimeRecorder() = default;
+
+void InferenceTimeRecorder::finish()
+{
+    std::lock_guard<std::mutex> lock{mMutex};
+    mTraceWriter.reset();
+}
+
+void InferenceTimeRecorder::record(InferenceTrace const& trace)
+{
+    InferenceTime const t = traceToTiming(trace);
+
+    std::lock_guard<std::mutex> lock{mMutex};
+    ++mAllQueries;
+    mAllComputeMs += t.compute;
+    if (trace.computeStart < mWarmupMs)
+    {
+        ++mWarmups;
+        return;
+    }
+
+    if (mTotal[0].count() == 0)
+    {
+        mFirstH2dStart = trace.h2dStart;
+        mIntervalStartMs = trace.h2dStart;
+    }
+    mFirstH2dStart = std::min(mFirstH2dStart, trace.h2dStart);
+    if (trace.h2dStart >= mLastH2dStart)
+    {
+        // The report measures the walltime up to the end of the last query to start, as the sorted trace does.
+        mLastH2dStart = trace.h2dStart;
+        mLastD2hEnd = trace.d2hEnd;
+    }
+
+    if (mTraceWriter)
+    {
+        mTraceWriter->append(trace);
+    }
+
+    std::array<float, static_cast<size_t>(Metric::kCOUNT)> const values{t.latency(), t.enq, t.h2d, t.compute, t.d2h};
+    for (size_t m = 0; m < values.size(); ++m)
+    {
+        mTotal[m].add(values[m]);
+    }
+
+    if (mIntervalMs > 0.F)
+    {
+        if (trace.d2hEnd >= mIntervalStartMs + mIntervalMs && mInterval[0].count() > 0)
+        {
+            printInterval(trace.d2hEnd);
+        }
+        for (size_t m = 0; m < values.size(); ++m)
+        {
+            mInterval[m].add(values[m]);
+        }
+    }
+}
+
+void InferenceTimeRecorder::printInterval(float endMs)
+{
+    float const intervalMs = endMs - mIntervalStartMs;
+    float const throughput = mBatchSize * mInterval[0].count() / intervalMs * 1000;
+    auto const latency = mInterval[static_cast<int32_t>(Metric::kLATENCY)].getResult(mPercentiles);
+    auto const compute = mInterval[static_cast<int32_t>(Metric::kCOMPUTE)].getResult(mPercentiles);
+
+    mOs << "Interval [" << mIntervalStartMs / 1000 << " s, " << endMs / 1000 << " s]: " << mInterval[0].count()
+        << " queries, throughput = " << throughput << " qps" << std::endl;
+    mOs << "  Latency: " << toPerfString(latency, mPercentiles) << std::endl;
+    mOs << "  GPU Compute Time: " << toPerfString(compute, mPercentiles) << std::endl;
+
+    for (auto& h : mInterval)
+    {
+        h.reset();
+    }
+    mIntervalStartMs = endMs;
+}
+
 //! Printed format:
 //! [ value, ...]
 //! value ::= { "start enq : time, "end enq" : time, "start h2d" : time, "end h2d" : time, "start compute" : time,
@@ -385,6 +713,9 @@ void Profiler::reportLayerTime(char const* layerName, float timeMs) noexcept
         mUpdatesCount += mLayers.empty() || first;
         if (first)
         {
+            // A new run starts, so the previous one is complete.
+            mRunTimes.add(mRunTimeMs);
+            mRunTimeMs = 0.F;
             mIterator = mLayers.begin();
         }
         else
@@ -395,10 +726,23 @@ void Profiler::reportLayerTime(char const* layerName, float timeMs) noexcept
         }
     }
 
-    mIterator->timeMs.push_back(timeMs);
+    mIterator->times.add(timeMs);
+    mRunTimeMs += timeMs;
     ++mIterator;
 }
 
+float Profiler::getMedianTime() const noexcept
+{
+    if (mUpdatesCount == 0)
+    {
+        return 0.F;
+    }
+    // The last run is only added to mRunTimes when the next one starts.
+    LatencyHistogram runTimes(mRunTimes);
+    runTimes.add(mRunTimeMs);
+    return runTimes.getResult({}).median;
+}
+
 void Profiler::print(std::ostream& os) const noexcept
 {
     std::string const nameHdr("   Layer");
@@ -420,7 +764,7 @@ void Profiler::print(std::ostream& os) const noexcept
 
     for (auto const& p : mLayers)
     {
-        if (p.timeMs.empty() || getTotalTime(p) == 0.F)
+        if (p.times.count() == 0 || getTotalTime(p) == 0.F)
         {
             // there is no point to print profiling for layer that didn't run at all
             continue;
@@ -449,21 +793,238 @@ void Profiler::exportJSONProfile(std::string const& fileName) const noexcept
     os << "[" << std::endl << "  { \"count\" : " << mUpdatesCount << " }" << std::endl;
 
     auto const totalTimeMs = getTotalTime();
+    auto const summaries = getLayerSummaries();
 
-    for (auto const& l : mLayers)
+    for (size_t i = 0; i < mLayers.size(); ++i)
     {
+        auto const& l = mLayers[i];
+        auto const& s = summaries[i];
         // clang-format off
-        os << ", {" << R"( "name" : ")"      << l.name << R"(")"
-                       R"(, "timeMs" : )"     << getTotalTime(l)
-           <<          R"(, "averageMs" : )"  << getAvgTime(l)
-           <<          R"(, "medianMs" : )"  << getMedianTime(l)
-           <<          R"(, "percentage" : )" << getTotalTime(l) / totalTimeMs * 100
+        os << ", {" << R"( "name" : ")"        << l.name << R"(")"
+                       R"(, "timeMs" : )"       << getTotalTime(l)
+           <<          R"(, "averageMs" : )"    << getAvgTime(l)
+           <<          R"(, "medianMs" : )"     << s.medianMs
+           <<          R"(, "percentage" : )"   << getTotalTime(l) / totalTimeMs * 100
+           <<          R"(, "count" : )"        << s.count
+           <<          R"(, "medianLowMs" : )"  << s.medianLowMs
+           <<          R"(, "medianHighMs" : )" << s.medianHighMs
            << " }"  << std::endl;
         // clang-format on
     }
     os << "]" << std::endl;
 }
 
+namespace
+{
+//! Quantile of the normal distribution for a two-sided 95% confidence interval.
+constexpr double kZ95{1.96};
+
+//! Standard error of a median estimated from its 95% confidence interval.
+double medianStandardError(LayerTimeSummary const& s)
+{
+    return (static_cast<double>(s.medianHighMs) - static_cast<double>(s.medianLowMs)) / (2.0 * kZ95);
+}
+
+//! Key of a layer in a profile: its name, and how many layers of the same name come before it.
+std::vector<std::pair<std::string, int32_t>> layerKeys(std::vector<LayerTimeSummary> const& summaries)
+{
+    std::unordered_map<std::string, int32_t> seen;
+    std::vector<std::pair<std::string, int32_t>> keys;
+    keys.reserve(summaries.size());
+    for (auto const& s : summaries)
+    {
+        keys.emplace_back(s.name, seen[s.name]++);
+    }
+    return keys;
+}
+
+std::string keyToString(std::pair<std::string, int32_t> const& key)
+{
+    return key.second == 0 ? key.first : key.first + " (#" + std::to_string(key.second + 1) + ")";
+}
+} // namespace
+
+std::vector<LayerTimeSummary> Profiler::getLayerSummaries() const
+{
+    std::vector<LayerTimeSummary> summaries;
+    summaries.reserve(mLayers.size());
+    for (auto const& l : mLayers)
+    {
+        LayerTimeSummary s;
+        s.name = l.name;
+        s.count = l.times.count();
+        if (s.count > 0)
+        {
+            s.medianMs = getMedianTime(l);
+            // The ranks n / 2 -+ 1.96 / 2 * sqrt(n) bound a 95% confidence interval of the median, whatever the
+            // distribution of the times.
+            auto const n = static_cast<double>(s.count);
+            double const halfWidth = kZ95 / 2.0 * std::sqrt(n);
+            s.medianLowMs = l.times.valueAtRank(static_cast<int64_t>(std::ceil(n / 2.0 - halfWidth)) - 1);
+            s.medianHighMs = l.times.valueAtRank(static_cast<int64_t>(std::ceil(n / 2.0 + halfWidth)) - 1);
+        }
+        summaries.push_back(std::move(s));
+    }
+    return summaries;
+}
+
+bool ProfileComparison::hasRegressionAbove(float thresholdPercent) const
+{
+    return std::any_of(regressions.begin(), regressions.end(),
+        [thresholdPercent](LayerTimeChange const& c) { return c.changePercent > thresholdPercent; });
+}
+
+bool loadLayerSummaries(std::string const& fileName, std::vector<LayerTimeSummary>& summaries)
+{
+    std::ifstream is(fileName);
+    if (!is)
+    {
+        sample::gLogError << "Cannot open the profile " << fileName << std::endl;
+        return false;
+    }
+    summaries.clear();
+    try
+    {
+        for (auto const& entry : nlohmann::json::parse(is))
+        {
+            if (!entry.contains("name"))
+            {
+                continue; // The entry with the number of iterations.
+            }
+            if (!entry.contains("count") || !entry.contains("medianLowMs") || !entry.contains("medianHighMs"))
+            {
+                sample::gLogError << "The profile " << fileName << " has no confidence intervals for the layer "
+                                  << "medians. Export it again with --exportProfile to compare with it." << std::endl;
+                return false;
+            }
+            LayerTimeSummary s;
+            s.name = entry.at("name").get<std::string>();
+            s.count = entry.at("count").get<int64_t>();
+            s.medianMs = entry.at("medianMs").get<float>();
+            s.medianLowMs = entry.at("medianLowMs").get<float>();
+            s.medianHighMs = entry.at("medianHighMs").get<float>();
+            summaries.push_back(std::move(s));
+        }
+    }
+    catch (nlohmann::json::exception const& e)
+    {
+        sample::gLogError << "Cannot parse the profile " << fileName << ": " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+ProfileComparison compareLayerProfiles(
+    std::vector<LayerTimeSummary> const& baseline, std::vector<LayerTimeSummary> const& current, double significance)
+{
+    ProfileComparison comparison;
+    auto const baselineKeys = layerKeys(baseline);
+    auto const currentKeys = layerKeys(current);
+    std::map<std::pair<std::string, int32_t>, size_t> baselineIndex;
+    for (size_t i = 0; i < baseline.size(); ++i)
+    {
+        baselineIndex.emplace(baselineKeys[i], i);
+    }
+
+    // Pairs of (baseline, current) layers. Layers that did not run have no meaningful relative change.
+    std::vector<std::pair<LayerTimeSummary const*, LayerTimeSummary const*>> pairs;
+    for (size_t i = 0; i < current.size(); ++i)
+    {
+        auto const found = baselineIndex.find(currentKeys[i]);
+        if (found == baselineIndex.end())
+        {
+            comparison.onlyInCurrent.push_back(keyToString(currentKeys[i]));
+            continue;
+        }
+        auto const& b = baseline[found->second];
+        baselineIndex.erase(found);
+        if (b.count > 0 && current[i].count > 0 && b.medianMs > 0.F)
+        {
+            pairs.emplace_back(&b, &current[i]);
+        }
+    }
+    for (size_t i = 0; i < baseline.size(); ++i)
+    {
+        if (baselineIndex.count(baselineKeys[i]) != 0)
+        {
+            comparison.onlyInBaseline.push_back(keyToString(baselineKeys[i]));
+        }
+    }
+
+    comparison.nbCompared = static_cast<int32_t>(pairs.size());
+    double const threshold = significance / std::max<double>(1.0, pairs.size());
+    for (auto const& [b, c] : pairs)
+    {
+        double const difference = static_cast<double>(c->medianMs) - static_cast<double>(b->medianMs);
+        double const standardError = std::hypot(medianStandardError(*b), medianStandardError(*c));
+        double pValue{1.0};
+        if (standardError > 0.0)
+        {
+            pValue = std::erfc(std::abs(difference) / standardError / std::sqrt(2.0));
+        }
+        else if (difference != 0.0)
+        {
+            pValue = 0.0; // Both runs were perfectly steady, so any difference is real.
+        }
+        if (pValue >= threshold)
+        {
+            continue;
+        }
+        LayerTimeChange change{c->name, b->medianMs, c->medianMs,
+            static_cast<float>(difference / static_cast<double>(b->medianMs) * 100.0), pValue};
+        (difference > 0.0 ? comparison.regressions : comparison.improvements).push_back(std::move(change));
+    }
+
+    auto const byMagnitude = [](LayerTimeChange const& x, LayerTimeChange const& y) {
+        return std::abs(x.changePercent) > std::abs(y.changePercent);
+    };
+    std::sort(comparison.regressions.begin(), comparison.regressions.end(), byMagnitude);
+    std::sort(comparison.improvements.begin(), comparison.improvements.end(), byMagnitude);
+    return comparison;
+}
+
+void printProfileComparison(ProfileComparison const& comparison, float thresholdPercent, std::ostream& os)
+{
+    os << std::endl
+       << "=== Profile Comparison (" << comparison.nbCompared << " layers compared) ===" << std::endl;
+    auto const printChanges = [&os](char const* title, std::vector<LayerTimeChange> const& changes) {
+        if (changes.empty())
+        {
+            return;
+        }
+        os << title << std::endl << "   Baseline(ms)   Current(ms)   Change(%)    p-value   Layer" << std::endl;
+        for (auto const& c : changes)
+        {
+            // clang-format off
+            os << std::setw(15) << std::fixed << std::setprecision(4) << c.baselineMs
+               << std::setw(14) << std::fixed << std::setprecision(4) << c.currentMs
+               << std::setw(12) << std::showpos << std::fixed << std::setprecision(1) << c.changePercent
+               << std::noshowpos
+               << std::setw(11) << std::scientific << std::setprecision(1) << c.pValue << std::defaultfloat
+               << "   " << c.name << std::endl;
+            // clang-format on
+        }
+    };
+    printChanges("Significant regressions:", comparison.regressions);
+    printChanges("Significant improvements:", comparison.improvements);
+    if (comparison.regressions.empty() && comparison.improvements.empty())
+    {
+        os << "No significant change in the layer times." << std::endl;
+    }
+    if (!comparison.onlyInBaseline.empty() || !comparison.onlyInCurrent.empty())
+    {
+        os << comparison.onlyInBaseline.size() << " layer(s) only in the baseline and "
+           << comparison.onlyInCurrent.size() << " only in the current profile were not compared." << std::endl;
+    }
+    auto const nbAboveThreshold = std::count_if(comparison.regressions.begin(), comparison.regressions.end(),
+        [thresholdPercent](LayerTimeChange const& c) { return c.changePercent > thresholdPercent; });
+    if (nbAboveThreshold > 0)
+    {
+        os << nbAboveThreshold << " layer(s) regressed by more than " << thresholdPercent << "%." << std::endl;
+    }
+    os << std::endl;
+}
+
 void dumpInputs(nvinfer1::IExecutionContext const& context, BindingsStd const& bindings, std::ostream& os)
 {
     os << "Input Tensors:" << std::endl;
@@ -610,6 +1171,32 @@ void printPerformanceProfile(ReportingOptions const& reporting, InferenceEnviron
     }
 }
 
+bool compareWithBaselineProfile(ReportingOptions const& reporting, Profiler const& profiler)
+{
+    std::vector<LayerTimeSummary> baseline;
+    if (!loadLayerSummaries(reporting.compareProfile, baseline))
+    {
+        return false;
+    }
+    auto const comparison = compareLayerProfiles(baseline, profiler.getLayerSummaries());
+    printProfileComparison(comparison, reporting.compareProfileThreshold, sample::gLogInfo);
+    for (auto const& name : comparison.onlyInBaseline)
+    {
+        sample::gLogVerbose << "Only in the baseline profile: " << name << std::endl;
+    }
+    for (auto const& name : comparison.onlyInCurrent)
+    {
+        sample::gLogVerbose << "Only in the current profile: " << name << std::endl;
+    }
+    if (comparison.hasRegressionAbove(reporting.compareProfileThreshold))
+    {
+        sample::gLogError << "Layer times regressed by more than " << reporting.compareProfileThreshold
+                          << "% compared with " << reporting.compareProfile << std::endl;
+        return false;
+    }
+    return true;
+}
+
 namespace details
 {
 void dump(std::unique_ptr<nvinfer1::IExecutionContext> const& context, std::unique_ptr<BindingsStd> const& binding,
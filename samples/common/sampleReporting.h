@@ -18,9 +18,15 @@
 #ifndef TRT_SAMPLE_REPORTING_H
 #define TRT_SAMPLE_REPORTING_H
 
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <numeric>
+#include <vector>
 
 #include "sampleOptions.h"
 
@@ -28,6 +34,7 @@ namespace sample
 {
 
 class BindingsStd;
+class TraceFileWriter;
 
 //!
 //! \struct InferenceTime
@@ -123,6 +130,194 @@ struct PerformanceResult
     float coeffVar{0.F}; // coefficient of variation
 };
 
+//!
+//! \class LatencyHistogram
+//! \brief Bounded-memory, log-bucketed histogram of times in milliseconds
+//!
+//! Every power of two in [2^-20, 2^20) ms is split into 2^kSUB_BUCKET_BITS linear sub-buckets, so the memory
+//! footprint is fixed regardless of the number of samples. Sub-buckets are only allocated for the range of powers of
+//! two that the samples span, which keeps a histogram of times within a few powers of two to a few KiB. Median and
+//! percentiles are reported as bucket midpoints (clamped to the exact min/max) and are within
+//! 2^-(kSUB_BUCKET_BITS+1), i.e. ~0.4%, of the exact order statistic.
+//! min, max, mean and coefficient of variation are exact.
+//!
+class LatencyHistogram
+{
+public:
+    static constexpr int32_t kSUB_BUCKET_BITS{7};
+    static constexpr int32_t kMIN_EXPONENT{-20};
+    static constexpr int32_t kMAX_EXPONENT{20};
+
+    //! Record one sample.
+    void add(float ms);
+
+    //! Forget every sample but keep the bucket storage.
+    void reset() noexcept;
+
+    int64_t count() const noexcept
+    {
+        return mCount;
+    }
+
+    //! Exact mean of the samples.
+    double mean() const noexcept
+    {
+        return mMean;
+    }
+
+    //! Summarize the samples with the same rank conventions as getPerformanceResult().
+    PerformanceResult getResult(std::vector<float> const& percentiles) const;
+
+    //! Value of the sample at the given rank in ascending order, approximated by its bucket midpoint.
+    float valueAtRank(int64_t rank) const noexcept;
+
+private:
+    //! Counts of the sub-buckets of the powers of two from mFirstOctave on, in a single allocation so that recording
+    //! a sample touches a single cache line of counts.
+    std::vector<int64_t> mBuckets;
+    int32_t mFirstOctave{0}; //!< Index of the first power of two in mBuckets, counting from 2^kMIN_EXPONENT.
+    int64_t mUnderflow{0};   //!< Samples below 2^kMIN_EXPONENT, including zeros.
+    int64_t mOverflow{0};    //!< Samples at or above 2^kMAX_EXPONENT.
+    int64_t mCount{0};
+    double mMean{0.0}; //!< Running mean (Welford).
+    double mM2{0.0};   //!< Running sum of squared differences from the mean (Welford).
+    float mMin{0.F};
+    float mMax{0.F};
+};
+
+//!
+//! \class TimingPruner
+//! \brief Decide when a tuning iteration can stop timing because its median compute time cannot beat a target
+//!
+//! Runs a one-sided sign test on the compute times seen so far: if the true median were at or below the target,
+//! every query would be at or below it with probability at least 1/2. Timing stops once fewer queries than that are
+//! below the target by more than kZ standard deviations of the binomial count, which for a route 3x slower than the
+//! best happens after kMIN_SAMPLES queries. Memory and time per sample are constant.
+//!
+class TimingPruner
+{
+public:
+    static constexpr int64_t kMIN_SAMPLES{16};
+    static constexpr double kZ{3.0};
+
+    //! A non-positive or non-finite targetMs disables pruning.
+    explicit TimingPruner(double targetMs) noexcept
+        : mTargetMs(targetMs)
+    {
+    }
+
+    bool isEnabled() const noexcept
+    {
+        return mTargetMs > 0.0 && std::isfinite(mTargetMs);
+    }
+
+    //! \brief Record one compute time.
+    //! \return true once the median is confidently above the target; stays true afterwards.
+    bool add(float computeMs) noexcept;
+
+    int64_t count() const noexcept
+    {
+        return mCount;
+    }
+
+private:
+    double mTargetMs{0.0};
+    int64_t mCount{0};
+    int64_t mAtOrBelow{0}; //!< Number of samples that are at or below the target.
+    bool mPruned{false};
+};
+
+//!
+//! \class InferenceTimeRecorder
+//! \brief Streaming alternative to keeping a std::vector<InferenceTrace> for the performance report
+//!
+//! Folds every trace into one LatencyHistogram per metric as it completes, so memory does not grow with the number
+//! of iterations. When an interval is configured, a short summary of the queries completed in each interval is
+//! printed while inference is running. When a trace file is given, every query after warmup is also appended to it
+//! in the binary trace format. record() may be called concurrently from the inference threads.
+//!
+class InferenceTimeRecorder
+{
+public:
+    enum class Metric : int32_t
+    {
+        kLATENCY = 0,
+        kENQUEUE,
+        kH2D,
+        kCOMPUTE,
+        kD2H,
+        kCOUNT
+    };
+
+    InferenceTimeRecorder(ReportingOptions const& reporting, InferenceOptions const& inference, std::ostream& os,
+        std::string const& traceFileName = "");
+
+    ~InferenceTimeRecorder();
+
+    //! Fold one completed trace into the statistics.
+    void record(InferenceTrace const& trace);
+
+    //! Write out and close the binary trace file, if any. Called once inference has stopped.
+    void finish();
+
+    //! Whether the caller should also keep the raw traces (i.e. streaming statistics were not requested).
+    bool keepTraces() const noexcept
+    {
+        return mKeepTraces;
+    }
+
+    int32_t getWarmups() const noexcept
+    {
+        return mWarmups;
+    }
+
+    int64_t getTimings() const noexcept
+    {
+        return mTotal[0].count();
+    }
+
+    //! Host walltime from the first query after warmup to the end of the last query, in milliseconds.
+    float getBenchTimeMs() const noexcept
+    {
+        return mLastD2hEnd - mFirstH2dStart;
+    }
+
+    //! Mean GPU compute time over every recorded query, warmup included, in milliseconds.
+    double getMeanComputeMs() const noexcept
+    {
+        return mAllQueries ? mAllComputeMs / static_cast<double>(mAllQueries) : 0.0;
+    }
+
+    PerformanceResult getResult(Metric metric, std::vector<float> const& percentiles) const
+    {
+        return mTotal[static_cast<int32_t>(metric)].getResult(percentiles);
+    }
+
+private:
+    using Histograms = std::array<LatencyHistogram, static_cast<size_t>(Metric::kCOUNT)>;
+
+    void printInterval(float endMs);
+
+    std::mutex mMutex;
+    std::ostream& mOs;
+    std::vector<float> mPercentiles;
+    float mWarmupMs{0.F};
+    float mIntervalMs{0.F};
+    int32_t mBatchSize{1};
+    bool mKeepTraces{true};
+
+    std::unique_ptr<TraceFileWriter> mTraceWriter;
+    Histograms mTotal;
+    Histograms mInterval;
+    int32_t mWarmups{0};
+    int64_t mAllQueries{0};
+    double mAllComputeMs{0.0};
+    float mFirstH2dStart{0.F};
+    float mLastH2dStart{0.F};
+    float mLastD2hEnd{0.F};
+    float mIntervalStartMs{0.F};
+};
+
 //!
 //! \brief Print benchmarking time and number of traces collected
 //!
@@ -136,8 +331,14 @@ void printTiming(std::vector<InferenceTime> const& timings, int32_t runsPerAvg,
 //!
 //! \brief Print the performance summary of a trace
 //!
-void printEpilog(std::vector<InferenceTime> const& timings, std::vector<float> const& percentiles, int32_t batchSize,
-    std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose);
+void printEpilog(std::vector<InferenceTime> const& timings, float walltimeMs, std::vector<float> const& percentiles,
+    int32_t batchSize, int32_t infStreams, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose);
+
+//!
+//! \brief Print the performance summary from streaming statistics
+//!
+void printEpilog(InferenceTimeRecorder const& recorder, float walltimeMs, std::vector<float> const& percentiles,
+    int32_t batchSize, int32_t infStreams, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose);
 
 //!
 //! \brief Get the result of a specific performance metric from a trace
@@ -156,6 +357,12 @@ void printMetricExplanations(std::ostream& os);
 void printPerformanceReport(std::vector<InferenceTrace> const& trace, ReportingOptions const& reportingOpts,
     InferenceOptions const& infOpts, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose);
 
+//!
+//! \brief Print and summarize streaming statistics collected by an InferenceTimeRecorder
+//!
+void printPerformanceReport(InferenceTimeRecorder const& recorder, ReportingOptions const& reportingOpts,
+    InferenceOptions const& infOpts, std::ostream& osInfo, std::ostream& osWarning, std::ostream& osVerbose);
+
 //!
 //! \brief Export a timing trace to JSON file
 //!
@@ -187,13 +394,30 @@ void exportJSONOutput(nvinfer1::IExecutionContext const& context, BindingsStd co
 struct LayerProfile
 {
     std::string name;
-    std::vector<float> timeMs;
+    LatencyHistogram times; //!< Times of the layer over the profiled runs.
+};
+
+//!
+//! \struct LayerTimeSummary
+//! \brief Median time of a layer over the profiled runs, with a distribution-free 95% confidence interval
+//!
+struct LayerTimeSummary
+{
+    std::string name;
+    int64_t count{0}; //!< Number of runs the layer was timed in.
+    float medianMs{0.F};
+    float medianLowMs{0.F};  //!< Lower bound of the confidence interval of the median.
+    float medianHighMs{0.F}; //!< Upper bound of the confidence interval of the median.
 };
 
 //!
 //! \class Profiler
 //! \brief Collect per-layer profile information, assuming times are reported in the same order
 //!
+//! The times of every layer, and the total time of every run, are summarized in a LatencyHistogram as they are
+//! reported, so memory does not grow with the number of runs. Totals, averages and percentages are exact up to float
+//! rounding; medians and their confidence intervals are within 0.4% of the exact order statistics.
+//!
 class Profiler : public nvinfer1::IProfiler
 {
 
@@ -207,68 +431,97 @@ public:
     //!
     void exportJSONProfile(std::string const& fileName) const noexcept;
 
+    //!
+    //! \brief Summarize the time distribution of every layer, in the order the layers run
+    //!
+    std::vector<LayerTimeSummary> getLayerSummaries() const;
+
 private:
     float getTotalTime() const noexcept
     {
-        auto const plusLayerTime = [](float accumulator, LayerProfile const& lp) {
-            return accumulator + std::accumulate(lp.timeMs.begin(), lp.timeMs.end(), 0.F, std::plus<float>());
-        };
+        auto const plusLayerTime
+            = [this](float accumulator, LayerProfile const& lp) { return accumulator + getTotalTime(lp); };
         return std::accumulate(mLayers.begin(), mLayers.end(), 0.0F, plusLayerTime);
     }
 
-    float getMedianTime() const noexcept
-    {
-        if (mLayers.empty())
-        {
-            return 0.F;
-        }
-        std::vector<float> totalTime;
-        for (size_t run = 0; run < mLayers[0].timeMs.size(); ++run)
-        {
-            auto const layerTime
-                = [&run](float accumulator, LayerProfile const& lp) { return accumulator + lp.timeMs[run]; };
-            auto t = std::accumulate(mLayers.begin(), mLayers.end(), 0.F, layerTime);
-            totalTime.push_back(t);
-        }
-        return median(totalTime);
-    }
+    //! Median of the sum of the layer times of each run.
+    float getMedianTime() const noexcept;
 
     float getMedianTime(LayerProfile const& p) const noexcept
     {
-        return median(p.timeMs);
-    }
-
-    static float median(std::vector<float> vals)
-    {
-        if (vals.empty())
-        {
-            return 0.F;
-        }
-        std::sort(vals.begin(), vals.end());
-        if (vals.size() % 2U == 1U)
-        {
-            return vals[vals.size() / 2U];
-        }
-        return (vals[vals.size() / 2U - 1U] + vals[vals.size() / 2U]) * 0.5F;
+        return p.times.count() == 0 ? 0.F : p.times.getResult({}).median;
     }
 
     //! return the total runtime of given layer profile
     float getTotalTime(LayerProfile const& p) const noexcept
     {
-        auto const& vals = p.timeMs;
-        return std::accumulate(vals.begin(), vals.end(), 0.F, std::plus<float>());
+        return static_cast<float>(p.times.mean() * static_cast<double>(p.times.count()));
     }
 
     float getAvgTime(LayerProfile const& p) const noexcept
     {
-        return getTotalTime(p) / p.timeMs.size();
+        return static_cast<float>(p.times.mean());
     }
 
     std::vector<LayerProfile> mLayers;
     std::vector<LayerProfile>::iterator mIterator{mLayers.begin()};
     int32_t mUpdatesCount{0};
+    LatencyHistogram mRunTimes; //!< Sum of the layer times of each completed run.
+    float mRunTimeMs{0.F};      //!< Sum of the layer times of the current run.
 };
 
+//!
+//! \struct LayerTimeChange
+//! \brief A layer whose median time differs significantly between a baseline and the current profile
+//!
+struct LayerTimeChange
+{
+    std::string name;
+    float baselineMs{0.F};
+    float currentMs{0.F};
+    float changePercent{0.F}; //!< Positive for a regression.
+    double pValue{1.0};
+};
+
+//!
+//! \struct ProfileComparison
+//! \brief Result of comparing the layer times of two profiles
+//!
+struct ProfileComparison
+{
+    std::vector<LayerTimeChange> regressions;  //!< Sorted from the largest change.
+    std::vector<LayerTimeChange> improvements; //!< Sorted from the largest change.
+    int32_t nbCompared{0};                     //!< Number of layers found in both profiles.
+    std::vector<std::string> onlyInBaseline;
+    std::vector<std::string> onlyInCurrent;
+
+    //! Whether a significant regression is larger than thresholdPercent.
+    bool hasRegressionAbove(float thresholdPercent) const;
+};
+
+//!
+//! \brief Load the layer summaries of a profile written by --exportProfile
+//!
+//! \return false if the file cannot be parsed or was written without the confidence intervals of the medians.
+//!
+bool loadLayerSummaries(std::string const& fileName, std::vector<LayerTimeSummary>& summaries);
+
+//!
+//! \brief Compare the median time of every layer of two profiles
+//!
+//! Layers are matched by name, and repeated names by order of appearance. The difference of the medians is tested
+//! against the standard errors derived from their confidence intervals. A change is significant when its two-sided
+//! p-value is below significance divided by the number of compared layers (Bonferroni correction), so that a large
+//! network does not report changes by chance.
+//!
+ProfileComparison compareLayerProfiles(std::vector<LayerTimeSummary> const& baseline,
+    std::vector<LayerTimeSummary> const& current, double significance = 0.05);
+
+//!
+//! \brief Print the significant changes of a comparison
+//!
+void printProfileComparison(ProfileComparison const& comparison, float thresholdPercent, std::ostream& os);
+
 //!
 //! \brief Print layer info to logger or export it to output JSON file.
 //!
@@ -288,6 +541,14 @@ struct InferenceEnvironmentBase;
 //!
 void printPerformanceProfile(ReportingOptions const& reporting, InferenceEnvironmentBase& iEnv);
 
+//!
+//! \brief Compare the per-layer profile of the run with the baseline given by --compareProfile.
+//!
+//! \return false if the baseline cannot be loaded or a layer regressed significantly by more than
+//!         --compareProfileThreshold.
+//!
+bool compareWithBaselineProfile(ReportingOptions const& reporting, Profiler const& profiler);
+
 //!
 //! \brief Print binding output values to logger or export them to output JSON file.
 //!
@@ -0,0 +1,256 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sampleReporting.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <sstream>
+
+using namespace sample;
+
+namespace
+{
+std::vector<float> const kPERCENTILES{0.F, 50.F, 90.F, 99.F, 100.F};
+//! Upper bound of the relative error of a bucket midpoint.
+constexpr float kRELATIVE_ERROR{1.F / (1 << (LatencyHistogram::kSUB_BUCKET_BITS + 1))};
+} // namespace
+
+TEST(LatencyHistogram, Empty)
+{
+    LatencyHistogram h;
+    auto const r = h.getResult(kPERCENTILES);
+    EXPECT_EQ(h.count(), 0);
+    EXPECT_TRUE(std::isinf(r.median));
+    ASSERT_EQ(r.percentiles.size(), kPERCENTILES.size());
+    EXPECT_TRUE(std::isinf(r.percentiles.back()));
+    EXPECT_EQ(r.coeffVar, 0.F);
+}
+
+TEST(LatencyHistogram, ZerosAreExact)
+{
+    LatencyHistogram h;
+    for (int32_t i = 0; i < 10; ++i)
+    {
+        h.add(0.F);
+    }
+    auto const r = h.getResult(kPERCENTILES);
+    EXPECT_EQ(r.min, 0.F);
+    EXPECT_EQ(r.max, 0.F);
+    EXPECT_EQ(r.median, 0.F);
+    EXPECT_EQ(r.percentiles[3], 0.F);
+    EXPECT_TRUE(std::isinf(r.coeffVar));
+}
+
+TEST(LatencyHistogram, MatchesSortedTrace)
+{
+    std::mt19937 gen(42);
+    std::lognormal_distribution<float> dist(0.F, 0.5F);
+    std::vector<InferenceTime> timings;
+    LatencyHistogram h;
+    for (int32_t i = 0; i < 10001; ++i)
+    {
+        float const v = dist(gen);
+        timings.emplace_back(0.F, 0.F, v, 0.F);
+        h.add(v);
+    }
+
+    auto const exact
+        = getPerformanceResult(timings, [](InferenceTime const& t) { return t.compute; }, kPERCENTILES);
+    auto const approx = h.getResult(kPERCENTILES);
+
+    EXPECT_EQ(approx.min, exact.min);
+    EXPECT_EQ(approx.max, exact.max);
+    EXPECT_NEAR(approx.mean, exact.mean, 1e-3F * exact.mean);
+    EXPECT_NEAR(approx.coeffVar, exact.coeffVar, 1e-2F * exact.coeffVar);
+    EXPECT_NEAR(approx.median, exact.median, kRELATIVE_ERROR * exact.median);
+    ASSERT_EQ(approx.percentiles.size(), exact.percentiles.size());
+    for (size_t i = 0; i < exact.percentiles.size(); ++i)
+    {
+        EXPECT_NEAR(approx.percentiles[i], exact.percentiles[i], kRELATIVE_ERROR * exact.percentiles[i]);
+    }
+}
+
+TEST(LatencyHistogram, Reset)
+{
+    LatencyHistogram h;
+    h.add(5.F);
+    h.add(7.F);
+    h.reset();
+    h.add(1.F);
+    auto const r = h.getResult(kPERCENTILES);
+    EXPECT_EQ(h.count(), 1);
+    EXPECT_EQ(r.min, 1.F);
+    EXPECT_EQ(r.max, 1.F);
+    EXPECT_EQ(r.median, 1.F);
+}
+
+TEST(InferenceTimeRecorder, SkipsWarmupAndPrintsIntervals)
+{
+    ReportingOptions reporting;
+    reporting.streamingStats = true;
+    reporting.reportInterval = 1.F;
+    InferenceOptions inference;
+    inference.warmup = 100.F;
+    std::ostringstream os;
+    InferenceTimeRecorder recorder(reporting, inference, os);
+
+    // One query every 10 ms for 3 s, each with 2 ms of compute.
+    for (int32_t i = 0; i < 300; ++i)
+    {
+        float const start = 10.F * i;
+        recorder.record(InferenceTrace(0, start, start, start, start, start, start + 2.F, start + 2.F, start + 2.F));
+    }
+
+    EXPECT_FALSE(recorder.keepTraces());
+    EXPECT_EQ(recorder.getWarmups(), 10);
+    EXPECT_EQ(recorder.getTimings(), 290);
+    EXPECT_FLOAT_EQ(recorder.getBenchTimeMs(), 2992.F - 100.F);
+    EXPECT_FLOAT_EQ(recorder.getMeanComputeMs(), 2.F);
+    auto const compute = recorder.getResult(InferenceTimeRecorder::Metric::kCOMPUTE, kPERCENTILES);
+    EXPECT_EQ(compute.median, 2.F);
+
+    std::string const log = os.str();
+    size_t intervals{0};
+    for (size_t pos = log.find("Interval ["); pos != std::string::npos; pos = log.find("Interval [", pos + 1))
+    {
+        ++intervals;
+    }
+    EXPECT_EQ(intervals, 2U);
+}
+
+TEST(TimingPruner, PrunesOnlyRoutesSlowerThanTheTarget)
+{
+    TimingPruner disabled(std::numeric_limits<double>::infinity());
+    EXPECT_FALSE(disabled.isEnabled());
+    EXPECT_FALSE(disabled.add(100.F));
+
+    // A route 3x slower than the target stops after the minimum number of queries.
+    TimingPruner slow(1.0);
+    int64_t queries{0};
+    while (!slow.add(3.F))
+    {
+        ++queries;
+    }
+    EXPECT_EQ(queries + 1, TimingPruner::kMIN_SAMPLES);
+    EXPECT_TRUE(slow.add(0.5F));
+
+    // A noisy route that is slightly faster than the target is timed to the end.
+    std::mt19937 gen(42);
+    std::normal_distribution<float> dist(0.95F, 0.1F);
+    TimingPruner faster(1.0);
+    for (int32_t i = 0; i < 10000; ++i)
+    {
+        ASSERT_FALSE(faster.add(dist(gen)));
+    }
+    EXPECT_EQ(faster.count(), 10000);
+}
+
+TEST(Profiler, LayerSummariesBoundTheMedian)
+{
+    Profiler profiler;
+    for (int32_t run = 0; run < 101; ++run)
+    {
+        profiler.reportLayerTime("conv", 1.F + 0.01F * static_cast<float>((run * 37) % 101));
+        profiler.reportLayerTime("relu", 0.5F);
+    }
+
+    auto const summaries = profiler.getLayerSummaries();
+    ASSERT_EQ(summaries.size(), 2U);
+    EXPECT_EQ(summaries[0].name, "conv");
+    EXPECT_EQ(summaries[0].count, 101);
+    EXPECT_NEAR(summaries[0].medianMs, 1.5F, 1.5F * kRELATIVE_ERROR);
+    // Ranks 50 -+ 0.98 * sqrt(101) of the 101 sorted times.
+    EXPECT_NEAR(summaries[0].medianLowMs, 1.4F, 1.4F * kRELATIVE_ERROR);
+    EXPECT_NEAR(summaries[0].medianHighMs, 1.6F, 1.6F * kRELATIVE_ERROR);
+    EXPECT_EQ(summaries[1].medianLowMs, 0.5F);
+    EXPECT_EQ(summaries[1].medianHighMs, 0.5F);
+
+    auto const path = (std::filesystem::temp_directory_path() / "trt_profile_summaries.json").string();
+    profiler.exportJSONProfile(path);
+    std::vector<LayerTimeSummary> loaded;
+    ASSERT_TRUE(loadLayerSummaries(path, loaded));
+    std::remove(path.c_str());
+    ASSERT_EQ(loaded.size(), 2U);
+    EXPECT_EQ(loaded[0].name, "conv");
+    EXPECT_EQ(loaded[0].count, 101);
+    EXPECT_NEAR(loaded[0].medianHighMs, summaries[0].medianHighMs, 1e-5F);
+}
+
+TEST(Profiler, PrintsTotalsAndMediansOfRuns)
+{
+    Profiler profiler;
+    // Run i takes 1 + i ms in conv and 2 ms in relu, so the median run takes 1 + 50 + 2 ms.
+    for (int32_t run = 0; run < 101; ++run)
+    {
+        profiler.reportLayerTime("conv", 1.F + static_cast<float>(run));
+        profiler.reportLayerTime("relu", 2.F);
+    }
+    std::ostringstream os;
+    profiler.print(os);
+
+    std::istringstream lines(os.str());
+    std::string line;
+    float totalMs{0.F};
+    float avgMs{0.F};
+    float medianMs{0.F};
+    float percentage{0.F};
+    std::string name;
+    while (std::getline(lines, line))
+    {
+        std::istringstream(line) >> totalMs >> avgMs >> medianMs >> percentage >> name;
+        if (name == "Total")
+        {
+            break;
+        }
+    }
+    ASSERT_EQ(name, "Total");
+    EXPECT_FLOAT_EQ(totalMs, 101.F + 5050.F + 202.F);
+    EXPECT_FLOAT_EQ(avgMs, 53.F);
+    EXPECT_NEAR(medianMs, 53.F, 53.F * kRELATIVE_ERROR);
+}
+
+TEST(Profiler, CompareReportsOnlySignificantChanges)
+{
+    std::vector<LayerTimeSummary> const baseline{{"conv", 100, 1.F, 0.99F, 1.01F}, {"relu", 100, 1.F, 0.99F, 1.01F},
+        {"pool", 100, 1.F, 0.5F, 1.5F}, {"gemm", 100, 2.F, 1.98F, 2.02F}, {"gemm", 100, 1.F, 0.99F, 1.01F},
+        {"removed", 100, 1.F, 0.99F, 1.01F}};
+    std::vector<LayerTimeSummary> const current{{"conv", 100, 1.2F, 1.19F, 1.21F}, {"relu", 100, 1.F, 0.99F, 1.01F},
+        {"pool", 100, 1.2F, 0.7F, 1.7F}, {"gemm", 100, 2.F, 1.98F, 2.02F}, {"gemm", 100, 0.9F, 0.89F, 0.91F},
+        {"added", 100, 1.F, 0.99F, 1.01F}};
+
+    auto const comparison = compareLayerProfiles(baseline, current);
+    EXPECT_EQ(comparison.nbCompared, 5);
+    // pool is 20% slower, but its times are too noisy for that to be significant.
+    ASSERT_EQ(comparison.regressions.size(), 1U);
+    EXPECT_EQ(comparison.regressions[0].name, "conv");
+    EXPECT_NEAR(comparison.regressions[0].changePercent, 20.F, 1e-3F);
+    // The second gemm is matched with the second gemm of the baseline.
+    ASSERT_EQ(comparison.improvements.size(), 1U);
+    EXPECT_EQ(comparison.improvements[0].name, "gemm");
+    EXPECT_NEAR(comparison.improvements[0].changePercent, -10.F, 1e-3F);
+    EXPECT_EQ(comparison.onlyInBaseline, std::vector<std::string>{"removed"});
+    EXPECT_EQ(comparison.onlyInCurrent, std::vector<std::string>{"added"});
+
+    EXPECT_TRUE(comparison.hasRegressionAbove(10.F));
+    EXPECT_FALSE(comparison.hasRegressionAbove(25.F));
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sampleTraceFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace sample
+{
+
+static_assert(sizeof(TraceFileHeader) == 32, "TraceFileHeader layout must not change within a version");
+
+TraceFileWriter::TraceFileWriter(std::string const& fileName, float warmupMs, uint32_t blockCapacity)
+    : mFile(fileName, std::ios::binary | std::ios::trunc)
+    , mBlockCapacity(std::max<uint32_t>(blockCapacity, 1))
+    , mBlock(static_cast<size_t>(mBlockCapacity) * kTRACE_FILE_NB_COLUMNS)
+{
+    TraceFileHeader header{};
+    std::memcpy(header.magic, kTRACE_FILE_MAGIC, sizeof(header.magic));
+    header.version = kTRACE_FILE_VERSION;
+    header.headerSize = sizeof(TraceFileHeader);
+    header.nbColumns = kTRACE_FILE_NB_COLUMNS;
+    header.blockCapacity = mBlockCapacity;
+    header.warmupMs = warmupMs;
+    mFile.write(reinterpret_cast<char const*>(&header), sizeof(header));
+}
+
+TraceFileWriter::~TraceFileWriter()
+{
+    flush();
+}
+
+void TraceFileWriter::append(InferenceTrace const& trace)
+{
+    float const values[kTRACE_FILE_NB_COLUMNS] = {static_cast<float>(trace.stream), trace.enqStart, trace.enqEnd,
+        trace.h2dStart, trace.h2dEnd, trace.computeStart, trace.computeEnd, trace.d2hStart, trace.d2hEnd};
+    for (int32_t c = 0; c < kTRACE_FILE_NB_COLUMNS; ++c)
+    {
+        mBlock[static_cast<size_t>(c) * mBlockCapacity + mCount] = values[c];
+    }
+    if (++mCount == mBlockCapacity)
+    {
+        flush();
+    }
+}
+
+void TraceFileWriter::flush()
+{
+    if (mCount == 0 || !mFile.is_open())
+    {
+        return;
+    }
+    mFile.write(reinterpret_cast<char const*>(&mCount), sizeof(mCount));
+    for (int32_t c = 0; c < kTRACE_FILE_NB_COLUMNS; ++c)
+    {
+        mFile.write(reinterpret_cast<char const*>(mBlock.data() + static_cast<size_t>(c) * mBlockCapacity),
+            static_cast<std::streamsize>(mCount * sizeof(float)));
+    }
+    mFile.flush();
+    mCount = 0;
+}
+
+TraceFileReader::TraceFileReader(std::string const& fileName)
+    : mFile(fileName, std::ios::binary)
+{
+    if (!mFile)
+    {
+        throw std::runtime_error("Cannot open trace file " + fileName);
+    }
+    mFile.read(reinterpret_cast<char*>(&mHeader), sizeof(mHeader));
+    if (!mFile || std::memcmp(mHeader.magic, kTRACE_FILE_MAGIC, sizeof(mHeader.magic)) != 0)
+    {
+        throw std::runtime_error(fileName + " is not a binary trtexec trace");
+    }
+    if (mHeader.version != kTRACE_FILE_VERSION || mHeader.headerSize < sizeof(TraceFileHeader)
+        || mHeader.nbColumns != static_cast<uint32_t>(kTRACE_FILE_NB_COLUMNS) || mHeader.blockCapacity == 0)
+    {
+        throw std::runtime_error(fileName + " has an unsupported trace file version or layout");
+    }
+    mFile.seekg(mHeader.headerSize);
+    mBlock.resize(static_cast<size_t>(mHeader.blockCapacity) * kTRACE_FILE_NB_COLUMNS);
+}
+
+bool TraceFileReader::nextBlock(std::vector<InferenceTrace>& traces)
+{
+    traces.clear();
+    uint32_t count{0};
+    if (!mFile.read(reinterpret_cast<char*>(&count), sizeof(count)) || count == 0 || count > mHeader.blockCapacity)
+    {
+        return false;
+    }
+    auto const bytes = static_cast<std::streamsize>(static_cast<size_t>(count) * kTRACE_FILE_NB_COLUMNS * sizeof(float));
+    if (!mFile.read(reinterpret_cast<char*>(mBlock.data()), bytes))
+    {
+        return false;
+    }
+
+    auto const column = [&](TraceColumn c, uint32_t i) { return mBlock[static_cast<size_t>(c) * count + i]; };
+    traces.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        traces.emplace_back(static_cast<int32_t>(column(TraceColumn::kSTREAM, i)),
+            column(TraceColumn::kENQ_START, i), column(TraceColumn::kENQ_END, i), column(TraceColumn::kH2D_START, i),
+            column(TraceColumn::kH2D_END, i), column(TraceColumn::kCOMPUTE_START, i),
+            column(TraceColumn::kCOMPUTE_END, i), column(TraceColumn::kD2H_START, i), column(TraceColumn::kD2H_END, i));
+    }
+    return true;
+}
+
+} // namespace sample
@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRT_SAMPLE_TRACE_FILE_H
+#define TRT_SAMPLE_TRACE_FILE_H
+
+#include "sampleReporting.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace sample
+{
+
+//!
+//! Binary timing trace written by --exportTimes with --exportTimesFormat=binary.
+//!
+//! Layout (little-endian):
+//!   TraceFileHeader
+//!   block*: uint32_t nbRecords, then nbRecords float32 values for each TraceColumn in order
+//!
+//! Records are appended as queries complete, so they are in completion order rather than sorted by start time.
+//! Each block is self-describing, which lets readers stream the file block by block and stop cleanly at a block
+//! that was only partially written because the run was interrupted.
+//!
+constexpr char kTRACE_FILE_MAGIC[8] = {'T', 'R', 'T', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t kTRACE_FILE_VERSION{1};
+constexpr uint32_t kTRACE_FILE_DEFAULT_BLOCK_RECORDS{4096};
+
+//!
+//! \enum TraceColumn
+//! \brief Columns of a binary trace block; all times are in milliseconds since the start of inference.
+//!
+enum class TraceColumn : int32_t
+{
+    kSTREAM = 0,
+    kENQ_START,
+    kENQ_END,
+    kH2D_START,
+    kH2D_END,
+    kCOMPUTE_START,
+    kCOMPUTE_END,
+    kD2H_START,
+    kD2H_END,
+    kCOUNT
+};
+
+constexpr int32_t kTRACE_FILE_NB_COLUMNS{static_cast<int32_t>(TraceColumn::kCOUNT)};
+
+//!
+//! \struct TraceFileHeader
+//! \brief Fixed-size header at the start of a binary trace file
+//!
+struct TraceFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;    //!< sizeof(TraceFileHeader), so that later versions can append fields.
+    uint32_t nbColumns;     //!< Number of columns in every block.
+    uint32_t blockCapacity; //!< Maximum number of records in one block.
+    float warmupMs;         //!< Warmup duration of the run; warmup queries are not written.
+    uint32_t reserved;
+};
+
+//!
+//! \class TraceFileWriter
+//! \brief Append InferenceTraces to a binary trace file, one column-major block at a time
+//!
+class TraceFileWriter
+{
+public:
+    TraceFileWriter(
+        std::string const& fileName, float warmupMs, uint32_t blockCapacity = kTRACE_FILE_DEFAULT_BLOCK_RECORDS);
+
+    //! Writes the pending partial block.
+    ~TraceFileWriter();
+
+    TraceFileWriter(TraceFileWriter const&) = delete;
+    TraceFileWriter& operator=(TraceFileWriter const&) = delete;
+
+    bool isOpen() const
+    {
+        return mFile.is_open() && mFile.good();
+    }
+
+    void append(InferenceTrace const& trace);
+
+    //! Write the pending records as a (possibly partial) block.
+    void flush();
+
+private:
+    std::ofstream mFile;
+    uint32_t mBlockCapacity{0};
+    uint32_t mCount{0};
+    std::vector<float> mBlock; //!< mBlockCapacity values per column, column after column.
+};
+
+//!
+//! \class TraceFileReader
+//! \brief Stream a binary trace file block by block without loading it entirely
+//!
+class TraceFileReader
+{
+public:
+    //! Throws std::runtime_error if the file cannot be opened or does not start with a valid header.
+    explicit TraceFileReader(std::string const& fileName);
+
+    float getWarmupMs() const
+    {
+        return mHeader.warmupMs;
+    }
+
+    //!
+    //! \brief Read the next block into traces, replacing its content
+    //! \return false at the end of the file or at a truncated trailing block.
+    //!
+    bool nextBlock(std::vector<InferenceTrace>& traces);
+
+private:
+    std::ifstream mFile;
+    TraceFileHeader mHeader{};
+    std::vector<float> mBlock;
+};
+
+} // namespace sample
+
+#endif // TRT_SAMPLE_TRACE_FILE_H
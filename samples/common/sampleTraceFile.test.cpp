@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sampleTraceFile.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace sample;
+
+namespace
+{
+std::string tempTracePath(char const* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+InferenceTrace makeTrace(int32_t i)
+{
+    float const t = static_cast<float>(i);
+    return InferenceTrace(i % 3, t, t + 0.1F, t + 0.2F, t + 0.3F, t + 0.4F, t + 0.5F, t + 0.6F, t + 0.7F);
+}
+} // namespace
+
+TEST(TraceFile, RoundTripAcrossBlocks)
+{
+    auto const path = tempTracePath("trt_trace_roundtrip.bin");
+    {
+        TraceFileWriter writer(path, 200.F, 16);
+        ASSERT_TRUE(writer.isOpen());
+        for (int32_t i = 0; i < 40; ++i)
+        {
+            writer.append(makeTrace(i));
+        }
+    }
+
+    TraceFileReader reader(path);
+    EXPECT_EQ(reader.getWarmupMs(), 200.F);
+    std::vector<InferenceTrace> block;
+    int32_t i = 0;
+    int32_t nbBlocks = 0;
+    while (reader.nextBlock(block))
+    {
+        ++nbBlocks;
+        for (auto const& t : block)
+        {
+            auto const expected = makeTrace(i++);
+            EXPECT_EQ(t.stream, expected.stream);
+            EXPECT_EQ(t.enqStart, expected.enqStart);
+            EXPECT_EQ(t.h2dEnd, expected.h2dEnd);
+            EXPECT_EQ(t.computeStart, expected.computeStart);
+            EXPECT_EQ(t.d2hEnd, expected.d2hEnd);
+        }
+    }
+    EXPECT_EQ(i, 40);
+    EXPECT_EQ(nbBlocks, 3);
+    std::remove(path.c_str());
+}
+
+TEST(TraceFile, TruncatedBlockIsIgnored)
+{
+    auto const path = tempTracePath("trt_trace_truncated.bin");
+    {
+        TraceFileWriter writer(path, 0.F, 8);
+        for (int32_t i = 0; i < 12; ++i)
+        {
+            writer.append(makeTrace(i));
+        }
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 5);
+
+    TraceFileReader reader(path);
+    std::vector<InferenceTrace> block;
+    ASSERT_TRUE(reader.nextBlock(block));
+    EXPECT_EQ(block.size(), 8U);
+    EXPECT_FALSE(reader.nextBlock(block));
+    EXPECT_TRUE(block.empty());
+    std::remove(path.c_str());
+}
+
+TEST(TraceFile, RejectsOtherFiles)
+{
+    auto const path = tempTracePath("trt_trace_json.bin");
+    {
+        std::ofstream os(path);
+        os << "[\n  { \"startEnqMs\" : 0 }\n]\n";
+    }
+    EXPECT_THROW(TraceFileReader{path}, std::runtime_error);
+    std::remove(path.c_str());
+}
@@ -20,7 +20,10 @@
 #include "nlohmann/json.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <iomanip>
+#include <limits>
 #include <set>
 #include <sstream>
 #include <unordered_set>
@@ -453,6 +456,7 @@ BigInt TuningContext::count() const
     switch (searchAlgorithm)
     {
     case TuningSearchAlgorithm::kEXHAUSTIVE:
+    case TuningSearchAlgorithm::kADAPTIVE:
     {
         // Product of all value list sizes
         BigInt total(1);
@@ -514,6 +518,7 @@ std::string TuningContext::getPathAtIndex(BigInt const& index) const
     switch (searchAlgorithm)
     {
     case TuningSearchAlgorithm::kEXHAUSTIVE:
+    case TuningSearchAlgorithm::kADAPTIVE:
     {
         // Reverse mixed-radix decomposition: decompose index into per-knob value indices.
         // Work from right to left (least significant to most significant).
@@ -569,6 +574,179 @@ std::string TuningContext::getPathAtIndex(BigInt const& index) const
     }
 }
 
+// ============================================================================
+// TuningRouteIterator Implementation
+// ============================================================================
+
+TuningRouteIterator::TuningRouteIterator(TuningContext const& ctx, BigInt const& start)
+    : mCtx(ctx)
+    , mCount(ctx.count())
+    , mKnobOffsets(ctx.parsedExprs.size(), 0)
+{
+    if (isFastExpansion())
+    {
+        ASSERT(mCtx.parsedExprs.size() == mCtx.defaultValues.size());
+    }
+    seek(start);
+}
+
+std::string const& TuningRouteIterator::path() const
+{
+    if (done())
+    {
+        throw std::out_of_range("Index " + mIndex.toString() + " is out of range [0, " + mCount.toString() + ")");
+    }
+    return mPath;
+}
+
+void TuningRouteIterator::next()
+{
+    ++mIndex;
+    if (done())
+    {
+        return;
+    }
+
+    if (isFastExpansion())
+    {
+        // Variations never move back to a knob on the right, so the new varied knob is the first one that changed.
+        bool const found = mVariedKnob < 0
+            ? findVariation(static_cast<int64_t>(mCtx.parsedExprs.size()) - 1, 0)
+            : findVariation(mVariedKnob, mVariedPosition + 1);
+        ASSERT(found);
+        rebuildPath(static_cast<uint64_t>(mVariedKnob));
+        return;
+    }
+
+    // Odometer step: the last knob moves fastest, as in the mixed-radix decomposition of getPathAtIndex.
+    uint64_t knob = mPositions.size() - 1;
+    while (++mPositions[knob] == mCtx.parsedExprs[knob].mValues.size())
+    {
+        mPositions[knob] = 0;
+        ASSERT(knob > 0); // Wrapping the first knob means index == count, handled by done() above.
+        --knob;
+    }
+    rebuildPath(knob);
+}
+
+void TuningRouteIterator::seek(BigInt const& index)
+{
+    mIndex = index;
+    if (done())
+    {
+        return;
+    }
+
+    if (isFastExpansion())
+    {
+        mVariedKnob = -1;
+        mVariedPosition = 0;
+        if (!index.isZero())
+        {
+            // Same walk as identifyVariedKnob, but skipping whole knobs at a time.
+            BigInt remaining = index;
+            --remaining;
+            for (int64_t i = static_cast<int64_t>(mCtx.parsedExprs.size()) - 1; i >= 0 && mVariedKnob < 0; --i)
+            {
+                auto const& expr = mCtx.parsedExprs[i];
+                if (expr.mIsFixed)
+                {
+                    continue;
+                }
+                auto const nbVariations = static_cast<uint64_t>(
+                    std::count_if(expr.mValues.begin(), expr.mValues.end(),
+                        [&](std::string const& value) { return value != mCtx.defaultValues[i]; }));
+                if (!(remaining < BigInt{nbVariations}))
+                {
+                    remaining -= BigInt{nbVariations};
+                    continue;
+                }
+                // remaining now fits in a word: skip that many non-default values of this knob.
+                uint64_t toSkip = remaining.toUint64();
+                bool const found = findVariation(i, 0);
+                ASSERT(found);
+                while (toSkip-- > 0)
+                {
+                    findVariation(i, mVariedPosition + 1);
+                }
+            }
+            ASSERT(mVariedKnob >= 0);
+        }
+        rebuildPath(0);
+        return;
+    }
+
+    // Reverse mixed-radix decomposition, once per seek.
+    mPositions.assign(mCtx.parsedExprs.size(), 0);
+    BigInt current = index;
+    for (int64_t i = static_cast<int64_t>(mCtx.parsedExprs.size()) - 1; i >= 0 && !current.isZero(); --i)
+    {
+        auto [quotient, remainder] = BigInt::divideWithRemainder(current, BigInt{mCtx.parsedExprs[i].mValues.size()});
+        mPositions[i] = remainder.toUint64();
+        current = quotient;
+    }
+    rebuildPath(0);
+}
+
+bool TuningRouteIterator::isFastExpansion() const noexcept
+{
+    return mCtx.searchAlgorithm == TuningSearchAlgorithm::kFAST
+        || mCtx.searchAlgorithm == TuningSearchAlgorithm::kMIXED;
+}
+
+std::string const& TuningRouteIterator::valueAt(uint64_t knob) const
+{
+    auto const& expr = mCtx.parsedExprs[knob];
+    if (!isFastExpansion())
+    {
+        return expr.mValues[mPositions[knob]];
+    }
+    if (static_cast<int64_t>(knob) == mVariedKnob)
+    {
+        return expr.mValues[mVariedPosition];
+    }
+    return expr.mIsFixed ? expr.mValues[0] : mCtx.defaultValues[knob];
+}
+
+bool TuningRouteIterator::findVariation(int64_t knob, uint64_t position)
+{
+    for (int64_t i = knob; i >= 0; --i, position = 0)
+    {
+        auto const& expr = mCtx.parsedExprs[i];
+        if (expr.mIsFixed)
+        {
+            continue;
+        }
+        for (uint64_t p = position; p < expr.mValues.size(); ++p)
+        {
+            if (expr.mValues[p] != mCtx.defaultValues[i])
+            {
+                mVariedKnob = i;
+                mVariedPosition = p;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void TuningRouteIterator::rebuildPath(uint64_t firstChangedKnob)
+{
+    // Same format as getPathAtIndex: space-separated knob=value pairs.
+    mPath.resize(mKnobOffsets[firstChangedKnob]);
+    for (uint64_t j = firstChangedKnob; j < mCtx.parsedExprs.size(); ++j)
+    {
+        mKnobOffsets[j] = mPath.size();
+        if (j > 0)
+        {
+            mPath += ' ';
+        }
+        mPath += mCtx.parsedExprs[j].mKnobName;
+        mPath += '=';
+        mPath += valueAt(j);
+    }
+}
+
 // ============================================================================
 // Mixed Search Phase 2 Context Builder
 // ============================================================================
@@ -662,6 +840,248 @@ std::optional<std::pair<int32_t, std::string>> identifyVariedKnob(TuningContext
     return std::nullopt; // Index out of range
 }
 
+// ============================================================================
+// Adaptive Search
+// ============================================================================
+
+namespace
+{
+//! Running sum of the residual GPU time (time - mean) of the successful routes that use one knob value.
+struct KnobValueStats
+{
+    double residualSum{0.0};
+    int64_t successes{0};
+};
+} // namespace
+
+AdaptiveRouteSearch::AdaptiveRouteSearch(TuningContext const& ctx, BigInt const& budget, uint64_t seed)
+    : mCtx(ctx)
+    , mSpaceSize(ctx.count())
+    , mBudget(budget < mSpaceSize ? budget : mSpaceSize)
+    , mRng(seed)
+{
+    mBaseline.resize(ctx.parsedExprs.size(), 0);
+    mFailures.resize(ctx.parsedExprs.size());
+    for (uint64_t k = 0; k < ctx.parsedExprs.size(); ++k)
+    {
+        auto const& values = ctx.parsedExprs[k].mValues;
+        mFailures[k].resize(values.size(), 0);
+        if (!ctx.parsedExprs[k].mIsFixed && k < ctx.defaultValues.size())
+        {
+            auto const it = std::find(values.begin(), values.end(), ctx.defaultValues[k]);
+            mBaseline[k] = it != values.end() ? static_cast<uint64_t>(it - values.begin()) : 0;
+        }
+    }
+}
+
+AdaptiveRouteSearch::Values AdaptiveRouteSearch::decompose(BigInt const& index) const
+{
+    Values values(mCtx.parsedExprs.size());
+    BigInt current = index;
+    for (int64_t k = static_cast<int64_t>(values.size()) - 1; k >= 0; --k)
+    {
+        BigInt const base(mCtx.parsedExprs[k].mValues.size());
+        values[k] = (current % base).toUint64();
+        current = current / base;
+    }
+    return values;
+}
+
+BigInt AdaptiveRouteSearch::compose(Values const& values) const
+{
+    BigInt index{0};
+    for (uint64_t k = 0; k < values.size(); ++k)
+    {
+        index = index * BigInt(mCtx.parsedExprs[k].mValues.size()) + BigInt(values[k]);
+    }
+    return index;
+}
+
+std::optional<AdaptiveRouteSearch::Values> AdaptiveRouteSearch::pickCandidate()
+{
+    uint64_t const nbKnobs = mCtx.parsedExprs.size();
+
+    // Surrogate statistics. Before the first success, penalties and bonuses are scaled by a nominal 1 ms.
+    double mean{1.0};
+    if (!mSuccesses.empty())
+    {
+        mean = 0.0;
+        for (auto const& success : mSuccesses)
+        {
+            mean += success.second;
+        }
+        mean /= static_cast<double>(mSuccesses.size());
+    }
+    std::vector<std::vector<KnobValueStats>> stats(nbKnobs);
+    for (uint64_t k = 0; k < nbKnobs; ++k)
+    {
+        stats[k].resize(mCtx.parsedExprs[k].mValues.size());
+    }
+    for (auto const& [values, gpuTimeMs] : mSuccesses)
+    {
+        for (uint64_t k = 0; k < nbKnobs; ++k)
+        {
+            stats[k][values[k]].residualSum += gpuTimeMs - mean;
+            ++stats[k][values[k]].successes;
+        }
+    }
+    double const logTried = std::log(1.0 + static_cast<double>(mTried.size()));
+
+    auto const score = [&](Values const& values) {
+        double predicted = mean;
+        for (uint64_t k = 0; k < nbKnobs; ++k)
+        {
+            if (mCtx.parsedExprs[k].mValues.size() < 2)
+            {
+                continue;
+            }
+            auto const& s = stats[k][values[k]];
+            int64_t const failures = mFailures[k][values[k]];
+            int64_t const tries = s.successes + failures;
+            if (s.successes > 0)
+            {
+                predicted += s.residualSum / static_cast<double>(s.successes);
+            }
+            if (tries > 0)
+            {
+                predicted += mean * static_cast<double>(failures) / static_cast<double>(tries);
+            }
+            predicted -= kAdaptiveSearchExploration * mean * std::sqrt(logTried / static_cast<double>(1 + tries));
+        }
+        return predicted;
+    };
+
+    std::optional<Values> best;
+    double bestScore{std::numeric_limits<double>::infinity()};
+    auto const consider = [&](Values const& values) {
+        if (mTried.count(values) != 0)
+        {
+            return;
+        }
+        double const s = score(values);
+        if (s < bestScore)
+        {
+            bestScore = s;
+            best = values;
+        }
+    };
+
+    // One-knob neighbours of the incumbent explore interactions with the knob values already chosen.
+    Values const& incumbent = mBest ? mBest->first : mBaseline;
+    for (uint64_t k = 0; k < nbKnobs; ++k)
+    {
+        Values neighbour = incumbent;
+        for (uint64_t v = 0; v < mCtx.parsedExprs[k].mValues.size(); ++v)
+        {
+            if (v != incumbent[k])
+            {
+                neighbour[k] = v;
+                consider(neighbour);
+            }
+        }
+    }
+    for (int32_t r = 0; r < kAdaptiveSearchRandomCandidates; ++r)
+    {
+        Values random(nbKnobs);
+        for (uint64_t k = 0; k < nbKnobs; ++k)
+        {
+            // Not std::uniform_int_distribution, whose output is implementation-defined: a seed must propose the same
+            // routes with every standard library so that --continue replays the same search.
+            random[k] = mRng() % mCtx.parsedExprs[k].mValues.size();
+        }
+        consider(random);
+    }
+    return best;
+}
+
+std::optional<BigInt> AdaptiveRouteSearch::proposeNext()
+{
+    if (!(mProposed < mBudget))
+    {
+        return std::nullopt;
+    }
+
+    std::optional<Values> next;
+    if (mTried.count(mBaseline) == 0)
+    {
+        next = mBaseline;
+    }
+    else
+    {
+        next = pickCandidate();
+    }
+    if (!next)
+    {
+        // Every candidate was tried already, which only happens in small spaces: take the first untried route.
+        for (BigInt i{0}; i < mSpaceSize && !next; ++i)
+        {
+            Values values = decompose(i);
+            if (mTried.count(values) == 0)
+            {
+                next = std::move(values);
+            }
+        }
+    }
+    ASSERT(next.has_value());
+    mTried.insert(*next);
+    ++mProposed;
+    return compose(*next);
+}
+
+void AdaptiveRouteSearch::reportResult(BigInt const& index, bool succeeded, double gpuTimeMs)
+{
+    Values values = decompose(index);
+    if (succeeded && gpuTimeMs > 0.0)
+    {
+        if (!mBest || gpuTimeMs < mBest->second)
+        {
+            mBest = std::make_pair(values, gpuTimeMs);
+        }
+        mSuccesses.emplace_back(std::move(values), gpuTimeMs);
+        return;
+    }
+    for (uint64_t k = 0; k < values.size(); ++k)
+    {
+        ++mFailures[k][values[k]];
+    }
+}
+
+void AdaptiveRouteSearch::replay(BigInt const& index, bool succeeded, double gpuTimeMs)
+{
+    if (mTried.insert(decompose(index)).second)
+    {
+        ++mProposed;
+    }
+    reportResult(index, succeeded, gpuTimeMs);
+}
+
+std::optional<BigInt> AdaptiveRouteSearch::findIndexOfPath(std::string const& path) const
+{
+    // getPathAtIndex() joins "knob=value" pairs with single spaces, in parsedExprs order.
+    std::istringstream tokens(path);
+    Values values(mCtx.parsedExprs.size());
+    std::string token;
+    for (uint64_t k = 0; k < values.size(); ++k)
+    {
+        auto const& expr = mCtx.parsedExprs[k];
+        if (!(tokens >> token) || token.compare(0, expr.mKnobName.size() + 1, expr.mKnobName + "=") != 0)
+        {
+            return std::nullopt;
+        }
+        auto const it = std::find(expr.mValues.begin(), expr.mValues.end(), token.substr(expr.mKnobName.size() + 1));
+        if (it == expr.mValues.end())
+        {
+            return std::nullopt;
+        }
+        values[k] = static_cast<uint64_t>(it - expr.mValues.begin());
+    }
+    if (tokens >> token)
+    {
+        return std::nullopt;
+    }
+    return compose(values);
+}
+
 bool isTuningOnlyArg(char const* arg)
 {
     // Tuning-only flags that the parent interprets and that must not appear on the child argv.
@@ -673,13 +1093,18 @@ bool isTuningOnlyArg(char const* arg)
         "--tuningSearch",
         "--tuningCacheFile",
         "--tuningTimeOut",
+        "--tuningBudget",
+        "--tuningJobs",
+        "--tuningDevices",
+        "--tuningPrune",
         "--saveAllEngines",
         "--continue",
         "--dryRun",
-        // The parent will inject its own --setBuildRoute, --saveEngine, --tuningResultFile.
+        // The parent will inject its own --setBuildRoute, --saveEngine, --tuningResultFile (and --tuningPruneAboveMs).
         "--setBuildRoute",
         "--saveEngine",
         "--tuningResultFile",
+        "--tuningPruneAboveMs",
     };
     return std::any_of(std::begin(kTUNING_STRIP_PREFIXES), std::end(kTUNING_STRIP_PREFIXES), [arg](char const* prefix) {
         auto const len = std::strlen(prefix);
@@ -688,22 +1113,45 @@ bool isTuningOnlyArg(char const* arg)
 }
 
 std::vector<char*> buildTuningChildArgv(int32_t argc, char** argv, std::string const& route,
-    std::string const& enginePath, std::string const& resultJsonPath, std::vector<std::string>& storage)
+    std::string const& enginePath, std::string const& resultJsonPath, std::vector<std::string>& storage,
+    std::optional<int32_t> device, std::optional<double> pruneAboveMs)
 {
+    auto const isDeviceArg = [](char const* arg) {
+        constexpr char const* kDEVICE = "--device";
+        auto const len = std::strlen(kDEVICE);
+        return std::strncmp(arg, kDEVICE, len) == 0 && (arg[len] == '\0' || arg[len] == '=');
+    };
     storage.clear();
-    storage.reserve(argc + 3);
+    storage.reserve(argc + 5);
     // Always include argv[0] (the trtexec executable path) verbatim.
     storage.emplace_back(argv[0]);
     for (int32_t i = 1; i < argc; ++i)
     {
-        if (argv[i] != nullptr && !isTuningOnlyArg(argv[i]))
+        if (argv[i] == nullptr || isTuningOnlyArg(argv[i]))
+        {
+            continue;
+        }
+        // A pinned worker overrides the user's --device; duplicates would be rejected by the child's parser.
+        if (device.has_value() && isDeviceArg(argv[i]))
         {
-            storage.emplace_back(argv[i]);
+            continue;
         }
+        storage.emplace_back(argv[i]);
     }
     storage.emplace_back("--setBuildRoute=" + route);
     storage.emplace_back("--saveEngine=" + enginePath);
     storage.emplace_back("--tuningResultFile=" + resultJsonPath);
+    if (device.has_value())
+    {
+        storage.emplace_back("--device=" + std::to_string(*device));
+    }
+    if (pruneAboveMs.has_value())
+    {
+        // Enough digits that the child compares against the same time the parent recorded.
+        std::ostringstream os;
+        os << std::setprecision(std::numeric_limits<double>::max_digits10) << *pruneAboveMs;
+        storage.emplace_back("--tuningPruneAboveMs=" + os.str());
+    }
 
     std::vector<char*> out;
     out.reserve(storage.size() + 1);
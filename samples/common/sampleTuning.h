@@ -23,10 +23,16 @@
 #include "sampleOptions.h"
 
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
 #include <optional>
+#include <random>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace sample
@@ -239,17 +245,78 @@ struct TuningContext
     std::string defaultBuildRoute;
 
     //! \brief Compute total configuration count based on searchAlgorithm.
-    //! - Exhaustive: product of all value list sizes.
+    //! - Exhaustive / adaptive: product of all value list sizes.
     //! - Fast: 1 (baseline) + sum of non-default values per variable knob.
     BigInt count() const;
 
     //! \brief Get the build route string for a given index (lazy).
     //! Throws std::out_of_range if index is out of range.
-    //! - Exhaustive: reverse mixed-radix decomposition.
+    //! - Exhaustive / adaptive: reverse mixed-radix decomposition.
     //! - Fast: baseline at index 0, one-off variations at index 1..N.
     std::string getPathAtIndex(BigInt const& index) const;
 };
 
+//! \class TuningRouteIterator
+//! \brief Enumerates the build routes of a TuningContext in index order without decomposing every index.
+//!
+//! getPathAtIndex() decomposes its index from scratch with BigInt division. The iterator instead keeps the value
+//! position of every knob (an odometer in exhaustive mode, the one varied knob in fast mode) and advances it, so
+//! next() does no division and only rebuilds the part of the route string from the first knob that changed.
+//! seek() and skip() decompose an index once, to resume a sweep with --continue or to split it between workers.
+//!
+//! The context must outlive the iterator and must not be modified while the iterator is in use.
+class TuningRouteIterator
+{
+public:
+    //! \brief Position the iterator at route \p start. An iterator positioned at or past count() is done().
+    explicit TuningRouteIterator(TuningContext const& ctx, BigInt const& start = BigInt{0});
+
+    //! \brief True once the iterator has moved past the last route.
+    bool done() const noexcept
+    {
+        return !(mIndex < mCount);
+    }
+
+    //! \brief Index of the current route.
+    BigInt const& index() const noexcept
+    {
+        return mIndex;
+    }
+
+    //! \brief The current route, equal to getPathAtIndex(index()).
+    //! Throws std::out_of_range if done().
+    std::string const& path() const;
+
+    //! \brief Advance to the next route.
+    void next();
+
+    //! \brief Jump to route \p index.
+    void seek(BigInt const& index);
+
+    //! \brief Move forward by \p count routes, e.g. by the number of workers when each takes every N-th route.
+    void skip(BigInt const& count)
+    {
+        seek(mIndex + count);
+    }
+
+private:
+    bool isFastExpansion() const noexcept;
+    std::string const& valueAt(uint64_t knob) const;
+    //! \brief Fast mode: vary the first non-default value at or after (knob, position), walking knobs right-to-left.
+    bool findVariation(int64_t knob, uint64_t position);
+    //! \brief Rewrite the route string from \p firstChangedKnob onwards.
+    void rebuildPath(uint64_t firstChangedKnob);
+
+    TuningContext const& mCtx;
+    BigInt mCount;
+    BigInt mIndex;
+    std::vector<uint64_t> mPositions;  //!< Exhaustive: position of every knob's value in its value list.
+    int64_t mVariedKnob{-1};           //!< Fast: knob set to a non-default value, or -1 for the baseline.
+    uint64_t mVariedPosition{0};       //!< Fast: position of that value in the knob's value list.
+    std::string mPath;                 //!< Route string of the current index.
+    std::vector<uint64_t> mKnobOffsets; //!< Offset in mPath where each knob's part (with its separator) starts.
+};
+
 // ============================================================================
 // Mixed Search Algorithm Support
 // ============================================================================
@@ -323,6 +390,188 @@ std::optional<std::pair<int32_t, std::string>> identifyVariedKnob(TuningContext
 void collectPositiveKnobFromResult(bool crashed, double gpuTimeMs, double baselineGpuTimeMs, BigInt const& index,
     TuningContext const& ctx, std::vector<MixedSearchKnobResult>& positiveKnobs);
 
+// ============================================================================
+// Adaptive Search Algorithm Support
+// ============================================================================
+//
+// Adaptive search explores the full (exhaustive) space but only builds up to a
+// budget of routes, choosing each next route from the results so far:
+//   1. The baseline (all knobs at their defaults) is tried first.
+//   2. Every following route minimizes an additive surrogate of the GPU time:
+//      the mean time of the successful routes plus the mean effect of each of
+//      the route's knob values, plus a penalty for values that made builds fail,
+//      minus an exploration bonus for values that were rarely tried.
+//   3. Candidates are the one-knob neighbours of the best route so far (so knob
+//      interactions are explored around it) and a few random routes.
+// The loop stops at the budget, at --tuningTimeOut, or when the space is exhausted.
+
+//! Number of random routes scored along with the neighbours of the best route.
+constexpr int32_t kAdaptiveSearchRandomCandidates = 64;
+
+//! Weight of the exploration bonus, relative to the mean GPU time.
+constexpr double kAdaptiveSearchExploration = 0.1;
+
+//! \class AdaptiveRouteSearch
+//! \brief Proposes the routes of --tuningSearch=adaptive one at a time.
+//!
+//! Routes are identified by their index in the exhaustive expansion of the context,
+//! so callers materialize them with TuningContext::getPathAtIndex().
+class AdaptiveRouteSearch
+{
+public:
+    //! \param[in] ctx    Context to search; must outlive this object.
+    //! \param[in] budget Maximum number of routes to propose.
+    //! \param[in] seed   Seed of the random candidates, so that a search is reproducible.
+    AdaptiveRouteSearch(TuningContext const& ctx, BigInt const& budget, uint64_t seed = 0);
+
+    //! \brief Number of routes that will be proposed: the budget, capped by the size of the space.
+    BigInt const& getBudget() const noexcept
+    {
+        return mBudget;
+    }
+
+    //! \brief Index of the next route to try, or nullopt once the budget is spent.
+    std::optional<BigInt> proposeNext();
+
+    //! \brief Report the outcome of a proposed route. Results may arrive in any order.
+    void reportResult(BigInt const& index, bool succeeded, double gpuTimeMs);
+
+    //! \brief Record a route tried by an earlier run (--continue) as proposed and report its result.
+    void replay(BigInt const& index, bool succeeded, double gpuTimeMs);
+
+    //! \brief Index of a route string produced by getPathAtIndex(), or nullopt if it is not in the space.
+    std::optional<BigInt> findIndexOfPath(std::string const& path) const;
+
+private:
+    using Values = std::vector<uint64_t>; //!< Value index of every knob.
+
+    Values decompose(BigInt const& index) const;
+    BigInt compose(Values const& values) const;
+
+    //! Lowest-scoring untried route among the neighbours of the best route and random routes.
+    std::optional<Values> pickCandidate();
+
+    TuningContext const& mCtx;
+    BigInt mSpaceSize;
+    BigInt mBudget;
+    BigInt mProposed{0};
+    Values mBaseline;
+    std::set<Values> mTried;
+    std::vector<std::pair<Values, double>> mSuccesses; //!< Successful routes and their GPU time.
+    std::vector<std::vector<int64_t>> mFailures;       //!< [knob][value] number of failed routes.
+    std::optional<std::pair<Values, double>> mBest;    //!< Fastest successful route so far.
+    std::mt19937_64 mRng;
+};
+
+//! \struct TuningIterationCallbacks
+//! \brief What runTuningIterations() does to prepare, start, wait for and record one tuning iteration.
+//!
+//! A job is whatever runs an iteration (a child process in trtexec), identified by an id such as its pid.
+template <typename Iteration, typename Result>
+struct TuningIterationCallbacks
+{
+    //! Prepare iteration `index`, or return nullopt to start no further iterations (timeout, budget spent).
+    std::function<std::optional<Iteration>(BigInt const& index)> prepare;
+    //! Start a job for the iteration on worker slot `slot`. Returns the job id, or the result of an iteration
+    //! that could not be started.
+    std::function<std::variant<int64_t, Result>(Iteration& iteration, int32_t slot)> launch;
+    //! Wait for any job to exit and return its id and exit status, or nullopt if jobs can no longer be waited for.
+    std::function<std::optional<std::pair<int64_t, int32_t>>()> wait;
+    //! Result of an iteration from the exit status of its job; status is nullopt if the job could not be waited for.
+    std::function<Result(Iteration& iteration, std::optional<int32_t> status)> collect;
+    //! Fold a finished iteration into the caller's state. Called strictly in index order.
+    std::function<void(Iteration& iteration, Result& result)> record;
+};
+
+//! \brief Run iterations [first, count) with up to nbSlots jobs in flight, recording results in index order.
+//!
+//! Jobs are reaped in whatever order they exit; finished iterations wait in a reorder buffer until every earlier
+//! one is recorded. Every iteration that can be recorded is recorded before the next one is prepared, so with a
+//! single slot each iteration is prepared knowing the results of all earlier ones, as in a sequential sweep.
+//! Once prepare() returns nullopt no job is started, but jobs in flight are waited for and recorded.
+template <typename Iteration, typename Result>
+void runTuningIterations(
+    int32_t nbSlots, BigInt const& first, BigInt const& count, TuningIterationCallbacks<Iteration, Result> const& cb)
+{
+    struct Job
+    {
+        BigInt index;
+        int32_t slot;
+        Iteration iteration;
+    };
+    std::unordered_map<int64_t, Job> inFlight;
+    std::map<BigInt, std::pair<Iteration, Result>> finished;
+    BigInt next = first;
+    BigInt nextToRecord = first;
+    auto const recordReady = [&]() {
+        for (auto f = finished.begin(); f != finished.end() && f->first == nextToRecord; f = finished.erase(f))
+        {
+            cb.record(f->second.first, f->second.second);
+            ++nextToRecord;
+        }
+    };
+
+    std::vector<int32_t> freeSlots;
+    for (int32_t s = nbSlots - 1; s >= 0; --s)
+    {
+        freeSlots.push_back(s);
+    }
+    bool stopped{false};
+    while (true)
+    {
+        // Fill every idle slot, recording what has finished before each new iteration is prepared.
+        while (!stopped && !freeSlots.empty() && next < count)
+        {
+            recordReady();
+            std::optional<Iteration> iteration = cb.prepare(next);
+            if (!iteration)
+            {
+                stopped = true;
+                break;
+            }
+            BigInt const index = next;
+            ++next;
+            int32_t const slot = freeSlots.back();
+            auto launched = cb.launch(*iteration, slot);
+            if (auto* result = std::get_if<Result>(&launched))
+            {
+                finished.emplace(index, std::make_pair(std::move(*iteration), std::move(*result)));
+                continue;
+            }
+            freeSlots.pop_back();
+            inFlight.emplace(std::get<int64_t>(launched), Job{index, slot, std::move(*iteration)});
+        }
+        recordReady();
+        if (inFlight.empty())
+        {
+            break;
+        }
+
+        auto const exited = cb.wait();
+        if (!exited)
+        {
+            // The jobs can no longer be waited for; collect every outstanding one as failed.
+            for (auto& [id, job] : inFlight)
+            {
+                freeSlots.push_back(job.slot);
+                Result result = cb.collect(job.iteration, std::nullopt);
+                finished.emplace(job.index, std::make_pair(std::move(job.iteration), std::move(result)));
+            }
+            inFlight.clear();
+            continue;
+        }
+        auto const job = inFlight.find(exited->first);
+        if (job == inFlight.end())
+        {
+            continue;
+        }
+        freeSlots.push_back(job->second.slot);
+        Result result = cb.collect(job->second.iteration, exited->second);
+        finished.emplace(job->second.index, std::make_pair(std::move(job->second.iteration), std::move(result)));
+        inFlight.erase(job);
+    }
+}
+
 // Exit codes for child process to distinguish failure modes (used when --tuneBuildRoutes expands to multiple configs)
 constexpr int32_t kChildExitSuccess = 0;
 constexpr int32_t kChildExitFailure = 1;            // runOnceBuildAndInfer returned failure
@@ -345,11 +594,15 @@ struct TuningIterationResult
 
 //! \brief Build a child argv for one tuning iteration: copies argv with tuning-only
 //! flags removed and appends `--setBuildRoute=<route>`, `--saveEngine=<enginePath>`,
-//! `--tuningResultFile=<resultJsonPath>`. String storage is owned by `storage` so
-//! the returned `char*` pointers stay valid until the caller's execvp() completes.
-//! The returned vector is nullptr-terminated, ready for execvp().
+//! `--tuningResultFile=<resultJsonPath>`. When `device` is set (a --tuningDevices
+//! worker), any user `--device` is dropped and `--device=<device>` is appended. When
+//! `pruneAboveMs` is set (--tuningPrune), `--tuningPruneAboveMs=<pruneAboveMs>` is appended.
+//! String storage is owned by `storage` so the returned `char*` pointers stay valid
+//! until the caller's execvp() completes. The returned vector is nullptr-terminated,
+//! ready for execvp().
 [[nodiscard]] std::vector<char*> buildTuningChildArgv(int32_t argc, char** argv, std::string const& route,
-    std::string const& enginePath, std::string const& resultJsonPath, std::vector<std::string>& storage);
+    std::string const& enginePath, std::string const& resultJsonPath, std::vector<std::string>& storage,
+    std::optional<int32_t> device = std::nullopt, std::optional<double> pruneAboveMs = std::nullopt);
 
 } // namespace sample
 
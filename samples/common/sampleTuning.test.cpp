@@ -0,0 +1,309 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sampleTuning.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+
+using namespace sample;
+
+namespace
+{
+//! Four knobs with three values each (81 routes); the defaults are the first values.
+TuningContext makeAdaptiveContext()
+{
+    TuningContext ctx;
+    ctx.searchAlgorithm = TuningSearchAlgorithm::kADAPTIVE;
+    for (char const* name : {"-a", "-b", "-c", "-d"})
+    {
+        ctx.parsedExprs.push_back({name, {"0", "1", "2"}, false});
+        ctx.defaultValues.emplace_back("0");
+    }
+    ctx.totalCount = ctx.count();
+    return ctx;
+}
+
+//! Synthetic GPU time: knob values have independent costs, plus an interaction that makes "-a=2 -b=2" the optimum.
+//! Routes with "-d=2" fail to build.
+std::optional<double> syntheticGpuTime(std::vector<uint64_t> const& v)
+{
+    if (v[3] == 2)
+    {
+        return std::nullopt;
+    }
+    double const cost[3] = {1.0, 0.8, 1.2};
+    double t = 10.0 + cost[v[0]] + cost[v[1]] + cost[v[2]] + cost[v[3]];
+    if (v[0] == 2 && v[1] == 2)
+    {
+        t -= 2.0;
+    }
+    return t;
+}
+
+std::vector<uint64_t> decomposeIndex(BigInt index)
+{
+    std::vector<uint64_t> v(4);
+    for (int32_t k = 3; k >= 0; --k)
+    {
+        v[k] = (index % BigInt(3)).toUint64();
+        index = index / BigInt(3);
+    }
+    return v;
+}
+} // namespace
+
+TEST(AdaptiveRouteSearch, BaselineFirstAndNoRepeats)
+{
+    TuningContext const ctx = makeAdaptiveContext();
+    AdaptiveRouteSearch search(ctx, BigInt(100));
+    EXPECT_EQ(search.getBudget(), BigInt(81));
+
+    auto const first = search.proposeNext();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(ctx.getPathAtIndex(*first), "-a=0 -b=0 -c=0 -d=0");
+
+    std::set<std::string> routes{ctx.getPathAtIndex(*first)};
+    search.reportResult(*first, true, 14.0);
+    while (auto const next = search.proposeNext())
+    {
+        EXPECT_TRUE(routes.insert(ctx.getPathAtIndex(*next)).second);
+        auto const t = syntheticGpuTime(decomposeIndex(*next));
+        search.reportResult(*next, t.has_value(), t.value_or(0.0));
+    }
+    EXPECT_EQ(routes.size(), 81U);
+}
+
+TEST(AdaptiveRouteSearch, FindsInteractionWithinBudget)
+{
+    TuningContext const ctx = makeAdaptiveContext();
+    // The interaction is not reachable by changing one knob at a time from the baseline, so this checks that the
+    // search explores beyond the incumbent's neighbours. The exact routes depend on the seed, not on the standard
+    // library: mt19937_64 is fully specified.
+    AdaptiveRouteSearch search(ctx, BigInt(30));
+    double best{std::numeric_limits<double>::infinity()};
+    std::vector<uint64_t> bestValues;
+    int32_t proposals{0};
+    while (auto const next = search.proposeNext())
+    {
+        ++proposals;
+        auto const t = syntheticGpuTime(decomposeIndex(*next));
+        search.reportResult(*next, t.has_value(), t.value_or(0.0));
+        if (t && *t < best)
+        {
+            best = *t;
+            bestValues = decomposeIndex(*next);
+        }
+    }
+    EXPECT_LE(proposals, 30);
+    ASSERT_EQ(bestValues.size(), 4U);
+    EXPECT_EQ(bestValues[0], 2U);
+    EXPECT_EQ(bestValues[1], 2U);
+}
+
+TEST(RunTuningIterations, SingleSlotProposalsSeeEveryPriorResult)
+{
+    // Like trtexec --tuningJobs=1 with adaptive search: each route is proposed after all earlier ones are reported.
+    TuningContext const ctx = makeAdaptiveContext();
+    AdaptiveRouteSearch search(ctx, BigInt(20));
+    int64_t reported{0};
+    int64_t nextJob{0};
+    std::map<int64_t, std::optional<double>> jobs;
+
+    TuningIterationCallbacks<BigInt, std::optional<double>> cb;
+    cb.prepare = [&](BigInt const& index) -> std::optional<BigInt> {
+        EXPECT_EQ(BigInt(static_cast<uint64_t>(reported)), index);
+        return search.proposeNext();
+    };
+    cb.launch = [&](BigInt& route, int32_t slot) -> std::variant<int64_t, std::optional<double>> {
+        EXPECT_EQ(slot, 0);
+        jobs.emplace(nextJob, syntheticGpuTime(decomposeIndex(route)));
+        return nextJob++;
+    };
+    cb.wait = [&]() -> std::optional<std::pair<int64_t, int32_t>> {
+        EXPECT_EQ(jobs.size(), 1U);
+        return std::make_pair(jobs.begin()->first, 0);
+    };
+    cb.collect = [&](BigInt&, std::optional<int32_t> status) {
+        EXPECT_TRUE(status.has_value());
+        auto const result = jobs.begin()->second;
+        jobs.erase(jobs.begin());
+        return result;
+    };
+    cb.record = [&](BigInt& route, std::optional<double>& t) {
+        search.reportResult(route, t.has_value(), t.value_or(0.0));
+        ++reported;
+    };
+    runTuningIterations(1, BigInt(0), search.getBudget(), cb);
+    EXPECT_EQ(reported, 20);
+}
+
+TEST(RunTuningIterations, RecordsInIndexOrder)
+{
+    // Jobs exit newest first; launch failures and an unknown job id are mixed in.
+    struct Job
+    {
+        int64_t id;
+        uint64_t iteration;
+        int32_t slot;
+    };
+    uint64_t const first{2};
+    std::vector<uint64_t> prepared;
+    std::vector<uint64_t> recorded;
+    std::vector<Job> running;
+    bool unknownReported{false};
+
+    TuningIterationCallbacks<uint64_t, std::string> cb;
+    cb.prepare = [&](BigInt const& index) -> std::optional<uint64_t> {
+        // Everything before the oldest running iteration has been recorded, launch failures included.
+        uint64_t const oldest = running.empty() ? index.toUint64() : running.front().iteration;
+        EXPECT_EQ(first + recorded.size(), oldest);
+        prepared.push_back(index.toUint64());
+        return index.toUint64();
+    };
+    cb.launch = [&](uint64_t& it, int32_t slot) -> std::variant<int64_t, std::string> {
+        if (it % 5 == 3)
+        {
+            return std::string{"launch failed"};
+        }
+        for (auto const& job : running)
+        {
+            EXPECT_NE(job.slot, slot);
+        }
+        running.push_back({static_cast<int64_t>(100 + it), it, slot});
+        return running.back().id;
+    };
+    cb.wait = [&]() -> std::optional<std::pair<int64_t, int32_t>> {
+        if (!unknownReported)
+        {
+            unknownReported = true;
+            return std::make_pair(int64_t{7}, 0);
+        }
+        Job const job = running.back();
+        running.pop_back();
+        return std::make_pair(job.id, static_cast<int32_t>(job.iteration));
+    };
+    cb.collect = [&](uint64_t& it, std::optional<int32_t> status) {
+        EXPECT_EQ(status, std::optional<int32_t>(static_cast<int32_t>(it)));
+        return std::string{"ok"};
+    };
+    cb.record = [&](uint64_t& it, std::string& result) {
+        EXPECT_EQ(result, it % 5 == 3 ? "launch failed" : "ok");
+        recorded.push_back(it);
+    };
+    runTuningIterations(3, BigInt(first), BigInt(17), cb);
+
+    std::vector<uint64_t> expected;
+    for (uint64_t i = first; i < 17; ++i)
+    {
+        expected.push_back(i);
+    }
+    EXPECT_EQ(prepared, expected);
+    EXPECT_EQ(recorded, expected);
+    EXPECT_TRUE(running.empty());
+}
+
+TEST(RunTuningIterations, StopsPreparingAndCollectsAbandonedJobs)
+{
+    std::vector<std::pair<uint64_t, bool>> recorded;
+    int32_t launched{0};
+    int32_t waits{0};
+
+    TuningIterationCallbacks<uint64_t, bool> cb;
+    cb.prepare = [&](BigInt const& index) -> std::optional<uint64_t> {
+        if (index.toUint64() >= 4)
+        {
+            return std::nullopt;
+        }
+        return index.toUint64();
+    };
+    cb.launch = [&](uint64_t& it, int32_t) -> std::variant<int64_t, bool> {
+        ++launched;
+        return static_cast<int64_t>(it);
+    };
+    cb.wait = [&]() -> std::optional<std::pair<int64_t, int32_t>> {
+        // The first job exits, then the rest can no longer be waited for.
+        if (waits++ == 0)
+        {
+            return std::make_pair(int64_t{0}, 0);
+        }
+        return std::nullopt;
+    };
+    cb.collect = [&](uint64_t&, std::optional<int32_t> status) { return status.has_value(); };
+    cb.record = [&](uint64_t& it, bool& reaped) { recorded.emplace_back(it, reaped); };
+    runTuningIterations(2, BigInt(0), BigInt(100), cb);
+
+    // Slots freed by abandoned jobs are refilled until prepare() declines.
+    EXPECT_EQ(launched, 4);
+    std::vector<std::pair<uint64_t, bool>> const expected{{0, true}, {1, false}, {2, false}, {3, false}};
+    EXPECT_EQ(recorded, expected);
+}
+
+TEST(AdaptiveRouteSearch, FindIndexOfPath)
+{
+    TuningContext const ctx = makeAdaptiveContext();
+    AdaptiveRouteSearch search(ctx, BigInt(10));
+    for (BigInt i{0}; i < ctx.totalCount; ++i)
+    {
+        EXPECT_EQ(search.findIndexOfPath(ctx.getPathAtIndex(i)), std::optional<BigInt>(i));
+    }
+    EXPECT_FALSE(search.findIndexOfPath("-a=0 -b=0 -c=0").has_value());
+    EXPECT_FALSE(search.findIndexOfPath("-a=0 -b=0 -c=0 -d=7").has_value());
+}
+
+TEST(TuningRouteIterator, MatchesGetPathAtIndex)
+{
+    TuningContext ctx;
+    ctx.parsedExprs = {{"-a", {"0", "1"}, false}, {"-b", {"x"}, true}, {"-c", {"0", "1", "2"}, false},
+        {"-d", {"on", "off"}, false}};
+    ctx.defaultValues = {"1", "x", "0", "off"};
+    for (auto const algorithm : {TuningSearchAlgorithm::kEXHAUSTIVE, TuningSearchAlgorithm::kFAST})
+    {
+        ctx.searchAlgorithm = algorithm;
+        ctx.totalCount = ctx.count();
+        BigInt i{0};
+        for (TuningRouteIterator route(ctx); !route.done(); route.next(), ++i)
+        {
+            EXPECT_EQ(route.index(), i);
+            EXPECT_EQ(route.path(), ctx.getPathAtIndex(i));
+            // Seeking and skipping land on the same route as stepping.
+            EXPECT_EQ(TuningRouteIterator(ctx, i).path(), route.path());
+            TuningRouteIterator skipped(ctx);
+            skipped.skip(i);
+            EXPECT_EQ(skipped.path(), route.path());
+        }
+        EXPECT_EQ(i, ctx.totalCount);
+        EXPECT_TRUE(TuningRouteIterator(ctx, ctx.totalCount).done());
+        EXPECT_THROW(TuningRouteIterator(ctx, ctx.totalCount).path(), std::out_of_range);
+    }
+}
+
+TEST(TuningRouteIterator, SkipSplitsRoutesBetweenWorkers)
+{
+    TuningContext const ctx = makeAdaptiveContext();
+    std::set<std::string> routes;
+    for (uint64_t worker = 0; worker < 4; ++worker)
+    {
+        for (TuningRouteIterator route(ctx, BigInt{worker}); !route.done(); route.skip(BigInt{4}))
+        {
+            EXPECT_TRUE(routes.insert(route.path()).second);
+        }
+    }
+    EXPECT_EQ(routes.size(), 81U);
+}
@@ -21,18 +21,35 @@
 #include "half.h"
 #include <nlohmann/json.hpp>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
 #include <climits>
 #include <cstdlib>
+#include <cstring>
 #include <cuda.h>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <limits>
+#include <locale>
+#include <map>
+#include <optional>
 #include <sstream>
+#include <thread>
 #include <type_traits>
 
 #if CUDA_VERSION >= 11060
 #include <cuda_fp8.h>
 #endif
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h> // fsync
+#endif
+
 using namespace nvinfer1;
 using samplesCommon::startsWith;
 
@@ -81,40 +98,235 @@ void loadFromFile(std::string const& fileName, char* dst, size_t size)
 {
     ASSERT(dst);
 
-    std::ifstream file(fileName, std::ios::in | std::ios::binary);
-    if (file.is_open())
+    auto const content = loadFileContent(fileName, size);
+    std::memcpy(dst, content->data(), size);
+}
+
+namespace
+{
+[[noreturn]] void throwCannotOpen(std::string const& fileName)
+{
+    std::ostringstream msg;
+    msg << "Cannot open file " << fileName << "!";
+    throw std::invalid_argument(msg.str());
+}
+} // namespace
+
+FileContent::FileContent(std::string const& fileName)
+{
+#if !defined(_WIN32)
+    int32_t const fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throwCannotOpen(fileName);
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        throwCannotOpen(fileName);
+    }
+    mSize = static_cast<size_t>(st.st_size);
+    if (mSize > 0)
     {
-        file.seekg(0, std::ios::end);
-        int64_t fileSize = static_cast<int64_t>(file.tellg());
-        // Due to change from int32_t to int64_t VC engines created with earlier versions
-        // may expect input of the half of the size
-        if (fileSize != static_cast<int64_t>(size) && fileSize != static_cast<int64_t>(size * 2))
+        // A private read-only mapping shares the page cache: every user of the file reads the same physical pages.
+        void* const data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
         {
-            std::ostringstream msg;
-            msg << "Unexpected file size for input file: " << fileName << ". Note: Input binding size is: " << size
-                << " bytes but the file size is " << fileSize
-                << " bytes. Double check the size and datatype of the provided data.";
-            throw std::invalid_argument(msg.str());
+            mData = data;
+            mMapped = true;
         }
-        // Move file pointer back to the beginning after reading file size.
-        file.seekg(0, std::ios::beg);
-        file.read(dst, size);
-        size_t const nbBytesRead = file.gcount();
-        file.close();
-        if (nbBytesRead != size)
+    }
+    ::close(fd);
+    if (mMapped || mSize == 0)
+    {
+        return;
+    }
+#endif
+    // Fall back to reading the whole file, e.g. on Windows or for files that cannot be mapped (pipes, some FUSE
+    // file systems).
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        throwCannotOpen(fileName);
+    }
+    file.seekg(0, std::ios::end);
+    mSize = static_cast<size_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+    mBuffer.resize(mSize);
+    file.read(mBuffer.data(), static_cast<std::streamsize>(mSize));
+    if (static_cast<size_t>(file.gcount()) != mSize)
+    {
+        std::ostringstream msg;
+        msg << "Unexpected file size for input file: " << fileName << ". Note: Expected: " << mSize
+            << " bytes but only read: " << file.gcount() << " bytes";
+        throw std::invalid_argument(msg.str());
+    }
+    mData = mBuffer.data();
+}
+
+FileContent::~FileContent()
+{
+    if (mPinState > 0)
+    {
+        static_cast<void>(cudaHostUnregister(const_cast<void*>(mData)));
+    }
+#if !defined(_WIN32)
+    if (mMapped)
+    {
+        munmap(const_cast<void*>(mData), mSize);
+    }
+#endif
+}
+
+bool FileContent::pin() const
+{
+    std::lock_guard<std::mutex> lock(mPinMutex);
+    if (mPinState == 0)
+    {
+        // The mapping is read-only, so it must be registered as such.
+        uint32_t const flags = mMapped ? cudaHostRegisterReadOnly : cudaHostRegisterDefault;
+        bool const pinned
+            = mSize > 0 && cudaHostRegister(const_cast<void*>(mData), mSize, flags) == cudaSuccess;
+        if (!pinned)
         {
-            std::ostringstream msg;
-            msg << "Unexpected file size for input file: " << fileName << ". Note: Expected: " << size
-                << " bytes but only read: " << nbBytesRead << " bytes";
-            throw std::invalid_argument(msg.str());
+            // Clear the sticky error so that it is not reported by an unrelated later call.
+            static_cast<void>(cudaGetLastError());
         }
+        mPinState = pinned ? 1 : -1;
     }
-    else
+    return mPinState > 0;
+}
+
+void FileContent::prefetch() const
+{
+    // Locking the pages reads them in.
+    if (pin())
+    {
+        return;
+    }
+    constexpr size_t kPAGE_SIZE{4096};
+    auto const* bytes = static_cast<unsigned char const*>(mData);
+    unsigned char sum{0};
+    for (size_t i = 0; i < mSize; i += kPAGE_SIZE)
+    {
+        sum ^= bytes[i];
+    }
+    // Keep the reads from being optimized away.
+    unsigned char volatile sink{sum};
+    static_cast<void>(sink);
+}
+
+std::shared_ptr<FileContent const> loadFileContent(std::string const& fileName, std::optional<size_t> expectedSize)
+{
+    static std::mutex cacheMutex;
+    static std::map<std::pair<std::string, uintmax_t>, std::weak_ptr<FileContent const>> cache;
+
+    std::error_code ec;
+    uintmax_t const fileSize = std::filesystem::file_size(fileName, ec);
+    if (ec)
+    {
+        throwCannotOpen(fileName);
+    }
+    // Due to change from int32_t to int64_t VC engines created with earlier versions
+    // may expect input of the half of the size
+    if (expectedSize && fileSize != *expectedSize && fileSize != *expectedSize * 2)
+    {
+        std::ostringstream msg;
+        msg << "Unexpected file size for input file: " << fileName << ". Note: Input binding size is: "
+            << *expectedSize << " bytes but the file size is " << fileSize
+            << " bytes. Double check the size and datatype of the provided data.";
+        throw std::invalid_argument(msg.str());
+    }
+
+    // The file is read under the lock so that concurrent loads of the same file read it once.
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto& entry = cache[{fileName, fileSize}];
+    auto content = entry.lock();
+    if (!content)
+    {
+        content = std::make_shared<FileContent const>(fileName);
+        entry = content;
+        std::erase_if(cache, [](auto const& item) { return item.second.expired(); });
+    }
+    if (expectedSize && content->size() < *expectedSize)
     {
+        // The file was truncated since its size was checked.
         std::ostringstream msg;
-        msg << "Cannot open file " << fileName << "!";
+        msg << "Unexpected file size for input file: " << fileName << ". Note: Expected: " << *expectedSize
+            << " bytes but only read: " << content->size() << " bytes";
         throw std::invalid_argument(msg.str());
     }
+    return content;
+}
+
+RefPairPrefetcher::RefPairPrefetcher(std::vector<InferenceOptions::RefPair> const& refPairs, int32_t depth)
+    : mRefPairs(refPairs)
+    , mDepth(depth)
+    , mLoaded(refPairs.size())
+{
+    // cudaHostRegister pins for the current device, which a new thread does not inherit.
+    CHECK(cudaGetDevice(&mDevice));
+    mThread = std::thread(&RefPairPrefetcher::run, this);
+}
+
+RefPairPrefetcher::~RefPairPrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_all();
+    mThread.join();
+}
+
+std::vector<std::shared_ptr<FileContent const>> RefPairPrefetcher::acquire(int32_t pair)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    for (int32_t p = mCurrent; p < pair; ++p)
+    {
+        mLoaded[p].clear();
+    }
+    mCurrent = pair;
+    mCondition.notify_all();
+    mCondition.wait(lock, [&] { return mNext > pair; });
+    return mLoaded[pair];
+}
+
+void RefPairPrefetcher::run()
+{
+    CHECK(cudaSetDevice(mDevice));
+    int32_t const nbPairs = static_cast<int32_t>(mRefPairs.size());
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        mCondition.wait(lock, [&] { return mStop || mNext == nbPairs || mNext <= mCurrent + mDepth; });
+        if (mStop || mNext == nbPairs)
+        {
+            return;
+        }
+        int32_t const pair = mNext;
+        lock.unlock();
+        std::vector<std::shared_ptr<FileContent const>> contents;
+        for (auto const& input : mRefPairs[pair].first)
+        {
+            std::shared_ptr<FileContent const> content;
+            try
+            {
+                content = loadFileContent(input.second);
+                content->prefetch();
+            }
+            catch (std::exception const&)
+            {
+                // Reported by the inference thread when it fills the pair.
+            }
+            contents.push_back(std::move(content));
+        }
+        lock.lock();
+        mLoaded[pair] = std::move(contents);
+        ++mNext;
+        mCondition.notify_all();
+    }
 }
 
 std::vector<std::string> splitToStringVec(std::string const& s, char separator, int64_t maxSplit)
@@ -521,98 +733,290 @@ void sparsify(Weights const& weights, int32_t k, int32_t trs, std::vector<int8_t
     }
 }
 
+namespace
+{
+//! Elements formatted by one thread at a time; the chunks of a large tensor are formatted in parallel.
+constexpr int64_t kDUMP_ELEMENTS_PER_CHUNK{1 << 20};
+//! Largest stream precision formatted with std::to_chars; every such number fits in kDUMP_MAX_NUMBER_CHARS.
+constexpr std::streamsize kDUMP_MAX_PRECISION{40};
+constexpr size_t kDUMP_MAX_NUMBER_CHARS{128};
+
+//! The value that is printed for an element, of the type it is printed as.
 template <typename T>
-void print(std::ostream& os, T v)
+T toDumpValue(T v)
 {
-    os << v;
+    return v;
 }
 
-void print(std::ostream& os, int8_t v)
+int32_t toDumpValue(int8_t v)
 {
-    os << static_cast<int32_t>(v);
+    return v;
 }
 
-void print(std::ostream& os, uint8_t v)
+uint32_t toDumpValue(uint8_t v)
 {
-    os << static_cast<uint32_t>(v);
+    return v;
 }
 
-void print(std::ostream& os, __half v)
+float toDumpValue(__half v)
 {
-    os << static_cast<float>(v);
+    return static_cast<float>(v);
+}
+
+float toDumpValue(BFloat16 v)
+{
+    return static_cast<float>(v);
 }
 
 #if CUDA_VERSION >= 11060
-void print(std::ostream& os, __nv_fp8_e4m3 v)
+float toDumpValue(__nv_fp8_e4m3 v)
 {
-    os << static_cast<float>(v);
+    return static_cast<float>(v);
 }
 #endif
 
-int32_t dataOffsetFromDims(int64_t v, Dims const& dims, Dims const& strides, int32_t vectorDim, int32_t spv)
+//! Walks the elements of a host tensor in row-major order of dims and tracks the offset of the current element in a
+//! buffer with the given strides, vectorized along vectorDim with spv components per vector (vectorDim == -1 if not
+//! vectorized). Stepping is an odometer increment, so there is no div/mod per dimension and element.
+class TensorOffsetWalker
 {
-    int32_t dataOffset = 0;
-    for (int32_t dimIndex = dims.nbDims - 1; dimIndex >= 0; --dimIndex)
+public:
+    TensorOffsetWalker(Dims const& dims, Dims const& strides, int32_t vectorDim, int32_t spv, int64_t start)
+        : mNbDims(dims.nbDims)
+        , mVectorDim(vectorDim)
+        , mSpv(spv)
     {
-        int32_t dimVal = v % dims.d[dimIndex];
-        if (dimIndex == vectorDim)
+        // Decompose the start index once.
+        for (int32_t d = mNbDims - 1; d >= 0; --d)
         {
-            dataOffset += (dimVal / spv) * strides.d[dimIndex] * spv + dimVal % spv;
+            mDims[d] = dims.d[d];
+            mIndex[d] = start % mDims[d];
+            start /= mDims[d];
+            if (d == vectorDim)
+            {
+                mStep[d] = static_cast<int64_t>(strides.d[d]) * spv;
+                mLane = mIndex[d] % spv;
+                mContribution[d] = (mIndex[d] / spv) * mStep[d] + mLane;
+            }
+            else
+            {
+                mStep[d] = static_cast<int64_t>(strides.d[d]) * (vectorDim == -1 ? 1 : spv);
+                mContribution[d] = mIndex[d] * mStep[d];
+            }
+            mOffset += mContribution[d];
         }
-        else
+    }
+
+    int64_t offset() const noexcept
+    {
+        return mOffset;
+    }
+
+    void next() noexcept
+    {
+        for (int32_t d = mNbDims - 1; d >= 0; --d)
         {
-            dataOffset += dimVal * strides.d[dimIndex] * (vectorDim == -1 ? 1 : spv);
+            if (++mIndex[d] < mDims[d])
+            {
+                int64_t step = mStep[d];
+                if (d == mVectorDim)
+                {
+                    // Components of a vector are adjacent; the next vector starts a stride after the current one.
+                    step = 1;
+                    if (++mLane == mSpv)
+                    {
+                        mLane = 0;
+                        step = mStep[d] - (mSpv - 1);
+                    }
+                }
+                mContribution[d] += step;
+                mOffset += step;
+                return;
+            }
+            mOffset -= mContribution[d];
+            mContribution[d] = 0;
+            mIndex[d] = 0;
+            if (d == mVectorDim)
+            {
+                mLane = 0;
+            }
         }
-        v /= dims.d[dimIndex];
-        ASSERT(v >= 0);
     }
 
-    return dataOffset;
+private:
+    int32_t mNbDims{0};
+    int32_t mVectorDim{-1};
+    int64_t mSpv{1};
+    int64_t mLane{0}; //!< Component of the current element in its vector.
+    int64_t mOffset{0};
+    std::array<int64_t, Dims::MAX_DIMS> mDims{};
+    std::array<int64_t, Dims::MAX_DIMS> mIndex{};
+    std::array<int64_t, Dims::MAX_DIMS> mStep{};         //!< Offset increment of a step along each dimension.
+    std::array<int64_t, Dims::MAX_DIMS> mContribution{}; //!< Part of mOffset due to the index along each dimension.
+};
+
+//! How numbers are formatted with std::to_chars so that they read exactly as operator<< would print them.
+struct DumpNumberFormat
+{
+    std::chars_format floatFormat{std::chars_format::general};
+    int32_t precision{6};
+};
+
+//! The std::to_chars equivalent of the stream's formatting state, or nullopt if the stream formats numbers in a way
+//! std::to_chars does not reproduce (sign, base, padding, hexfloat, boolalpha or a locale with other punctuation).
+std::optional<DumpNumberFormat> getDumpNumberFormat(std::ostream const& os)
+{
+    auto const flags = os.flags();
+    auto const base = flags & std::ios_base::basefield;
+    if ((flags & (std::ios_base::showpos | std::ios_base::showpoint | std::ios_base::uppercase | std::ios_base::boolalpha))
+            != 0
+        || (base != 0 && base != std::ios_base::dec) || os.width() != 0 || os.precision() < 0
+        || os.precision() > kDUMP_MAX_PRECISION)
+    {
+        return std::nullopt;
+    }
+    auto const& punct = std::use_facet<std::numpunct<char>>(os.getloc());
+    if (punct.decimal_point() != '.' || !punct.grouping().empty())
+    {
+        return std::nullopt;
+    }
+
+    DumpNumberFormat format;
+    format.precision = static_cast<int32_t>(os.precision());
+    auto const floatField = flags & std::ios_base::floatfield;
+    if (floatField == std::ios_base::fixed)
+    {
+        format.floatFormat = std::chars_format::fixed;
+    }
+    else if (floatField == std::ios_base::scientific)
+    {
+        format.floatFormat = std::chars_format::scientific;
+    }
+    else if (floatField != std::ios_base::fmtflags{})
+    {
+        return std::nullopt; // hexfloat
+    }
+    return format;
 }
 
-template <typename T>
-void dumpBuffer(void const* buffer, std::string const& separator, std::ostream& os, Dims const& dims,
-    Dims const& strides, int32_t vectorDim, int32_t spv)
+template <typename V>
+void appendNumber(std::string& out, V value, DumpNumberFormat const& format)
 {
-    auto const vol = volume(dims);
-    T const* typedBuffer = static_cast<T const*>(buffer);
-    for (int64_t v = 0; v < vol; ++v)
+    std::array<char, kDUMP_MAX_NUMBER_CHARS> chars;
+    std::to_chars_result result{};
+    if constexpr (std::is_same_v<V, bool>)
     {
-        int32_t dataOffset = dataOffsetFromDims(v, dims, strides, vectorDim, spv);
-        if (v > 0)
-        {
-            os << separator;
-        }
-        print(os, typedBuffer[dataOffset]);
+        result = std::to_chars(chars.data(), chars.data() + chars.size(), static_cast<int32_t>(value));
     }
+    else if constexpr (std::is_floating_point_v<V>)
+    {
+        // operator<< formats floats as doubles.
+        result = std::to_chars(
+            chars.data(), chars.data() + chars.size(), static_cast<double>(value), format.floatFormat, format.precision);
+    }
+    else
+    {
+        result = std::to_chars(chars.data(), chars.data() + chars.size(), value);
+    }
+    ASSERT(result.ec == std::errc{});
+    out.append(chars.data(), result.ptr);
 }
 
-void dumpInt4Buffer(void const* buffer, std::string const& separator, std::ostream& os, Dims const& dims,
-    Dims const& strides, int32_t vectorDim, int32_t spv)
+//! Print the elements of a tensor, getValue(offset) returning the value of the element at an offset of the buffer.
+//!
+//! Elements are formatted with std::to_chars into chunk buffers, several chunks in parallel for large tensors, and
+//! the buffers are written in order, so the output is the same as printing every element with operator<<.
+template <typename GetValue>
+void dumpElements(std::ostream& os, std::string const& separator, Dims const& dims, Dims const& strides,
+    int32_t vectorDim, int32_t spv, GetValue const& getValue)
 {
-    auto const vol = volume(dims);
-    uint8_t const* typedBuffer = static_cast<uint8_t const*>(buffer);
-    for (int64_t v = 0; v < vol; ++v)
+    int64_t const vol = volume(dims);
+    if (vol <= 0)
     {
-        int32_t dataOffset = dataOffsetFromDims(v, dims, strides, vectorDim, spv);
-        if (v > 0)
+        return;
+    }
+
+    auto const format = getDumpNumberFormat(os);
+    if (!format)
+    {
+        TensorOffsetWalker walker(dims, strides, vectorDim, spv, 0);
+        for (int64_t v = 0; v < vol; ++v, walker.next())
         {
-            os << separator;
+            if (v > 0)
+            {
+                os << separator;
+            }
+            os << getValue(walker.offset());
         }
+        return;
+    }
 
-        auto value = typedBuffer[dataOffset / 2];
-        if (dataOffset % 2 == 0)
+    auto const formatChunk = [&](std::string& out, int64_t begin, int64_t end) {
+        out.clear();
+        TensorOffsetWalker walker(dims, strides, vectorDim, spv, begin);
+        for (int64_t v = begin; v < end; ++v, walker.next())
         {
-            // Cast to int8_t before right shift, so right-shift will sign-extend.
-            // Left shift on int8_t can be undefined behaviour, must perform left shift on uint8_t.
-            os << (static_cast<int8_t>(value << 4) >> 4);
+            if (v > 0)
+            {
+                out += separator;
+            }
+            appendNumber(out, getValue(walker.offset()), *format);
         }
-        else
+    };
+
+    int64_t const nbChunks = (vol + kDUMP_ELEMENTS_PER_CHUNK - 1) / kDUMP_ELEMENTS_PER_CHUNK;
+    int64_t const nbThreads = std::min<int64_t>(std::max<int64_t>(std::thread::hardware_concurrency(), 1), nbChunks);
+    // Format nbThreads chunks at a time so that the memory held by the buffers stays bounded.
+    std::vector<std::string> buffers(nbThreads);
+    for (int64_t first = 0; first < nbChunks; first += nbThreads)
+    {
+        int64_t const nbRoundChunks = std::min(nbThreads, nbChunks - first);
+        auto const formatRoundChunk = [&](int64_t t) {
+            int64_t const begin = (first + t) * kDUMP_ELEMENTS_PER_CHUNK;
+            formatChunk(buffers[t], begin, std::min(begin + kDUMP_ELEMENTS_PER_CHUNK, vol));
+        };
+        std::vector<std::thread> threads;
+        for (int64_t t = 1; t < nbRoundChunks; ++t)
+        {
+            threads.emplace_back(formatRoundChunk, t);
+        }
+        formatRoundChunk(0);
+        for (auto& th : threads)
         {
-            os << (static_cast<int8_t>(value) >> 4);
+            th.join();
+        }
+        for (int64_t t = 0; t < nbRoundChunks; ++t)
+        {
+            os.write(buffers[t].data(), static_cast<std::streamsize>(buffers[t].size()));
         }
     }
 }
+} // namespace
+
+template <typename T>
+void dumpBuffer(void const* buffer, std::string const& separator, std::ostream& os, Dims const& dims,
+    Dims const& strides, int32_t vectorDim, int32_t spv)
+{
+    T const* typedBuffer = static_cast<T const*>(buffer);
+    dumpElements(os, separator, dims, strides, vectorDim, spv,
+        [typedBuffer](int64_t offset) { return toDumpValue(typedBuffer[offset]); });
+}
+
+void dumpInt4Buffer(void const* buffer, std::string const& separator, std::ostream& os, Dims const& dims,
+    Dims const& strides, int32_t vectorDim, int32_t spv)
+{
+    uint8_t const* typedBuffer = static_cast<uint8_t const*>(buffer);
+    dumpElements(os, separator, dims, strides, vectorDim, spv, [typedBuffer](int64_t offset) {
+        auto const value = typedBuffer[offset / 2];
+        if (offset % 2 == 0)
+        {
+            // Cast to int8_t before right shift, so right-shift will sign-extend.
+            // Left shift on int8_t can be undefined behaviour, must perform left shift on uint8_t.
+            return static_cast<int8_t>(value << 4) >> 4;
+        }
+        return static_cast<int8_t>(value) >> 4;
+    });
+}
 
 // Explicit instantiation
 template void dumpBuffer<bool>(void const* buffer, std::string const& separator, std::ostream& os, Dims const& dims,
@@ -704,38 +1108,112 @@ void transpose2DWeights(void* dst, void const* src, int32_t const m, int32_t con
 template void transpose2DWeights<float>(void* dst, void const* src, int32_t const m, int32_t const n);
 template void transpose2DWeights<half_float::half>(void* dst, void const* src, int32_t const m, int32_t const n);
 
+namespace
+{
+//! Minimum number of elements generated by each thread of fillBuffer.
+constexpr int64_t kFILL_ELEMENTS_PER_THREAD{1 << 20};
+//! Number of elements generated at a time before being converted to the buffer type.
+constexpr int64_t kFILL_BLOCK_SIZE{256};
+
+//! Counter-based generator: the SplitMix64 finalizer applied to (key, counter). It has no state, so any element can be
+//! generated independently of the others.
+inline uint64_t counterRandom(uint64_t key, uint64_t counter)
+{
+    uint64_t z = key + (counter + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+//! Scramble the user seed so that nearby seeds do not generate shifted copies of the same sequence.
+inline uint64_t seedToKey(uint64_t seed)
+{
+    return counterRandom(0, seed);
+}
+
+//! Call fillRange(begin, end) over [0, volume), splitting large volumes across threads.
+template <typename FillRange>
+void parallelFill(int64_t volume, FillRange const& fillRange)
+{
+    int64_t const maxThreads = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+    int64_t const nbThreads = std::min(maxThreads, (volume + kFILL_ELEMENTS_PER_THREAD - 1) / kFILL_ELEMENTS_PER_THREAD);
+    if (nbThreads <= 1)
+    {
+        fillRange(0, volume);
+        return;
+    }
+
+    int64_t const chunk = roundUp((volume + nbThreads - 1) / nbThreads, kFILL_BLOCK_SIZE);
+    std::vector<std::thread> threads;
+    for (int64_t t = 1; t < nbThreads; ++t)
+    {
+        int64_t const begin = std::min(t * chunk, volume);
+        int64_t const end = std::min(begin + chunk, volume);
+        threads.emplace_back([&fillRange, begin, end] { fillRange(begin, end); });
+    }
+    fillRange(0, std::min(chunk, volume));
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+}
+} // namespace
+
 template <typename T, typename std::enable_if<std::is_integral<T>::value, bool>::type>
-void fillBuffer(void* buffer, int64_t volume, int32_t min, int32_t max)
+void fillBuffer(void* buffer, int64_t volume, int32_t min, int32_t max, uint64_t seed)
 {
+    ASSERT(min <= max);
     T* typedBuffer = static_cast<T*>(buffer);
-    std::default_random_engine engine;
-    std::uniform_int_distribution<int32_t> distribution(min, max);
-    auto generator = [&engine, &distribution]() { return static_cast<T>(distribution(engine)); };
-    std::generate(typedBuffer, typedBuffer + volume, generator);
+    uint64_t const key = seedToKey(seed);
+    uint64_t const range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    parallelFill(volume, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i)
+        {
+            // Map the high 32 random bits to [0, range) with a multiply instead of a modulo.
+            uint64_t const offset = ((counterRandom(key, i) >> 32) * range) >> 32;
+            typedBuffer[i] = static_cast<T>(min + static_cast<int64_t>(offset));
+        }
+    });
 }
 
 template <typename T, typename std::enable_if<!std::is_integral<T>::value, bool>::type>
-void fillBuffer(void* buffer, int64_t volume, float min, float max)
+void fillBuffer(void* buffer, int64_t volume, float min, float max, uint64_t seed)
 {
+    ASSERT(min <= max);
     T* typedBuffer = static_cast<T*>(buffer);
-    std::default_random_engine engine;
-    std::uniform_real_distribution<float> distribution(min, max);
-    auto generator = [&engine, &distribution]() { return static_cast<T>(distribution(engine)); };
-    std::generate(typedBuffer, typedBuffer + volume, generator);
+    uint64_t const key = seedToKey(seed);
+    // 24 random bits fill the float mantissa, which gives a uniform value in [0, 1).
+    float const scale = (max - min) / static_cast<float>(1 << 24);
+    parallelFill(volume, [&](int64_t begin, int64_t end) {
+        std::array<float, kFILL_BLOCK_SIZE> block;
+        for (int64_t i = begin; i < end; i += kFILL_BLOCK_SIZE)
+        {
+            int64_t const n = std::min(kFILL_BLOCK_SIZE, end - i);
+            // Generate and convert in separate loops so that both are simple enough to be vectorized.
+            for (int64_t j = 0; j < n; ++j)
+            {
+                block[j] = min + scale * static_cast<float>(counterRandom(key, i + j) >> 40);
+            }
+            for (int64_t j = 0; j < n; ++j)
+            {
+                typedBuffer[i + j] = static_cast<T>(block[j]);
+            }
+        }
+    });
 }
 
 // Explicit instantiation
-template void fillBuffer<bool>(void* buffer, int64_t volume, int32_t min, int32_t max);
-template void fillBuffer<int32_t>(void* buffer, int64_t volume, int32_t min, int32_t max);
-template void fillBuffer<int8_t>(void* buffer, int64_t volume, int32_t min, int32_t max);
-template void fillBuffer<float>(void* buffer, int64_t volume, float min, float max);
-template void fillBuffer<__half>(void* buffer, int64_t volume, float min, float max);
-template void fillBuffer<BFloat16>(void* buffer, int64_t volume, float min, float max);
+template void fillBuffer<bool>(void* buffer, int64_t volume, int32_t min, int32_t max, uint64_t seed);
+template void fillBuffer<int32_t>(void* buffer, int64_t volume, int32_t min, int32_t max, uint64_t seed);
+template void fillBuffer<int8_t>(void* buffer, int64_t volume, int32_t min, int32_t max, uint64_t seed);
+template void fillBuffer<float>(void* buffer, int64_t volume, float min, float max, uint64_t seed);
+template void fillBuffer<__half>(void* buffer, int64_t volume, float min, float max, uint64_t seed);
+template void fillBuffer<BFloat16>(void* buffer, int64_t volume, float min, float max, uint64_t seed);
 #if CUDA_VERSION >= 11060
-template void fillBuffer<__nv_fp8_e4m3>(void* buffer, int64_t volume, float min, float max);
+template void fillBuffer<__nv_fp8_e4m3>(void* buffer, int64_t volume, float min, float max, uint64_t seed);
 #endif
-template void fillBuffer<uint8_t>(void* buffer, int64_t volume, int32_t min, int32_t max);
-template void fillBuffer<int64_t>(void* buffer, int64_t volume, int32_t min, int32_t max);
+template void fillBuffer<uint8_t>(void* buffer, int64_t volume, int32_t min, int32_t max, uint64_t seed);
+template void fillBuffer<int64_t>(void* buffer, int64_t volume, int32_t min, int32_t max, uint64_t seed);
 
 bool matchStringWithOneWildcard(std::string const& pattern, std::string const& target)
 {
@@ -863,119 +1341,357 @@ std::vector<std::string> sanitizeArgv(int32_t argc, char** argv)
 // Accuracy Validator Implementations
 // ============================================================================
 
+namespace
+{
+
+//! Number of independent accumulators per thread. Breaking the loop-carried dependency on a single accumulator lets
+//! the compiler keep the lanes in SIMD registers.
+constexpr int64_t kACCURACY_LANES{8};
+//! Number of elements reduced as one unit by one thread.
+constexpr int64_t kACCURACY_ELEMENTS_PER_CHUNK{1 << 20};
+static_assert(kACCURACY_ELEMENTS_PER_CHUNK % kACCURACY_LANES == 0, "Only the last chunk may have a scalar tail");
+//! Minimum number of chunks per thread. Starting a thread costs tens of microseconds, so smaller tensors are reduced
+//! on the calling thread alone.
+constexpr int64_t kACCURACY_MIN_CHUNKS_PER_THREAD{2};
+
+//! Thread count set by setAccuracyValidatorThreads(), 0 for one per hardware thread.
+std::atomic<int32_t> gAccuracyValidatorThreads{0};
+
+//! Decode IEEE binary16 bits without going through half_float::half.
+inline float halfBitsToFloat(uint16_t h)
+{
+    uint32_t const sign = static_cast<uint32_t>(h & 0x8000U) << 16;
+    uint32_t const exponent = (h >> 10) & 0x1FU;
+    uint32_t const mantissa = h & 0x3FFU;
+    uint32_t bits{0};
+    if (exponent == 0x1FU)
+    {
+        bits = sign | 0x7F800000U | (mantissa << 13);
+    }
+    else if (exponent != 0)
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    else
+    {
+        // Zero or subnormal: mantissa * 2^-24 is exact in float.
+        float const f = static_cast<float>(mantissa) * 5.9604644775390625e-8F;
+        return sign ? -f : f;
+    }
+    float f{0.F};
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+#if CUDA_VERSION >= 11060
+//! Decode table for FP8 E4M3 (bias 7, no infinities, S.1111.111 is NaN).
+std::array<float, 256> const& fp8E4M3Table()
+{
+    static std::array<float, 256> const table = [] {
+        std::array<float, 256> t{};
+        for (int32_t b = 0; b < 256; ++b)
+        {
+            int32_t const exponent = (b >> 3) & 0xF;
+            int32_t const mantissa = b & 0x7;
+            float v{0.F};
+            if (exponent == 0xF && mantissa == 0x7)
+            {
+                v = std::numeric_limits<float>::quiet_NaN();
+            }
+            else if (exponent == 0)
+            {
+                v = std::ldexp(static_cast<float>(mantissa) / 8.F, -6);
+            }
+            else
+            {
+                v = std::ldexp(1.F + static_cast<float>(mantissa) / 8.F, exponent - 7);
+            }
+            t[b] = (b & 0x80) ? -v : v;
+        }
+        return t;
+    }();
+    return table;
+}
+#endif
+
 template <typename T>
-double L0AccuracyValidator<T>::calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference)
+inline double toAccuracyValue(T const& v)
+{
+    return static_cast<double>(v);
+}
+
+template <>
+inline double toAccuracyValue(half_float::half const& v)
 {
-    // Uses PyTorch/NumPy allclose formula: |a - b| <= atol + rtol * |b|
-    // See: https://docs.pytorch.org/docs/stable/generated/torch.allclose.html
-    // and infer_ref_check/infer_ref_check.cpp::torchIsClose()
-    ASSERT(actual.size() == reference.size());
-    ASSERT(actual.size() != 0);
-    int64_t mismatchCount = 0;
-    for (uint64_t i = 0; i < actual.size(); ++i)
+    uint16_t bits{0};
+    std::memcpy(&bits, &v, sizeof(bits));
+    return halfBitsToFloat(bits);
+}
+
+template <>
+inline double toAccuracyValue(BFloat16 const& v)
+{
+    uint16_t rep{0};
+    std::memcpy(&rep, &v, sizeof(rep));
+    uint32_t const bits = static_cast<uint32_t>(rep) << 16;
+    float f{0.F};
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+#if CUDA_VERSION >= 11060
+template <>
+inline double toAccuracyValue(__nv_fp8_e4m3 const& v)
+{
+    uint8_t bits{0};
+    std::memcpy(&bits, &v, sizeof(bits));
+    return fp8E4M3Table()[bits];
+}
+#endif
+
+//! Reduce op.accumulate() over elements [begin, end) of two views.
+template <typename T, typename Op>
+typename Op::State reduceAccuracyRange(
+    StridedView<T> const& actual, StridedView<T> const& reference, int64_t begin, int64_t end, Op const& op)
+{
+    if constexpr (Op::kORDERED)
+    {
+        typename Op::State state{};
+        for (int64_t i = begin; i < end; ++i)
+        {
+            op.accumulate(state, toAccuracyValue(actual[i]), toAccuracyValue(reference[i]));
+        }
+        return state;
+    }
+    std::array<typename Op::State, kACCURACY_LANES> lanes{};
+    int64_t i = begin;
+    if (actual.stride == 1 && reference.stride == 1)
     {
-        double const absDiff = std::abs(static_cast<double>(actual[i]) - static_cast<double>(reference[i]));
-        double const refAbs = std::abs(static_cast<double>(reference[i]));
-        double const tolerance = mAtol + mRtol * refAbs;
-        if (absDiff > tolerance)
+        T const* a = actual.data;
+        T const* r = reference.data;
+        for (; i + kACCURACY_LANES <= end; i += kACCURACY_LANES)
         {
-            mismatchCount++;
+            for (int64_t l = 0; l < kACCURACY_LANES; ++l)
+            {
+                op.accumulate(lanes[l], toAccuracyValue(a[i + l]), toAccuracyValue(r[i + l]));
+            }
         }
     }
-    return static_cast<double>(mismatchCount) / actual.size();
+    for (; i < end; ++i)
+    {
+        op.accumulate(lanes[0], toAccuracyValue(actual[i]), toAccuracyValue(reference[i]));
+    }
+    for (int64_t l = 1; l < kACCURACY_LANES; ++l)
+    {
+        Op::combine(lanes[0], lanes[l]);
+    }
+    return lanes[0];
 }
 
-template <typename T>
-double L1AccuracyValidator<T>::calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference)
+//! Reduce op over two whole views.
+//!
+//! Ops whose result depends on the order of accumulation (Op::kORDERED, the floating-point sums) are reduced
+//! element by element into one accumulator, so they are bit-identical to a sequential loop. That loop is bound by the
+//! latency of the dependent additions, so threads could only speed it up by reordering the sum.
+//!
+//! The other ops are exact in any order. Large tensors are cut into chunks of kACCURACY_ELEMENTS_PER_CHUNK elements
+//! that are reduced by whichever thread is free.
+template <typename T, typename Op>
+typename Op::State reduceAccuracy(StridedView<T> const& actual, StridedView<T> const& reference, Op const& op)
 {
-    ASSERT(actual.size() == reference.size());
-    ASSERT(actual.size() != 0);
-    double sum = 0.0;
-    for (uint64_t i = 0; i < actual.size(); ++i)
+    ASSERT(actual.size == reference.size);
+    ASSERT(actual.size != 0);
+    int64_t const size = actual.size;
+    if constexpr (Op::kORDERED)
     {
-        sum += std::abs(static_cast<double>(actual[i]) - static_cast<double>(reference[i]));
+        return reduceAccuracyRange(actual, reference, 0, size, op);
     }
-    return sum / actual.size();
+    int64_t const nbChunks = (size + kACCURACY_ELEMENTS_PER_CHUNK - 1) / kACCURACY_ELEMENTS_PER_CHUNK;
+    int32_t const threadSetting = gAccuracyValidatorThreads.load(std::memory_order_relaxed);
+    int64_t const maxThreads
+        = threadSetting > 0 ? threadSetting : std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+    int64_t const nbThreads = std::clamp<int64_t>(nbChunks / kACCURACY_MIN_CHUNKS_PER_THREAD, 1, maxThreads);
+
+    std::vector<typename Op::State> partials(nbChunks);
+    std::atomic<int64_t> nextChunk{0};
+    auto const reduceChunks = [&] {
+        for (int64_t c = nextChunk++; c < nbChunks; c = nextChunk++)
+        {
+            int64_t const begin = c * kACCURACY_ELEMENTS_PER_CHUNK;
+            partials[c] = reduceAccuracyRange(
+                actual, reference, begin, std::min(begin + kACCURACY_ELEMENTS_PER_CHUNK, size), op);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int64_t t = 1; t < nbThreads; ++t)
+    {
+        threads.emplace_back(reduceChunks);
+    }
+    reduceChunks();
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    for (int64_t c = 1; c < nbChunks; ++c)
+    {
+        Op::combine(partials[0], partials[c]);
+    }
+    return partials[0];
 }
 
-template <typename T>
-double L2AccuracyValidator<T>::calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference)
+struct L0Op
 {
-    ASSERT(actual.size() == reference.size());
-    ASSERT(actual.size() != 0);
-    double sum = 0.0;
-    for (uint64_t i = 0; i < actual.size(); ++i)
+    static constexpr bool kORDERED{false};
+    using State = int64_t;
+    double atol;
+    double rtol;
+    void accumulate(State& s, double a, double r) const
     {
-        double diff = static_cast<double>(actual[i]) - static_cast<double>(reference[i]);
-        sum += diff * diff;
+        // Uses PyTorch/NumPy allclose formula: |a - b| <= atol + rtol * |b|
+        // See: https://docs.pytorch.org/docs/stable/generated/torch.allclose.html
+        // and infer_ref_check/infer_ref_check.cpp::torchIsClose()
+        s += std::abs(a - r) > atol + rtol * std::abs(r);
     }
-    return sum / actual.size();
-}
+    static void combine(State& s, State const& o)
+    {
+        s += o;
+    }
+};
 
-template <typename T>
-double LInfAccuracyValidator<T>::calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference)
+struct L1Op
 {
-    ASSERT(actual.size() == reference.size());
-    ASSERT(actual.size() != 0);
-    double maxDiff = 0.0;
-    for (uint64_t i = 0; i < actual.size(); ++i)
+    static constexpr bool kORDERED{true};
+    using State = double;
+    void accumulate(State& s, double a, double r) const
     {
-        double diff = std::abs(static_cast<double>(actual[i]) - static_cast<double>(reference[i]));
-        maxDiff = std::max(maxDiff, diff);
+        s += std::abs(a - r);
     }
-    return maxDiff;
+    static void combine(State& s, State const& o)
+    {
+        s += o;
+    }
+};
+
+struct L2Op
+{
+    static constexpr bool kORDERED{true};
+    using State = double;
+    void accumulate(State& s, double a, double r) const
+    {
+        double const diff = a - r;
+        s += diff * diff;
+    }
+    static void combine(State& s, State const& o)
+    {
+        s += o;
+    }
+};
+
+struct LInfOp
+{
+    static constexpr bool kORDERED{false};
+    using State = double;
+    void accumulate(State& s, double a, double r) const
+    {
+        // Like std::max(s, diff): a NaN difference is ignored.
+        s = std::max(s, std::abs(a - r));
+    }
+    static void combine(State& s, State const& o)
+    {
+        s = std::max(s, o);
+    }
+};
+
+struct CosineOp
+{
+    static constexpr bool kORDERED{true};
+    struct State
+    {
+        double dotProduct{0.0};
+        double normActual{0.0};
+        double normRef{0.0};
+    };
+    void accumulate(State& s, double a, double r) const
+    {
+        s.dotProduct += a * r;
+        s.normActual += a * a;
+        s.normRef += r * r;
+    }
+    static void combine(State& s, State const& o)
+    {
+        s.dotProduct += o.dotProduct;
+        s.normActual += o.normActual;
+        s.normRef += o.normRef;
+    }
+};
+
+} // namespace
+
+void setAccuracyValidatorThreads(int32_t nbThreads)
+{
+    gAccuracyValidatorThreads.store(std::max(nbThreads, 0), std::memory_order_relaxed);
+}
+
+template <typename T>
+double L0AccuracyValidator<T>::calculateAccuracy(StridedView<T> actual, StridedView<T> reference)
+{
+    auto const mismatchCount = reduceAccuracy(actual, reference, L0Op{mAtol, mRtol});
+    return static_cast<double>(mismatchCount) / actual.size;
+}
+
+template <typename T>
+double L1AccuracyValidator<T>::calculateAccuracy(StridedView<T> actual, StridedView<T> reference)
+{
+    return reduceAccuracy(actual, reference, L1Op{}) / actual.size;
+}
+
+template <typename T>
+double L2AccuracyValidator<T>::calculateAccuracy(StridedView<T> actual, StridedView<T> reference)
+{
+    return reduceAccuracy(actual, reference, L2Op{}) / actual.size;
+}
+
+template <typename T>
+double LInfAccuracyValidator<T>::calculateAccuracy(StridedView<T> actual, StridedView<T> reference)
+{
+    return reduceAccuracy(actual, reference, LInfOp{});
 }
 
 template <typename T>
-double CosineSimilarityValidator<T>::calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference)
-{
-    ASSERT(actual.size() == reference.size());
-    ASSERT(actual.size() != 0);
-    double dotProduct = 0.0;
-    double normActual = 0.0;
-    double normRef = 0.0;
-    for (uint64_t i = 0; i < actual.size(); ++i)
-    {
-        double a = static_cast<double>(actual[i]);
-        double r = static_cast<double>(reference[i]);
-        dotProduct += a * r;
-        normActual += a * a;
-        normRef += r * r;
-    }
-    double denominator = std::sqrt(normActual) * std::sqrt(normRef);
+double CosineSimilarityValidator<T>::calculateAccuracy(StridedView<T> actual, StridedView<T> reference)
+{
+    auto const sums = reduceAccuracy(actual, reference, CosineOp{});
+    double denominator = std::sqrt(sums.normActual) * std::sqrt(sums.normRef);
     if (denominator < 1e-12)
     {
         return 1.0; // Handle zero vectors
     }
-    double cosineSim = dotProduct / denominator;
+    double cosineSim = sums.dotProduct / denominator;
     return 1.0 - cosineSim; // Return as cost (0 = perfect match)
 }
 
 // Explicit template instantiations for supported types
-template class L0AccuracyValidator<float>;
-template class L0AccuracyValidator<int32_t>;
-template class L0AccuracyValidator<int8_t>;
-template class L0AccuracyValidator<half_float::half>;
-
-template class L1AccuracyValidator<float>;
-template class L1AccuracyValidator<int32_t>;
-template class L1AccuracyValidator<int8_t>;
-template class L1AccuracyValidator<half_float::half>;
-
-template class L2AccuracyValidator<float>;
-template class L2AccuracyValidator<int32_t>;
-template class L2AccuracyValidator<int8_t>;
-template class L2AccuracyValidator<half_float::half>;
-
-template class LInfAccuracyValidator<float>;
-template class LInfAccuracyValidator<int32_t>;
-template class LInfAccuracyValidator<int8_t>;
-template class LInfAccuracyValidator<half_float::half>;
-
-template class CosineSimilarityValidator<float>;
-template class CosineSimilarityValidator<int32_t>;
-template class CosineSimilarityValidator<int8_t>;
-template class CosineSimilarityValidator<half_float::half>;
+#if CUDA_VERSION >= 11060
+#define INSTANTIATE_ACCURACY_VALIDATOR_FP8(Validator) template class Validator<__nv_fp8_e4m3>;
+#else
+#define INSTANTIATE_ACCURACY_VALIDATOR_FP8(Validator)
+#endif
+#define INSTANTIATE_ACCURACY_VALIDATOR(Validator)                                                                      \
+    template class Validator<float>;                                                                                   \
+    template class Validator<int32_t>;                                                                                 \
+    template class Validator<int8_t>;                                                                                  \
+    template class Validator<half_float::half>;                                                                        \
+    template class Validator<BFloat16>;                                                                                \
+    INSTANTIATE_ACCURACY_VALIDATOR_FP8(Validator)
+
+INSTANTIATE_ACCURACY_VALIDATOR(L0AccuracyValidator)
+INSTANTIATE_ACCURACY_VALIDATOR(L1AccuracyValidator)
+INSTANTIATE_ACCURACY_VALIDATOR(L2AccuracyValidator)
+INSTANTIATE_ACCURACY_VALIDATOR(LInfAccuracyValidator)
+INSTANTIATE_ACCURACY_VALIDATOR(CosineSimilarityValidator)
+
+#undef INSTANTIATE_ACCURACY_VALIDATOR
+#undef INSTANTIATE_ACCURACY_VALIDATOR_FP8
 
 bool peekArg(int32_t argc, char** argv, char const* flag)
 {
@@ -1193,45 +1909,7 @@ void writeTuningCacheHeader(std::string const& cacheFilePath, AllOptions const&
         return;
     }
     file << header.dump() << std::endl;
-}
-
-void writeTuningCacheIteration(std::string const& cacheFilePath, uint64_t iter, std::string const& buildRoute,
-    bool crashed, std::string const& errorMessage, std::unordered_map<std::string, double> const& accuracyLossValues,
-    double gpuTimeMs)
-{
-    // Use ordered_json to preserve insertion order matching best_config.json.example:
-    // iter, build_route, crash, error_message, accuracy_loss, gpu_time
-    nlohmann::ordered_json result;
-    result[tuningCache::kIter] = iter;
-    result[tuningCache::kBuildRoute] = buildRoute;
-    result[tuningCache::kCrash] = crashed;
-    result[tuningCache::kErrorMessage] = errorMessage;
-
-    // accuracy_loss is a per-output map: {"output_name": accuracy_value, ...}
-    // When crashed, accuracy values are unavailable so we write null.
-    if (crashed || accuracyLossValues.empty())
-    {
-        result[tuningCache::kAccuracyLoss] = nullptr;
-    }
-    else
-    {
-        nlohmann::ordered_json accMap;
-        for (auto const& [name, value] : accuracyLossValues)
-        {
-            accMap[name] = value;
-        }
-        result[tuningCache::kAccuracyLoss] = accMap;
-    }
-    result[tuningCache::kGpuTime] = crashed ? nlohmann::ordered_json(nullptr) : nlohmann::ordered_json(gpuTimeMs);
-
-    std::ofstream file(cacheFilePath, std::ios::app);
-    if (!file)
-    {
-        sample::gLogError << "Cannot open tuning cache file to append iteration " << iter << ": " << cacheFilePath
-                          << std::endl;
-        return;
-    }
-    file << result.dump() << std::endl;
+    std::remove(getTuningCacheIndexPath(cacheFilePath).c_str());
 }
 
 std::vector<std::string> reconstructArgvFromCacheHeader(
@@ -1342,16 +2020,7 @@ std::optional<TuningCacheHeader> readTuningCacheHeader(std::string const& cacheF
             return std::nullopt;
         }
 
-        // Count remaining non-empty lines as completed iterations.
-        header.completedIterations = 0;
-        std::string line;
-        while (std::getline(file, line))
-        {
-            if (!line.empty())
-            {
-                ++header.completedIterations;
-            }
-        }
+        header.completedIterations = static_cast<int64_t>(readTuningCacheIndex(cacheFilePath).size());
 
         return header;
     }
@@ -1362,47 +2031,308 @@ std::optional<TuningCacheHeader> readTuningCacheHeader(std::string const& cacheF
     }
 }
 
-std::vector<CachedIterationResult> readCachedIterationResults(std::string const& cacheFilePath, int64_t maxIterations)
+namespace
 {
-    std::vector<CachedIterationResult> results;
-    std::ifstream file(cacheFilePath);
-    if (!file.is_open())
+//! \struct TuningCacheIndexHeader
+//! \brief Header of the tuning cache index.
+struct TuningCacheIndexHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t entrySize; //!< sizeof(TuningCacheIndexEntry)
+    uint64_t firstOffset; //!< End of the cache header line, where the first iteration line starts.
+};
+
+static_assert(sizeof(TuningCacheIndexHeader) == 24, "TuningCacheIndexHeader layout must not change within a version");
+static_assert(sizeof(TuningCacheIndexEntry) == 32, "TuningCacheIndexEntry layout must not change within a version");
+
+//! Flush f and ask the OS to write it to disk, so that what follows in another file is never persisted before it.
+bool syncFile(std::FILE* f)
+{
+    if (std::fflush(f) != 0)
+    {
+        return false;
+    }
+#if !defined(_WIN32)
+    return fsync(fileno(f)) == 0;
+#else
+    return true;
+#endif
+}
+
+//! Byte offset just past the header line of a tuning cache, or nullopt if it has no complete header line.
+std::optional<uint64_t> findCacheHeaderEnd(std::ifstream& cache)
+{
+    std::string headerLine;
+    if (!std::getline(cache, headerLine) || headerLine.empty() || cache.eof())
     {
-        return results;
+        return std::nullopt;
     }
+    return static_cast<uint64_t>(headerLine.size()) + 1;
+}
 
-    std::string line;
-    // Skip header line.
-    if (!std::getline(file, line))
+//! Index entries from <cache>.idx, or nullopt if the index is missing or does not belong to this cache layout.
+//! Only the entries that form a contiguous run of lines within cacheSize bytes are kept.
+std::optional<std::vector<TuningCacheIndexEntry>> loadIndexFile(
+    std::string const& cacheFilePath, uint64_t headerEnd, uint64_t cacheSize)
+{
+    std::ifstream index(getTuningCacheIndexPath(cacheFilePath), std::ios::binary);
+    TuningCacheIndexHeader header{};
+    if (!index || !index.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, tuningCache::kIndexMagic, sizeof(header.magic)) != 0
+        || header.version != tuningCache::kIndexVersion || header.entrySize != sizeof(TuningCacheIndexEntry)
+        || header.firstOffset != headerEnd)
     {
-        return results;
+        return std::nullopt;
     }
 
-    // Read iteration lines, extracting crash and gpu_time fields.
-    while (std::getline(file, line) && static_cast<int64_t>(results.size()) < maxIterations)
+    std::vector<TuningCacheIndexEntry> entries;
+    uint64_t expectedOffset = headerEnd;
+    TuningCacheIndexEntry entry;
+    while (index.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
     {
-        if (line.empty())
+        if (entry.offset != expectedOffset || entry.length == 0 || entry.offset + entry.length > cacheSize)
         {
-            continue;
+            break;
         }
-        try
+        expectedOffset += entry.length;
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+//! Rebuild the index of a cache that has none by parsing its iteration lines. A trailing line without a newline or
+//! that is not valid JSON was interrupted mid-write and ends the scan.
+std::vector<TuningCacheIndexEntry> scanCacheLines(std::ifstream& cache, uint64_t headerEnd)
+{
+    std::vector<TuningCacheIndexEntry> entries;
+    uint64_t offset = headerEnd;
+    std::string line;
+    while (std::getline(cache, line) && !cache.eof())
+    {
+        uint64_t const length = static_cast<uint64_t>(line.size()) + 1;
+        if (!line.empty())
         {
-            auto j = nlohmann::json::parse(line);
-            CachedIterationResult r;
-            r.crashed = j.value(tuningCache::kCrash, true);
-            r.gpuTimeMs = j.contains(tuningCache::kGpuTime) && j[tuningCache::kGpuTime].is_number()
-                ? j[tuningCache::kGpuTime].get<double>()
-                : 0.0;
-            results.push_back(r);
+            TuningCacheIndexEntry entry;
+            try
+            {
+                auto const j = nlohmann::json::parse(line);
+                entry.iter = j.value(tuningCache::kIter, static_cast<uint64_t>(entries.size()));
+                bool const crashed = j.value(tuningCache::kCrash, true);
+                // Older caches do not record accuracy failures; treat every non-crashed iteration as a success.
+                entry.flags = crashed ? tuningCache::kIndexCrashed : tuningCache::kIndexSucceeded;
+                if (!crashed && j.value(tuningCache::kPruned, false))
+                {
+                    entry.flags = tuningCache::kIndexPruned;
+                }
+                auto const gpuTime = j.find(tuningCache::kGpuTime);
+                entry.gpuTimeMs = (gpuTime != j.end() && gpuTime->is_number()) ? gpuTime->get<double>() : 0.0;
+            }
+            catch (nlohmann::json::exception const&)
+            {
+                break;
+            }
+            entry.offset = offset;
+            entry.length = static_cast<uint32_t>(length);
+            entries.push_back(entry);
+        }
+        else if (!entries.empty())
+        {
+            // Fold stray empty lines into the previous entry so that entries stay contiguous.
+            entries.back().length += 1;
+        }
+        offset += length;
+    }
+    return entries;
+}
+
+//! Index entries of cacheFilePath along with the end of its header line, or nullopt if the cache has no header.
+std::optional<std::pair<uint64_t, std::vector<TuningCacheIndexEntry>>> loadTuningCacheIndex(
+    std::string const& cacheFilePath, bool* rebuilt = nullptr)
+{
+    std::ifstream cache(cacheFilePath, std::ios::binary);
+    auto const headerEnd = cache ? findCacheHeaderEnd(cache) : std::nullopt;
+    if (!headerEnd)
+    {
+        return std::nullopt;
+    }
+    std::error_code ec;
+    uint64_t const cacheSize = std::filesystem::file_size(cacheFilePath, ec);
+    if (auto entries = loadIndexFile(cacheFilePath, *headerEnd, ec ? 0 : cacheSize))
+    {
+        return std::make_pair(*headerEnd, std::move(*entries));
+    }
+    if (rebuilt != nullptr)
+    {
+        *rebuilt = true;
+    }
+    return std::make_pair(*headerEnd, scanCacheLines(cache, *headerEnd));
+}
+} // namespace
+
+std::string getTuningCacheIndexPath(std::string const& cacheFilePath)
+{
+    return cacheFilePath + ".idx";
+}
+
+std::vector<TuningCacheIndexEntry> readTuningCacheIndex(std::string const& cacheFilePath)
+{
+    auto index = loadTuningCacheIndex(cacheFilePath);
+    return index ? std::move(index->second) : std::vector<TuningCacheIndexEntry>{};
+}
+
+TuningCacheStore::TuningCacheStore(std::string const& cacheFilePath)
+    : mCachePath(cacheFilePath)
+{
+    bool rebuilt{false};
+    auto index = loadTuningCacheIndex(cacheFilePath, &rebuilt);
+    if (!index)
+    {
+        sample::gLogError << "Tuning cache " << cacheFilePath << " has no valid header; iterations will not be cached."
+                          << std::endl;
+        return;
+    }
+    uint64_t const headerEnd = index->first;
+    mEntries = std::move(index->second);
+    mCacheSize = mEntries.empty() ? headerEnd : mEntries.back().offset + mEntries.back().length;
+
+    // Drop whatever follows the last indexed line: it was either written partially or never indexed.
+    std::error_code ec;
+    if (std::filesystem::file_size(cacheFilePath, ec) != mCacheSize && !ec)
+    {
+        sample::gLogWarning << "Tuning cache " << cacheFilePath << " ends with an incomplete iteration; discarding it."
+                            << std::endl;
+        std::filesystem::resize_file(cacheFilePath, mCacheSize, ec);
+    }
+    if (ec)
+    {
+        sample::gLogError << "Cannot repair tuning cache " << cacheFilePath << ": " << ec.message() << std::endl;
+        return;
+    }
+
+    // Rewrite the index in full when it was rebuilt or had a torn tail, then keep appending to it.
+    std::string const indexPath = getTuningCacheIndexPath(cacheFilePath);
+    uint64_t const indexSize = sizeof(TuningCacheIndexHeader) + mEntries.size() * sizeof(TuningCacheIndexEntry);
+    if (rebuilt || std::filesystem::file_size(indexPath, ec) != indexSize || ec)
+    {
+        mIndex = std::fopen(indexPath.c_str(), "wb");
+        if (mIndex != nullptr)
+        {
+            TuningCacheIndexHeader header{};
+            std::memcpy(header.magic, tuningCache::kIndexMagic, sizeof(header.magic));
+            header.version = tuningCache::kIndexVersion;
+            header.entrySize = sizeof(TuningCacheIndexEntry);
+            header.firstOffset = headerEnd;
+            std::fwrite(&header, sizeof(header), 1, mIndex);
+            std::fwrite(mEntries.data(), sizeof(TuningCacheIndexEntry), mEntries.size(), mIndex);
+            syncFile(mIndex);
         }
-        catch (nlohmann::json::exception const&)
+    }
+    else
+    {
+        mIndex = std::fopen(indexPath.c_str(), "ab");
+    }
+    mCache = std::fopen(cacheFilePath.c_str(), "ab");
+    if (!isOpen())
+    {
+        sample::gLogError << "Cannot open tuning cache " << cacheFilePath << " or its index for appending."
+                          << std::endl;
+    }
+}
+
+TuningCacheStore::~TuningCacheStore()
+{
+    if (mCache != nullptr)
+    {
+        std::fclose(mCache);
+    }
+    if (mIndex != nullptr)
+    {
+        std::fclose(mIndex);
+    }
+}
+
+void TuningCacheStore::appendIteration(uint64_t iter, std::string const& buildRoute, bool crashed, bool succeeded,
+    std::string const& errorMessage, std::unordered_map<std::string, double> const& accuracyLossValues,
+    double gpuTimeMs, bool pruned)
+{
+    if (!isOpen())
+    {
+        sample::gLogError << "Cannot append iteration " << iter << " to tuning cache " << mCachePath << std::endl;
+        return;
+    }
+
+    // Use ordered_json to preserve insertion order matching best_config.json.example:
+    // iter, build_route, crash, error_message, accuracy_loss, gpu_time
+    nlohmann::ordered_json result;
+    result[tuningCache::kIter] = iter;
+    result[tuningCache::kBuildRoute] = buildRoute;
+    result[tuningCache::kCrash] = crashed;
+    result[tuningCache::kErrorMessage] = errorMessage;
+
+    // accuracy_loss is a per-output map: {"output_name": accuracy_value, ...}
+    // When crashed, accuracy values are unavailable so we write null.
+    if (crashed || accuracyLossValues.empty())
+    {
+        result[tuningCache::kAccuracyLoss] = nullptr;
+    }
+    else
+    {
+        nlohmann::ordered_json accMap;
+        for (auto const& [name, value] : accuracyLossValues)
         {
-            // Malformed line — treat as crashed.
-            results.push_back({true, 0.0});
+            accMap[name] = value;
         }
+        result[tuningCache::kAccuracyLoss] = accMap;
+    }
+    result[tuningCache::kGpuTime] = crashed ? nlohmann::ordered_json(nullptr) : nlohmann::ordered_json(gpuTimeMs);
+    // Only written when set, so that the lines of fully timed iterations keep their format.
+    if (pruned)
+    {
+        result[tuningCache::kPruned] = true;
+    }
+    std::string const line = result.dump() + "\n";
+
+    // The line must be on disk before the index entry that points at it.
+    if (std::fwrite(line.data(), 1, line.size(), mCache) != line.size() || !syncFile(mCache))
+    {
+        sample::gLogError << "Failed to append iteration " << iter << " to tuning cache " << mCachePath << std::endl;
+        return;
+    }
+
+    TuningCacheIndexEntry entry;
+    entry.iter = iter;
+    entry.offset = mCacheSize;
+    entry.length = static_cast<uint32_t>(line.size());
+    entry.flags = (crashed ? tuningCache::kIndexCrashed : 0U) | (succeeded ? tuningCache::kIndexSucceeded : 0U)
+        | (pruned ? tuningCache::kIndexPruned : 0U);
+    entry.gpuTimeMs = crashed ? 0.0 : gpuTimeMs;
+    mCacheSize += line.size();
+    mEntries.push_back(entry);
+    if (std::fwrite(&entry, sizeof(entry), 1, mIndex) != 1 || !syncFile(mIndex))
+    {
+        sample::gLogWarning << "Failed to index iteration " << iter << " of tuning cache " << mCachePath
+                            << "; it will be run again on --continue." << std::endl;
     }
+}
 
-    return results;
+std::string TuningCacheStore::readBuildRoute(size_t position) const
+{
+    auto const& entry = mEntries.at(position);
+    std::ifstream cache(mCachePath, std::ios::binary);
+    std::string line(entry.length, '\0');
+    if (!cache.seekg(static_cast<std::streamoff>(entry.offset)) || !cache.read(line.data(), entry.length))
+    {
+        return {};
+    }
+    try
+    {
+        return nlohmann::json::parse(line).value(tuningCache::kBuildRoute, std::string{});
+    }
+    catch (nlohmann::json::exception const&)
+    {
+        return {};
+    }
 }
 
 } // namespace sample
@@ -19,12 +19,16 @@
 #define TRT_SAMPLE_UTILS_H
 
 #include <cmath>
+#include <condition_variable>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <random>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -64,11 +68,17 @@ using samplesCommon::volume;
 
 nvinfer1::Dims toDims(std::vector<int64_t> const& vec);
 
+//!
+//! \brief Fill buffer with uniformly distributed random values in [min, max] (integers) or [min, max) (floats)
+//!
+//! Every element is a function of the seed and of its index only, so the content of the buffer is reproducible for a
+//! given seed no matter how many threads generate it. Large buffers are filled by several threads.
+//!
 template <typename T, typename std::enable_if<std::is_integral<T>::value, bool>::type = true>
-void fillBuffer(void* buffer, int64_t volume, int32_t min, int32_t max);
+void fillBuffer(void* buffer, int64_t volume, int32_t min, int32_t max, uint64_t seed = 0);
 
 template <typename T, typename std::enable_if<!std::is_integral<T>::value, bool>::type = true>
-void fillBuffer(void* buffer, int64_t volume, float min, float max);
+void fillBuffer(void* buffer, int64_t volume, float min, float max, uint64_t seed = 0);
 
 template <typename T>
 void dumpBuffer(void const* buffer, std::string const& separator, std::ostream& os, nvinfer1::Dims const& dims,
@@ -79,6 +89,98 @@ void dumpInt4Buffer(void const* buffer, std::string const& separator, std::ostre
 
 void loadFromFile(std::string const& fileName, char* dst, size_t size);
 
+//!
+//! \class FileContent
+//! \brief Read-only content of a file, memory-mapped when the platform allows it
+//!
+//! Obtained from loadFileContent(), which hands the same FileContent to every caller that loads the same file while it
+//! is in use, so that each file is read and held in host memory only once per process.
+//!
+class FileContent
+{
+public:
+    //! Throws std::invalid_argument if the file cannot be opened or read.
+    explicit FileContent(std::string const& fileName);
+
+    ~FileContent();
+
+    FileContent(FileContent const&) = delete;
+    FileContent& operator=(FileContent const&) = delete;
+
+    void const* data() const noexcept
+    {
+        return mData;
+    }
+
+    size_t size() const noexcept
+    {
+        return mSize;
+    }
+
+    //! \brief Page-lock the content so that copies to the device are asynchronous. Thread-safe; only pins once.
+    //! \return false if the pages cannot be locked, in which case the content is still readable.
+    bool pin() const;
+
+    //! \brief Bring the whole content into memory ahead of its use, pinning it if possible.
+    void prefetch() const;
+
+private:
+    void const* mData{nullptr};
+    size_t mSize{0};
+    bool mMapped{false};
+    std::vector<char> mBuffer; //!< Holds the content when the file cannot be mapped.
+    mutable std::mutex mPinMutex;
+    mutable int32_t mPinState{0}; //!< 0 = not tried yet, 1 = pinned, -1 = pinning failed.
+};
+
+//!
+//! \brief Load a file through the process-wide file content cache
+//!
+//! The cache is keyed by path and file size and only holds weak references: the content is shared by every caller
+//! that loads the same file while an earlier caller still holds it, and released with its last user. Thread-safe.
+//! With expectedSize set, throws std::invalid_argument unless the file holds expectedSize bytes, or twice as many
+//! for version-compatible engines built with int32 shapes (only the first expectedSize bytes are then used).
+//!
+std::shared_ptr<FileContent const> loadFileContent(std::string const& fileName, std::optional<size_t> expectedSize = {});
+
+//!
+//! \class RefPairPrefetcher
+//! \brief Loads the input files of the next reference pairs on a background thread
+//!
+//! Up to depth pairs ahead of the one being run are loaded and pinned, and held until their pair is acquired, so
+//! that filling the bindings of a pair finds its files in the file content cache instead of reading them on the
+//! inference thread. The files are pinned for the device current on the thread that constructs the prefetcher.
+//! A file that fails to load is skipped: the error is reported when the pair is filled.
+//!
+class RefPairPrefetcher
+{
+public:
+    RefPairPrefetcher(std::vector<InferenceOptions::RefPair> const& refPairs, int32_t depth);
+
+    ~RefPairPrefetcher();
+
+    RefPairPrefetcher(RefPairPrefetcher const&) = delete;
+    RefPairPrefetcher& operator=(RefPairPrefetcher const&) = delete;
+
+    //! \brief Wait until the inputs of pair are loaded, and release those of the pairs before it.
+    //! \return The contents of the inputs of pair, in the order of the pair's map; null for a file that failed to load.
+    std::vector<std::shared_ptr<FileContent const>> acquire(int32_t pair);
+
+private:
+    void run();
+
+    std::vector<InferenceOptions::RefPair> const& mRefPairs;
+    int32_t const mDepth;
+    int32_t mDevice{0};                                                   //!< Device the files are pinned for.
+    std::vector<std::vector<std::shared_ptr<FileContent const>>> mLoaded; //!< Indexed by pair.
+    int32_t mCurrent{0};                                                  //!< Pair being run.
+    int32_t mNext{0};                                                     //!< Next pair to load.
+    bool mStop{false};
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::thread mThread; //!< Started by the constructor once the device is known.
+};
+
 std::vector<std::string> splitToStringVec(std::string const& option, char separator, int64_t maxSplit = -1);
 
 bool broadcastIOFormats(std::vector<IOFormat> const& formats, size_t nbBindings, bool isInput = true);
@@ -158,15 +260,56 @@ std::string sanitizeRemoteAutoTuningConfig(std::string const& config);
 //! @return Vector of sanitized argument strings
 std::vector<std::string> sanitizeArgv(int32_t argc, char** argv);
 
+//! Read-only view over the elements of a host tensor, possibly strided.
+//! Lets the accuracy validators read output and reference buffers in place instead of copying them.
+template <typename T>
+struct StridedView
+{
+    StridedView() = default;
+    StridedView(T const* data_, int64_t size_, int64_t stride_ = 1)
+        : data(data_)
+        , size(size_)
+        , stride(stride_)
+    {
+    }
+    StridedView(std::vector<T> const& v)
+        : data(v.data())
+        , size(static_cast<int64_t>(v.size()))
+    {
+    }
+
+    T const& operator[](int64_t i) const
+    {
+        return data[i * stride];
+    }
+
+    T const* data{nullptr};
+    int64_t size{0};
+    int64_t stride{1}; //!< Distance between consecutive elements, in elements.
+};
+
+//! Set the number of threads used by the L0 and LInf accuracy validators; 0 (the default) uses one per hardware
+//! thread. The sums of the other validators are accumulated in element order on the calling thread.
+void setAccuracyValidatorThreads(int32_t nbThreads);
+
 //! Interface for accuracy validation
 //! This interface provides a way to calculate the accuracy gap between the actual and reference outputs.
 //! Since all the return value is a "loss value", the lower the return value, the better accuracy it is.
+//! Elements are compared in double precision. Large tensors are split into fixed-size chunks reduced across threads,
+//! and each chunk accumulates in several independent lanes so that the compiler can vectorize the loop; sums may
+//! therefore differ from a sequential loop in the last bits, while L0 and LInf are exact. The result does not depend
+//! on the number of threads.
 template <typename T>
 class IAccuracyValidator
 {
 public:
     virtual ~IAccuracyValidator() = default;
-    virtual double calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference) = 0;
+    virtual double calculateAccuracy(StridedView<T> actual, StridedView<T> reference) = 0;
+
+    double calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference)
+    {
+        return calculateAccuracy(StridedView<T>(actual), StridedView<T>(reference));
+    }
 };
 
 //! L0 accuracy validator calculates element-wise accuracy using the PyTorch/NumPy allclose formula.
@@ -183,7 +326,8 @@ public:
     {
     }
 
-    double calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference) override;
+    using IAccuracyValidator<T>::calculateAccuracy;
+    double calculateAccuracy(StridedView<T> actual, StridedView<T> reference) override;
 
 private:
     double mAtol;
@@ -197,7 +341,8 @@ template <typename T>
 class L1AccuracyValidator : public IAccuracyValidator<T>
 {
 public:
-    double calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference) override;
+    using IAccuracyValidator<T>::calculateAccuracy;
+    double calculateAccuracy(StridedView<T> actual, StridedView<T> reference) override;
 };
 
 //! L2 accuracy validator calculates mean squared error.
@@ -207,7 +352,8 @@ template <typename T>
 class L2AccuracyValidator : public IAccuracyValidator<T>
 {
 public:
-    double calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference) override;
+    using IAccuracyValidator<T>::calculateAccuracy;
+    double calculateAccuracy(StridedView<T> actual, StridedView<T> reference) override;
 };
 
 //! LInf accuracy validator calculates maximum absolute error.
@@ -217,7 +363,8 @@ template <typename T>
 class LInfAccuracyValidator : public IAccuracyValidator<T>
 {
 public:
-    double calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference) override;
+    using IAccuracyValidator<T>::calculateAccuracy;
+    double calculateAccuracy(StridedView<T> actual, StridedView<T> reference) override;
 };
 
 //! Cosine similarity validator calculates 1 - cosine_similarity.
@@ -228,7 +375,8 @@ template <typename T>
 class CosineSimilarityValidator : public IAccuracyValidator<T>
 {
 public:
-    double calculateAccuracy(std::vector<T> const& actual, std::vector<T> const& reference) override;
+    using IAccuracyValidator<T>::calculateAccuracy;
+    double calculateAccuracy(StridedView<T> actual, StridedView<T> reference) override;
 };
 
 //! \brief Get human-readable name string for an accuracy validation algorithm.
@@ -275,7 +423,8 @@ std::unique_ptr<IAccuracyValidator<T>> createAccuracyValidator(
 
 // ============================================================================
 // Tuning cache I/O (used by --tuneBuildRoutes / --continue).
-// Header is a single JSON object on line 1; iterations are JSON Lines after.
+// Header is a single JSON object on line 1; iterations are JSON Lines after,
+// indexed by the binary sidecar <cache>.idx (see TuningCacheIndexEntry).
 // ============================================================================
 
 //! \brief Reconstruct a shell-safe command line string from argc/argv.
@@ -285,26 +434,20 @@ std::string buildShellQuotedCmdLine(int32_t argc, char** argv);
 //! Empty input or realpath() failure returns the input unchanged.
 std::string resolveAbsolutePath(std::string const& path);
 
-//! \brief Write the tuning cache file header (line 1, JSON object).
+//! \brief Write the tuning cache file header (line 1, JSON object) and drop any previous iterations and index.
 void writeTuningCacheHeader(std::string const& cacheFilePath, AllOptions const& options, int32_t argc, char** argv,
     std::string const& tunerVersion, std::string const& defaultBuildRoute);
 
-//! \brief Append one iteration line to the cache file. Fields: iter, build_route, crash,
-//! error_message, accuracy_loss, gpu_time. Crashed iterations have null accuracy/gpu.
-void writeTuningCacheIteration(std::string const& cacheFilePath, uint64_t iter, std::string const& buildRoute,
-    bool crashed, std::string const& errorMessage, std::unordered_map<std::string, double> const& accuracyLossValues,
-    double gpuTimeMs);
-
 //! \struct TuningCacheHeader
 //! \brief Parsed contents of the cache header, returned by readTuningCacheHeader().
 struct TuningCacheHeader
 {
     std::vector<std::string> argv;          //!< Original command line with file paths absolute.
     std::string tuningExpr;                  //!< Expanded --tuneBuildRoutes expression.
-    int64_t completedIterations{0};          //!< Number of iteration lines after the header.
+    int64_t completedIterations{0};          //!< Number of iterations recorded in the index.
 };
 
-//! \brief Read and parse the cache file's header line + count completed iteration lines.
+//! \brief Read and parse the cache file's header line; completed iterations come from the index.
 std::optional<TuningCacheHeader> readTuningCacheHeader(std::string const& cacheFilePath);
 
 //! \brief Rebuild argv for a --continue resume. argv[0] is replaced with currentExePath;
@@ -313,16 +456,77 @@ std::optional<TuningCacheHeader> readTuningCacheHeader(std::string const& cacheF
 std::vector<std::string> reconstructArgvFromCacheHeader(
     TuningCacheHeader const& header, std::string const& currentExePath, std::string const& cacheFilePath);
 
-//! \struct CachedIterationResult
-//! \brief Minimal per-iteration fields from the cache, used to reconstruct mixed-mode positive knobs.
-struct CachedIterationResult
+//! \struct TuningCacheIndexEntry
+//! \brief Fixed-size record of the tuning cache index (<cache>.idx), one per iteration line of the cache.
+//!
+//! The index is a small binary sidecar: a TuningCacheIndexHeader followed by one entry per iteration, in the order
+//! the iterations were appended. It lets --continue find the resume point, the best iteration and the results needed
+//! to rebuild mixed-mode positive knobs without parsing the JSON lines of the cache.
+struct TuningCacheIndexEntry
 {
-    bool crashed{true};
-    double gpuTimeMs{0.0};
+    uint64_t iter{0};      //!< Iteration index within its phase.
+    uint64_t offset{0};    //!< Byte offset of the iteration line in the cache file.
+    uint32_t length{0};    //!< Length of the line, including its trailing newline.
+    uint32_t flags{0};     //!< Combination of the tuningCache::kIndex* flags.
+    double gpuTimeMs{0.0}; //!< Mean GPU time (over the timed queries if pruned), 0 when the iteration crashed.
 };
 
-//! \brief Read up to maxIterations iteration lines from the cache and extract (crashed, gpu_time).
-std::vector<CachedIterationResult> readCachedIterationResults(std::string const& cacheFilePath, int64_t maxIterations);
+//! \brief Path of the index of a tuning cache file.
+std::string getTuningCacheIndexPath(std::string const& cacheFilePath);
+
+//! \brief Read the index of a tuning cache without modifying either file.
+//!
+//! Entries that point past the end of the cache, or a partially written trailing entry, are dropped. When the index
+//! is missing or invalid (e.g. a cache written by an older trtexec), it is rebuilt by scanning the cache once.
+std::vector<TuningCacheIndexEntry> readTuningCacheIndex(std::string const& cacheFilePath);
+
+//!
+//! \class TuningCacheStore
+//! \brief Append iterations to a tuning cache and its index through handles kept open for the whole sweep
+//!
+//! Each iteration line is written and synced before its index entry, so a crash can at worst leave a line that has
+//! no index entry yet. Opening the store truncates the cache back to the last indexed line, which drops such a line
+//! (and any partially written one) so the iteration is simply run again.
+//!
+class TuningCacheStore
+{
+public:
+    //! Open cacheFilePath, whose header must have been written by writeTuningCacheHeader().
+    explicit TuningCacheStore(std::string const& cacheFilePath);
+
+    ~TuningCacheStore();
+
+    TuningCacheStore(TuningCacheStore const&) = delete;
+    TuningCacheStore& operator=(TuningCacheStore const&) = delete;
+
+    bool isOpen() const
+    {
+        return mCache != nullptr && mIndex != nullptr;
+    }
+
+    //! \brief Append one iteration line. Fields: iter, build_route, crash, error_message, accuracy_loss, gpu_time,
+    //! and pruned when the child stopped timing early (--tuningPrune).
+    //! Crashed iterations have null accuracy/gpu. succeeded is only kept in the index, for best-iteration selection.
+    void appendIteration(uint64_t iter, std::string const& buildRoute, bool crashed, bool succeeded,
+        std::string const& errorMessage, std::unordered_map<std::string, double> const& accuracyLossValues,
+        double gpuTimeMs, bool pruned = false);
+
+    //! Index entries of the iterations recorded so far, in append order.
+    std::vector<TuningCacheIndexEntry> const& getEntries() const
+    {
+        return mEntries;
+    }
+
+    //! \brief Build route of the entry at position, read from its cache line with a single seek.
+    std::string readBuildRoute(size_t position) const;
+
+private:
+    std::string mCachePath;
+    std::FILE* mCache{nullptr};
+    std::FILE* mIndex{nullptr};
+    uint64_t mCacheSize{0};
+    std::vector<TuningCacheIndexEntry> mEntries;
+};
 
 namespace tuningCache
 {
@@ -332,6 +536,13 @@ constexpr char const* kCrash = "crash";
 constexpr char const* kErrorMessage = "error_message";
 constexpr char const* kAccuracyLoss = "accuracy_loss";
 constexpr char const* kGpuTime = "gpu_time";
+constexpr char const* kPruned = "pruned";
+
+constexpr char kIndexMagic[8] = {'T', 'R', 'T', 'T', 'U', 'N', 'E', 'I'};
+constexpr uint32_t kIndexVersion{1};
+constexpr uint32_t kIndexCrashed{1U << 0};   //!< The iteration crashed or could not be launched.
+constexpr uint32_t kIndexSucceeded{1U << 1}; //!< The iteration built, ran and passed accuracy validation.
+constexpr uint32_t kIndexPruned{1U << 2};    //!< Timing stopped early because the route could not beat the best one.
 } // namespace tuningCache
 
 } // namespace sample
@@ -0,0 +1,401 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "streamReader.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace samplesCommon
+{
+
+namespace
+{
+constexpr int64_t kMAX_READ_SIZE{1 << 30}; //!< Largest single read request, below every platform's limit.
+
+int64_t roundUp(int64_t value, int64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+//! Whether destination is device memory. Host, managed and unknown pointers are read into directly; when no CUDA
+//! device is present cudaPointerGetAttributes fails, which keeps host reads usable without a GPU.
+bool isDeviceMemory(void const* destination)
+{
+    cudaPointerAttributes attributes{};
+    if (cudaPointerGetAttributes(&attributes, destination) != cudaSuccess)
+    {
+        // Clear the sticky error so that it is not reported by an unrelated later call.
+        static_cast<void>(cudaGetLastError());
+        return false;
+    }
+    return attributes.type == cudaMemoryTypeDevice;
+}
+
+int32_t openFile(std::string const& filepath, bool directIO)
+{
+#if defined(_WIN32)
+    static_cast<void>(directIO);
+    return _open(filepath.c_str(), _O_RDONLY | _O_BINARY);
+#elif defined(O_DIRECT)
+    return ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC | (directIO ? O_DIRECT : 0));
+#else
+    static_cast<void>(directIO);
+    return ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+void closeFile(int32_t fd)
+{
+#if defined(_WIN32)
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+int64_t getFileSize(int32_t fd)
+{
+#if defined(_WIN32)
+    return _lseeki64(fd, 0, SEEK_END);
+#else
+    struct stat st{};
+    return fstat(fd, &st) == 0 ? static_cast<int64_t>(st.st_size) : -1;
+#endif
+}
+} // namespace
+
+AsyncStreamReader::AsyncStreamReader(int64_t chunkSize) noexcept
+    : mChunkSize(roundUp(std::max<int64_t>(chunkSize, 1), kDIRECT_IO_ALIGNMENT))
+{
+}
+
+AsyncStreamReader::~AsyncStreamReader()
+{
+    close();
+    releaseStaging();
+}
+
+bool AsyncStreamReader::open(std::string const& filepath, bool directIO)
+{
+    close();
+    mFd = openFile(filepath, directIO);
+    mDirectIO = directIO && mFd >= 0;
+#if defined(O_DIRECT)
+    if (directIO && mFd < 0 && errno == EINVAL)
+    {
+        sample::gLogWarning << "The file system of " << filepath
+                            << " does not support direct I/O; reading it through the page cache." << std::endl;
+        mFd = openFile(filepath, false);
+    }
+#else
+    if (directIO)
+    {
+        sample::gLogWarning << "Direct I/O is not supported on this platform; reading " << filepath
+                            << " through the page cache." << std::endl;
+        mDirectIO = false;
+    }
+#endif
+    if (mFd < 0)
+    {
+        return false;
+    }
+    mFileSize = getFileSize(mFd);
+    if (mFileSize < 0)
+    {
+        close();
+        return false;
+    }
+#if defined(__linux__)
+    if (!mDirectIO)
+    {
+        // Plans are read front to back; let the kernel read ahead aggressively.
+        static_cast<void>(posix_fadvise(mFd, 0, 0, POSIX_FADV_SEQUENTIAL));
+    }
+#endif
+    mPosition = 0;
+    return true;
+}
+
+void AsyncStreamReader::close()
+{
+    waitForCopies();
+    if (mFd >= 0)
+    {
+        closeFile(mFd);
+        mFd = -1;
+    }
+    mDirectIO = false;
+    mPosition = 0;
+    mFileSize = 0;
+}
+
+bool AsyncStreamReader::seek(int64_t offset, nvinfer1::SeekPosition where) noexcept
+{
+    if (!isOpen())
+    {
+        return false;
+    }
+    int64_t base{0};
+    switch (where)
+    {
+    case (nvinfer1::SeekPosition::kSET): base = 0; break;
+    case (nvinfer1::SeekPosition::kCUR): base = mPosition; break;
+    case (nvinfer1::SeekPosition::kEND): base = mFileSize; break;
+    }
+    if (base + offset < 0)
+    {
+        return false;
+    }
+    mPosition = base + offset;
+    return true;
+}
+
+int64_t AsyncStreamReader::read(void* destination, int64_t nbBytes, cudaStream_t stream) noexcept
+{
+    if (!isOpen() || destination == nullptr || nbBytes < 0)
+    {
+        return -1;
+    }
+    bool const toDevice = isDeviceMemory(destination);
+    if (!toDevice && !mDirectIO)
+    {
+        int64_t const nbRead = readAt(destination, mPosition, nbBytes);
+        if (nbRead > 0)
+        {
+            mPosition += nbRead;
+        }
+        return nbRead;
+    }
+
+    auto* const out = static_cast<char*>(destination);
+    int64_t total{0};
+    while (total < nbBytes)
+    {
+        StagingBuffer* buffer = acquireBuffer(toDevice);
+        if (buffer == nullptr)
+        {
+            return -1;
+        }
+        char const* data{nullptr};
+        int64_t const request = std::min(nbBytes - total, mChunkSize);
+        int64_t const nbStaged = stage(*buffer, request, data);
+        if (nbStaged < 0)
+        {
+            return -1;
+        }
+        if (nbStaged == 0)
+        {
+            break;
+        }
+        if (toDevice)
+        {
+            // The copy out of a pinned buffer is truly asynchronous: the next chunk is read while it is in flight.
+            // A pageable buffer can be reused as soon as cudaMemcpyAsync returns.
+            if (cudaMemcpyAsync(out + total, data, nbStaged, cudaMemcpyHostToDevice, stream) != cudaSuccess)
+            {
+                return -1;
+            }
+            if (buffer->pinned)
+            {
+                if (cudaEventRecord(buffer->copied, stream) != cudaSuccess)
+                {
+                    return -1;
+                }
+                buffer->inFlight = true;
+            }
+        }
+        else
+        {
+            std::memcpy(out + total, data, static_cast<size_t>(nbStaged));
+        }
+        total += nbStaged;
+        mPosition += nbStaged;
+        if (nbStaged < request)
+        {
+            break; // End of the file.
+        }
+    }
+    return total;
+}
+
+int64_t AsyncStreamReader::readAt(void* destination, int64_t offset, int64_t nbBytes) noexcept
+{
+    auto* const out = static_cast<char*>(destination);
+    int64_t done{0};
+    while (done < nbBytes)
+    {
+        int64_t const request = std::min(nbBytes - done, kMAX_READ_SIZE);
+#if defined(_WIN32)
+        if (_lseeki64(mFd, offset + done, SEEK_SET) < 0)
+        {
+            return -1;
+        }
+        int64_t const n = _read(mFd, out + done, static_cast<unsigned int>(request));
+#else
+        int64_t const n = pread(mFd, out + done, static_cast<size_t>(request), static_cast<off_t>(offset + done));
+#endif
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -1;
+        }
+        if (n == 0)
+        {
+            break;
+        }
+        done += n;
+    }
+    return done;
+}
+
+int64_t AsyncStreamReader::stage(StagingBuffer const& buffer, int64_t nbBytes, char const*& data) noexcept
+{
+    if (!mDirectIO)
+    {
+        data = buffer.data;
+        return readAt(buffer.data, mPosition, nbBytes);
+    }
+    // Direct reads cover the aligned blocks around the requested range; the buffer holds a chunk plus one block.
+    int64_t const alignedOffset = mPosition / kDIRECT_IO_ALIGNMENT * kDIRECT_IO_ALIGNMENT;
+    int64_t const skip = mPosition - alignedOffset;
+    int64_t const nbRead = readAt(buffer.data, alignedOffset, roundUp(skip + nbBytes, kDIRECT_IO_ALIGNMENT));
+    if (nbRead < 0)
+    {
+        return -1;
+    }
+    data = buffer.data + skip;
+    return std::clamp<int64_t>(nbRead - skip, 0, nbBytes);
+}
+
+AsyncStreamReader::StagingBuffer* AsyncStreamReader::acquireBuffer(bool pinned) noexcept
+{
+    // Device reads want pinned buffers for asynchronous copies; host reads can use whatever the pool holds.
+    // Once pinned memory could not be allocated, device reads keep using the pageable pool instead of retrying.
+    bool const wantPinned = pinned && !mPinnedUnavailable;
+    bool const poolIsPinned = !mStaging.empty() && mStaging.front().pinned;
+    if (mStaging.empty() || (wantPinned && !poolIsPinned))
+    {
+        releaseStaging();
+        if (!allocateStaging(wantPinned))
+        {
+            if (!wantPinned || !allocateStaging(false))
+            {
+                return nullptr;
+            }
+            mPinnedUnavailable = true;
+        }
+    }
+    StagingBuffer& buffer = mStaging[mNextBuffer];
+    mNextBuffer = (mNextBuffer + 1) % mStaging.size();
+    if (buffer.inFlight)
+    {
+        if (cudaEventSynchronize(buffer.copied) != cudaSuccess)
+        {
+            return nullptr;
+        }
+        buffer.inFlight = false;
+    }
+    return &buffer;
+}
+
+bool AsyncStreamReader::allocateStaging(bool pinned) noexcept
+{
+    size_t const bufferSize = static_cast<size_t>(mChunkSize + kDIRECT_IO_ALIGNMENT);
+    mStaging.resize(kNB_STAGING_BUFFERS);
+    for (auto& buffer : mStaging)
+    {
+        buffer.pinned = pinned;
+        if (pinned)
+        {
+            // cudaMallocHost returns page-aligned memory, which satisfies the direct I/O alignment.
+            if (cudaMallocHost(reinterpret_cast<void**>(&buffer.data), bufferSize) != cudaSuccess
+                || cudaEventCreateWithFlags(&buffer.copied, cudaEventDisableTiming) != cudaSuccess)
+            {
+                static_cast<void>(cudaGetLastError());
+                releaseStaging();
+                return false;
+            }
+        }
+        else
+        {
+            buffer.data = static_cast<char*>(
+                ::operator new[](bufferSize, std::align_val_t{kDIRECT_IO_ALIGNMENT}, std::nothrow));
+            if (buffer.data == nullptr)
+            {
+                releaseStaging();
+                return false;
+            }
+        }
+    }
+    mNextBuffer = 0;
+    return true;
+}
+
+void AsyncStreamReader::releaseStaging() noexcept
+{
+    waitForCopies();
+    for (auto& buffer : mStaging)
+    {
+        if (buffer.pinned)
+        {
+            if (buffer.data != nullptr)
+            {
+                cudaFreeHost(buffer.data);
+            }
+            if (buffer.copied != nullptr)
+            {
+                cudaEventDestroy(buffer.copied);
+            }
+        }
+        else if (buffer.data != nullptr)
+        {
+            ::operator delete[](buffer.data, std::align_val_t{kDIRECT_IO_ALIGNMENT});
+        }
+    }
+    mStaging.clear();
+    mNextBuffer = 0;
+}
+
+void AsyncStreamReader::waitForCopies() noexcept
+{
+    for (auto& buffer : mStaging)
+    {
+        if (buffer.inFlight)
+        {
+            static_cast<void>(cudaEventSynchronize(buffer.copied));
+            buffer.inFlight = false;
+        }
+    }
+}
+
+} // namespace samplesCommon
@@ -19,92 +19,100 @@
 #define STREAM_READER_H
 
 #include "NvInferRuntime.h"
-#include "sampleUtils.h"
-#include <fstream>
+
+#include <cstdint>
+#include <cuda_runtime_api.h>
+#include <string>
+#include <vector>
 
 namespace samplesCommon
 {
 
 //! Implements the TensorRT IStreamReaderV2 interface to allow deserializing an engine directly from the plan file.
 //! Supports seeking to a position within the file, and reading directly to device pointers.
-//! This implementation is not optimized, and will not provide performance improvements over the existing reader.
+//!
+//! The file is read with positional reads on a raw file descriptor, so seeking only moves the logical position.
+//! Reads into host memory go straight to the destination. Reads into device memory go through a small pool of
+//! reusable pinned staging buffers, one chunk at a time: the next chunk is read from the file while the copy of the
+//! previous one to the device is still in flight, and a buffer is only reused once the copy out of it has completed.
+//!
+//! With direct I/O (O_DIRECT, Linux only) the page cache is bypassed, so streaming a plan larger than the free host
+//! memory does not evict everything else. Direct reads must be block-aligned and therefore always go through a
+//! staging buffer. If the file system does not support direct I/O, the file is read through the page cache.
 class AsyncStreamReader final : public nvinfer1::IStreamReaderV2
 {
 public:
-    bool open(std::string const& filepath)
-    {
-        mFile.open(filepath, std::ios::binary);
-        return mFile.is_open();
-    }
+    static constexpr int64_t kDEFAULT_CHUNK_SIZE{8 << 20};
+    static constexpr int32_t kNB_STAGING_BUFFERS{3};
+    //! Alignment of direct reads; also a multiple of the page size, so it suits every supported platform.
+    static constexpr int64_t kDIRECT_IO_ALIGNMENT{4096};
 
-    void close()
-    {
-        if (mFile.is_open())
-        {
-            mFile.close();
-        }
-    }
+    //! chunkSize is rounded up to a multiple of kDIRECT_IO_ALIGNMENT.
+    explicit AsyncStreamReader(int64_t chunkSize = kDEFAULT_CHUNK_SIZE) noexcept;
 
-    ~AsyncStreamReader() final
-    {
-        close();
-    }
+    ~AsyncStreamReader() final;
 
-    bool seek(int64_t offset, nvinfer1::SeekPosition where) noexcept final
-    {
-        switch (where)
-        {
-        case (nvinfer1::SeekPosition::kSET): mFile.seekg(offset, std::ios_base::beg); break;
-        case (nvinfer1::SeekPosition::kCUR): mFile.seekg(offset, std::ios_base::cur); break;
-        case (nvinfer1::SeekPosition::kEND): mFile.seekg(offset, std::ios_base::end); break;
-        }
-        return mFile.good();
-    }
+    AsyncStreamReader(AsyncStreamReader const&) = delete;
+    AsyncStreamReader& operator=(AsyncStreamReader const&) = delete;
 
-    int64_t read(void* destination, int64_t nbBytes, cudaStream_t stream) noexcept final
-    {
-        if (!mFile.good())
-        {
-            return -1;
-        }
-
-        cudaPointerAttributes attributes;
-        ASSERT(cudaPointerGetAttributes(&attributes, destination) == cudaSuccess);
-
-        // from CUDA 11 onward, host pointers are return cudaMemoryTypeUnregistered
-        if (attributes.type == cudaMemoryTypeHost || attributes.type == cudaMemoryTypeUnregistered)
-        {
-            mFile.read(static_cast<char*>(destination), nbBytes);
-            return mFile.gcount();
-        }
-        else if (attributes.type == cudaMemoryTypeDevice)
-        {
-            // Set up a temp buffer to read into if reading into device memory.
-            std::unique_ptr<char[]> tmpBuf{new char[nbBytes]};
-            mFile.read(tmpBuf.get(), nbBytes);
-            // cudaMemcpyAsync into device storage.
-            ASSERT(cudaMemcpyAsync(destination, tmpBuf.get(), nbBytes, cudaMemcpyHostToDevice, stream) == cudaSuccess);
-            // No race between the copying and freeing of tmpBuf, because cudaMemcpyAsync will
-            // return once the pageable buffer has been copied to the staging memory for DMA transfer
-            // to device memory.
-            return mFile.gcount();
-        }
-        return -1;
-    }
+    //! Open filepath for reading, closing the file opened before if any.
+    bool open(std::string const& filepath, bool directIO = false);
+
+    //! Wait for the copies that are still in flight and close the file. Staging buffers are kept for the next file.
+    void close();
+
+    bool seek(int64_t offset, nvinfer1::SeekPosition where) noexcept final;
+
+    int64_t read(void* destination, int64_t nbBytes, cudaStream_t stream) noexcept final;
 
     void reset()
     {
-        ASSERT(mFile.good());
-        mFile.seekg(0);
+        mPosition = 0;
     }
 
     bool isOpen() const
     {
-        return mFile.is_open();
+        return mFd >= 0;
+    }
+
+    //! Whether the open file is read with direct I/O, i.e. it was requested and the file system supports it.
+    bool isDirectIO() const
+    {
+        return mDirectIO;
     }
 
 private:
-    std::ifstream mFile;
+    struct StagingBuffer
+    {
+        char* data{nullptr};
+        bool pinned{false};
+        cudaEvent_t copied{nullptr}; //!< Recorded after the copy out of a pinned buffer.
+        bool inFlight{false};
+    };
+
+    //! Read nbBytes at offset, retrying short reads. Returns the number of bytes read (less at the end of the file)
+    //! or -1 on error.
+    int64_t readAt(void* destination, int64_t offset, int64_t nbBytes) noexcept;
+
+    //! Read up to nbBytes at the current position into buffer and point data at them.
+    //! Returns the number of bytes available at data, 0 at the end of the file or -1 on error.
+    int64_t stage(StagingBuffer const& buffer, int64_t nbBytes, char const*& data) noexcept;
+
+    //! Next staging buffer of the pool, once the copy out of it has completed. nullptr if none can be allocated.
+    StagingBuffer* acquireBuffer(bool pinned) noexcept;
+
+    bool allocateStaging(bool pinned) noexcept;
+    void releaseStaging() noexcept;
+    void waitForCopies() noexcept;
+
+    int32_t mFd{-1};
+    bool mDirectIO{false};
+    int64_t mPosition{0};
+    int64_t mFileSize{0};
+    int64_t mChunkSize{kDEFAULT_CHUNK_SIZE};
+    std::vector<StagingBuffer> mStaging;
+    size_t mNextBuffer{0};
+    bool mPinnedUnavailable{false}; //!< Pinned staging buffers failed to allocate; use pageable ones from then on.
 };
 
 } // namespace samplesCommon
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "streamReader.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace samplesCommon;
+
+namespace
+{
+//! Write a file of n bytes whose byte i is a function of i, and return its path.
+std::string writePatternFile(char const* name, int64_t n)
+{
+    auto const path = (std::filesystem::temp_directory_path() / name).string();
+    std::vector<char> data(static_cast<size_t>(n));
+    for (int64_t i = 0; i < n; ++i)
+    {
+        data[i] = static_cast<char>((i * 31) ^ (i >> 8));
+    }
+    std::ofstream(path, std::ios::binary).write(data.data(), static_cast<std::streamsize>(n));
+    return path;
+}
+
+bool matchesPattern(std::vector<char> const& data, int64_t offset, int64_t n)
+{
+    for (int64_t i = 0; i < n; ++i)
+    {
+        int64_t const j = offset + i;
+        if (data[i] != static_cast<char>((j * 31) ^ (j >> 8)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST(AsyncStreamReader, HostReadsSeekAndStopAtEnd)
+{
+    // Not a multiple of the chunk size, so the last chunk is short.
+    int64_t const size = 3 * AsyncStreamReader::kDIRECT_IO_ALIGNMENT + 123;
+    auto const path = writePatternFile("trt_stream_reader.bin", size);
+    for (bool const directIO : {false, true})
+    {
+        AsyncStreamReader reader(AsyncStreamReader::kDIRECT_IO_ALIGNMENT);
+        ASSERT_TRUE(reader.open(path, directIO));
+
+        std::vector<char> data(static_cast<size_t>(size));
+        // Unaligned position and length, spanning several chunks.
+        ASSERT_TRUE(reader.seek(1001, nvinfer1::SeekPosition::kSET));
+        ASSERT_EQ(reader.read(data.data(), 9000, nullptr), 9000);
+        EXPECT_TRUE(matchesPattern(data, 1001, 9000));
+
+        ASSERT_TRUE(reader.seek(-100, nvinfer1::SeekPosition::kCUR));
+        ASSERT_EQ(reader.read(data.data(), 50, nullptr), 50);
+        EXPECT_TRUE(matchesPattern(data, 9901, 50));
+
+        // A read past the end returns what is left, then 0.
+        ASSERT_TRUE(reader.seek(-10, nvinfer1::SeekPosition::kEND));
+        ASSERT_EQ(reader.read(data.data(), 100, nullptr), 10);
+        EXPECT_TRUE(matchesPattern(data, size - 10, 10));
+        EXPECT_EQ(reader.read(data.data(), 100, nullptr), 0);
+        EXPECT_FALSE(reader.seek(-1, nvinfer1::SeekPosition::kSET));
+
+        reader.reset();
+        ASSERT_EQ(reader.read(data.data(), size, nullptr), size);
+        EXPECT_TRUE(matchesPattern(data, 0, size));
+        reader.close();
+        EXPECT_FALSE(reader.isOpen());
+        EXPECT_EQ(reader.read(data.data(), 1, nullptr), -1);
+    }
+    std::remove(path.c_str());
+}
+
+//! Run with --gtest_also_run_disabled_tests --gtest_filter=AsyncStreamReader.DISABLED_Benchmark
+//! Compares with reading through std::ifstream, as the reader did before. Run it on a cold page cache (or on a file
+//! larger than the free memory) for numbers that are representative of loading a large plan.
+TEST(AsyncStreamReader, DISABLED_Benchmark)
+{
+    int64_t const size = int64_t{1} << 30;
+    int64_t const request = int64_t{64} << 20;
+    auto const path = writePatternFile("trt_stream_reader_benchmark.bin", size);
+    std::vector<char> data(static_cast<size_t>(request));
+    auto const time = [](auto&& fn) {
+        auto const start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    double const ifstreamS = time([&] {
+        std::ifstream file(path, std::ios::binary);
+        while (file.read(data.data(), request) || file.gcount() > 0)
+        {
+        }
+    });
+    for (bool const directIO : {false, true})
+    {
+        AsyncStreamReader reader;
+        ASSERT_TRUE(reader.open(path, directIO));
+        double const readerS = time([&] {
+            while (reader.read(data.data(), request, nullptr) > 0)
+            {
+            }
+        });
+        std::cout << "Read " << (size >> 20) << " MiB: std::ifstream " << (size >> 20) / ifstreamS
+                  << " MiB/s, AsyncStreamReader" << (reader.isDirectIO() ? " (direct I/O) " : " ")
+                  << (size >> 20) / readerS << " MiB/s" << std::endl;
+    }
+    std::remove(path.c_str());
+}
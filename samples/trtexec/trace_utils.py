@@ -0,0 +1,119 @@
+#
+# SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""
+Utils to read trtexec timing traces
+
+Both the JSON trace written by --exportTimes and the binary trace written by
+--exportTimes --exportTimesFormat=binary are supported. Binary traces are read
+one block at a time, so memory use does not depend on the length of the run.
+"""
+
+import array
+import json
+import struct
+import sys
+
+MAGIC = b"TRTTRACE"
+VERSION = 1
+
+# magic, version, headerSize, nbColumns, blockCapacity, warmupMs, reserved
+header = struct.Struct("<8sIIIIfI")
+blockCount = struct.Struct("<I")
+
+# Column order of a binary trace block (see samples/common/sampleTraceFile.h).
+columns = [
+    "stream",
+    "startEnqMs",
+    "endEnqMs",
+    "startH2dMs",
+    "endH2dMs",
+    "startComputeMs",
+    "endComputeMs",
+    "startD2hMs",
+    "endD2hMs",
+]
+
+
+def isBinaryTrace(fileName):
+    """Check if a file starts with the binary trace magic"""
+
+    with open(fileName, "rb") as f:
+        return f.read(len(MAGIC)) == MAGIC
+
+
+def readHeader(f):
+    """Read and validate the header of a binary trace, leaving f at the first block"""
+
+    raw = f.read(header.size)
+    if len(raw) < header.size:
+        raise ValueError("Truncated trace header")
+    magic, version, headerSize, nbColumns, blockCapacity, warmupMs, _ = header.unpack(raw)
+    if magic != MAGIC:
+        raise ValueError("Not a binary trtexec trace")
+    if version != VERSION or nbColumns != len(columns) or headerSize < header.size:
+        raise ValueError("Unsupported trace file version {} with {} columns".format(version, nbColumns))
+    f.seek(headerSize)
+    return {"version": version, "blockCapacity": blockCapacity, "warmupMs": warmupMs}
+
+
+def readBinaryBlocks(fileName):
+    """Yield the blocks of a binary trace as dictionaries of column name to array of floats.
+    A trailing block that was only partially written (e.g. the run was killed) is ignored."""
+
+    with open(fileName, "rb") as f:
+        info = readHeader(f)
+        while True:
+            raw = f.read(blockCount.size)
+            if len(raw) < blockCount.size:
+                return
+            (count,) = blockCount.unpack(raw)
+            if count == 0 or count > info["blockCapacity"]:
+                return
+            data = f.read(4 * count * len(columns))
+            if len(data) < 4 * count * len(columns):
+                return
+            values = array.array("f")
+            values.frombytes(data)
+            if sys.byteorder != "little":
+                values.byteswap()
+            yield {name: values[c * count : (c + 1) * count] for c, name in enumerate(columns)}
+
+
+def addIntervals(record):
+    """Add the durations derived from the timestamps, as exportJSONTrace does"""
+
+    record["h2dMs"] = record["endH2dMs"] - record["startH2dMs"]
+    record["computeMs"] = record["endComputeMs"] - record["startComputeMs"]
+    record["d2hMs"] = record["endD2hMs"] - record["startD2hMs"]
+    record["latencyMs"] = record["h2dMs"] + record["computeMs"] + record["d2hMs"]
+    return record
+
+
+def readTrace(fileName):
+    """Yield the records of a JSON or binary trace as dictionaries keyed like the JSON trace"""
+
+    if not isBinaryTrace(fileName):
+        with open(fileName) as f:
+            yield from json.load(f)
+        return
+
+    for block in readBinaryBlocks(fileName):
+        for i in range(len(block["stream"])):
+            record = {name: block[name][i] for name in columns}
+            record["stream"] = int(record["stream"])
+            yield addIntervals(record)
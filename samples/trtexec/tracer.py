@@ -17,27 +17,32 @@
 #
 
 """
-Print a trtexec timing trace from a JSON file
+Print a trtexec timing trace from a JSON or binary file
 
-Given a JSON file containing a trtexec timing trace,
+Given a file containing a trtexec timing trace, written by
+--exportTimes in either the json or the binary format,
 this program prints the trace in CSV table format.
 Each row represents an entry point in the trace.
 
 The columns, as indicated by the header, respresent
 one of the metric recorded. The output format can
 be optionally converted to a format suitable for
-GNUPlot.
+GNUPlot, or to the JSON trace format.
+Binary traces are processed one block at a time, so
+long traces do not need to fit in memory.
 """
 
 import sys
 import json
 import argparse
+import itertools
 import prn_utils as pu
+import trace_utils as tu
 
 
-timestamps = ["startInMs", "endInMs", "startComputeMs", "endComputeMs", "startOutMs", "endOutMs"]
+timestamps = ["startH2dMs", "endH2dMs", "startComputeMs", "endComputeMs", "startD2hMs", "endD2hMs"]
 
-intervals = ["inMs", "computeMs", "outMs", "latencyMs", "endToEndMs"]
+intervals = ["h2dMs", "computeMs", "d2hMs", "latencyMs"]
 
 allMetrics = timestamps + intervals
 
@@ -54,7 +59,6 @@ descriptions = [
     "compute",
     "output",
     "latency",
-    "end to end latency",
 ]
 
 metricsDescription = pu.combineDescriptions("Possible metrics (all in ms) are:", allMetrics, descriptions)
@@ -63,11 +67,27 @@ metricsDescription = pu.combineDescriptions("Possible metrics (all in ms) are:",
 def skipTrace(trace, start):
     """Skip trace entries until start time"""
 
-    for t in range(len(trace)):
-        if trace[t]["startComputeMs"] >= start:
-            return trace[t:]
+    return itertools.dropwhile(lambda t: t["startComputeMs"] < start, trace)
 
-    return []
+
+def filterTrace(trace, metrics):
+    """Keep the selected metrics of each trace entry, in the order of allMetrics"""
+
+    for t in trace:
+        yield [t.get(m, "") for m in allMetrics if m in metrics]
+
+
+def printJson(trace):
+    """Print trace entries in the format of the JSON trace written by trtexec"""
+
+    print("[")
+    sep = "  "
+    for t in trace:
+        # Binary traces hold float32 values; 7 significant digits represent them exactly enough.
+        t = {k: float("{:.7g}".format(v)) if isinstance(v, float) else v for k, v in t.items()}
+        print(sep + json.dumps(t))
+        sep = ", "
+    print("]")
 
 
 def hasTimestamp(metrics):
@@ -82,7 +102,6 @@ def hasTimestamp(metrics):
 def avgData(data, avg, times):
     """Average trace entries (every avg entries)"""
 
-    averaged = []
     accumulator = []
     r = 0
 
@@ -98,12 +117,10 @@ def avgData(data, avg, times):
         if r == avg:
             for t in range(times, len(row)):
                 accumulator[t] /= avg
-            averaged.append(accumulator)
+            yield accumulator
             accumulator = []
             r = 0
 
-    return averaged
-
 
 def main():
     parser = argparse.ArgumentParser(description=__doc__)
@@ -123,22 +140,28 @@ def main():
     )
     parser.add_argument("--gp", action="store_true", help="Print GNUPlot format.")
     parser.add_argument("--no-header", action="store_true", help="Omit the header row.")
+    parser.add_argument(
+        "--json", action="store_true", help="Convert the trace to the JSON trace format instead of printing CSV."
+    )
     parser.add_argument("name", metavar="filename", help="Trace file.")
     args = parser.parse_args()
 
+    trace = tu.readTrace(args.name)
+
+    if args.start > 0:
+        trace = skipTrace(trace, args.start)
+
+    if args.json:
+        printJson(trace)
+        return
+
     metrics = args.metrics.split(",")
     count = args.gp and (not hasTimestamp(metrics) or len(metrics) == 1)
 
     if not args.no_header:
         pu.printHeader(allMetrics, metrics, args.gp, count)
 
-    with open(args.name) as f:
-        trace = json.load(f)
-
-    if args.start > 0:
-        trace = skipTrace(trace, args.start)
-
-    trace = pu.filterData(trace, allMetrics, metrics)
+    trace = filterTrace(trace, metrics)
 
     if args.avg > 1:
         trace = avgData(trace, args.avg, hasTimestamp(metrics))
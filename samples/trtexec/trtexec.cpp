@@ -42,7 +42,12 @@
 #include <sys/wait.h>
 #include <unistd.h>
 #endif
+#if defined(__linux__)
+#include <sched.h>
+#endif
 #include <system_error>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include "NvInfer.h"
@@ -436,6 +441,10 @@ int32_t runOnceBuildAndInfer(
     {
         sample::setReportableSeverity(ILogger::Severity::kVERBOSE);
     }
+    if (options.reporting.asyncLogging)
+    {
+        sample::AsyncLogWriter::start();
+    }
     std::string const jitInVersion;
     if (!options.build.cpuOnly)
     {
@@ -669,13 +678,14 @@ int32_t runOnceBuildAndInfer(
                          << std::endl;
         return EXIT_FAILURE;
     }
-    bool const profilerEnabled = options.reporting.profile || !options.reporting.exportProfile.empty();
+    bool const profilerEnabled = options.reporting.profile || !options.reporting.exportProfile.empty()
+        || !options.reporting.compareProfile.empty();
 
     bool const layerInfoEnabled = options.reporting.layerInfo || !options.reporting.exportLayerInfo.empty();
     if (iEnv->safe && (profilerEnabled || layerInfoEnabled))
     {
         sample::gLogError << "Safe runtime does not support --dumpProfile or --exportProfile=<file> or "
-                             "--dumpLayerInfo or --exportLayerInfo=<file>, please use "
+                             "--compareProfile=<file> or --dumpLayerInfo or --exportLayerInfo=<file>, please use "
                              "--verbose to print profiling info."
                           << std::endl;
         return EXIT_FAILURE;
@@ -724,12 +734,28 @@ int32_t runOnceBuildAndInfer(
         return EXIT_FAILURE;
     }
 
-    printPerformanceReport(
-        trace, options.reporting, options.inference, sample::gLogInfo, sample::gLogWarning, sample::gLogVerbose);
+    if (options.reporting.streamingStats)
+    {
+        printPerformanceReport(*iEnv->timeRecorder, options.reporting, options.inference, sample::gLogInfo,
+            sample::gLogWarning, sample::gLogVerbose);
+    }
+    else
+    {
+        printPerformanceReport(
+            trace, options.reporting, options.inference, sample::gLogInfo, sample::gLogWarning, sample::gLogVerbose);
+    }
 
     printOutput(options.reporting, *iEnv, options.inference.batch);
 
-    if (profilerEnabled)
+    bool const pruned = iEnv->pruned;
+    if (pruned)
+    {
+        sample::gLogInfo << "Timing stopped early: the median GPU compute time is above --tuningPruneAboveMs="
+                         << options.inference.pruneAboveMs << " ms." << std::endl;
+    }
+
+    // A pruned tuning iteration cannot become the best route, so its layer profile is not worth the extra run.
+    if (profilerEnabled && !pruned)
     {
         iEnv->profiler = std::make_unique<Profiler>();
         if (!prepareProfileRun(*iEnv, options.inference, options.system))
@@ -741,12 +767,17 @@ int32_t runOnceBuildAndInfer(
             sample::gLogError << "Error occurred during inference" << std::endl;
             return EXIT_FAILURE;
         }
+        printPerformanceProfile(options.reporting, *iEnv);
+        if (!options.reporting.compareProfile.empty()
+            && !compareWithBaselineProfile(options.reporting, *iEnv->profiler))
+        {
+            return EXIT_FAILURE;
+        }
     }
-    printPerformanceProfile(options.reporting, *iEnv);
 
     // --tuningResultFile is the hidden parent->child IPC channel used by the
-    // tuning loop. Write a compact JSON with gpu_time_ms, accuracy_failed, and
-    // per-tensor accuracy_loss so the parent can update its cache + best
+    // tuning loop. Write a compact JSON with gpu_time_ms, accuracy_failed, pruned
+    // and per-tensor accuracy_loss so the parent can update its cache + best
     // tracking after waitpid(). The flag is omitted from --help; an end user
     // who passes it manually still gets the same JSON, which is intentional —
     // it makes a tuning iteration reproducible by `--setBuildRoute=<route>
@@ -754,7 +785,11 @@ int32_t runOnceBuildAndInfer(
     if (!options.tuning.tuningResultFile.empty())
     {
         double meanGpuTimeMs{0.0};
-        if (!trace.empty())
+        if (options.reporting.streamingStats)
+        {
+            meanGpuTimeMs = iEnv->timeRecorder->getMeanComputeMs();
+        }
+        else if (!trace.empty())
         {
             double sum{0.0};
             for (auto const& t : trace)
@@ -766,6 +801,7 @@ int32_t runOnceBuildAndInfer(
         nlohmann::json j;
         j["gpu_time_ms"] = meanGpuTimeMs;
         j["accuracy_failed"] = iEnv->accuracyFailed;
+        j["pruned"] = pruned;
         auto lossJson = nlohmann::json::object();
         for (auto const& [name, loss] : iEnv->accuracyLossValues)
         {
@@ -855,6 +891,7 @@ struct IterationResult
 {
     bool crashed{false};        //!< Child crashed or fork/waitpid failed.
     bool accuracyFailed{false}; //!< Child reported accuracy-threshold failure.
+    bool pruned{false};         //!< Child stopped timing early because it could not beat --tuningPruneAboveMs.
     int32_t exitCode{0};        //!< Child exit code (or -1 on fork/waitpid error).
     double gpuTimeMs{0.0};      //!< Mean GPU compute time (ms) from the trace.
     std::string errorMessage;   //!< Brief diagnostic for the parent log.
@@ -880,6 +917,7 @@ IterationResult readChildResult(std::string const& jsonPath)
         in >> j;
         r.gpuTimeMs = j.value("gpu_time_ms", 0.0);
         r.accuracyFailed = j.value("accuracy_failed", false);
+        r.pruned = j.value("pruned", false);
         if (j.contains("accuracy_loss") && j["accuracy_loss"].is_object())
         {
             for (auto const& [k, v] : j["accuracy_loss"].items())
@@ -896,14 +934,63 @@ IterationResult readChildResult(std::string const& jsonPath)
     return r;
 }
 
-//! Fork+exec one child trtexec invocation for the given route. Reads the
-//! resulting JSON and returns an IterationResult. Never throws — failures
-//! are reported as `crashed=true` with a brief errorMessage.
-IterationResult runChildForOneRoute(int32_t argc, char** argv, BigInt const& globalIndex, std::string const& route,
-    std::string const& enginePath, std::string const& resultJsonPath)
+//! CPU and device resources that one --tuningJobs worker pins its children to.
+struct WorkerSlot
+{
+    std::optional<int32_t> device; //!< Injected as --device=<N>; nullopt keeps the user's --device.
+    std::vector<int32_t> cpus;     //!< Child CPU affinity set; empty keeps the inherited mask.
+};
+
+//! Build one WorkerSlot per --tuningJobs worker. Devices are assigned round-robin from
+//! --tuningDevices. With more than one worker, the CPUs the parent may run on are split
+//! into contiguous, disjoint sets so concurrent builds do not contend for the same cores.
+std::vector<WorkerSlot> makeWorkerSlots(TuningOptions const& tuning)
+{
+    int32_t const jobs = std::max(tuning.jobs, 1);
+    std::vector<WorkerSlot> slots(static_cast<size_t>(jobs));
+    for (int32_t s = 0; s < jobs && !tuning.devices.empty(); ++s)
+    {
+        slots[s].device = tuning.devices[static_cast<size_t>(s) % tuning.devices.size()];
+    }
+#if defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (jobs > 1 && sched_getaffinity(0, sizeof(mask), &mask) == 0)
+    {
+        std::vector<int32_t> cpus;
+        for (int32_t c = 0; c < CPU_SETSIZE; ++c)
+        {
+            if (CPU_ISSET(c, &mask))
+            {
+                cpus.push_back(c);
+            }
+        }
+        // Fewer CPUs than workers: leave every child on the full mask rather than oversubscribe one core.
+        if (cpus.size() >= static_cast<size_t>(jobs))
+        {
+            size_t const perSlot = cpus.size() / static_cast<size_t>(jobs);
+            for (int32_t s = 0; s < jobs; ++s)
+            {
+                auto const first = cpus.begin() + static_cast<int64_t>(s * perSlot);
+                auto const last = (s == jobs - 1) ? cpus.end() : first + static_cast<int64_t>(perSlot);
+                slots[s].cpus.assign(first, last);
+            }
+        }
+    }
+#endif
+    return slots;
+}
+
+//! Fork+exec one child trtexec invocation for the given route, pinned to `slot`.
+//! Returns the child's pid, or -1 (with `errorMessage` set) if fork() failed.
+//! Does not wait for the child; see collectChildResult().
+pid_t spawnChildForOneRoute(int32_t argc, char** argv, BigInt const& globalIndex, std::string const& route,
+    std::string const& enginePath, std::string const& resultJsonPath, WorkerSlot const& slot,
+    std::optional<double> pruneAboveMs, std::string& errorMessage)
 {
     std::vector<std::string> storage;
-    auto const childArgv = buildTuningChildArgv(argc, argv, route, enginePath, resultJsonPath, storage);
+    auto const childArgv
+        = buildTuningChildArgv(argc, argv, route, enginePath, resultJsonPath, storage, slot.device, pruneAboveMs);
 
     sample::gLogInfo << "Tuning iteration [" << globalIndex.toString() << "]: " << route << std::endl;
     // Ensure stale result files from a previous iteration aren't mistaken for this one's output.
@@ -912,33 +999,39 @@ IterationResult runChildForOneRoute(int32_t argc, char** argv, BigInt const& glo
     pid_t const pid = fork();
     if (pid < 0)
     {
-        IterationResult r;
-        r.crashed = true;
-        r.exitCode = -1;
-        r.errorMessage = std::string{"fork() failed: "} + std::strerror(errno);
-        sample::gLogError << r.errorMessage << std::endl;
-        return r;
+        errorMessage = std::string{"fork() failed: "} + std::strerror(errno);
+        sample::gLogError << errorMessage << std::endl;
+        return -1;
     }
     if (pid == 0)
     {
+#if defined(__linux__)
+        if (!slot.cpus.empty())
+        {
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            for (int32_t const c : slot.cpus)
+            {
+                CPU_SET(c, &mask);
+            }
+            // Best effort: an affinity failure only costs isolation, not correctness.
+            (void) sched_setaffinity(0, sizeof(mask), &mask);
+        }
+#endif
         // Child: replace ourselves with a fresh trtexec invocation. execvp searches PATH for argv[0].
         execvp(childArgv[0], childArgv.data());
         // execvp returns only on failure.
         std::cerr << "execvp() failed: " << std::strerror(errno) << std::endl;
         _exit(127);
     }
-    // Parent: wait for the child.
-    int32_t status{};
-    pid_t const w = waitpid(pid, &status, 0);
-    if (w < 0)
-    {
-        IterationResult r;
-        r.crashed = true;
-        r.exitCode = -1;
-        r.errorMessage = std::string{"waitpid() failed: "} + std::strerror(errno);
-        return r;
-    }
+    return pid;
+}
 
+//! Turn a reaped child's wait status into an IterationResult, reading the JSON the
+//! child wrote. Never throws — failures are reported as `crashed=true` with a brief
+//! errorMessage.
+IterationResult collectChildResult(int32_t status, std::string const& resultJsonPath)
+{
     IterationResult r = readChildResult(resultJsonPath);
     if (WIFEXITED(status))
     {
@@ -967,6 +1060,16 @@ IterationResult runChildForOneRoute(int32_t argc, char** argv, BigInt const& glo
     return r;
 }
 
+//! Result for an iteration whose child could not be started or reaped.
+IterationResult makeLaunchFailure(std::string errorMessage)
+{
+    IterationResult r;
+    r.crashed = true;
+    r.exitCode = -1;
+    r.errorMessage = std::move(errorMessage);
+    return r;
+}
+
 //! Resolve the tuning context up-front: parse the user's expression, query the
 //! knob database from --setBuildRoute's empty-route side-effect path (the
 //! default-constructed BuilderConfig populates `allBuildRoutes` from Myelin),
@@ -1126,13 +1229,26 @@ bool validateTuningOptions(AllOptions const& options)
     return true;
 }
 
+//! \brief Number of routes tried by --tuningSearch=adaptive: --tuningBudget, or by default twice the number of
+//! iterations of a fast search over the same expression.
+BigInt getAdaptiveSearchBudget(TuningOptions const& tuning, TuningContext const& ctx)
+{
+    if (tuning.budget > 0)
+    {
+        return BigInt(static_cast<uint64_t>(tuning.budget));
+    }
+    TuningContext fast = ctx;
+    fast.searchAlgorithm = TuningSearchAlgorithm::kFAST;
+    return fast.count() * BigInt(2);
+}
+
 //! \brief Print the dryRun enumeration of routes. No engine work is performed.
 void emitDryRunListing(TuningContext const& ctx)
 {
     sample::gLogInfo << "--dryRun: " << ctx.totalCount.toString() << " build routes would be tried:" << std::endl;
-    for (BigInt i{0}; i < ctx.totalCount; ++i)
+    for (TuningRouteIterator route(ctx); !route.done(); route.next())
     {
-        sample::gLogInfo << "[" << i.toString() << "]:" << ctx.getPathAtIndex(i) << std::endl;
+        sample::gLogInfo << "[" << route.index().toString() << "]:" << route.path() << std::endl;
     }
 }
 
@@ -1149,9 +1265,12 @@ struct PhaseState
     char** const argv{};                                   //!< Parent argv (passed verbatim to children).
     // Mutable across iterations and across phases:
     BigInt successCount{0};
+    BigInt prunedCount{0};
     double bestGpuTimeMs{std::numeric_limits<double>::infinity()};
     std::string bestEnginePath;
     std::string bestRoute;
+    std::unique_ptr<TuningCacheStore> cache; //!< Open --tuningCacheFile, or null when caching is disabled.
+    std::unique_ptr<AdaptiveRouteSearch> adaptive; //!< Route proposer of --tuningSearch=adaptive, else null.
 };
 
 //! Build the temp-engine path for one iteration. With --saveAllEngines, use a stable
@@ -1168,96 +1287,292 @@ std::string makeIterationEnginePath(PhaseState const& state, char const* phaseLa
     return "/tmp/trtexec_tuning_" + std::to_string(state.ppid) + "_iter" + phaseLabel + "_" + i.toString() + ".plan";
 }
 
+//! True once --tuningTimeOut has elapsed since the loop started.
+bool tuningTimeoutReached(PhaseState const& state)
+{
+    if (state.options.tuning.timeout <= 0)
+    {
+        return false;
+    }
+    auto const elapsedS
+        = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - state.startTime).count();
+    return elapsedS >= state.options.tuning.timeout;
+}
+
+//! \brief GPU time above which a child may stop timing under --tuningPrune, or nullopt to time it fully.
+//!
+//! Children are only pruned against a best route whose engine can still be promoted, so pruning never leaves the
+//! sweep without a result. Mixed-mode phase 1 prunes against the baseline instead when it is slower, because a
+//! route that beats the baseline is a positive knob even if it loses to the best route.
+std::optional<double> getPruneThreshold(
+    PhaseState const& state, std::vector<MixedSearchKnobResult> const* positiveKnobs, double baselineGpuTimeMs)
+{
+    if (!state.options.tuning.prune || !std::isfinite(state.bestGpuTimeMs))
+    {
+        return std::nullopt;
+    }
+    if (positiveKnobs != nullptr)
+    {
+        if (!std::isfinite(baselineGpuTimeMs))
+        {
+            return std::nullopt;
+        }
+        return std::max(state.bestGpuTimeMs, baselineGpuTimeMs);
+    }
+    return state.bestGpuTimeMs;
+}
+
+//! One iteration handed to a worker: everything needed to record it once its child exits.
+struct PendingIteration
+{
+    BigInt index;
+    BigInt routeIndex; //!< Index of the route in phaseCtx; differs from index in adaptive search.
+    std::string route;
+    std::string enginePath;
+    std::string jsonPath;
+};
+
+//! \brief Fold one finished iteration into the phase state, in iteration order.
+//!
+//! Updates best tracking, the mixed-mode baseline / positive knobs and the tuning cache.
+//! runOnePhase calls this strictly in index order even when children finish out of order,
+//! so best-route ties, the index-0 baseline and the cache index's --continue
+//! resume point behave exactly as in a sequential sweep.
+void recordIterationResult(PhaseState& state, TuningContext const& phaseCtx, PendingIteration const& it,
+    IterationResult const& result, std::vector<MixedSearchKnobResult>* positiveKnobs, double& baselineGpuTimeMs)
+{
+    BigInt const& i = it.index;
+    bool const succeeded = !result.crashed && result.exitCode == EXIT_SUCCESS && !result.pruned;
+    if (result.pruned && !result.crashed)
+    {
+        // Not a failure: the route was only timed until it could no longer beat the best one.
+        ++state.prunedCount;
+        sample::gLogInfo << "Iteration [" << i.toString() << "] pruned (gpu_time_ms=" << result.gpuTimeMs
+                         << " over the queries timed)." << std::endl;
+        sample::gLogger.reportTaskEnd(state.sampleTest, i.toString(), it.route);
+    }
+    else if (succeeded)
+    {
+        ++state.successCount;
+        if (result.gpuTimeMs < state.bestGpuTimeMs)
+        {
+            state.bestGpuTimeMs = result.gpuTimeMs;
+            state.bestEnginePath = it.enginePath;
+            state.bestRoute = it.route;
+        }
+        // Track baseline (index 0) so mixed-mode can decide "positive knob".
+        if (i.isZero())
+        {
+            baselineGpuTimeMs = result.gpuTimeMs;
+        }
+        sample::gLogger.reportTaskEnd(state.sampleTest, i.toString(), it.route);
+    }
+    else
+    {
+        sample::gLogWarning << "Iteration [" << i.toString() << "] failed: "
+                            << (result.errorMessage.empty() ? "(no message)" : result.errorMessage) << std::endl;
+        sample::gLogger.reportTaskAbort(state.sampleTest, i.toString(), it.route);
+    }
+    // For mixed-mode phase 1, collect knobs that beat the baseline.
+    if (positiveKnobs != nullptr && !i.isZero() && baselineGpuTimeMs != std::numeric_limits<double>::infinity())
+    {
+        // Phase 1 prunes against the baseline, so a pruned route cannot be a positive knob.
+        collectPositiveKnobFromResult(
+            result.crashed || result.pruned, result.gpuTimeMs, baselineGpuTimeMs, i, phaseCtx, *positiveKnobs);
+    }
+    if (state.adaptive != nullptr)
+    {
+        // The partial time of a pruned route still tells the surrogate model that this region is slow.
+        state.adaptive->reportResult(it.routeIndex, succeeded || (result.pruned && !result.crashed), result.gpuTimeMs);
+    }
+    // Append this iteration's result to the tuning cache file (--tuningCacheFile).
+    if (state.cache != nullptr)
+    {
+        state.cache->appendIteration(i.toUint64(), it.route, result.crashed, succeeded, result.errorMessage,
+            result.accuracyLossValues, result.gpuTimeMs, result.pruned && !result.crashed);
+    }
+    std::remove(it.jsonPath.c_str());
+}
+
 //! \brief Run one phase of the tuning loop (phase 1, or phase 2 of mixed mode).
 //!
-//! Iterates phaseCtx.totalCount times, fork+execs a child per iteration, and updates
-//! `state` with the best route seen. When `positiveKnobs` is non-null and we're past
-//! the baseline iteration (i==0), records each iteration that beats the baseline so
-//! mixed-mode can build its phase-2 sub-context.
+//! Iterates phaseCtx.totalCount times (or the adaptive search budget, asking state.adaptive
+//! for each route), keeping up to --tuningJobs children in flight
+//! (one per WorkerSlot), and updates `state` with the best route seen. Scheduling is done by
+//! runTuningIterations(): children are reaped in whatever order they exit and handed to
+//! recordIterationResult() in index order, and every finished iteration is recorded before
+//! the next route is proposed. When `positiveKnobs` is
+//! non-null and we're past the baseline iteration (i==0), records each iteration that
+//! beats the baseline so mixed-mode can build its phase-2 sub-context.
 //!
 //! Returns false if --tuningTimeOut tripped (so the caller stops chaining phases),
-//! true on normal completion.
-//!
-//! NOLINT: orchestrator function that touches every per-iteration concern (timeout, route
-//! enumeration, child invocation, best-tracker update, mixed-mode positive-knob collection,
-//! cache writing, temp-file cleanup, TASK_BEGIN/END/ABORT logging). Further extraction would
-//! either fragment one logical iteration step across multiple functions or require passing
-//! the same PhaseState everywhere — both make the per-iteration story harder to read.
-// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+//! true on normal completion. On timeout no new child is started, but children already
+//! in flight are waited for and recorded.
 bool runOnePhase(PhaseState& state, TuningContext const& phaseCtx, char const* phaseLabel,
-    std::vector<MixedSearchKnobResult>* positiveKnobs, double* baselineGpuTimeMsOut, int64_t skipUntil)
+    std::vector<WorkerSlot> const& slots, std::vector<MixedSearchKnobResult>* positiveKnobs,
+    double* baselineGpuTimeMsInOut, int64_t skipUntil)
 {
-    sample::gLogInfo << "Tuning " << phaseLabel << ": " << phaseCtx.totalCount.toString() << " iterations." << std::endl;
-    double baselineGpuTimeMs = std::numeric_limits<double>::infinity();
-    for (BigInt i{0}; i < phaseCtx.totalCount; ++i)
+    AdaptiveRouteSearch* const adaptive = state.adaptive.get();
+    BigInt const iterationCount = adaptive != nullptr ? adaptive->getBudget() : phaseCtx.totalCount;
+    sample::gLogInfo << "Tuning " << phaseLabel << ": " << iterationCount.toString() << " iterations";
+    if (slots.size() > 1)
+    {
+        sample::gLogInfo << " (" << slots.size() << " concurrent jobs)";
+    }
+    sample::gLogInfo << "." << std::endl;
+    // A resumed phase 1 starts from the baseline restored from the tuning cache.
+    double baselineGpuTimeMs
+        = baselineGpuTimeMsInOut != nullptr ? *baselineGpuTimeMsInOut : std::numeric_limits<double>::infinity();
+
+    // --continue: skip iterations already in the cache.
+    BigInt const first{skipUntil > 0 ? static_cast<uint64_t>(skipUntil) : uint64_t{0}};
+    // Routes of a fixed enumeration advance incrementally instead of decomposing every index.
+    std::optional<TuningRouteIterator> routes;
+    if (adaptive == nullptr)
     {
-        // --continue: skip iterations already in the cache.
-        if (skipUntil > 0 && i < BigInt{static_cast<uint64_t>(skipUntil)})
+        routes.emplace(phaseCtx, first);
+    }
+    bool timedOut{false};
+    std::string waitError;
+
+    TuningIterationCallbacks<PendingIteration, IterationResult> callbacks;
+    callbacks.prepare = [&](BigInt const& index) -> std::optional<PendingIteration> {
+        if (tuningTimeoutReached(state))
         {
-            continue;
+            sample::gLogInfo << "Tuning timeout reached (" << state.options.tuning.timeout << "s); stopping early."
+                             << std::endl;
+            timedOut = true;
+            return std::nullopt;
         }
-        if (state.options.tuning.timeout > 0)
+        PendingIteration it;
+        it.index = index;
+        if (adaptive != nullptr)
         {
-            auto const elapsedS = std::chrono::duration_cast<std::chrono::seconds>(
-                std::chrono::steady_clock::now() - state.startTime).count();
-            if (elapsedS >= state.options.tuning.timeout)
+            // Every earlier iteration that has finished has been reported to the search by now.
+            auto const routeIndex = adaptive->proposeNext();
+            if (!routeIndex)
             {
-                sample::gLogInfo << "Tuning timeout reached (" << state.options.tuning.timeout
-                                 << "s); stopping early." << std::endl;
-                return false;
+                return std::nullopt;
             }
+            it.routeIndex = *routeIndex;
+            it.route = phaseCtx.getPathAtIndex(it.routeIndex);
         }
+        else
+        {
+            it.routeIndex = index;
+            it.route = routes->path();
+            routes->next();
+        }
+        it.enginePath = makeIterationEnginePath(state, phaseLabel, index);
+        it.jsonPath = "/tmp/trtexec_tuning_" + std::to_string(state.ppid) + "_iter" + index.toString() + ".json";
+        return it;
+    };
+    callbacks.launch = [&](PendingIteration& it, int32_t slot) -> std::variant<int64_t, IterationResult> {
+        sample::gLogger.reportTaskBegin(state.sampleTest, it.index.toString(), it.route);
+        std::string errorMessage;
+        pid_t const pid = spawnChildForOneRoute(state.argc, state.argv, it.index, it.route, it.enginePath,
+            it.jsonPath, slots[slot], getPruneThreshold(state, positiveKnobs, baselineGpuTimeMs), errorMessage);
+        if (pid < 0)
+        {
+            return makeLaunchFailure(std::move(errorMessage));
+        }
+        return static_cast<int64_t>(pid);
+    };
+    callbacks.wait = [&]() -> std::optional<std::pair<int64_t, int32_t>> {
+        int32_t status{};
+        pid_t w{};
+        do
+        {
+            w = waitpid(-1, &status, 0);
+        } while (w < 0 && errno == EINTR);
+        if (w < 0)
+        {
+            waitError = std::string{"waitpid() failed: "} + std::strerror(errno);
+            return std::nullopt;
+        }
+        return std::make_pair(static_cast<int64_t>(w), status);
+    };
+    callbacks.collect = [&](PendingIteration& it, std::optional<int32_t> status) {
+        return status ? collectChildResult(*status, it.jsonPath) : makeLaunchFailure(waitError);
+    };
+    callbacks.record = [&](PendingIteration& it, IterationResult& result) {
+        recordIterationResult(state, phaseCtx, it, result, positiveKnobs, baselineGpuTimeMs);
+    };
+    runTuningIterations(static_cast<int32_t>(slots.size()), first, iterationCount, callbacks);
 
-        std::string const route = phaseCtx.getPathAtIndex(i);
-        std::string const enginePath = makeIterationEnginePath(state, phaseLabel, i);
-        std::string const jsonPath = "/tmp/trtexec_tuning_" + std::to_string(state.ppid)
-            + "_iter" + i.toString() + ".json";
-
-        sample::gLogger.reportTaskBegin(state.sampleTest, i.toString(), route);
-
-        IterationResult const result = runChildForOneRoute(state.argc, state.argv, i, route, enginePath, jsonPath);
+    if (baselineGpuTimeMsInOut != nullptr)
+    {
+        *baselineGpuTimeMsInOut = baselineGpuTimeMs;
+    }
+    return !timedOut;
+}
 
-        if (!result.crashed && result.exitCode == EXIT_SUCCESS)
+//! \brief Fold the iterations recorded before an interrupted run into the phase-1 state on --continue.
+//!
+//! Only the cache index is read: success count, baseline and mixed-mode positive knobs come from its fixed-size
+//! entries, and the best route is read from its single cache line. Adaptive search also reads the route of every
+//! cached iteration to replay it into the route proposer. The cached best can only be promoted when its
+//! engine is still on disk, i.e. with --saveAllEngines; otherwise the resumed sweep picks the best of the new
+//! iterations.
+void restoreFromTuningCache(PhaseState& state, TuningContext const& ctx, int64_t resumeFromIter,
+    std::vector<MixedSearchKnobResult>* positiveKnobs, double& baselineGpuTimeMs)
+{
+    auto const& entries = state.cache->getEntries();
+    auto const nbPhase1 = std::min<size_t>(entries.size(), static_cast<size_t>(std::max<int64_t>(resumeFromIter, 0)));
+    std::optional<size_t> best;
+    for (size_t k = 0; k < nbPhase1; ++k)
+    {
+        auto const& e = entries[k];
+        bool const crashed = (e.flags & tuningCache::kIndexCrashed) != 0;
+        bool const pruned = (e.flags & tuningCache::kIndexPruned) != 0;
+        if (pruned)
+        {
+            ++state.prunedCount;
+        }
+        if (state.adaptive != nullptr)
+        {
+            // Adaptive routes are not a function of the iteration index; map the cached route back to the space.
+            if (auto const routeIndex = state.adaptive->findIndexOfPath(state.cache->readBuildRoute(k)))
+            {
+                state.adaptive->replay(
+                    *routeIndex, pruned || (e.flags & tuningCache::kIndexSucceeded) != 0, e.gpuTimeMs);
+            }
+        }
+        if ((e.flags & tuningCache::kIndexSucceeded) != 0)
         {
             ++state.successCount;
-            if (result.gpuTimeMs < state.bestGpuTimeMs)
+            if (!best || e.gpuTimeMs < entries[*best].gpuTimeMs)
             {
-                state.bestGpuTimeMs = result.gpuTimeMs;
-                state.bestEnginePath = enginePath;
-                state.bestRoute = route;
+                best = k;
             }
-            // Track baseline (index 0) so mixed-mode can decide "positive knob".
-            if (i.isZero())
+            if (e.iter == 0)
             {
-                baselineGpuTimeMs = result.gpuTimeMs;
+                baselineGpuTimeMs = e.gpuTimeMs;
             }
-            sample::gLogger.reportTaskEnd(state.sampleTest, i.toString(), route);
         }
-        else
-        {
-            sample::gLogWarning << "Iteration [" << i.toString() << "] failed: "
-                                << (result.errorMessage.empty() ? "(no message)" : result.errorMessage) << std::endl;
-            sample::gLogger.reportTaskAbort(state.sampleTest, i.toString(), route);
-        }
-        // For mixed-mode phase 1, collect knobs that beat the baseline.
-        if (positiveKnobs != nullptr && !i.isZero() && baselineGpuTimeMs != std::numeric_limits<double>::infinity())
+        if (positiveKnobs != nullptr && e.iter != 0 && baselineGpuTimeMs != std::numeric_limits<double>::infinity())
         {
             collectPositiveKnobFromResult(
-                result.crashed, result.gpuTimeMs, baselineGpuTimeMs, i, phaseCtx, *positiveKnobs);
-        }
-        // Append this iteration's result to the tuning cache file (--tuningCacheFile).
-        if (!state.options.tuning.tuningCacheFile.empty())
-        {
-            writeTuningCacheIteration(state.options.tuning.tuningCacheFile, i.toUint64(), route, result.crashed,
-                result.errorMessage, result.accuracyLossValues, result.gpuTimeMs);
+                crashed || pruned, e.gpuTimeMs, baselineGpuTimeMs, BigInt{e.iter}, ctx, *positiveKnobs);
         }
-        std::remove(jsonPath.c_str());
     }
-    if (baselineGpuTimeMsOut != nullptr)
+    if (!best)
     {
-        *baselineGpuTimeMsOut = baselineGpuTimeMs;
+        return;
     }
-    return true;
+
+    std::string const route = state.cache->readBuildRoute(*best);
+    std::string const enginePath = makeIterationEnginePath(state, "phase1", BigInt{entries[*best].iter});
+    if (state.options.build.saveAllEngines && std::ifstream(enginePath).good())
+    {
+        state.bestGpuTimeMs = entries[*best].gpuTimeMs;
+        state.bestEnginePath = enginePath;
+        state.bestRoute = route;
+    }
+    sample::gLogInfo << "--continue: " << state.successCount.toString() << " cached iteration(s) succeeded; best was "
+                     << route << " (gpu_time_ms=" << entries[*best].gpuTimeMs << ")"
+                     << (state.bestEnginePath.empty() ? ", its engine is not available and will not be promoted." : ".")
+                     << std::endl;
 }
 
 //! \brief Copy the best-iteration engine to the user's --saveEngine path and emit the
@@ -1284,7 +1599,12 @@ int32_t finalizeBestEngine(PhaseState const& state, BigInt const& totalCount)
     sample::gLogInfo << "Best iteration: " << state.bestRoute << " (gpu_time_ms=" << state.bestGpuTimeMs << ")"
                      << std::endl;
     sample::gLogInfo << "Tuning summary: " << state.successCount.toString() << " / " << totalCount.toString()
-                     << " iterations succeeded." << std::endl;
+                     << " iterations succeeded";
+    if (!state.prunedCount.isZero())
+    {
+        sample::gLogInfo << ", " << state.prunedCount.toString() << " pruned";
+    }
+    sample::gLogInfo << "." << std::endl;
     return sample::gLogger.reportPass(state.sampleTest);
 }
 
@@ -1365,11 +1685,25 @@ int32_t sample::runTuningLoop(int32_t argc, char** argv)
     // Children must see the reconstructed argv when resuming — the user's bare
     // `--continue --tuningCacheFile=path` argv has none of the original build/inference flags.
     PhaseState state{options, sampleTest, getpid(), std::chrono::steady_clock::now(), effectiveArgc, effectiveArgv};
+    std::vector<WorkerSlot> const slots = makeWorkerSlots(options.tuning);
     std::vector<MixedSearchKnobResult> positiveKnobs;
     double phase1BaselineMs{std::numeric_limits<double>::infinity()};
     bool const isMixed = options.tuning.tuningSearchAlgorithm == TuningSearchAlgorithm::kMIXED;
-    bool const phase1Completed
-        = runOnePhase(state, ctx, "phase1", isMixed ? &positiveKnobs : nullptr, &phase1BaselineMs, resume.resumeFromIter);
+    if (options.tuning.tuningSearchAlgorithm == TuningSearchAlgorithm::kADAPTIVE)
+    {
+        state.adaptive = std::make_unique<AdaptiveRouteSearch>(ctx, getAdaptiveSearchBudget(options.tuning, ctx));
+    }
+    if (!options.tuning.tuningCacheFile.empty())
+    {
+        state.cache = std::make_unique<TuningCacheStore>(options.tuning.tuningCacheFile);
+        if (options.tuning.continueFromCache)
+        {
+            restoreFromTuningCache(
+                state, ctx, resume.resumeFromIter, isMixed ? &positiveKnobs : nullptr, phase1BaselineMs);
+        }
+    }
+    bool const phase1Completed = runOnePhase(
+        state, ctx, "phase1", slots, isMixed ? &positiveKnobs : nullptr, &phase1BaselineMs, resume.resumeFromIter);
 
     if (phase1Completed && isMixed && positiveKnobs.size() > 1)
     {
@@ -1377,7 +1711,7 @@ int32_t sample::runTuningLoop(int32_t argc, char** argv)
                          << " positive knobs identified; entering phase 2." << std::endl;
         TuningContext const phase2Ctx = buildMixedPhase2Context(ctx, positiveKnobs);
         // Phase 2 always starts fresh (no resume mid-phase-2).
-        (void) runOnePhase(state, phase2Ctx, "phase2", nullptr, nullptr, 0);
+        (void) runOnePhase(state, phase2Ctx, "phase2", slots, nullptr, nullptr, 0);
     }
     else if (isMixed)
     {
@@ -1386,7 +1720,7 @@ int32_t sample::runTuningLoop(int32_t argc, char** argv)
     }
 
     // 7. Promote the best iteration's engine to the user's --saveEngine path.
-    return finalizeBestEngine(state, ctx.totalCount);
+    return finalizeBestEngine(state, state.adaptive != nullptr ? state.adaptive->getBudget() : ctx.totalCount);
 }
 
 #endif // POSIX && ENABLE_FEATURE_GLOBAL_PERF_TUNER
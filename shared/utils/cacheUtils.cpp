@@ -18,53 +18,377 @@
 #include "cacheUtils.h"
 #include "NvInfer.h"
 #include "fileLock.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#ifdef _MSC_VER
+#include <io.h> // _commit
+#else
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#endif
 
 namespace nvinfer1::utils
 {
+namespace
+{
+//! Magic bytes opening a cache file written by writeCacheFileLocked().
+constexpr char kCACHE_FILE_MAGIC[8] = {'T', 'R', 'T', 'C', 'A', 'C', 'H', 'E'};
+//! Version of the CacheFileHeader layout.
+constexpr uint32_t kCACHE_FILE_VERSION = 1;
+
+//! Fixed-size header written in front of the serialized cache. It lets a reader tell a complete file from one that
+//! was truncated or overwritten mid-write. Files without the magic are raw caches from older writers or other tools
+//! and are loaded unchanged.
+struct CacheFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t payloadSize;
+    uint64_t checksum; //!< FNV-1a 64 of the payload.
+};
+static_assert(sizeof(CacheFileHeader) == 32, "CacheFileHeader must not contain padding.");
+
+uint64_t fnv1a64(char const* data, size_t size) noexcept
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+//! Locate the payload of a cache file of `fsize` bytes whose first min(fsize, sizeof(CacheFileHeader)) bytes are
+//! `prefix`. Returns the payload offset: 0 for a raw cache, sizeof(CacheFileHeader) for a framed one. Returns
+//! std::nullopt (after logging) when the header does not describe a complete file. `header` receives the parsed
+//! header of a framed file.
+std::optional<size_t> locateCachePayload(
+    ILogger& logger, std::string const& fileName, char const* prefix, size_t fsize, CacheFileHeader& header)
+{
+    if (fsize < sizeof(CacheFileHeader))
+    {
+        return 0;
+    }
+    std::memcpy(&header, prefix, sizeof(CacheFileHeader));
+    if (std::memcmp(header.magic, kCACHE_FILE_MAGIC, sizeof(kCACHE_FILE_MAGIC)) != 0)
+    {
+        return 0;
+    }
+    if (header.version != kCACHE_FILE_VERSION || header.headerSize != sizeof(CacheFileHeader)
+        || header.payloadSize != fsize - sizeof(CacheFileHeader))
+    {
+        std::stringstream ss;
+        ss << "Cache file " << fileName << " is truncated or has an unsupported header (expected "
+           << header.payloadSize << " payload bytes, found " << fsize - sizeof(CacheFileHeader)
+           << "). A new cache will be generated and written.";
+        logger.log(ILogger::Severity::kWARNING, ss.str().c_str());
+        return std::nullopt;
+    }
+    return sizeof(CacheFileHeader);
+}
+
+//! Check the payload of a framed cache file against its header checksum, logging on mismatch.
+bool verifyCachePayload(
+    ILogger& logger, std::string const& fileName, CacheFileHeader const& header, char const* payload, size_t size)
+{
+    if (fnv1a64(payload, size) != header.checksum)
+    {
+        std::stringstream ss;
+        ss << "Checksum mismatch in cache file " << fileName << ". A new cache will be generated and written.";
+        logger.log(ILogger::Severity::kWARNING, ss.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+//! Read a cache file, validating and stripping the CacheFileHeader if present. The caller must hold the FileLock.
+//! A torn or corrupt file is reported and treated as missing, so the caller starts from an empty cache.
+std::vector<char> readCacheFileLocked(ILogger& logger, std::string const& inFileName)
+{
+    std::ifstream iFile(inFileName, std::ios::in | std::ios::binary);
+    if (!iFile)
+    {
+        std::stringstream ss;
+        ss << "Could not read cache from: " << inFileName << ". A new cache will be generated and written.";
+        logger.log(ILogger::Severity::kWARNING, ss.str().c_str());
+        return {};
+    }
+    iFile.seekg(0, std::ifstream::end);
+    size_t const fsize = iFile.tellg();
+    iFile.seekg(0, std::ifstream::beg);
+
+    char prefix[sizeof(CacheFileHeader)]{};
+    iFile.read(prefix, static_cast<std::streamsize>(std::min(fsize, sizeof(prefix))));
+    CacheFileHeader header{};
+    auto const payloadOffset = locateCachePayload(logger, inFileName, prefix, fsize, header);
+    if (!payloadOffset)
+    {
+        return {};
+    }
+    size_t const payloadSize = fsize - *payloadOffset;
+    iFile.seekg(static_cast<std::streamoff>(*payloadOffset), std::ifstream::beg);
+
+    std::vector<char> content(payloadSize);
+    iFile.read(content.data(), payloadSize);
+    if (!iFile)
+    {
+        std::stringstream ss;
+        ss << "Failed to read " << payloadSize << " bytes of cache from: " << inFileName
+           << ". A new cache will be generated and written.";
+        logger.log(ILogger::Severity::kWARNING, ss.str().c_str());
+        return {};
+    }
+    if (*payloadOffset != 0 && !verifyCachePayload(logger, inFileName, header, content.data(), content.size()))
+    {
+        return {};
+    }
+    std::stringstream ss;
+    ss << "Loaded " << payloadSize << " bytes of cache from file: " << inFileName;
+    logger.log(ILogger::Severity::kINFO, ss.str().c_str());
+    return content;
+}
+
+//! Write `data` behind a CacheFileHeader to a temporary file next to `outFileName`, flush it to disk and rename it
+//! over `outFileName`. Readers therefore see either the previous file or the complete new one, never a partial
+//! write. The caller must hold the FileLock. Returns false (after logging) on failure; the old file is kept.
+bool writeCacheFileLocked(ILogger& logger, std::string const& outFileName, void const* data, size_t size)
+{
+    CacheFileHeader header{};
+    std::memcpy(header.magic, kCACHE_FILE_MAGIC, sizeof(kCACHE_FILE_MAGIC));
+    header.version = kCACHE_FILE_VERSION;
+    header.headerSize = sizeof(CacheFileHeader);
+    header.payloadSize = size;
+    header.checksum = fnv1a64(static_cast<char const*>(data), size);
+
+    auto const fail = [&](std::string const& what, std::string const& tmpFileName) {
+        std::stringstream ss;
+        ss << "Could not write cache to file: " << outFileName << " (" << what << ")";
+        logger.log(ILogger::Severity::kWARNING, ss.str().c_str());
+        std::remove(tmpFileName.c_str());
+        return false;
+    };
+
+#ifdef _MSC_VER
+    std::string const tmpFileName = outFileName + ".tmp" + std::to_string(GetCurrentProcessId());
+    FILE* tmpFile = fopen(tmpFileName.c_str(), "wb");
+    if (tmpFile == nullptr)
+    {
+        return fail("cannot create " + tmpFileName, tmpFileName);
+    }
+    bool const written = fwrite(&header, sizeof(header), 1, tmpFile) == 1
+        && (size == 0 || fwrite(data, size, 1, tmpFile) == 1) && fflush(tmpFile) == 0 && _commit(_fileno(tmpFile)) == 0;
+    fclose(tmpFile);
+    if (!written)
+    {
+        return fail("write to " + tmpFileName + " failed", tmpFileName);
+    }
+    if (!MoveFileExA(tmpFileName.c_str(), outFileName.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        return fail("rename from " + tmpFileName + " failed", tmpFileName);
+    }
+#else
+    std::string const tmpFileName = outFileName + ".tmp" + std::to_string(getpid());
+    int32_t const fd = open(tmpFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (fd < 0)
+    {
+        return fail("cannot create " + tmpFileName + ": " + std::strerror(errno), tmpFileName);
+    }
+    auto const writeAll = [fd](void const* buf, size_t count) {
+        auto const* p = static_cast<char const*>(buf);
+        while (count > 0)
+        {
+            ssize_t const n = write(fd, p, count);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                return false;
+            }
+            p += n;
+            count -= static_cast<size_t>(n);
+        }
+        return true;
+    };
+    bool const written = writeAll(&header, sizeof(header)) && writeAll(data, size) && fsync(fd) == 0;
+    int32_t const savedErrno = errno;
+    close(fd);
+    if (!written)
+    {
+        return fail("write to " + tmpFileName + " failed: " + std::strerror(savedErrno), tmpFileName);
+    }
+    if (rename(tmpFileName.c_str(), outFileName.c_str()) != 0)
+    {
+        return fail("rename from " + tmpFileName + " failed: " + std::strerror(errno), tmpFileName);
+    }
+    // Persist the rename itself. Best effort: the data is already durable and the rename atomic.
+    auto const slash = outFileName.find_last_of('/');
+    std::string const dirName = slash == std::string::npos ? "." : (slash == 0 ? "/" : outFileName.substr(0, slash));
+    int32_t const dirFd = open(dirName.c_str(), O_RDONLY);
+    if (dirFd >= 0)
+    {
+        fsync(dirFd);
+        close(dirFd);
+    }
+#endif
+    return true;
+}
+} // namespace
+
 std::vector<char> loadCacheFile(ILogger& logger, std::string const& inFileName)
 {
     try
     {
         FileLock fileLock{logger, inFileName};
-        std::ifstream iFile(inFileName, std::ios::in | std::ios::binary);
-        if (!iFile)
+        return readCacheFileLocked(logger, inFileName);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Exception while loading cache file " << inFileName << ": " << e.what() << std::endl;
+    }
+    return {};
+}
+
+CacheFileView::CacheFileView(CacheFileView&& other) noexcept
+    : mLock(std::move(other.mLock))
+    , mMapping(std::exchange(other.mMapping, nullptr))
+    , mMappingSize(std::exchange(other.mMappingSize, 0))
+    , mData(std::exchange(other.mData, nullptr))
+    , mSize(std::exchange(other.mSize, 0))
+    , mOwned(std::move(other.mOwned))
+{
+}
+
+CacheFileView& CacheFileView::operator=(CacheFileView&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        mLock = std::move(other.mLock);
+        mMapping = std::exchange(other.mMapping, nullptr);
+        mMappingSize = std::exchange(other.mMappingSize, 0);
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+        mOwned = std::move(other.mOwned);
+    }
+    return *this;
+}
+
+CacheFileView::~CacheFileView()
+{
+    reset();
+}
+
+void CacheFileView::reset() noexcept
+{
+#ifndef _MSC_VER
+    if (mMapping != nullptr)
+    {
+        munmap(mMapping, mMappingSize);
+    }
+#endif
+    mMapping = nullptr;
+    mMappingSize = 0;
+    mData = nullptr;
+    mSize = 0;
+    mOwned.clear();
+    // Unmap before unlocking so a writer never replaces the file under a live mapping of this process.
+    mLock.reset();
+}
+
+CacheFileView mapCacheFile(ILogger& logger, std::string const& inFileName)
+{
+    CacheFileView view;
+    try
+    {
+        view.mLock = std::make_unique<FileLock>(logger, inFileName, FileLock::Mode::kSHARED);
+#ifdef _MSC_VER
+        // No mapping on Windows yet; fall back to an owned copy with the same validation.
+        view.mOwned = readCacheFileLocked(logger, inFileName);
+        view.mData = view.mOwned.data();
+        view.mSize = view.mOwned.size();
+#else
+        int32_t const fd = open(inFileName.c_str(), O_RDONLY);
+        if (fd < 0)
         {
             std::stringstream ss;
             ss << "Could not read cache from: " << inFileName << ". A new cache will be generated and written.";
             logger.log(ILogger::Severity::kWARNING, ss.str().c_str());
-            return std::vector<char>();
+            return view;
+        }
+        struct stat st{};
+        void* mapping = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        // The mapping stays valid after the descriptor is closed.
+        close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            // Empty or unmappable (e.g. a pipe): read it the ordinary way.
+            view.mOwned = readCacheFileLocked(logger, inFileName);
+            view.mData = view.mOwned.data();
+            view.mSize = view.mOwned.size();
+            return view;
+        }
+        view.mMapping = mapping;
+        view.mMappingSize = static_cast<size_t>(st.st_size);
+        // The whole file is consumed front to back, once.
+        madvise(mapping, view.mMappingSize, MADV_SEQUENTIAL);
+
+        auto const* bytes = static_cast<char const*>(mapping);
+        CacheFileHeader header{};
+        auto const payloadOffset = locateCachePayload(logger, inFileName, bytes, view.mMappingSize, header);
+        if (!payloadOffset)
+        {
+            view.reset();
+            return view;
+        }
+        view.mData = bytes + *payloadOffset;
+        view.mSize = view.mMappingSize - *payloadOffset;
+        if (*payloadOffset != 0 && !verifyCachePayload(logger, inFileName, header, view.mData, view.mSize))
+        {
+            view.reset();
+            return view;
         }
-        iFile.seekg(0, std::ifstream::end);
-        size_t fsize = iFile.tellg();
-        iFile.seekg(0, std::ifstream::beg);
-        std::vector<char> content(fsize);
-        iFile.read(content.data(), fsize);
-        iFile.close();
         std::stringstream ss;
-        ss << "Loaded " << fsize << " bytes of cache from file: " << inFileName;
+        ss << "Mapped " << view.mSize << " bytes of cache from file: " << inFileName;
         logger.log(ILogger::Severity::kINFO, ss.str().c_str());
-        return content;
+#endif
     }
     catch (std::exception const& e)
     {
-        std::cerr << "Exception while loading cache file " << inFileName << ": " << e.what() << std::endl;
+        std::cerr << "Exception while mapping cache file " << inFileName << ": " << e.what() << std::endl;
+        view.reset();
     }
-    return {};
+    return view;
 }
 
 std::unique_ptr<ITimingCache> buildTimingCacheFromFile(
     ILogger& logger, IBuilderConfig& config, std::string const& timingCacheFile)
 {
     std::unique_ptr<nvinfer1::ITimingCache> timingCache{};
-    std::vector<char> timingCacheContents = loadCacheFile(logger, timingCacheFile);
-
-    timingCache.reset(config.createTimingCache(timingCacheContents.data(), timingCacheContents.size()));
+    {
+        // createTimingCache copies what it needs, so the mapping (and its shared lock) ends with this scope.
+        CacheFileView const timingCacheContents = mapCacheFile(logger, timingCacheFile);
+        timingCache.reset(config.createTimingCache(timingCacheContents.data(), timingCacheContents.size()));
+    }
     if (timingCache == nullptr)
     {
         logger.log(ILogger::Severity::kERROR, ("Failed to create ITimingCache from file " + timingCacheFile).c_str());
@@ -86,19 +410,12 @@ void saveCacheFile(ILogger& logger, std::string const& outFileName, IHostMemory
     try
     {
         FileLock fileLock{logger, outFileName};
-        std::ofstream oFile(outFileName, std::ios::out | std::ios::binary);
-        if (!oFile)
+        if (writeCacheFileLocked(logger, outFileName, blob->data(), blob->size()))
         {
             std::stringstream ss;
-            ss << "Could not write cache to file: " << outFileName;
-            logger.log(ILogger::Severity::kWARNING, ss.str().c_str());
-            return;
+            ss << "Saved " << blob->size() << " bytes of cache to file: " << outFileName;
+            logger.log(ILogger::Severity::kINFO, ss.str().c_str());
         }
-        oFile.write(reinterpret_cast<char const*>(blob->data()), blob->size());
-        oFile.close();
-        std::stringstream ss;
-        ss << "Saved " << blob->size() << " bytes of cache to file: " << outFileName;
-        logger.log(ILogger::Severity::kINFO, ss.str().c_str());
     }
     catch (std::exception const& e)
     {
@@ -106,42 +423,53 @@ void saveCacheFile(ILogger& logger, std::string const& outFileName, IHostMemory
     }
 }
 
-void updateTimingCacheFile(nvinfer1::ILogger& logger, std::string const& fileName,
-    nvinfer1::ITimingCache const* timingCache, nvinfer1::IBuilder& builder)
+bool updateCacheFile(ILogger& logger, std::string const& fileName,
+    std::function<std::unique_ptr<IHostMemory>(std::vector<char> const&)> const& update)
 {
     try
     {
-        std::unique_ptr<IBuilderConfig> config{builder.createBuilderConfig()};
-        std::vector<char> timingCacheContents = loadCacheFile(logger, fileName);
-        std::unique_ptr<ITimingCache> fileTimingCache{
-            config->createTimingCache(timingCacheContents.data(), timingCacheContents.size())};
-
-        fileTimingCache->combine(*timingCache, false);
-        std::unique_ptr<IHostMemory> blob{fileTimingCache->serialize()};
+        // Hold one lock across read, merge and write. Releasing it between the read and the write lets a concurrent
+        // build replace the file in between, and its entries are then lost when this process writes its merge.
+        FileLock fileLock{logger, fileName};
+        std::unique_ptr<IHostMemory> const blob{update(readCacheFileLocked(logger, fileName))};
         if (!blob)
         {
-            throw std::runtime_error("Failed to serialize combined ITimingCache!");
+            return false;
         }
-
-        FileLock fileLock{logger, fileName};
-        std::ofstream oFile(fileName, std::ios::out | std::ios::binary);
-        if (!oFile)
+        if (writeCacheFileLocked(logger, fileName, blob->data(), blob->size()))
         {
             std::stringstream ss;
-            ss << "Could not write timing cache to: " << fileName;
-            logger.log(ILogger::Severity::kWARNING, ss.str().c_str());
-            return;
+            ss << "Saved " << blob->size() << " bytes of cache to " << fileName;
+            logger.log(ILogger::Severity::kINFO, ss.str().c_str());
+            return true;
         }
-
-        oFile.write(reinterpret_cast<char const*>(blob->data()), blob->size());
-        oFile.close();
-        std::stringstream ss;
-        ss << "Saved " << blob->size() << " bytes of timing cache to " << fileName;
-        logger.log(ILogger::Severity::kINFO, ss.str().c_str());
     }
     catch (std::exception const& e)
     {
-        std::cerr << "Exception while updating timing cache file " << fileName << ": " << e.what() << std::endl;
+        std::cerr << "Exception while updating cache file " << fileName << ": " << e.what() << std::endl;
     }
+    return false;
+}
+
+void updateTimingCacheFile(nvinfer1::ILogger& logger, std::string const& fileName,
+    nvinfer1::ITimingCache const* timingCache, nvinfer1::IBuilder& builder)
+{
+    updateCacheFile(logger, fileName, [&builder, timingCache](std::vector<char> const& timingCacheContents) {
+        std::unique_ptr<IBuilderConfig> config{builder.createBuilderConfig()};
+        std::unique_ptr<ITimingCache> fileTimingCache{
+            config->createTimingCache(timingCacheContents.data(), timingCacheContents.size())};
+        if (!fileTimingCache)
+        {
+            throw std::runtime_error("Failed to create ITimingCache from file contents!");
+        }
+
+        fileTimingCache->combine(*timingCache, false);
+        std::unique_ptr<IHostMemory> blob{fileTimingCache->serialize()};
+        if (!blob)
+        {
+            throw std::runtime_error("Failed to serialize combined ITimingCache!");
+        }
+        return blob;
+    });
 }
 } // namespace nvinfer1::utils
@@ -18,6 +18,8 @@
 #define TRT_SHARED_TIMINGCACHE_H_
 
 #include "NvInfer.h"
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -26,12 +28,72 @@
 namespace nvinfer1::utils
 {
 
+class FileLock;
+
+//! \brief Read-only view of the payload of a cache file, as returned by mapCacheFile().
+//!
+//! On POSIX systems the file is memory-mapped, so no copy of the cache is made. A shared file lock is held for the
+//! lifetime of the view: other readers proceed concurrently, while writers wait until the view is destroyed.
+//! An empty view means the file was missing, unreadable or failed validation.
+class CacheFileView
+{
+public:
+    CacheFileView() = default;
+    ~CacheFileView();
+    CacheFileView(CacheFileView const&) = delete;
+    CacheFileView& operator=(CacheFileView const&) = delete;
+    CacheFileView(CacheFileView&& other) noexcept;
+    CacheFileView& operator=(CacheFileView&& other) noexcept;
+
+    //! \returns Pointer to the first payload byte, or nullptr for an empty view.
+    void const* data() const noexcept
+    {
+        return mData;
+    }
+
+    //! \returns Number of payload bytes.
+    size_t size() const noexcept
+    {
+        return mSize;
+    }
+
+    bool empty() const noexcept
+    {
+        return mSize == 0;
+    }
+
+private:
+    friend CacheFileView mapCacheFile(nvinfer1::ILogger& logger, std::string const& inFileName);
+
+    //! Unmap the file and release the lock.
+    void reset() noexcept;
+
+    std::unique_ptr<FileLock> mLock;
+    void* mMapping{nullptr};   //!< Start of the file mapping (includes any header).
+    size_t mMappingSize{0};    //!< Size of the file mapping.
+    char const* mData{nullptr};
+    size_t mSize{0};
+    std::vector<char> mOwned;  //!< Backing storage when the file could not be mapped.
+};
+
 //! \brief Loads the binary contents of a cache file into a char vector. Used for both timing cache and runtime cache.
 //!
+//! Files written by saveCacheFile() or updateTimingCacheFile() start with a small checksummed header, which is
+//! validated and stripped here. A truncated or corrupt file is reported and treated as missing. Files without the
+//! header (raw caches from older versions or other tools) are returned unchanged.
+//!
 //! \note This is a blocking operation, as this method will acquire an exclusive file lock on the cache file for
 //! the duration of the read. \returns The binary data from the file, or an empty vector if an error occurred.
 std::vector<char> loadCacheFile(nvinfer1::ILogger& logger, std::string const& inFileName);
 
+//! \brief Maps a cache file read-only without copying it. Used for both timing cache and runtime cache.
+//!
+//! Performs the same header validation as loadCacheFile(). Falls back to reading the file into memory where mapping
+//! is not available.
+//!
+//! \note This acquires a shared file lock on the cache file, held until the returned view is destroyed.
+CacheFileView mapCacheFile(nvinfer1::ILogger& logger, std::string const& inFileName);
+
 //! \brief Helper method to load a timing cache from a file, build an ITimingCache with the data, and then set the new
 //! timing cache to the builder config. If the file is blank, or cannot be read, a new timing cache will be created from
 //! scratch.
@@ -42,16 +104,33 @@ std::unique_ptr<ITimingCache> buildTimingCacheFromFile(
 
 //! \brief Saves the contents of a cache object to a binary file.
 //!
+//! The blob is written behind a checksummed header to a temporary file, flushed to disk, and renamed over
+//! `outFileName`, so readers never observe a partially written cache.
+//!
+//! \warning The file is not a raw TensorRT blob: the payload follows a 32-byte header. Read it back with
+//! loadCacheFile() or mapCacheFile() rather than passing the file contents to TensorRT directly.
+//!
 //! \note This is a blocking operation, as this method will acquire an exclusive file lock on the cache file for
 //! the duration of the write.
 void saveCacheFile(nvinfer1::ILogger& logger, std::string const& outFileName, nvinfer1::IHostMemory const* blob);
 
+//! \brief Replaces the contents of a cache file with the result of `update`, as one locked transaction.
+//!
+//! `update` receives the current payload, as returned by loadCacheFile() (empty if the file is missing or invalid),
+//! and returns the blob to write, or nullptr to leave the file unchanged. The file is written in the same way as
+//! saveCacheFile().
+//!
+//! \note This holds an exclusive file lock from the read until the write completes, so concurrent updaters in other
+//! processes cannot drop each other's changes. \returns Whether the file was written.
+bool updateCacheFile(nvinfer1::ILogger& logger, std::string const& fileName,
+    std::function<std::unique_ptr<nvinfer1::IHostMemory>(std::vector<char> const&)> const& update);
+
 //! \brief Updates the contents of a timing cache binary file.
 //! This operation loads the timing cache file, combines it with the passed timingCache, and serializes the combined
-//! timing cache.
+//! timing cache. The file is replaced through updateCacheFile().
 //!
-//! \note This is a blocking operation, as this method will acquire an exclusive file lock on the timing cache file for
-//! the duration of the write.
+//! \note This is a blocking operation, as this method will hold an exclusive file lock on the timing cache file for
+//! the whole read-combine-write transaction, so concurrent updaters cannot drop each other's entries.
 void updateTimingCacheFile(nvinfer1::ILogger& logger, std::string const& fileName,
     nvinfer1::ITimingCache const* timingCache, nvinfer1::IBuilder& builder);
 
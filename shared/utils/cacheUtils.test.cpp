@@ -0,0 +1,328 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cacheUtils.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#ifndef _MSC_VER
+#include <sys/wait.h> // waitpid
+#include <unistd.h>   // fork, pipe
+#endif
+
+using namespace nvinfer1;
+using namespace nvinfer1::utils;
+
+namespace
+{
+//! Size of the header that saveCacheFile() writes in front of the payload.
+constexpr size_t kHEADER_SIZE{32};
+
+//! Counts warnings; everything else is dropped.
+class CountingLogger : public ILogger
+{
+public:
+    void log(Severity severity, char const* /*msg*/) noexcept override
+    {
+        if (severity <= Severity::kWARNING)
+        {
+            ++mWarnings;
+        }
+    }
+
+    int32_t warnings() const
+    {
+        return mWarnings;
+    }
+
+private:
+    int32_t mWarnings{0};
+};
+
+//! Host memory owned by the test, standing in for a blob serialized by TensorRT.
+class VectorHostMemory : public IHostMemory
+{
+public:
+    explicit VectorHostMemory(std::vector<char> contents)
+        : mStorage(std::move(contents))
+    {
+        mImpl = &mStorage;
+    }
+
+private:
+    class Storage : public apiv::VHostMemory
+    {
+    public:
+        explicit Storage(std::vector<char> contents)
+            : mContents(std::move(contents))
+        {
+        }
+
+        void* data() const noexcept override
+        {
+            return const_cast<char*>(mContents.data());
+        }
+
+        std::size_t size() const noexcept override
+        {
+            return mContents.size();
+        }
+
+        DataType type() const noexcept override
+        {
+            return DataType::kUINT8;
+        }
+
+    private:
+        std::vector<char> mContents;
+    };
+
+    Storage mStorage;
+};
+
+//! A cache file path that does not exist yet, removed with its lock file at the end of the test.
+class TempCachePath
+{
+public:
+    explicit TempCachePath(char const* name)
+        : mPath((std::filesystem::temp_directory_path() / name).string())
+    {
+        remove();
+    }
+
+    ~TempCachePath()
+    {
+        remove();
+    }
+
+    std::string const& str() const
+    {
+        return mPath;
+    }
+
+private:
+    void remove() const
+    {
+        std::error_code ec;
+        std::filesystem::remove(mPath, ec);
+        std::filesystem::remove(mPath + ".lock", ec);
+    }
+
+    std::string mPath;
+};
+
+//! Bytes that cover every value, so a payload that happens to contain the header magic is covered too.
+std::vector<char> makePayload(size_t size)
+{
+    std::vector<char> payload(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        payload[i] = static_cast<char>((i * 131 + 7) & 0xFF);
+    }
+    std::string const magic = "TRTCACHE";
+    std::copy(magic.begin(), magic.end(), payload.begin() + static_cast<std::ptrdiff_t>(size / 2));
+    return payload;
+}
+
+std::vector<char> readFile(std::string const& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+void writeFile(std::string const& fileName, std::vector<char> const& contents)
+{
+    std::ofstream file(fileName, std::ios::binary);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+std::vector<char> viewContents(CacheFileView const& view)
+{
+    auto const* data = static_cast<char const*>(view.data());
+    return view.empty() ? std::vector<char>{} : std::vector<char>(data, data + view.size());
+}
+} // namespace
+
+TEST(CacheUtils, RoundTripThroughHeader)
+{
+    TempCachePath const path("trt_cache_utils_roundtrip.bin");
+    CountingLogger logger;
+    auto const payload = makePayload(4096);
+    VectorHostMemory const blob(payload);
+    saveCacheFile(logger, path.str(), &blob);
+
+    // The file is the header followed by the payload, not the raw blob.
+    auto const file = readFile(path.str());
+    ASSERT_EQ(file.size(), payload.size() + kHEADER_SIZE);
+    EXPECT_EQ(std::memcmp(file.data(), "TRTCACHE", 8), 0);
+    EXPECT_TRUE(std::equal(payload.begin(), payload.end(), file.begin() + kHEADER_SIZE));
+
+    EXPECT_EQ(loadCacheFile(logger, path.str()), payload);
+    EXPECT_EQ(viewContents(mapCacheFile(logger, path.str())), payload);
+    EXPECT_EQ(logger.warnings(), 0);
+}
+
+TEST(CacheUtils, TruncatedFileIsTorn)
+{
+    TempCachePath const path("trt_cache_utils_torn.bin");
+    CountingLogger logger;
+    VectorHostMemory const blob(makePayload(4096));
+    saveCacheFile(logger, path.str(), &blob);
+    auto const file = readFile(path.str());
+
+    // Cut inside the payload, as a writer killed mid-write would, and right after the header.
+    for (size_t const size : {file.size() - 1, file.size() / 2, kHEADER_SIZE})
+    {
+        writeFile(path.str(), std::vector<char>(file.begin(), file.begin() + static_cast<std::ptrdiff_t>(size)));
+        int32_t const warnings = logger.warnings();
+        EXPECT_TRUE(loadCacheFile(logger, path.str()).empty()) << size;
+        EXPECT_TRUE(mapCacheFile(logger, path.str()).empty()) << size;
+        EXPECT_EQ(logger.warnings(), warnings + 2) << size;
+    }
+
+    // A complete file with a damaged payload fails the checksum.
+    auto corrupt = file;
+    corrupt[kHEADER_SIZE + 100] ^= 1;
+    writeFile(path.str(), corrupt);
+    EXPECT_TRUE(loadCacheFile(logger, path.str()).empty());
+    EXPECT_TRUE(mapCacheFile(logger, path.str()).empty());
+}
+
+TEST(CacheUtils, RawCachePassesThroughUnchanged)
+{
+    TempCachePath const path("trt_cache_utils_raw.bin");
+    CountingLogger logger;
+    // Shorter than the header, and longer than it without the magic.
+    for (size_t const size : {kHEADER_SIZE - 1, size_t{4096}})
+    {
+        std::vector<char> raw(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            raw[i] = static_cast<char>(i * 7 + 1);
+        }
+        writeFile(path.str(), raw);
+        EXPECT_EQ(loadCacheFile(logger, path.str()), raw) << size;
+        EXPECT_EQ(viewContents(mapCacheFile(logger, path.str())), raw) << size;
+    }
+    EXPECT_EQ(logger.warnings(), 0);
+}
+
+TEST(CacheUtils, UpdateWithoutBlobLeavesFileUnchanged)
+{
+    TempCachePath const path("trt_cache_utils_no_blob.bin");
+    CountingLogger logger;
+    auto const payload = makePayload(256);
+    VectorHostMemory const blob(payload);
+    saveCacheFile(logger, path.str(), &blob);
+
+    std::vector<char> seen;
+    EXPECT_FALSE(updateCacheFile(logger, path.str(), [&seen](std::vector<char> const& contents) {
+        seen = contents;
+        return std::unique_ptr<IHostMemory>{};
+    }));
+    EXPECT_EQ(seen, payload);
+    EXPECT_EQ(loadCacheFile(logger, path.str()), payload);
+}
+
+#ifndef _MSC_VER
+// The file lock is per process, so the updaters are separate processes, like two concurrent builds.
+TEST(CacheUtils, ConcurrentUpdatersKeepEveryEntry)
+{
+    TempCachePath const path("trt_cache_utils_concurrent.bin");
+    constexpr int32_t kUPDATERS{2};
+    constexpr int32_t kUPDATES{100};
+
+    // The children block reading this pipe until the parent closes it, so that they start together.
+    int32_t startPipe[2];
+    ASSERT_EQ(pipe(startPipe), 0);
+    std::vector<pid_t> children;
+    for (int32_t updater = 0; updater < kUPDATERS; ++updater)
+    {
+        pid_t const pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0)
+        {
+            close(startPipe[1]);
+            char start{};
+            static_cast<void>(read(startPipe[0], &start, 1));
+            CountingLogger logger;
+            for (int32_t i = 0; i < kUPDATES; ++i)
+            {
+                // Each update appends one line to whatever the file holds, like combining timing caches.
+                std::string const entry = std::to_string(updater) + ":" + std::to_string(i) + "\n";
+                bool const updated = updateCacheFile(logger, path.str(), [&entry](std::vector<char> const& contents) {
+                    auto merged = contents;
+                    merged.insert(merged.end(), entry.begin(), entry.end());
+                    // Combining takes a while; long enough for the other updater to run in between.
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                    return std::make_unique<VectorHostMemory>(std::move(merged));
+                });
+                if (!updated)
+                {
+                    _exit(1);
+                }
+            }
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    close(startPipe[0]);
+    close(startPipe[1]);
+    for (pid_t const pid : children)
+    {
+        int32_t status{};
+        ASSERT_EQ(waitpid(pid, &status, 0), pid);
+        EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    CountingLogger logger;
+    auto const contents = loadCacheFile(logger, path.str());
+    std::set<std::string> entries;
+    size_t lines = 0;
+    std::string line;
+    for (char const c : contents)
+    {
+        if (c == '\n')
+        {
+            entries.insert(line);
+            line.clear();
+            ++lines;
+        }
+        else
+        {
+            line += c;
+        }
+    }
+    EXPECT_EQ(lines, static_cast<size_t>(kUPDATERS * kUPDATES));
+    for (int32_t updater = 0; updater < kUPDATERS; ++updater)
+    {
+        for (int32_t i = 0; i < kUPDATES; ++i)
+        {
+            EXPECT_EQ(entries.count(std::to_string(updater) + ":" + std::to_string(i)), 1U);
+        }
+    }
+}
+#endif // _MSC_VER
@@ -16,6 +16,9 @@
  */
 #include "fileLock.h"
 #include "NvInfer.h"
+#ifndef _MSC_VER
+#include <fcntl.h> // fcntl
+#endif
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -23,7 +26,7 @@
 namespace nvinfer1::utils
 {
 
-FileLock::FileLock(ILogger& logger, std::string fileName)
+FileLock::FileLock(ILogger& logger, std::string fileName, Mode mode)
     : mLogger(logger)
     , mFileName(std::move(fileName))
 {
@@ -40,8 +43,10 @@ FileLock::FileLock(ILogger& logger, std::string fileName)
     {
         throw std::runtime_error("Failed to lock " + lockFileName + "!");
     }
+    static_cast<void>(mode);
 #elif defined(__QNX__)
     // Calling lockf(F_TLOCK) on QNX returns -1; the reported error is 89 (function not implemented).
+    static_cast<void>(mode);
     mLogger.log(ILogger::Severity::kVERBOSE, "FileLock is not supported on QNX or HOS.");
 #else
     mHandle = fopen(lockFileName.c_str(), "wb+");
@@ -49,13 +54,27 @@ FileLock::FileLock(ILogger& logger, std::string fileName)
     {
         throw std::runtime_error("Cannot open " + lockFileName + "!");
     }
+    bool const shared = mode == Mode::kSHARED;
     {
         std::stringstream ss;
-        ss << "Trying to set exclusive file lock " << lockFileName << std::endl;
+        ss << "Trying to set " << (shared ? "shared" : "exclusive") << " file lock " << lockFileName << std::endl;
         mLogger.log(ILogger::Severity::kVERBOSE, ss.str().c_str());
     }
     mDescriptor = fileno(mHandle);
-    auto ret = lockf(mDescriptor, F_LOCK, 0);
+    // lockf() only takes exclusive locks. A shared lock uses the underlying fcntl() record lock directly, which
+    // interoperates with lockf() on the same file.
+    int32_t ret{};
+    if (shared)
+    {
+        struct flock region{};
+        region.l_type = F_RDLCK;
+        region.l_whence = SEEK_SET;
+        ret = fcntl(mDescriptor, F_SETLKW, &region);
+    }
+    else
+    {
+        ret = lockf(mDescriptor, F_LOCK, 0);
+    }
     if (ret != 0)
     {
         mDescriptor = -1;
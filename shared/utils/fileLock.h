@@ -41,7 +41,15 @@ namespace nvinfer1::utils
 class FileLock
 {
 public:
-    explicit FileLock(nvinfer1::ILogger& logger, std::string fileName);
+    //! \brief Lock modes. Any number of kSHARED holders may coexist; kEXCLUSIVE excludes every other holder.
+    //! Windows has no shared lock file mode, so kSHARED behaves like kEXCLUSIVE there.
+    enum class Mode
+    {
+        kEXCLUSIVE,
+        kSHARED,
+    };
+
+    explicit FileLock(nvinfer1::ILogger& logger, std::string fileName, Mode mode = Mode::kEXCLUSIVE);
     ~FileLock();
     FileLock() = delete;                           // no default ctor
     FileLock(FileLock const&) = delete;            // no copy ctor
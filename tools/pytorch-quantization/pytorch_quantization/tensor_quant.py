@@ -317,19 +317,23 @@ class FakeTensorQuantFunction(Function):
             outputs, scale = _tensor_quant(inputs, amax, num_bits, unsigned, narrow_range)
             return outputs / scale.to(inputs.dtype)
 
-        if not inputs.is_cuda:
+        # The extension has both CUDA and CPU kernels. On CPU, where the legacy path has always been used, only use
+        # the extension when it gives the same result: the kernels ignore narrow_range, compute in float32, and only
+        # treat amax below 2^-24 as zero where the legacy path also zeroes amax equal to it.
+        if not inputs.is_cuda and not (narrow_range and inputs.dtype == torch.float32 and amax.dtype == torch.float32
+                                       and amax.min() > 1. / (1 << 24)):
+            return legacy_quant_func()
+
+        try:
+            if amax.numel() == 1:
+                outputs = cuda_ext.fake_tensor_quant(inputs, amax, num_bits, unsigned, narrow_range)
+            else:
+                axis = amax.shape.index(amax.numel())
+
+                outputs = cuda_ext.fake_tensor_quant_with_axis(inputs, amax.squeeze(), axis, num_bits, unsigned,
+                                                               narrow_range)
+        except (RuntimeError, ValueError) as error:
             outputs = legacy_quant_func()
-        else:
-            try:
-                if amax.numel() == 1:
-                    outputs = cuda_ext.fake_tensor_quant(inputs, amax, num_bits, unsigned, narrow_range)
-                else:
-                    axis = amax.shape.index(amax.numel())
-
-                    outputs = cuda_ext.fake_tensor_quant_with_axis(inputs, amax.squeeze(), axis, num_bits, unsigned,
-                                                                   narrow_range)
-            except (RuntimeError, ValueError) as error:
-                outputs = legacy_quant_func()
 
         return outputs
 
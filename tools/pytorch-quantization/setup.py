@@ -65,6 +65,7 @@ setup(
         CUDAExtension(
             name="pytorch_quantization.cuda_ext",
             sources=[os.path.join(abspath, "src/tensor_quant.cpp"),
+                     os.path.join(abspath, "src/tensor_quant_cpu.cpp"),
                      os.path.join(abspath, "src/tensor_quant_gpu.cu")])
     ],
     cmdclass={
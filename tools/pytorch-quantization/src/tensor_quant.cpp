@@ -22,28 +22,40 @@ at::Tensor fake_tensor_quant_cuda(at::Tensor, at::Tensor, int, bool, bool);
 at::Tensor fake_tensor_quant_with_axis_cuda(at::Tensor, at::Tensor, int, int, bool, bool);
 float bits_to_bound(int, int);
 at::Tensor fake_e4m3fy_cuda(at::Tensor inputs);
+void fake_tensor_quant_cpu_inplace(at::Tensor, at::Tensor, int, bool, bool);
+at::Tensor fake_tensor_quant_cpu(at::Tensor, at::Tensor, int, bool, bool);
+at::Tensor fake_tensor_quant_with_axis_cpu(at::Tensor, at::Tensor, int, int, bool, bool);
+at::Tensor fake_e4m3fy_cpu(at::Tensor inputs);
 
 void fake_tensor_quant_(at::Tensor inputs, at::Tensor amax, int num_bits = 8,
                         bool is_unsigned = false, bool narrow_range = true) {
-  TORCH_CHECK(inputs.is_cuda());
   TORCH_CHECK(inputs.is_contiguous())  // in-place on non-contiguous tensor is more difficult
   TORCH_CHECK(amax.numel(), 1);
-  fake_tensor_quant_cuda_inplace(inputs, amax, num_bits, is_unsigned, narrow_range);
+  if (inputs.is_cuda()) {
+    fake_tensor_quant_cuda_inplace(inputs, amax, num_bits, is_unsigned, narrow_range);
+  } else {
+    fake_tensor_quant_cpu_inplace(inputs, amax, num_bits, is_unsigned, narrow_range);
+  }
 }
 
 at::Tensor fake_tensor_quant(at::Tensor inputs, at::Tensor amax, int num_bits = 8,
                              bool is_unsigned = false, bool narrow_range = true) {
-  TORCH_CHECK(inputs.is_cuda());
   TORCH_CHECK(amax.numel(), 1);
-  return fake_tensor_quant_cuda(inputs.contiguous(), amax.contiguous(), num_bits, is_unsigned, narrow_range);
+  if (inputs.is_cuda()) {
+    return fake_tensor_quant_cuda(inputs.contiguous(), amax.contiguous(), num_bits, is_unsigned, narrow_range);
+  }
+  return fake_tensor_quant_cpu(inputs.contiguous(), amax.contiguous(), num_bits, is_unsigned, narrow_range);
 }
 
 at::Tensor fake_tensor_quant_with_axis(at::Tensor inputs, at::Tensor amax, int axis,
                                        int num_bits = 8, bool is_unsigned = false,
                                        bool narrow_range = true) {
-  TORCH_CHECK(inputs.is_cuda());
   TORCH_CHECK(amax.numel(), inputs.size(axis));
-  return fake_tensor_quant_with_axis_cuda(
+  if (inputs.is_cuda()) {
+    return fake_tensor_quant_with_axis_cuda(
+        inputs.contiguous(), amax.contiguous(), axis, num_bits, is_unsigned, narrow_range);
+  }
+  return fake_tensor_quant_with_axis_cpu(
       inputs.contiguous(), amax.contiguous(), axis, num_bits, is_unsigned, narrow_range);
 }
 
@@ -51,29 +63,39 @@ at::Tensor fake_tensor_quant_with_axis(at::Tensor inputs, at::Tensor amax, int a
 #if CUDA_VERSION > 11070
 
   #include <cuda_fp8.h>
-  #include <ATen/ATen.h>
-
-  at::Tensor fake_e4m3fy_cuda(at::Tensor inputs);
 
   at::Tensor fake_e4m3fy(at::Tensor inputs) {
     if (inputs.is_cuda()) {
       return fake_e4m3fy_cuda(inputs.contiguous());
-    } else {
-      TORCH_CHECK(inputs.dtype() == at::ScalarType::Float);
-      TORCH_CHECK(inputs.is_contiguous());
-      auto out = at::zeros_like(inputs);
-      for (int i = 0; i < inputs.numel(); ++i) {
-        out.data_ptr<float>()[i] = static_cast<float>(static_cast<__nv_fp8_e4m3>(inputs.data_ptr<float>()[i]));
-      }
-      return out;
     }
+    return fake_e4m3fy_cpu(inputs.contiguous());
+  }
+
+  // The scalar loop fake_e4m3fy used on CPU before fake_e4m3fy_cpu, kept as a reference for tests and benchmarks.
+  at::Tensor fake_e4m3fy_reference(at::Tensor inputs) {
+    TORCH_CHECK(inputs.dtype() == at::ScalarType::Float);
+    TORCH_CHECK(inputs.is_contiguous());
+    TORCH_CHECK(!inputs.is_cuda());
+    auto out = at::zeros_like(inputs);
+    for (int i = 0; i < inputs.numel(); ++i) {
+      out.data_ptr<float>()[i] = static_cast<float>(static_cast<__nv_fp8_e4m3>(inputs.data_ptr<float>()[i]));
+    }
+    return out;
   }
 
 #else
 
   #include <stdexcept>
 
+  // The CPU path does not depend on cuda_fp8.h.
   at::Tensor fake_e4m3fy(at::Tensor inputs) {
+    if (inputs.is_cuda()) {
+      throw std::runtime_error("FP8 emulation is not supported on CUDA 11.7 and below");
+    }
+    return fake_e4m3fy_cpu(inputs.contiguous());
+  }
+
+  at::Tensor fake_e4m3fy_reference(at::Tensor inputs) {
     throw std::runtime_error("FP8 emulation is not supported on CUDA 11.7 and below");
   }
 
@@ -92,4 +114,6 @@ PYBIND11_MODULE(TORCH_EXTENSION_NAME, m) {
 
   m.def("fake_e4m3fy", &fake_e4m3fy, "Reduce precision to E4M3",
         py::arg("inputs"));
+  m.def("_fake_e4m3fy_reference", &fake_e4m3fy_reference,
+        "Reduce precision to E4M3 with the scalar __nv_fp8_e4m3 conversion, on CPU", py::arg("inputs"));
 }
@@ -0,0 +1,210 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 1993-2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// CPU versions of the kernels in tensor_quant_gpu.cu. Results match the CUDA kernels bit for bit: the same float
+// arithmetic is done in the same order, only rounding is spelled differently so that the element loops have no
+// branches or library calls and the compiler can vectorize them. Loops are split across threads with
+// at::parallel_for.
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <torch/extension.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#define EPSILON (1. / (1<<24))  // Minimum representable of fp16
+
+namespace {
+
+// 1.5 * 2^23. Adding and subtracting it rounds a float of magnitude below 2^22 to an integer, ties to even, like rint
+// in the default rounding mode.
+constexpr float kRoundMagic = 12582912.f;
+constexpr float kRoundMagicLimit = 4194304.f;  // 2^22
+
+constexpr float kE4M3MaxNorm = 448.f;
+constexpr float kE4M3MinNorm = 0.015625f;  // 2^-6; below it, E4M3 values are multiples of 2^-9
+
+inline uint32_t float_as_bits(float x) {
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+inline float bits_as_float(uint32_t bits) {
+  float x;
+  std::memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+// rint for |x| < 2^22. The sign is restored afterwards so that negative values rounding to zero give -0 like rint.
+inline float round_half_even(float x) {
+  return std::copysign((std::fabs(x) + kRoundMagic) - kRoundMagic, x);
+}
+
+// Picks a or b without a branch. Float selects written with ?: are not if-converted under -ftrapping-math, which
+// keeps the loops calling e4m3_round from vectorizing.
+inline uint32_t select_bits(bool condition, uint32_t a, uint32_t b) {
+  const uint32_t mask = 0u - uint32_t(condition);
+  return (a & mask) | (b & ~mask);
+}
+
+// Same as static_cast<float>(static_cast<__nv_fp8_e4m3>(x)): round to nearest even, saturate to the largest finite
+// E4M3 value, keep NaN. Ranges are told apart on the bits of |x|, which order like the values.
+inline float e4m3_round(float x) {
+  const uint32_t bits = float_as_bits(x);
+  const uint32_t sign = bits & 0x80000000u;
+  const uint32_t abs_bits = bits ^ sign;
+  // Normal range: drop all but the top 3 mantissa bits, rounding to nearest even.
+  uint32_t rounded = (abs_bits + 0x7FFFFu + ((abs_bits >> 20) & 1u)) & 0xFFF00000u;
+  // Subnormal range. |x| * 512 is exact and below 8, so the magic constant rounds it.
+  const float subnormal = ((bits_as_float(abs_bits) * 512.f + kRoundMagic) - kRoundMagic) * (1.f / 512.f);
+  rounded = select_bits(abs_bits < float_as_bits(kE4M3MinNorm), float_as_bits(subnormal), rounded);
+  rounded = select_bits(abs_bits > float_as_bits(kE4M3MaxNorm), float_as_bits(kE4M3MaxNorm), rounded);
+  rounded = select_bits(abs_bits > 0x7F800000u, abs_bits, rounded);  // NaN
+  return bits_as_float(rounded | sign);
+}
+
+// Quantizes n contiguous elements with a single amax, as fake_tensor_quant_device does for each of them.
+template <typename T>
+void fake_tensor_quant_span(const T* inputs, T* outputs, int64_t n, float amax, float min_bound,
+                            float max_bound) {
+  if (amax < EPSILON) {
+    std::fill(outputs, outputs + n, static_cast<T>(0.f));
+    return;
+  }
+
+  const float scale = max_bound / amax;
+  if (max_bound < kRoundMagicLimit) {
+    // Clamping before rounding gives the same result as the other way around because the bounds are integers.
+    for (int64_t i = 0; i < n; ++i) {
+      float output = static_cast<float>(inputs[i]) * scale;
+      output = output > max_bound ? max_bound : output;
+      output = output < min_bound ? min_bound : output;
+      outputs[i] = static_cast<T>(round_half_even(output) / scale);
+    }
+  } else {
+    for (int64_t i = 0; i < n; ++i) {
+      float output = std::nearbyint(static_cast<float>(inputs[i]) * scale);
+      output = output > max_bound ? max_bound : output;
+      output = output < min_bound ? min_bound : output;
+      outputs[i] = static_cast<T>(output / scale);
+    }
+  }
+}
+
+// The CUDA kernels assert these on the device.
+void check_quant_args(const at::Tensor& inputs, const at::Tensor& amax, bool is_unsigned) {
+  TORCH_CHECK(amax.min().item<float>() >= 0, "amax must be non-negative");
+  if (is_unsigned) {
+    TORCH_CHECK(inputs.min().item<float>() >= 0, "Unsigned quantization requires non-negative inputs");
+  }
+}
+
+void fake_tensor_quant_cpu_impl(const at::Tensor& inputs, const at::Tensor& amax, at::Tensor& outputs,
+                                int num_bits, bool is_unsigned) {
+  const int64_t numel = inputs.numel();
+  if (numel == 0) {
+    return;
+  }
+  check_quant_args(inputs, amax, is_unsigned);
+
+  const float amax_value = amax.to(at::kCPU, at::ScalarType::Float).item<float>();
+  const float bound = (1 << (num_bits - 1 + int(is_unsigned))) - 1;
+  const float max_bound = bound;
+  const float min_bound = -bound;
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, inputs.scalar_type(), "fake_tensor_quant_cpu", [&] {
+        const scalar_t* in = inputs.data_ptr<scalar_t>();
+        scalar_t* out = outputs.data_ptr<scalar_t>();
+        at::parallel_for(0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+          fake_tensor_quant_span(in + begin, out + begin, end - begin, amax_value, min_bound, max_bound);
+        });
+      });
+}
+
+}  // namespace
+
+// narrow_range is accepted for the same signature as the CUDA functions and, like there, not used: the CUDA kernels
+// are launched with their default and always clamp to [-bound, bound].
+void fake_tensor_quant_cpu_inplace(at::Tensor inputs, at::Tensor amax, int num_bits = 8,
+                                   bool is_unsigned = false, bool narrow_range = true) {
+  fake_tensor_quant_cpu_impl(inputs, amax, inputs, num_bits, is_unsigned);
+}
+
+at::Tensor fake_tensor_quant_cpu(at::Tensor inputs, at::Tensor amax, int num_bits = 8,
+                                 bool is_unsigned = false, bool narrow_range = true) {
+  auto outputs = torch::empty_like(inputs);
+  fake_tensor_quant_cpu_impl(inputs, amax, outputs, num_bits, is_unsigned);
+  return outputs;
+}
+
+at::Tensor fake_tensor_quant_with_axis_cpu(at::Tensor inputs, at::Tensor amax, int axis,
+                                           int num_bits = 8, bool is_unsigned = false,
+                                           bool narrow_range = true) {
+  auto outputs = torch::empty_like(inputs);
+  const int64_t numel = inputs.numel();
+  if (numel == 0) {
+    return outputs;
+  }
+  check_quant_args(inputs, amax, is_unsigned);
+
+  auto amax_cpu = amax.to(at::kCPU, at::ScalarType::Float).contiguous();
+  const float* amax_ptr = amax_cpu.data_ptr<float>();
+  const int64_t axis_size = inputs.size(axis);
+  // Elements sharing an amax are contiguous: quantize them as a span, one span per index along the axis.
+  const int64_t inner_size = inputs.stride(axis);
+  const int64_t num_spans = numel / inner_size;
+
+  const float bound = (1 << (num_bits - 1 + int(is_unsigned))) - 1;
+  const float max_bound = bound;
+  const float min_bound = -bound;
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, inputs.scalar_type(), "fake_tensor_quant_with_axis_cpu", [&] {
+        const scalar_t* in = inputs.data_ptr<scalar_t>();
+        scalar_t* out = outputs.data_ptr<scalar_t>();
+        const int64_t grain_size = std::max<int64_t>(1, at::internal::GRAIN_SIZE / inner_size);
+        at::parallel_for(0, num_spans, grain_size, [&](int64_t begin, int64_t end) {
+          for (int64_t span = begin; span < end; ++span) {
+            const int64_t offset = span * inner_size;
+            fake_tensor_quant_span(in + offset, out + offset, inner_size, amax_ptr[span % axis_size], min_bound,
+                                   max_bound);
+          }
+        });
+      });
+  return outputs;
+}
+
+at::Tensor fake_e4m3fy_cpu(at::Tensor inputs) {
+  auto outputs = torch::empty_like(inputs);
+  const int64_t numel = inputs.numel();
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::Half, at::ScalarType::BFloat16, inputs.scalar_type(), "fake_e4m3fy_cpu", [&] {
+        const scalar_t* in = inputs.data_ptr<scalar_t>();
+        scalar_t* out = outputs.data_ptr<scalar_t>();
+        at::parallel_for(0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            out[i] = static_cast<scalar_t>(e4m3_round(static_cast<float>(in[i])));
+          }
+        });
+      });
+  return outputs;
+}
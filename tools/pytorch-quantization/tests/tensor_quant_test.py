@@ -16,6 +16,8 @@
 #
 """tests of tensor quantization function and module"""
 import contextlib
+import os
+import time
 
 import pytest
 import numpy as np
@@ -319,6 +321,132 @@ class TestFakeTensorQuant():
                 test_utils.compare(legacy_out, test_out, rtol=0, atol=0)
 
 
+requires_cuda = pytest.mark.skipif(not torch.cuda.is_available(), reason="CUDA is not available")
+
+
+class TestFakeTensorQuantCpu():
+    """The CPU kernels of cuda_ext must match the CUDA kernels bit for bit"""
+
+    @staticmethod
+    def _inputs(shape, dtype):
+        # Random values plus the ones that take special paths: zeros of both signs, ties, out of range and tiny values.
+        x = torch.randn(shape).flatten()
+        special = torch.tensor([0., -0., 0.5, -0.5, 1.5, -2.5, 1e3, -1e3, 1e-30, -1e-30])
+        x[:special.numel()] = special
+        return x.view(shape).to(dtype)
+
+    @staticmethod
+    def _assert_equal(a, b):
+        assert a.dtype == b.dtype
+        assert torch.equal(a.cpu(), b.cpu())
+
+    @requires_cuda
+    @pytest.mark.parametrize("dtype", [torch.float32, torch.float64, torch.float16, torch.bfloat16])
+    @pytest.mark.parametrize("narrow_range", [True, False])
+    def test_against_cuda(self, dtype, narrow_range):
+        x = self._inputs((37, 1025), dtype)
+        for num_bits in [3, 4, 5, 7, 8, 11, 16]:
+            for unsigned in [True, False]:
+                inputs = x.abs() if unsigned else x
+                amax = inputs.abs().max().float() / 2
+                self._assert_equal(
+                    cuda_ext.fake_tensor_quant(inputs, amax, num_bits, unsigned, narrow_range),
+                    cuda_ext.fake_tensor_quant(inputs.cuda(), amax.cuda(), num_bits, unsigned, narrow_range))
+
+                inplace = inputs.clone()
+                cuda_ext.fake_tensor_quant_(inplace, amax, num_bits, unsigned, narrow_range)
+                self._assert_equal(inplace,
+                                   cuda_ext.fake_tensor_quant(inputs.cuda(), amax.cuda(), num_bits, unsigned,
+                                                              narrow_range))
+
+    @requires_cuda
+    @pytest.mark.parametrize("dtype", [torch.float32, torch.float64, torch.float16, torch.bfloat16])
+    @pytest.mark.parametrize("axis", [0, 1, 2])
+    def test_against_cuda_with_axis(self, dtype, axis):
+        x = self._inputs((5, 7, 129), dtype)
+        amax = torch.rand(x.shape[axis]) * 2
+        amax[0] = 0.  # Quantizes the whole channel to zero
+        for num_bits in [4, 8]:
+            for narrow_range in [True, False]:
+                self._assert_equal(
+                    cuda_ext.fake_tensor_quant_with_axis(x, amax, axis, num_bits, False, narrow_range),
+                    cuda_ext.fake_tensor_quant_with_axis(x.cuda(), amax.cuda(), axis, num_bits, False, narrow_range))
+
+    @requires_cuda
+    @pytest.mark.parametrize("dtype", [torch.float32, torch.float64, torch.float16, torch.bfloat16])
+    def test_e4m3_against_cuda(self, dtype):
+        x = self._inputs((37, 1025), dtype) * 100
+        self._assert_equal(cuda_ext.fake_e4m3fy(x), cuda_ext.fake_e4m3fy(x.cuda()))
+
+    def test_against_legacy(self):
+        x = self._inputs((37, 1025), torch.float32)
+        for num_bits in [3, 4, 5, 7, 8, 11]:
+            amax = x.abs().max() / 2
+            self._assert_equal(cuda_ext.fake_tensor_quant(x, amax, num_bits, False, True),
+                               tensor_quant.legacy_fake_tensor_quant(x, amax, num_bits, False, True))
+
+            amax = x.abs().amax(dim=1, keepdim=True)
+            self._assert_equal(cuda_ext.fake_tensor_quant_with_axis(x, amax.squeeze(), 0, num_bits, False, True),
+                               tensor_quant.legacy_fake_tensor_quant(x, amax, num_bits, False, True))
+
+    def test_narrow_range_ignored(self):
+        """Like the CUDA kernels, the CPU kernels always clamp to the narrow range"""
+        x = self._inputs((37, 1025), torch.float32)
+        amax = x.abs().max() / 2
+        self._assert_equal(cuda_ext.fake_tensor_quant(x, amax, 8, False, False),
+                           cuda_ext.fake_tensor_quant(x, amax, 8, False, True))
+        amax = x.abs().amax(dim=1)
+        self._assert_equal(cuda_ext.fake_tensor_quant_with_axis(x, amax, 0, 8, False, False),
+                           cuda_ext.fake_tensor_quant_with_axis(x, amax, 0, 8, False, True))
+
+    @pytest.mark.parametrize("dtype", [torch.float32, torch.float64, torch.float16, torch.bfloat16])
+    def test_function_matches_legacy(self, dtype):
+        """fake_tensor_quant on CPU gives the legacy results for every dtype, range and amax"""
+        x = self._inputs((37, 1025), dtype)
+        channel_amax = x.float().abs().amax(dim=1, keepdim=True)
+        tiny_amax = channel_amax.clone()
+        tiny_amax[0] = 2.**-24  # Zeroed by the legacy path, not by the kernels
+        tiny_amax[1] = 0.
+        for amax in [x.float().abs().max() / 2, torch.tensor(2.**-24), channel_amax, tiny_amax, channel_amax.double()]:
+            for narrow_range in [True, False]:
+                self._assert_equal(tensor_quant.fake_tensor_quant(x, amax, 8, False, narrow_range),
+                                   tensor_quant.legacy_fake_tensor_quant(x, amax, 8, False, narrow_range))
+
+    def test_e4m3_all_fp16_values(self):
+        """Every half value through the CPU kernel matches the scalar __nv_fp8_e4m3 conversion"""
+        x = torch.arange(-2**15, 2**15, dtype=torch.int32).to(torch.int16).view(torch.float16).float()
+        x = x[~x.isnan()]
+        self._assert_equal(cuda_ext.fake_e4m3fy(x), cuda_ext._fake_e4m3fy_reference(x))
+
+        special = torch.tensor([float("inf"), -float("inf"), 448., 449., 464., -465., 2.**-10, 3 * 2.**-11, 1e-40])
+        self._assert_equal(cuda_ext.fake_e4m3fy(special), cuda_ext._fake_e4m3fy_reference(special))
+        assert cuda_ext.fake_e4m3fy(torch.tensor([float("nan")])).isnan().all()
+
+    def test_checks(self):
+        with pytest.raises(RuntimeError, match="amax must be non-negative"):
+            cuda_ext.fake_tensor_quant(torch.randn(8), torch.tensor(-1.))
+        with pytest.raises(RuntimeError, match="non-negative inputs"):
+            cuda_ext.fake_tensor_quant(-torch.rand(8) - 1, torch.tensor(1.), 8, True)
+
+    @pytest.mark.skipif("PYTORCH_QUANTIZATION_BENCHMARK" not in os.environ,
+                        reason="Set PYTORCH_QUANTIZATION_BENCHMARK to run benchmarks")
+    def test_e4m3_benchmark(self):
+        """Compares fake_e4m3fy on CPU with the scalar loop it replaced"""
+        x = torch.randn(1 << 24) * 100
+
+        def run(fn, repeat=5):
+            fn(x)
+            start = time.perf_counter()
+            for _ in range(repeat):
+                fn(x)
+            return (time.perf_counter() - start) / repeat
+
+        scalar_s = run(cuda_ext._fake_e4m3fy_reference)
+        vector_s = run(cuda_ext.fake_e4m3fy)
+        print("fake_e4m3fy on {} elements, {} threads: scalar loop {:.1f} ms, CPU kernel {:.1f} ms ({:.1f}x)".format(
+            x.numel(), torch.get_num_threads(), scalar_s * 1e3, vector_s * 1e3, scalar_s / vector_s))
+
+
 class TestQuantDescriptor():
 
     def test_scaled_mode(self):